@@ -1,6 +1,7 @@
 #include "active_item_cache.h"
 
 #include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include "item.h"
@@ -8,22 +9,30 @@
 
 void active_item_cache::remove( const item *it )
 {
-    active_items[it->processing_speed()].remove_if( [it]( const item_reference & active_item ) {
+    const auto is_target_or_broken = [it]( const item_reference & active_item ) {
         item *const target = active_item.item_ref.get();
         return !target || target == it;
-    } );
+    };
+    // Look the lists up rather than indexing, so removing an item that was never active does
+    // not leave behind empty lists that keep empty() false.
+    const auto speed_list = active_items.find( it->processing_speed() );
+    if( speed_list != active_items.end() ) {
+        speed_list->second.remove_if( is_target_or_broken );
+        if( speed_list->second.empty() ) {
+            active_items.erase( speed_list );
+        }
+    }
     if( it->can_revive() ) {
-        special_items[ special_item_type::corpse ].remove_if( [it]( const item_reference & active_item ) {
-            item *const target = active_item.item_ref.get();
-            return !target || target == it;
-        } );
+        const auto corpses = special_items.find( special_item_type::corpse );
+        if( corpses != special_items.end() ) {
+            corpses->second.remove_if( is_target_or_broken );
+        }
     }
     if( it->get_use( "explosion" ) ) {
-        special_items[ special_item_type::explosive ].remove_if( [it]( const item_reference &
-        active_item ) {
-            item *const target = active_item.item_ref.get();
-            return !target || target == it;
-        } );
+        const auto explosives = special_items.find( special_item_type::explosive );
+        if( explosives != special_items.end() ) {
+            explosives->second.remove_if( is_target_or_broken );
+        }
     }
 }
 
@@ -54,15 +63,17 @@ bool active_item_cache::empty() const
 std::vector<item_reference> active_item_cache::get()
 {
     std::vector<item_reference> all_cached_items;
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
-        for( std::list<item_reference>::iterator it = kv.second.begin(); it != kv.second.end(); ) {
+    for( auto kv = active_items.begin(); kv != active_items.end(); ) {
+        std::list<item_reference> &refs = kv->second;
+        for( std::list<item_reference>::iterator it = refs.begin(); it != refs.end(); ) {
             if( it->item_ref ) {
                 all_cached_items.emplace_back( *it );
                 ++it;
             } else {
-                it = kv.second.erase( it );
+                it = refs.erase( it );
             }
         }
+        kv = refs.empty() ? active_items.erase( kv ) : std::next( kv );
     }
     return all_cached_items;
 }
@@ -70,23 +81,25 @@ std::vector<item_reference> active_item_cache::get()
 std::vector<item_reference> active_item_cache::get_for_processing()
 {
     std::vector<item_reference> items_to_process;
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
+    for( auto kv = active_items.begin(); kv != active_items.end(); ) {
+        std::list<item_reference> &refs = kv->second;
         // Rely on iteration logic to make sure the number is sane.
-        int num_to_process = kv.second.size() / kv.first;
-        std::list<item_reference>::iterator it = kv.second.begin();
-        for( ; it != kv.second.end() && num_to_process >= 0; ) {
+        int num_to_process = refs.size() / kv->first;
+        std::list<item_reference>::iterator it = refs.begin();
+        for( ; it != refs.end() && num_to_process >= 0; ) {
             if( it->item_ref ) {
                 items_to_process.push_back( *it );
                 --num_to_process;
                 ++it;
             } else {
                 // The item has been destroyed, so remove the reference from the cache
-                it = kv.second.erase( it );
+                it = refs.erase( it );
             }
         }
         // Rotate the returned items to the end of their list so that the items that weren't
         // returned this time will be first in line on the next call
-        kv.second.splice( kv.second.end(), kv.second, kv.second.begin(), it );
+        refs.splice( refs.end(), refs, refs.begin(), it );
+        kv = refs.empty() ? active_items.erase( kv ) : std::next( kv );
     }
     return items_to_process;
 }
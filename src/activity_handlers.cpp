@@ -3872,7 +3872,8 @@ static void perform_zone_activity_turn( player *p,
     for( auto &tile : tiles ) {
         const auto &tile_loc = g->m.getlocal( tile );
 
-        auto route = g->m.route( p->pos(), tile_loc, p->get_pathfinding_settings(), p->get_path_avoid() );
+        auto route = g->m.route_memoized( p->pos(), tile_loc, p->get_pathfinding_settings(),
+                                          p->get_path_avoid() );
         if( route.size() > 1 ) {
             route.pop_back();
 
@@ -970,7 +970,7 @@ std::vector<tripoint> route_adjacent( const player &p, const tripoint &dest )
 
     const auto &avoid = p.get_path_avoid();
     for( const tripoint &tp : sorted ) {
-        auto route = g->m.route( p.pos(), tp, p.get_pathfinding_settings(), avoid );
+        auto route = g->m.route_memoized( p.pos(), tp, p.get_pathfinding_settings(), avoid );
 
         if( !route.empty() ) {
             return route;
@@ -1982,8 +1982,8 @@ void activity_on_turn_move_loot( player_activity &, player &p )
                 return;
             }
             std::vector<tripoint> route;
-            route = g->m.route( p.pos(), src_loc, p.get_pathfinding_settings(),
-                                p.get_path_avoid() );
+            route = g->m.route_memoized( p.pos(), src_loc, p.get_pathfinding_settings(),
+                                         p.get_path_avoid() );
             if( route.empty() ) {
                 // can't get there, can't do anything, skip it
                 continue;
@@ -2082,8 +2082,8 @@ void activity_on_turn_move_loot( player_activity &, player &p )
                             // get either direct route or route to nearest adjacent tile if
                             // source tile is impassable
                             if( g->m.passable( src_loc ) ) {
-                                route = g->m.route( p.pos(), src_loc, p.get_pathfinding_settings(),
-                                                    p.get_path_avoid() );
+                                route = g->m.route_memoized( p.pos(), src_loc,
+                                                             p.get_pathfinding_settings(), p.get_path_avoid() );
                             } else {
                                 // immpassable source tile (locker etc.),
                                 // get route to nerest adjacent tile instead
@@ -889,15 +889,10 @@ bool advanced_inventory_pane::is_filtered( const item &it ) const
         return false;
     }
 
-    const std::string str = it.tname();
-    if( filtercache.find( str ) == filtercache.end() ) {
-        const auto filter_fn = item_filter_from_string( filter );
-        filtercache[ str ] = filter_fn;
-
-        return !filter_fn( it );
+    if( !filter_fn ) {
+        filter_fn = item_filter_from_string( filter );
     }
-
-    return !filtercache[ str ]( it );
+    return !filter_fn( it );
 }
 
 // roll our own, to handle moving stacks better
@@ -2001,7 +1996,7 @@ void advanced_inventory_pane::set_filter( const std::string &new_filter )
         return;
     }
     filter = new_filter;
-    filtercache.clear();
+    filter_fn = nullptr;
     recalc = true;
 }
 
@@ -0,0 +1,104 @@
+#include "alloc_profile.h"
+
+#if defined(CATA_ALLOC_PROFILE)
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace
+{
+
+// Plain counters only, so using them from operator new never allocates
+thread_local uint64_t thread_allocations = 0;
+thread_local uint64_t thread_bytes = 0;
+
+} // namespace
+
+namespace alloc_profile
+{
+
+bool available()
+{
+#if defined(CATA_ALLOC_PROFILE)
+    return true;
+#else
+    return false;
+#endif
+}
+
+counts current()
+{
+    counts result;
+    result.allocations = thread_allocations;
+    result.bytes = thread_bytes;
+    return result;
+}
+
+} // namespace alloc_profile
+
+#if defined(CATA_ALLOC_PROFILE)
+
+static void *counted_alloc( const std::size_t size ) noexcept
+{
+    ++thread_allocations;
+    thread_bytes += size;
+    return std::malloc( size != 0 ? size : 1 );
+}
+
+void *operator new( const std::size_t size )
+{
+    if( void *const p = counted_alloc( size ) ) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[]( const std::size_t size )
+{
+    if( void *const p = counted_alloc( size ) ) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new( const std::size_t size, const std::nothrow_t & ) noexcept
+{
+    return counted_alloc( size );
+}
+
+void *operator new[]( const std::size_t size, const std::nothrow_t & ) noexcept
+{
+    return counted_alloc( size );
+}
+
+void operator delete( void *p ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete[]( void *p ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete( void *p, std::size_t ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete[]( void *p, std::size_t ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete( void *p, const std::nothrow_t & ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete[]( void *p, const std::nothrow_t & ) noexcept
+{
+    std::free( p );
+}
+
+#endif
@@ -0,0 +1,28 @@
+#pragma once
+#ifndef ALLOC_PROFILE_H
+#define ALLOC_PROFILE_H
+
+#include <cstdint>
+
+/**
+ * Counts of the heap allocations made by the calling thread, for attributing them to the
+ * phases of @ref turn_profile. The counting replaces the global operator new, so it is only
+ * built into the game with the ALLOC_PROFILE build option (CMake or make). Without it the
+ * counts stay zero.
+ */
+namespace alloc_profile
+{
+
+struct counts {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+/** Whether allocations are counted in this build. */
+bool available();
+/** Allocations the calling thread made so far. */
+counts current();
+
+} // namespace alloc_profile
+
+#endif
@@ -1,7 +1,9 @@
 #include "animation.h"
 
 #include "avatar.h"
+#include "calendar.h"
 #include "game.h"
+#include "game_moment.h"
 #include "map.h"
 #include "monster.h"
 #include "mtype.h"
@@ -45,7 +47,16 @@ class basic_animation
 
         void draw() const {
             wrefresh( g->w_terrain );
-            g->draw_panels();
+
+            // Nothing shown in the side panels can change between the frames of the
+            // animations of one action (the shots of a burst, the rings of an explosion),
+            // so they only need to be drawn for the first frame.
+            static game_moment panels_drawn_at;
+            const game_moment now = game_moment::now();
+            if( now != panels_drawn_at ) {
+                g->draw_panels();
+                panels_drawn_at = now;
+            }
 
             query_popup()
             .wait_message( "%s", _( "Hang on a bit..." ) )
@@ -561,7 +561,7 @@ void npc_settings::create_rule( const std::string &to_match )
 void rule_list::create_rule( cache &map_items, const std::string &to_match )
 {
     for( const rule &elem : *this ) {
-        if( !elem.bActive || !wildcard_match( to_match, elem.sRule ) ) {
+        if( !elem.bActive || !wildcard_pattern( elem.sRule ).matches( to_match ) ) {
             continue;
         }
 
@@ -569,6 +569,19 @@ void rule_list::create_rule( cache &map_items, const std::string &to_match )
     }
 }
 
+rule_state player_settings::check_item( const item &it )
+{
+    const std::string name = it.tname( 1, false );
+    // Also fills the cache if the rules changed
+    const rule_state known = check_item( name );
+    if( known != RULE_NONE || map_items.count( name ) > 0 ) {
+        return known;
+    }
+    create_rule( &it );
+    // Remember items no rule matches, so they aren't checked against all of them again
+    return map_items.emplace( name, RULE_NONE ).first->second;
+}
+
 void player_settings::create_rule( const item *it )
 {
     // @todo change it to be a reference
@@ -608,12 +621,13 @@ void rule_list::refresh_map_items( cache &map_items ) const
             continue;
         }
 
+        const wildcard_pattern pattern( elem.sRule );
         if( !elem.bExclude ) {
             //Check include patterns against all itemfactory items
             for( const itype *e : item_controller->all() ) {
                 const std::string &cur_item = e->nname( 1 );
 
-                if( !check_special_rule( e->materials, elem.sRule ) && !wildcard_match( cur_item, elem.sRule ) ) {
+                if( !check_special_rule( e->materials, elem.sRule ) && !pattern.matches( cur_item ) ) {
                     continue;
                 }
 
@@ -625,7 +639,7 @@ void rule_list::refresh_map_items( cache &map_items ) const
             //new exclusions will process during pickup attempts
             for( auto &map_item : map_items ) {
                 if( !check_special_rule( map_items.temp_items[ map_item.first ]->materials, elem.sRule ) &&
-                    !wildcard_match( map_item.first, elem.sRule ) ) {
+                    !pattern.matches( map_item.first ) ) {
                     continue;
                 }
 
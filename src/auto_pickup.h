@@ -24,6 +24,8 @@ namespace auto_pickup
  * lookup. When this is filled (by @ref auto_pickup::create_rule()), every
  * item existing in the game that matches a rule (either white- or blacklist)
  * is added as the key, with RULE_WHITELISTED or RULE_BLACKLISTED as the values.
+ * Items checked later are added by @ref player_settings::check_item, RULE_NONE if no rule
+ * matched them.
  */
 class cache : public std::unordered_map<std::string, rule_state>
 {
@@ -127,6 +129,13 @@ class player_settings : public base_settings
 
     public:
         ~player_settings() override = default;
+        using base_settings::check_item;
+        /**
+         * What the rules say about the item. Unlike checking its name, items no rule matched
+         * when the rules were loaded are checked as well, and the result is kept until the
+         * rules change.
+         */
+        rule_state check_item( const item &it );
         void create_rule( const item *it );
         bool has_rule( const item *it );
         void add_rule( const item *it );
@@ -180,9 +180,14 @@ projectile_attack_aim projectile_attack_roll( const dispersion_sources &dispersi
 
 dealt_projectile_attack projectile_attack( const projectile &proj_arg, const tripoint &source,
         const tripoint &target_arg, const dispersion_sources &dispersion,
-        Creature *origin, const vehicle *in_veh )
+        Creature *origin, const vehicle *in_veh, projectile_burst *burst )
 {
-    const bool do_animation = get_option<bool>( "ANIMATION_PROJECTILES" );
+    // A burst is shown by its first shot
+    const bool do_animation = get_option<bool>( "ANIMATION_PROJECTILES" ) &&
+                              ( burst == nullptr || !burst->animated );
+    if( burst != nullptr && do_animation ) {
+        burst->animated = true;
+    }
 
     double range = rl_dist( source, target_arg );
 
@@ -262,6 +267,16 @@ dealt_projectile_attack projectile_attack( const projectile &proj_arg, const tri
         // TODO: Z dispersion
         // If we missed, just draw a straight line.
         trajectory = line_to( source, target );
+    } else if( burst != nullptr ) {
+        // Go around obstacles a little if we're on target. The shots of a burst keep to the
+        // path found for the first of them, only what they hit changed in between.
+        if( burst->clear_path.empty() || burst->path_source != source ||
+            burst->path_target != target ) {
+            burst->clear_path = g->m.find_clear_path( source, target );
+            burst->path_source = source;
+            burst->path_target = target;
+        }
+        trajectory = burst->clear_path;
     } else {
         // Go around obstacles a little if we're on target.
         trajectory = g->m.find_clear_path( source, target );
@@ -2,13 +2,15 @@
 #ifndef BALLISTICS_H
 #define BALLISTICS_H
 
+#include <vector>
+
 #include "dispersion.h"
+#include "point.h"
 
 class Creature;
 class vehicle;
 struct dealt_projectile_attack;
 struct projectile;
-struct tripoint;
 
 /** Aim result for a single projectile attack */
 struct projectile_attack_aim {
@@ -23,13 +25,28 @@ struct projectile_attack_aim {
 projectile_attack_aim projectile_attack_roll( const dispersion_sources &dispersion, double range,
         double target_size );
 
+/**
+ * What the shots of one burst share, so the work is done once for all of them. Only for
+ * shots fired one right after the other.
+ */
+struct projectile_burst {
+    /** Whether a shot of the burst was animated already, the others are not. */
+    bool animated = false;
+    /** The path around obstacles from path_source to path_target, empty until needed. */
+    std::vector<tripoint> clear_path;
+    tripoint path_source;
+    tripoint path_target;
+};
+
 /**
  *  Fires a projectile at the target point from the source point with total_dispersion
  *  dispersion.
  *  Returns the rolled dispersion of the shot and the actually hit point.
+ *  @param burst If this is a shot of a burst, what the shots have in common.
  */
 dealt_projectile_attack projectile_attack( const projectile &proj_arg, const tripoint &source,
         const tripoint &target_arg, const dispersion_sources &dispersion,
-        Creature *origin = nullptr, const vehicle *in_veh = nullptr );
+        Creature *origin = nullptr, const vehicle *in_veh = nullptr,
+        projectile_burst *burst = nullptr );
 
 #endif
@@ -47,21 +47,22 @@ behavior_return node_t::tick( const oracle_t *subject ) const
     }
 }
 
-std::string node_t::goal() const
+const std::string &node_t::goal() const
 {
     return _goal;
 }
 
-std::string tree::tick( const oracle_t *subject )
+const std::string &tree::tick( const oracle_t *subject )
 {
     behavior_return result = root->tick( subject );
     active_node = result.result == running ? result.selection : nullptr;
     return goal();
 }
 
-std::string tree::goal() const
+const std::string &tree::goal() const
 {
-    return active_node == nullptr ? "idle" : active_node->goal();
+    static const std::string idle( "idle" );
+    return active_node == nullptr ? idle : active_node->goal();
 }
 
 void tree::add( const node_t *new_node )
@@ -160,7 +161,7 @@ void behavior::reset()
 void behavior::finalize()
 {
     for( const node_data &new_node : temp_node_data ) {
-        for( const std::string child : new_node.children ) {
+        for( const std::string &child : new_node.children ) {
             const_cast<node_t &>( new_node.id.obj() ).
             add_child( &string_id<node_t>( child ).obj() );
         }
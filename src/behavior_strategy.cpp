@@ -22,7 +22,7 @@ using namespace behavior;
 
 // A standard behavior strategy, execute runnable children in order unless one fails.
 behavior_return sequential_t::evaluate( const oracle_t *subject,
-                                        const std::vector<const node_t *> children ) const
+                                        const std::vector<const node_t *> &children ) const
 {
     for( const node_t *child : children ) {
         behavior_return outcome = child->tick( subject );
@@ -35,7 +35,7 @@ behavior_return sequential_t::evaluate( const oracle_t *subject,
 
 // A standard behavior strategy, execute runnable children in order until one succeeds.
 behavior_return fallback_t::evaluate( const oracle_t *subject,
-                                      const std::vector<const node_t *> children ) const
+                                      const std::vector<const node_t *> &children ) const
 {
     for( const node_t *child : children ) {
         behavior_return outcome = child->tick( subject );
@@ -48,7 +48,7 @@ behavior_return fallback_t::evaluate( const oracle_t *subject,
 
 // A non-standard behavior strategy, execute runnable children in order unconditionally.
 behavior_return sequential_until_done_t::evaluate( const oracle_t *subject,
-        const std::vector<const node_t *> children ) const
+        const std::vector<const node_t *> &children ) const
 {
     for( const node_t *child : children ) {
         behavior_return outcome = child->tick( subject );
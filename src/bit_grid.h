@@ -0,0 +1,53 @@
+#pragma once
+#ifndef BIT_GRID_H
+#define BIT_GRID_H
+
+#include <bitset>
+#include <cstddef>
+
+#include "point.h"
+
+/**
+ * A W by H grid of booleans packed into bits, used in place of `bool[W][H]`
+ * caches to keep them small.
+ * Bits are laid out like those arrays (all of column x = 0 first), so loops with
+ * x outside and y inside still walk memory in order.
+ * No bounds checking is done.
+ */
+template<size_t W, size_t H>
+class bit_grid
+{
+    public:
+        bool get( const point &p ) const {
+            return bits[index( p )];
+        }
+        void set( const point &p, const bool value = true ) {
+            bits.set( index( p ), value );
+        }
+        void reset( const point &p ) {
+            bits.reset( index( p ) );
+        }
+        /** Sets every cell to value. */
+        void fill( const bool value ) {
+            if( value ) {
+                bits.set();
+            } else {
+                bits.reset();
+            }
+        }
+        bool none() const {
+            return bits.none();
+        }
+        size_t count() const {
+            return bits.count();
+        }
+
+    private:
+        static size_t index( const point &p ) {
+            return static_cast<size_t>( p.x ) * H + static_cast<size_t>( p.y );
+        }
+
+        std::bitset<W *H> bits;
+};
+
+#endif
@@ -43,8 +43,11 @@
 #include "sdl_wrappers.h"
 #include "scent_map.h"
 #include "sounds.h"
+#include "string_formatter.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "trap.h"
+#include "turn_profile.h"
 #include "veh_type.h"
 #include "vehicle.h"
 #include "vpart_position.h"
@@ -205,6 +208,7 @@ cata_tiles::~cata_tiles() = default;
 
 void cata_tiles::on_options_changed()
 {
+    scene_cache_key.valid = false;
     memory_map_mode = get_option <std::string>( "MEMORY_MAP_MODE" );
 
     pixel_minimap_settings settings;
@@ -219,6 +223,14 @@ void cata_tiles::on_options_changed()
     minimap->set_settings( settings );
 }
 
+void cata_tiles::on_render_targets_reset()
+{
+    scene_cache_key.valid = false;
+    // After a device reset the texture itself is gone, not only what it showed
+    scene_cache_tex.reset();
+    minimap->reset();
+}
+
 const tile_type *tileset::find_tile_type( const std::string &id ) const
 {
     const auto iter = tile_ids.find( id );
@@ -235,6 +247,11 @@ tile_type &tileset::create_tile_type( const std::string &id, tile_type &&new_til
 void cata_tiles::load_tileset( const std::string &tileset_id, const bool precheck,
                                const bool force )
 {
+    // The looks_like chains also depend on the loaded game data, which may have changed
+    for( auto &cache : looks_like_cache ) {
+        cache.clear();
+    }
+    scene_cache_key.valid = false;
     if( tileset_ptr && tileset_ptr->get_tileset_id() == tileset_id && !force ) {
         return;
     }
@@ -303,16 +320,24 @@ static void get_tile_information( const std::string &config_path, std::string &j
     }
 }
 
-template<typename PixelConverter>
-static SDL_Surface_Ptr apply_color_filter( const SDL_Surface_Ptr &original,
-        PixelConverter pixel_converter )
+static SDL_Surface_Ptr copy_surface_32( const SDL_Surface_Ptr &original )
 {
     assert( original );
     SDL_Surface_Ptr surf = create_surface_32( original->w, original->h );
     assert( surf );
     throwErrorIf( SDL_BlitSurface( original.get(), nullptr, surf.get(), nullptr ) != 0,
                   "SDL_BlitSurface failed" );
+    return surf;
+}
 
+/**
+ * Converts the pixels of a surface made by @ref copy_surface_32 in place. Only touches
+ * the given surface, so different surfaces can be converted on different threads.
+ */
+template<typename PixelConverter>
+static void convert_pixels( const SDL_Surface_Ptr &surf, PixelConverter pixel_converter )
+{
+    assert( surf );
     auto pix = reinterpret_cast<SDL_Color *>( surf->pixels );
 
     for( int y = 0, ey = surf->h; y < ey; ++y ) {
@@ -325,8 +350,6 @@ static SDL_Surface_Ptr apply_color_filter( const SDL_Surface_Ptr &original,
             *pix = pixel_converter( *pix );
         }
     }
-
-    return surf;
 }
 
 static bool is_contained( const SDL_Rect &smaller, const SDL_Rect &larger )
@@ -376,18 +399,27 @@ void tileset_loader::create_textures_from_tile_atlas( const SDL_Surface_Ptr &til
             { std::make_tuple( &ts.memory_tile_values, tilecontext->memory_map_mode ) }
         }
     };
-    for( tiles_pixel_color_entry &entry : tile_values_data ) {
-        std::vector<texture> *tile_values = std::get<0>( entry );
+    // The copies are made here, blitting may re-encode the (run-length encoded) atlas,
+    // but the filters only touch their own copy and run on worker threads.
+    // Textures have to be created on this thread.
+    std::array<SDL_Surface_Ptr, std::tuple_size<decltype( tile_values_data )>::value> filtered;
+    thread_pool::task_group converters;
+    for( size_t i = 0; i < tile_values_data.size(); ++i ) {
         color_pixel_function_pointer color_pixel_function = get_color_pixel_function( std::get<1>
-                ( entry ) );
-        if( !color_pixel_function ) {
-            // TODO: Move it inside apply_color_filter.
-            copy_surface_to_texture( tile_atlas, offset, *tile_values );
-        } else {
-            copy_surface_to_texture( apply_color_filter( tile_atlas, color_pixel_function ), offset,
-                                     *tile_values );
+                ( tile_values_data[i] ) );
+        if( color_pixel_function ) {
+            filtered[i] = copy_surface_32( tile_atlas );
+            const SDL_Surface_Ptr &surf = filtered[i];
+            converters.run( [&surf, color_pixel_function]() {
+                convert_pixels( surf, color_pixel_function );
+            } );
         }
     }
+    converters.wait();
+    for( size_t i = 0; i < tile_values_data.size(); ++i ) {
+        std::vector<texture> *tile_values = std::get<0>( tile_values_data[i] );
+        copy_surface_to_texture( filtered[i] ? filtered[i] : tile_atlas, offset, *tile_values );
+    }
 }
 
 template<typename T>
@@ -997,48 +1029,37 @@ static int divide_round_down( int a, int b )
     }
 }
 
-void cata_tiles::draw( const point &dest, const tripoint &center, int width, int height,
-                       std::multimap<point, formatted_text> &overlay_strings,
-                       color_block_overlay_container &color_blocks )
+bool cata_tiles::can_cache_scene() const
 {
-    if( !g ) {
-        return;
-    }
-
-#if defined(__ANDROID__)
-    // Attempted bugfix for Google Play crash - prevent divide-by-zero if no tile width/height specified
-    if( tile_width == 0 || tile_height == 0 ) {
-        return;
-    }
-#endif
-
-    {
-        //set clipping to prevent drawing over stuff we shouldn't
-        SDL_Rect clipRect = {dest.x, dest.y, width, height};
-        printErrorIf( SDL_RenderSetClipRect( renderer.get(), &clipRect ) != 0,
-                      "SDL_RenderSetClipRect failed" );
+    // Overlays and overrides are filled per frame by the callers, the copied layers wouldn't have them
+    return SDL_RenderTargetSupported( renderer.get() ) &&
+           !g->displaying_scent && !g->displaying_radiation && !g->displaying_temperature &&
+           !g->displaying_visibility && !g->displaying_render_profile && !do_draw_zones &&
+           radiation_override.empty() && terrain_override.empty() && furniture_override.empty() &&
+           graffiti_override.empty() && trap_override.empty() && field_override.empty() &&
+           item_override.empty() && vpart_override.empty() && draw_below_override.empty() &&
+           monster_override.empty();
+}
 
-        //fill render area with black to prevent artifacts where no new pixels are drawn
-        render_fill_rect( renderer, clipRect, 0, 0, 0 );
-    }
+bool cata_tiles::scene_key::operator==( const scene_key &rhs ) const
+{
+    return valid && rhs.valid && dest == rhs.dest && size == rhs.size && center == rhs.center &&
+           moment == rhs.moment && player_pos == rhs.player_pos && tile_size == rhs.tile_size &&
+           ts == rhs.ts && iso == rhs.iso && nv_goggles == rhs.nv_goggles;
+}
 
-    int sx = 0;
-    int sy = 0;
-    get_window_tile_counts( width, height, sx, sy );
+void cata_tiles::draw_scene( const SDL_Rect &clipRect, const tripoint &center, const int sx,
+                             const int sy, std::multimap<point, formatted_text> &overlay_strings,
+                             color_block_overlay_container &color_blocks )
+{
+    printErrorIf( SDL_RenderSetClipRect( renderer.get(), &clipRect ) != 0,
+                  "SDL_RenderSetClipRect failed" );
+    //fill render area with black to prevent artifacts where no new pixels are drawn
+    render_fill_rect( renderer, clipRect, 0, 0, 0 );
 
-    init_light();
-    g->m.update_visibility_cache( center.z );
     const visibility_variables &cache = g->m.get_visibility_variables_cache();
-
     const bool iso_mode = tile_iso;
 
-    o = iso_mode ? center.xy() : center.xy() - point( POSX, POSY );
-
-    op = dest;
-    // Rounding up to include incomplete tiles at the bottom/right edges
-    screentile_width = divide_round_up( width, tile_width );
-    screentile_height = divide_round_up( height, tile_height );
-
     const int min_col = 0;
     const int max_col = sx;
     const int min_row = 0;
@@ -1058,10 +1079,6 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
         offscreen_type = VIS_BOOMER_DARK;
     }
 
-    //retrieve night vision goggle status once per draw
-    auto vision_cache = g->u.get_vision_modes();
-    nv_goggles_activated = vision_cache[NV_GOGGLES];
-
     // check that the creature for which we'll draw the visibility map is still alive at that point
     if( g->displaying_visibility && g->displaying_visibility_creature != nullptr )  {
         const Creature *creature = g->displaying_visibility_creature;
@@ -1079,6 +1096,8 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
     for( int row = min_row; row < max_row; row ++ ) {
         std::vector<tile_render_info> draw_points;
         draw_points.reserve( max_col );
+        // Terrain, with the darkness drawn over tiles out of sight
+        begin_render_layer( 0 );
         for( int col = min_col; col < max_col; col ++ ) {
             int temp_x, temp_y;
             if( iso_mode ) {
@@ -1208,6 +1227,7 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
 
             draw_points.emplace_back( pos, height_3d, invisible );
         }
+        end_render_layer();
         const std::array<decltype( &cata_tiles::draw_furniture ), 10> drawing_layers = {{
                 &cata_tiles::draw_furniture, &cata_tiles::draw_graffiti, &cata_tiles::draw_trap,
                 &cata_tiles::draw_field_or_item, &cata_tiles::draw_vpart,
@@ -1217,11 +1237,14 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
             }
         };
         // for each of the drawing layers in order, back to front ...
-        for( auto f : drawing_layers ) {
+        for( size_t layer = 0; layer < drawing_layers.size(); ++layer ) {
+            const auto f = drawing_layers[layer];
+            begin_render_layer( layer + 1 );
             // ... draw all the points we drew terrain for, in the same order
             for( auto &p : draw_points ) {
                 ( this->*f )( p.pos, ch.visibility_cache[p.pos.x][p.pos.y], p.height_3d, p.invisible );
             }
+            end_render_layer();
         }
         // display number of monsters to spawn in mapgen preview
         for( const auto &p : draw_points ) {
@@ -1253,6 +1276,7 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
     void_monster_override();
 
     //Memorize everything the character just saw even if it wasn't displayed.
+    begin_render_layer( 11 );
     for( int mem_y = min_visible_y; mem_y <= max_visible_y; mem_y++ ) {
         for( int mem_x = min_visible_x; mem_x <= max_visible_x; mem_x++ ) {
             rectangle already_drawn( point( min_col, min_row ), point( max_col, max_row ) );
@@ -1303,12 +1327,97 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
             draw_vpart( p, lighting, height_3d, invisible );
         }
     }
+    end_render_layer();
+}
+
+void cata_tiles::draw( const point &dest, const tripoint &center, int width, int height,
+                       std::multimap<point, formatted_text> &overlay_strings,
+                       color_block_overlay_container &color_blocks )
+{
+    if( !g ) {
+        return;
+    }
+
+#if defined(__ANDROID__)
+    // Attempted bugfix for Google Play crash - prevent divide-by-zero if no tile width/height specified
+    if( tile_width == 0 || tile_height == 0 ) {
+        return;
+    }
+#endif
+
+    //set clipping to prevent drawing over stuff we shouldn't
+    const SDL_Rect clipRect = {dest.x, dest.y, width, height};
+
+    int sx = 0;
+    int sy = 0;
+    get_window_tile_counts( width, height, sx, sy );
+
+    init_light();
+    g->m.update_visibility_cache( center.z );
+
+    o = tile_iso ? center.xy() : center.xy() - point( POSX, POSY );
+
+    op = dest;
+    // Rounding up to include incomplete tiles at the bottom/right edges
+    screentile_width = divide_round_up( width, tile_width );
+    screentile_height = divide_round_up( height, tile_height );
+
+    //retrieve night vision goggle status once per draw
+    auto vision_cache = g->u.get_vision_modes();
+    nv_goggles_activated = vision_cache[NV_GOGGLES];
+
+    profiling_render = g->displaying_render_profile;
+    if( profiling_render ) {
+        render_stats.fill( render_layer_stats() );
+        last_render_texture = nullptr;
+    }
+
+    // The map layers can't change while the game waits for input unless time passes, the
+    // player spends moves or the view changes. Redraws of the same scene (moving the
+    // cursor in look around, closing menus) reuse the last frame's layers.
+    scene_key key;
+    key.dest = dest;
+    key.size = point( width, height );
+    key.center = center;
+    key.moment = game_moment::now();
+    key.player_pos = g->u.pos();
+    key.tile_size = point( tile_width, tile_height );
+    key.ts = tileset_ptr.get();
+    key.iso = tile_iso;
+    key.nv_goggles = nv_goggles_activated;
+    key.valid = true;
+    const bool cacheable = can_cache_scene();
+    if( cacheable && scene_cache_tex && key == scene_cache_key ) {
+        printErrorIf( SDL_RenderSetClipRect( renderer.get(), &clipRect ) != 0,
+                      "SDL_RenderSetClipRect failed" );
+        RenderCopy( renderer, scene_cache_tex, &clipRect, &clipRect );
+    } else if( cacheable ) {
+        const point needed_size( dest.x + width, dest.y + height );
+        if( !scene_cache_tex || scene_cache_size.x < needed_size.x ||
+            scene_cache_size.y < needed_size.y ) {
+            scene_cache_tex = CreateTexture( renderer, SDL_PIXELFORMAT_ARGB8888,
+                                             SDL_TEXTUREACCESS_TARGET, needed_size.x, needed_size.y );
+            SetTextureBlendMode( scene_cache_tex, SDL_BLENDMODE_NONE );
+            scene_cache_size = needed_size;
+        }
+        SetRenderTarget( renderer, scene_cache_tex );
+        draw_scene( clipRect, center, sx, sy, overlay_strings, color_blocks );
+        set_displaybuffer_rendertarget();
+        printErrorIf( SDL_RenderSetClipRect( renderer.get(), &clipRect ) != 0,
+                      "SDL_RenderSetClipRect failed" );
+        RenderCopy( renderer, scene_cache_tex, &clipRect, &clipRect );
+        scene_cache_key = key;
+    } else {
+        scene_cache_key.valid = false;
+        draw_scene( clipRect, center, sx, sy, overlay_strings, color_blocks );
+    }
 
     in_animation = do_draw_explosion || do_draw_custom_explosion ||
                    do_draw_bullet || do_draw_hit || do_draw_line ||
                    do_draw_cursor || do_draw_highlight || do_draw_weather ||
                    do_draw_sct || do_draw_zones;
 
+    begin_render_layer( 12 );
     draw_footsteps_frame();
     if( in_animation ) {
         if( do_draw_explosion ) {
@@ -1361,11 +1470,65 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                                  0, 0, LL_LIT, false );
         }
     }
+    end_render_layer();
+    if( profiling_render ) {
+        report_render_profile( overlay_strings );
+        profiling_render = false;
+    }
 
     printErrorIf( SDL_RenderSetClipRect( renderer.get(), nullptr ) != 0,
                   "SDL_RenderSetClipRect failed" );
 }
 
+void cata_tiles::begin_render_layer( const size_t layer )
+{
+    render_layer = layer;
+    if( profiling_render ) {
+        render_layer_start = std::chrono::steady_clock::now();
+    }
+}
+
+void cata_tiles::end_render_layer()
+{
+    if( profiling_render ) {
+        render_stats[render_layer].time += std::chrono::steady_clock::now() - render_layer_start;
+    }
+}
+
+void cata_tiles::report_render_profile( std::multimap<point, formatted_text> &overlay_strings )
+{
+    // String literals, they are the names of the turn_profile phases too
+    static const std::array<const char *, render_layer_count> names = {{
+            "tiles_terrain", "tiles_furniture", "tiles_graffiti", "tiles_trap", "tiles_field_item",
+            "tiles_vpart", "tiles_vpart_below", "tiles_critter_below", "tiles_terrain_below",
+            "tiles_critter", "tiles_zone", "tiles_memorize", "tiles_overlays"
+        }
+    };
+    const auto to_ms = []( const std::chrono::steady_clock::duration & d ) {
+        return std::chrono::duration<double, std::milli>( d ).count();
+    };
+    std::vector<std::string> lines;
+    lines.push_back( string_format( "%-20s %6s %6s %8s %7s", "layer", "tiles", "copies",
+                                    "switches", "ms" ) );
+    render_layer_stats total;
+    for( size_t i = 0; i < render_stats.size(); ++i ) {
+        const render_layer_stats &stats = render_stats[i];
+        lines.push_back( string_format( "%-20s %6d %6d %8d %7.2f", names[i], stats.tiles,
+                                        stats.copies, stats.texture_switches, to_ms( stats.time ) ) );
+        total.tiles += stats.tiles;
+        total.copies += stats.copies;
+        total.texture_switches += stats.texture_switches;
+        total.time += stats.time;
+        turn_profile::record( names[i], stats.time );
+    }
+    lines.push_back( string_format( "%-20s %6d %6d %8d %7.2f", "total", total.tiles, total.copies,
+                                    total.texture_switches, to_ms( total.time ) ) );
+    for( size_t i = 0; i < lines.size(); ++i ) {
+        overlay_strings.emplace( point( fontwidth, static_cast<int>( i + 1 ) * fontheight ),
+                                 formatted_text( lines[i], catacurses::white, TEXT_ALIGNMENT_LEFT ) );
+    }
+}
+
 void cata_tiles::draw_minimap( const point &dest, const tripoint &center, int width, int height )
 {
     minimap->draw( SDL_Rect{ dest.x, dest.y, width, height }, center );
@@ -1427,6 +1590,28 @@ const tile_type *cata_tiles::find_tile_with_season( std::string &id )
 }
 
 const tile_type *cata_tiles::find_tile_looks_like( std::string &id, TILE_CATEGORY category )
+{
+    const int season = season_of_year( calendar::turn );
+    if( season != looks_like_cache_season ) {
+        for( auto &cache : looks_like_cache ) {
+            cache.clear();
+        }
+        looks_like_cache_season = season;
+    }
+    auto &cache = looks_like_cache[category];
+    const auto found = cache.find( id );
+    if( found != cache.end() ) {
+        id = found->second.id;
+        return found->second.tile;
+    }
+    std::string requested_id = id;
+    const tile_type *tt = find_tile_looks_like_uncached( id, category );
+    cache.emplace( std::move( requested_id ), looks_like_result{ id, tt } );
+    return tt;
+}
+
+const tile_type *cata_tiles::find_tile_looks_like_uncached( std::string &id,
+        TILE_CATEGORY category )
 {
     std::string looks_like = id;
     for( int cnt = 0; cnt < 10 && !looks_like.empty(); cnt++ ) {
@@ -1900,6 +2085,15 @@ bool cata_tiles::draw_sprite_at(
     destination.w = width * tile_width / tileset_ptr->get_tile_width();
     destination.h = height * tile_height / tileset_ptr->get_tile_height();
 
+    if( profiling_render ) {
+        render_layer_stats &stats = render_stats[render_layer];
+        ++stats.copies;
+        if( sprite_tex->sdl_texture() != last_render_texture ) {
+            ++stats.texture_switches;
+            last_render_texture = sprite_tex->sdl_texture();
+        }
+    }
+
     if( rotate_sprite ) {
         switch( rota ) {
             default:
@@ -1954,6 +2148,9 @@ bool cata_tiles::draw_tile_at(
     const tile_type &tile, const point &p, unsigned int loc_rand, int rota,
     lit_level ll, bool apply_night_vision_goggles, int &height_3d )
 {
+    if( profiling_render ) {
+        ++render_stats[render_layer].tiles;
+    }
     draw_sprite_at( tile, tile.bg, p, loc_rand, /*fg:*/ false, rota, ll,
                     apply_night_vision_goggles );
     draw_sprite_at( tile, tile.fg, p, loc_rand, /*fg:*/ true, rota, ll,
@@ -3248,7 +3445,7 @@ void cata_tiles::init_light()
 }
 
 void cata_tiles::get_terrain_orientation( const tripoint &p, int &rota, int &subtile,
-        const std::map<tripoint, ter_id> &ter_override, const bool ( &invisible )[5] )
+        const std::unordered_map<tripoint, ter_id> &ter_override, const bool ( &invisible )[5] )
 {
     const bool overridden = ter_override.find( p ) != ter_override.end();
     const auto ter = [&]( const tripoint & q, const bool invis ) -> ter_id {
@@ -3362,7 +3559,8 @@ void cata_tiles::get_rotation_and_subtile( const char val, int &rotation, int &s
 }
 
 void cata_tiles::get_connect_values( const tripoint &p, int &subtile, int &rotation,
-                                     const int connect_group, const std::map<tripoint, ter_id> &ter_override )
+                                     const int connect_group,
+                                     const std::unordered_map<tripoint, ter_id> &ter_override )
 {
     uint8_t connections = g->m.get_known_connections( p, connect_group, ter_override );
     get_rotation_and_subtile( connections, rotation, subtile );
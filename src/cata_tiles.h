@@ -2,6 +2,8 @@
 #ifndef CATA_TILES_H
 #define CATA_TILES_H
 
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <memory>
 #include <map>
@@ -13,6 +15,7 @@
 #include "sdl_wrappers.h"
 #include "animation.h"
 #include "creature.h"
+#include "game_moment.h"
 #include "lightmap.h"
 #include "line.h"
 #include "map_memory.h"
@@ -95,6 +98,10 @@ class texture
             return SDL_RenderCopyEx( renderer.get(), sdl_texture_ptr.get(), &srcrect, dstrect, angle, center,
                                      flip );
         }
+        /// The SDL texture this is a part of, tiles share a few of them.
+        const SDL_Texture *sdl_texture() const {
+            return sdl_texture_ptr.get();
+        }
 };
 
 class tileset
@@ -262,6 +269,17 @@ struct formatted_text {
  */
 using color_block_overlay_container = std::pair<SDL_BlendMode, std::multimap<point, SDL_Color>>;
 
+/** What one layer of the map took to draw in a frame, see game::displaying_render_profile. */
+struct render_layer_stats {
+    /** Tiles drawn, each with a background and a foreground sprite. */
+    int tiles = 0;
+    /** Calls of SDL_RenderCopyEx. */
+    int copies = 0;
+    /** Copies from a different texture than the copy before. */
+    int texture_switches = 0;
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::duration::zero();
+};
+
 class cata_tiles
 {
     public:
@@ -274,6 +292,12 @@ class cata_tiles
 
     public:
         void on_options_changed();
+        /**
+         * Called when the renderer lost what was drawn to target textures
+         * (SDL_RENDER_TARGETS_RESET) or lost its textures altogether (SDL_RENDER_DEVICE_RESET).
+         * The cached scene and the minimap are dropped, so the next frame draws them anew.
+         */
+        void on_render_targets_reset();
 
         /** Draw to screen */
         void draw( const point &dest, const tripoint &center, int width, int height,
@@ -287,8 +311,22 @@ class cata_tiles
         /** How many rows and columns of tiles fit into given dimensions **/
         void get_window_tile_counts( int width, int height, int &columns, int &rows ) const;
 
+        /** Draws the map layers of @ref draw, the part that @ref scene_cache_tex keeps. */
+        void draw_scene( const SDL_Rect &clipRect, const tripoint &center, int sx, int sy,
+                         std::multimap<point, formatted_text> &overlay_strings,
+                         color_block_overlay_container &color_blocks );
+        bool can_cache_scene() const;
+
+        /** Attributes the draws until @ref end_render_layer to that entry of @ref render_stats. */
+        void begin_render_layer( size_t layer );
+        void end_render_layer();
+        /** Adds @ref render_stats to the overlay strings and to the @ref turn_profile phases. */
+        void report_render_profile( std::multimap<point, formatted_text> &overlay_strings );
+
         const tile_type *find_tile_with_season( std::string &id );
+        /** Memoized in @ref looks_like_cache, see @ref find_tile_looks_like_uncached. */
         const tile_type *find_tile_looks_like( std::string &id, TILE_CATEGORY category );
+        const tile_type *find_tile_looks_like_uncached( std::string &id, TILE_CATEGORY category );
         bool find_overlay_looks_like( bool male, const std::string &overlay, std::string &draw_id );
 
         bool draw_from_id_string( std::string id, const tripoint &pos, int subtile, int rota, lit_level ll,
@@ -315,9 +353,9 @@ class cata_tiles
         /* Tile Picking */
         void get_tile_values( int t, const int *tn, int &subtile, int &rotation );
         void get_connect_values( const tripoint &p, int &subtile, int &rotation, int connect_group,
-                                 const std::map<tripoint, ter_id> &ter_override );
+                                 const std::unordered_map<tripoint, ter_id> &ter_override );
         void get_terrain_orientation( const tripoint &p, int &rota, int &subtile,
-                                      const std::map<tripoint, ter_id> &ter_override,
+                                      const std::unordered_map<tripoint, ter_id> &ter_override,
                                       const bool ( &invisible )[5] );
         void get_rotation_and_subtile( char val, int &rota, int &subtile );
 
@@ -543,25 +581,70 @@ class cata_tiles
         tripoint zone_end;
         tripoint zone_offset;
 
+        struct looks_like_result {
+            std::string id;
+            const tile_type *tile;
+        };
+        /**
+         * Results of @ref find_tile_looks_like by category and requested id. Walking the
+         * looks_like chain costs several string concatenations and lookups, and is done for
+         * every layer of every visible tile. Cleared when the tileset or the season changes.
+         */
+        std::array<std::unordered_map<std::string, looks_like_result>, C_WEATHER + 1> looks_like_cache;
+        int looks_like_cache_season = -1;
+
+        /** What the map layers drawn by @ref draw_scene depend on. */
+        struct scene_key {
+            point dest;
+            point size;
+            tripoint center;
+            game_moment moment;
+            tripoint player_pos;
+            point tile_size;
+            const tileset *ts = nullptr;
+            bool iso = false;
+            bool nv_goggles = false;
+            bool valid = false;
+
+            bool operator==( const scene_key &rhs ) const;
+        };
+        /** The last map layers drawn, reused while @ref scene_cache_key stays the same. */
+        SDL_Texture_Ptr scene_cache_tex;
+        point scene_cache_size;
+        scene_key scene_cache_key;
+
+        /**
+         * Terrain, the other map layers in the order @ref draw_scene draws them, memorizing the
+         * tiles out of view and everything drawn over the scene.
+         */
+        static constexpr size_t render_layer_count = 13;
+        /** Counts of the frame being drawn, only while game::displaying_render_profile is set. */
+        std::array<render_layer_stats, render_layer_count> render_stats;
+        bool profiling_render = false;
+        size_t render_layer = 0;
+        std::chrono::steady_clock::time_point render_layer_start;
+        const SDL_Texture *last_render_texture = nullptr;
+
         // offset values, in tile coordinates, not pixels
         point o;
         // offset for drawing, in pixels.
         point op;
 
-        std::map<tripoint, int> radiation_override;
-        std::map<tripoint, ter_id> terrain_override;
-        std::map<tripoint, furn_id> furniture_override;
-        std::map<tripoint, bool> graffiti_override;
-        std::map<tripoint, trap_id> trap_override;
-        std::map<tripoint, field_type_id> field_override;
+        std::unordered_map<tripoint, int> radiation_override;
+        std::unordered_map<tripoint, ter_id> terrain_override;
+        std::unordered_map<tripoint, furn_id> furniture_override;
+        std::unordered_map<tripoint, bool> graffiti_override;
+        std::unordered_map<tripoint, trap_id> trap_override;
+        std::unordered_map<tripoint, field_type_id> field_override;
         // bool represents item highlight
-        std::map<tripoint, std::tuple<itype_id, mtype_id, bool>> item_override;
+        std::unordered_map<tripoint, std::tuple<itype_id, mtype_id, bool>> item_override;
         // int, int, bool represents part_mod, veh_dir, and highlight respectively
         // point represents the mount direction
-        std::map<tripoint, std::tuple<vpart_id, int, int, bool, point>> vpart_override;
-        std::map<tripoint, bool> draw_below_override;
+        std::unordered_map<tripoint, std::tuple<vpart_id, int, int, bool, point>> vpart_override;
+        std::unordered_map<tripoint, bool> draw_below_override;
         // int represents spawn count
-        std::map<tripoint, std::tuple<mtype_id, int, bool, Creature::Attitude>> monster_override;
+        std::unordered_map<tripoint, std::tuple<mtype_id, int, bool, Creature::Attitude>>
+                monster_override;
 
     private:
         /**
@@ -2,6 +2,7 @@
 #ifndef CATA_UTILITY_H
 #define CATA_UTILITY_H
 
+#include <cstdint>
 #include <fstream>
 #include <functional>
 #include <string>
@@ -411,6 +412,8 @@ bool read_from_file_optional( const std::string &path, JsonDeserializer &reader
 class ofstream_wrapper
 {
     private:
+        // Declared before the stream, which may still flush into it when it's destroyed.
+        std::vector<char> buffer;
         std::ofstream file_stream;
         std::string path;
         std::string temp_path;
@@ -431,6 +434,15 @@ class ofstream_wrapper
         void close();
 };
 
+struct written_totals {
+    uint64_t files = 0;
+    uint64_t bytes = 0;
+};
+/** Files and bytes @ref ofstream_wrapper wrote so far, on all threads. For the save benchmark. */
+written_totals total_written();
+/** Like @ref total_written, but only what the calling thread wrote. */
+written_totals written_on_this_thread();
+
 std::istream &safe_getline( std::istream &ins, std::string &str );
 
 /** Apply fuzzy effect to a string like:
@@ -119,6 +119,12 @@ static const trait_id trait_THRESH_SPIDER( "THRESH_SPIDER" );
 static const trait_id trait_URSINE_EYE( "URSINE_EYE" );
 static const trait_id debug_nodmg( "DEBUG_NODMG" );
 
+// Read for every character each turn
+static const cached_option<int> option_speedydex_min_dex( "SPEEDYDEX_MIN_DEX" );
+static const cached_option<int> option_speedydex_dex_speed( "SPEEDYDEX_DEX_SPEED" );
+static const cached_option<float> option_player_healing_rate( "PLAYER_HEALING_RATE" );
+static const cached_option<float> option_npc_healing_rate( "NPC_HEALING_RATE" );
+
 // *INDENT-OFF*
 Character::Character() :
 
@@ -1899,6 +1905,53 @@ bool Character::has_nv()
 void Character::reset_encumbrance()
 {
     encumbrance_cache = calc_encumbrance();
+    worn_aggregates_dirty = true;
+}
+
+// How much of its coverage an item loses against the wind
+static int wind_penalty( const item &it )
+{
+    if( it.made_of( material_id( "leather" ) ) || it.made_of( material_id( "plastic" ) ) ||
+        it.made_of( material_id( "bone" ) ) ||
+        it.made_of( material_id( "chitin" ) ) || it.made_of( material_id( "nomex" ) ) ) {
+        return 10; // 90% effective
+    } else if( it.made_of( material_id( "cotton" ) ) ) {
+        return 30;
+    } else if( it.made_of( material_id( "wool" ) ) ) {
+        return 40;
+    }
+    return 1; // 99% effective
+}
+
+const std::array<worn_aggregate_data, num_bp> &Character::worn_aggregates() const
+{
+    if( !worn_aggregates_dirty ) {
+        return worn_aggregate_cache;
+    }
+    worn_aggregate_cache.fill( worn_aggregate_data() );
+    for( const item &i : worn ) {
+        const body_part_set covered = i.get_covered_body_parts();
+        if( covered.none() ) {
+            continue;
+        }
+        const int coverage = std::max( 0, i.get_coverage() - wind_penalty( i ) );
+        const bool wool = i.made_of( material_id( "wool" ) );
+        const int warmth = i.get_warmth();
+        for( const body_part bp : all_body_parts ) {
+            if( !covered.test( bp ) ) {
+                continue;
+            }
+            worn_aggregate_data &aggregate = worn_aggregate_cache[bp];
+            aggregate.wind_exposure *= ( 1.0 - coverage / 100.0 ); // Coverage is between 0 and 1?
+            if( wool ) {
+                aggregate.wool_warmth += warmth;
+            } else {
+                aggregate.wettable_warmth.push_back( warmth );
+            }
+        }
+    }
+    worn_aggregates_dirty = false;
+    return worn_aggregate_cache;
 }
 
 std::array<encumbrance_data, num_bp> Character::calc_encumbrance() const
@@ -2244,8 +2297,8 @@ int Character::get_int_bonus() const
 static int get_speedydex_bonus( const int dex )
 {
     // this is the number to be multiplied by the increment
-    const int modified_dex = std::max( dex - get_option<int>( "SPEEDYDEX_MIN_DEX" ), 0 );
-    return modified_dex * get_option<int>( "SPEEDYDEX_DEX_SPEED" );
+    const int modified_dex = std::max( dex - option_speedydex_min_dex.get(), 0 );
+    return modified_dex * option_speedydex_dex_speed.get();
 }
 
 int Character::get_speed() const
@@ -2567,7 +2620,7 @@ int Character::get_fatigue() const
 
 int Character::get_sleep_deprivation() const
 {
-    if( !get_option< bool >( "SLEEP_DEPRIVATION" ) ) {
+    if( !option_sleep_deprivation.get() ) {
         return 0;
     }
 
@@ -2941,7 +2994,8 @@ nc_color Character::symbol_color() const
         return cyan_background( basic );
     }
 
-    const auto &fields = g->m.field_at( pos() );
+    const map &here = g->m;
+    const field &fields = here.field_at( pos() );
 
     // Priority: electricity, fire, acid, gases
     bool has_elec = false;
@@ -3434,12 +3488,11 @@ float Character::mutation_value( const std::string &val ) const
 
 float Character::healing_rate( float at_rest_quality ) const
 {
-    // TODO: Cache
     float heal_rate;
     if( !is_npc() ) {
-        heal_rate = get_option< float >( "PLAYER_HEALING_RATE" );
+        heal_rate = option_player_healing_rate.get();
     } else {
-        heal_rate = get_option< float >( "NPC_HEALING_RATE" );
+        heal_rate = option_npc_healing_rate.get();
     }
     float awake_rate = heal_rate * mutation_value( "healing_awake" );
     float final_rate = 0.0f;
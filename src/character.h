@@ -137,6 +137,16 @@ struct encumbrance_data {
     }
 };
 
+/** What the worn items add up to on one body part, for the warmth and wind queries. */
+struct worn_aggregate_data {
+    /** Fraction of the body part the wind still gets to. */
+    float wind_exposure = 1.0f;
+    /** Warmth of the wool items, they keep it when wet. */
+    int wool_warmth = 0;
+    /** Warmth of each of the other items, wetness reduces it. */
+    std::vector<int> wettable_warmth;
+};
+
 struct aim_type {
     std::string name;
     std::string action;
@@ -968,6 +978,14 @@ class Character : public Creature, public visitable<Character>
         float activity_level = NO_EXERCISE;
 
         std::array<encumbrance_data, num_bp> encumbrance_cache;
+        /**
+         * Rebuilt by @ref worn_aggregates after @ref reset_encumbrance or an item being worn or
+         * taken off, which is whenever the parts the gear covers or what it is made of change.
+         * Item damage doesn't affect anything in it.
+         */
+        mutable std::array<worn_aggregate_data, num_bp> worn_aggregate_cache;
+        mutable bool worn_aggregates_dirty = true;
+        const std::array<worn_aggregate_data, num_bp> &worn_aggregates() const;
         mutable std::map<std::string, double> cached_info;
 
         /**
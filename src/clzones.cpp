@@ -568,8 +568,21 @@ bool zone_manager::has_type( const zone_type_id &type ) const
 
 bool zone_manager::has_defined( const zone_type_id &type, const faction_id &fac ) const
 {
-    const auto &type_iter = area_cache.find( zone_data::make_type_hash( type, fac ) );
-    return type_iter != area_cache.end();
+    const std::string type_hash = zone_data::make_type_hash( type, fac );
+    return area_cache.count( type_hash ) > 0 || vzone_cache.count( type_hash ) > 0;
+}
+
+void zone_manager::zone_area::add( const tripoint &start, const tripoint &end )
+{
+    boxes.emplace_back( start, end );
+    // Draw marked area
+    for( int x = start.x; x <= end.x; ++x ) {
+        for( int y = start.y; y <= end.y; ++y ) {
+            for( int z = start.z; z <= end.z; ++z ) {
+                points.insert( tripoint( x, y, z ) );
+            }
+        }
+    }
 }
 
 void zone_manager::cache_data()
@@ -580,21 +593,7 @@ void zone_manager::cache_data()
         if( !elem.get_enabled() ) {
             continue;
         }
-
-        const std::string &type_hash = elem.get_type_hash();
-        auto &cache = area_cache[type_hash];
-
-        tripoint start = elem.get_start_point();
-        tripoint end = elem.get_end_point();
-
-        // Draw marked area
-        for( int x = start.x; x <= end.x; ++x ) {
-            for( int y = start.y; y <= end.y; ++y ) {
-                for( int z = start.z; z <= end.z; ++z ) {
-                    cache.insert( tripoint( x, y, z ) );
-                }
-            }
-        }
+        area_cache[elem.get_type_hash()].add( elem.get_start_point(), elem.get_end_point() );
     }
 }
 
@@ -606,33 +605,23 @@ void zone_manager::cache_vzones()
         if( !elem->get_enabled() ) {
             continue;
         }
-
-        const std::string &type_hash = elem->get_type_hash();
-        auto &cache = area_cache[type_hash];
-
-        tripoint start = elem->get_start_point();
-        tripoint end = elem->get_end_point();
-
-        // Draw marked area
-        for( int x = start.x; x <= end.x; ++x ) {
-            for( int y = start.y; y <= end.y; ++y ) {
-                for( int z = start.z; z <= end.z; ++z ) {
-                    cache.insert( tripoint( x, y, z ) );
-                }
-            }
-        }
+        vzone_cache[elem->get_type_hash()].add( elem->get_start_point(), elem->get_end_point() );
     }
 }
 
-std::unordered_set<tripoint> zone_manager::get_point_set( const zone_type_id &type,
-        const faction_id &fac ) const
+const zone_manager::zone_area &zone_manager::get_area(
+    const std::unordered_map<std::string, zone_area> &cache, const zone_type_id &type,
+    const faction_id &fac )
 {
-    const auto &type_iter = area_cache.find( zone_data::make_type_hash( type, fac ) );
-    if( type_iter == area_cache.end() ) {
-        return std::unordered_set<tripoint>();
-    }
+    static const zone_area empty;
+    const auto &type_iter = cache.find( zone_data::make_type_hash( type, fac ) );
+    return type_iter == cache.end() ? empty : type_iter->second;
+}
 
-    return type_iter->second;
+const std::unordered_set<tripoint> &zone_manager::get_point_set( const zone_type_id &type,
+        const faction_id &fac ) const
+{
+    return get_area( area_cache, type, fac ).points;
 }
 
 std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint &where,
@@ -646,61 +635,74 @@ std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint &w
 {
     ( void )fac;
     std::unordered_set<tripoint> res;
-    for( const tripoint elem : g->m.points_in_radius( g->m.getlocal( where ), radius ) ) {
-        const zone_data *zone = get_zone_at( g->m.getabs( elem ) );
-        // if not a LOOT zone
-        if( ( !zone ) || ( zone->get_type().str().substr( 0, 4 ) != "LOOT" ) ) {
+    // Only points inside a loot zone can be one, so only those are looked at instead of
+    // everything in range.
+    for( const zone_data &loot_zone : zones ) {
+        if( loot_zone.get_type().str().substr( 0, 4 ) != "LOOT" ) {
             continue;
         }
-        if( npc_search && ( has( zone_type_id( "NO_NPC_PICKUP" ), elem ) ) ) {
+        const tripoint start = loot_zone.get_start_point();
+        const tripoint end = loot_zone.get_end_point();
+        if( where.z < start.z || where.z > end.z ) {
             continue;
         }
-        res.insert( elem );
+        for( int x = std::max( start.x, where.x - radius ); x <= std::min( end.x, where.x + radius );
+             ++x ) {
+            for( int y = std::max( start.y, where.y - radius );
+                 y <= std::min( end.y, where.y + radius ); ++y ) {
+                const tripoint abs_pos( x, y, where.z );
+                const tripoint elem = g->m.getlocal( abs_pos );
+                if( !g->m.inbounds( elem ) || res.count( elem ) > 0 ) {
+                    continue;
+                }
+                // The zone on top decides
+                const zone_data *zone = get_zone_at( abs_pos );
+                if( zone->get_type().str().substr( 0, 4 ) != "LOOT" ) {
+                    continue;
+                }
+                if( npc_search && ( has( zone_type_id( "NO_NPC_PICKUP" ), elem ) ) ) {
+                    continue;
+                }
+                res.insert( elem );
+            }
+        }
     }
     return res;
 }
 
-std::unordered_set<tripoint> zone_manager::get_vzone_set( const zone_type_id &type,
+const std::unordered_set<tripoint> &zone_manager::get_vzone_set( const zone_type_id &type,
         const faction_id &fac ) const
 {
-    //Only regenerate the vehicle zone cache if any vehicles have moved
-    const auto &type_iter = vzone_cache.find( zone_data::make_type_hash( type, fac ) );
-    if( type_iter == vzone_cache.end() ) {
-        return std::unordered_set<tripoint>();
-    }
-
-    return type_iter->second;
+    return get_area( vzone_cache, type, fac ).points;
 }
 
 bool zone_manager::has( const zone_type_id &type, const tripoint &where,
                         const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    const auto &vzone_set = get_vzone_set( type, fac );
-    return point_set.find( where ) != point_set.end() || vzone_set.find( where ) != vzone_set.end();
+    return get_point_set( type, fac ).count( where ) > 0 ||
+           get_vzone_set( type, fac ).count( where ) > 0;
+}
+
+// The nearest point of b to where, or where itself if it is inside
+static tripoint closest_in_box( const tripoint &where, const box &b )
+{
+    return tripoint( clamp( where.x, b.p_min.x, b.p_max.x ), clamp( where.y, b.p_min.y, b.p_max.y ),
+                     clamp( where.z, b.p_min.z, b.p_max.z ) );
 }
 
 bool zone_manager::has_near( const zone_type_id &type, const tripoint &where, int range,
                              const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    for( auto &point : point_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
+    for( const auto *cache : {
+             &area_cache, &vzone_cache
+         } ) {
+        for( const box &b : get_area( *cache, type, fac ).boxes ) {
+            const tripoint closest = closest_in_box( where, b );
+            if( closest.z == where.z && square_dist( closest, where ) <= range ) {
                 return true;
             }
         }
     }
-
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( auto &point : vzone_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                return true;
-            }
-        }
-    }
-
     return false;
 }
 
@@ -757,33 +759,28 @@ bool zone_manager::custom_loot_has( const tripoint &where, const item *it ) cons
 std::unordered_set<tripoint> zone_manager::get_near( const zone_type_id &type,
         const tripoint &where, int range, const item *it, const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
     auto near_point_set = std::unordered_set<tripoint>();
 
-    for( auto &point : point_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                if( it && has( zone_type_id( "LOOT_CUSTOM" ), point ) ) {
-                    if( custom_loot_has( point, it ) ) {
-                        near_point_set.insert( point );
-                    }
-                } else {
-                    near_point_set.insert( point );
-                }
+    // Only the part of each zone that is in range
+    for( const auto *cache : {
+             &area_cache, &vzone_cache
+         } ) {
+        for( const box &b : get_area( *cache, type, fac ).boxes ) {
+            if( where.z < b.p_min.z || where.z > b.p_max.z ) {
+                continue;
             }
-        }
-    }
-
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( auto &point : vzone_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                if( it && has( zone_type_id( "LOOT_CUSTOM" ), point ) ) {
-                    if( custom_loot_has( point, it ) ) {
+            for( int x = std::max( b.p_min.x, where.x - range );
+                 x <= std::min( b.p_max.x, where.x + range ); ++x ) {
+                for( int y = std::max( b.p_min.y, where.y - range );
+                     y <= std::min( b.p_max.y, where.y + range ); ++y ) {
+                    const tripoint point( x, y, where.z );
+                    if( it && has( zone_type_id( "LOOT_CUSTOM" ), point ) ) {
+                        if( custom_loot_has( point, it ) ) {
+                            near_point_set.insert( point );
+                        }
+                    } else {
                         near_point_set.insert( point );
                     }
-                } else {
-                    near_point_set.insert( point );
                 }
             }
         }
@@ -801,26 +798,18 @@ cata::optional<tripoint> zone_manager::get_nearest( const zone_type_id &type, co
 
     tripoint nearest_pos = tripoint( INT_MIN, INT_MIN, INT_MIN );
     int nearest_dist = range + 1;
-    const std::unordered_set<tripoint> &point_set = get_point_set( type, fac );
-    for( const tripoint &p : point_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
-            }
-        }
-    }
-
-    const std::unordered_set<tripoint> &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint &p : vzone_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
+    for( const auto *cache : {
+             &area_cache, &vzone_cache
+         } ) {
+        for( const box &b : get_area( *cache, type, fac ).boxes ) {
+            const tripoint p = closest_in_box( where, b );
+            int cur_dist = square_dist( p, where );
+            if( cur_dist < nearest_dist ) {
+                nearest_dist = cur_dist;
+                nearest_pos = p;
+                if( nearest_dist == 0 ) {
+                    return nearest_pos;
+                }
             }
         }
     }
@@ -337,11 +337,23 @@ class zone_manager
         std::vector<zone_data> removed_vzones;
 
         std::map<zone_type_id, zone_type> types;
-        std::unordered_map<std::string, std::unordered_set<tripoint>> area_cache;
-        std::unordered_map<std::string, std::unordered_set<tripoint>> vzone_cache;
-        std::unordered_set<tripoint> get_point_set( const zone_type_id &type,
+        /** The enabled zones of one type and faction. */
+        struct zone_area {
+            /** Every point inside one of the zones. */
+            std::unordered_set<tripoint> points;
+            /** The zones themselves, both corners included. */
+            std::vector<box> boxes;
+
+            void add( const tripoint &start, const tripoint &end );
+        };
+        /** By @ref zone_data::get_type_hash. */
+        std::unordered_map<std::string, zone_area> area_cache;
+        std::unordered_map<std::string, zone_area> vzone_cache;
+        static const zone_area &get_area( const std::unordered_map<std::string, zone_area> &cache,
+                                          const zone_type_id &type, const faction_id &fac );
+        const std::unordered_set<tripoint> &get_point_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
-        std::unordered_set<tripoint> get_vzone_set( const zone_type_id &type,
+        const std::unordered_set<tripoint> &get_vzone_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
 
         //Cache number of items already checked on each source tile when sorting
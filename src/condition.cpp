@@ -93,13 +93,13 @@ void conditional_t<T>::set_has_any_trait( JsonObject &jo, const std::string &mem
 template<class T>
 void conditional_t<T>::set_has_trait( JsonObject &jo, const std::string &member, bool is_npc )
 {
-    const std::string &trait_to_check = jo.get_string( member );
+    const trait_id trait_to_check( jo.get_string( member ) );
     condition = [trait_to_check, is_npc]( const T & d ) {
         player *actor = d.alpha;
         if( is_npc ) {
             actor = dynamic_cast<player *>( d.beta );
         }
-        return actor->has_trait( trait_id( trait_to_check ) );
+        return actor->has_trait( trait_to_check );
     };
 }
 
@@ -146,19 +146,19 @@ void conditional_t<T>::set_is_riding( bool is_npc )
 template<class T>
 void conditional_t<T>::set_npc_has_class( JsonObject &jo )
 {
-    const std::string &class_to_check = jo.get_string( "npc_has_class" );
+    const npc_class_id class_to_check( jo.get_string( "npc_has_class" ) );
     condition = [class_to_check]( const T & d ) {
-        return d.beta->myclass == npc_class_id( class_to_check );
+        return d.beta->myclass == class_to_check;
     };
 }
 
 template<class T>
 void conditional_t<T>::set_u_has_mission( JsonObject &jo )
 {
-    const std::string &mission = jo.get_string( "u_has_mission" );
+    const mission_type_id mission( jo.get_string( "u_has_mission" ) );
     condition = [mission]( const T & ) {
         for( auto miss_it : g->u.get_active_missions() ) {
-            if( miss_it->mission_id() == mission_type_id( mission ) ) {
+            if( miss_it->mission_id() == mission ) {
                 return true;
             }
         }
@@ -296,15 +296,17 @@ template<class T>
 void conditional_t<T>::set_has_bionics( JsonObject &jo, const std::string &member, bool is_npc )
 {
     const std::string bionics_id = jo.get_string( member );
-    condition = [bionics_id, is_npc]( const T & d ) {
+    const bool any_bionic = bionics_id == "ANY";
+    const bionic_id bio( bionics_id );
+    condition = [any_bionic, bio, is_npc]( const T & d ) {
         player *actor = d.alpha;
         if( is_npc ) {
             actor = dynamic_cast<player *>( d.beta );
         }
-        if( bionics_id == "ANY" ) {
+        if( any_bionic ) {
             return actor->num_bionics() > 0 || actor->max_power_level > 0;
         }
-        return actor->has_bionic( bionic_id( bionics_id ) );
+        return actor->has_bionic( bio );
     };
 }
 
@@ -312,13 +314,13 @@ void conditional_t<T>::set_has_bionics( JsonObject &jo, const std::string &membe
 template<class T>
 void conditional_t<T>::set_has_effect( JsonObject &jo, const std::string &member, bool is_npc )
 {
-    const std::string &effect_id = jo.get_string( member );
+    const efftype_id effect_id( jo.get_string( member ) );
     condition = [effect_id, is_npc]( const T & d ) {
         player *actor = d.alpha;
         if( is_npc ) {
             actor = dynamic_cast<player *>( d.beta );
         }
-        return actor->has_effect( efftype_id( effect_id ) );
+        return actor->has_effect( effect_id );
     };
 }
 
@@ -351,7 +353,9 @@ template<class T>
 void conditional_t<T>::set_at_om_location( JsonObject &jo, const std::string &member, bool is_npc )
 {
     const std::string &location = jo.get_string( member );
-    condition = [location, is_npc]( const T & d ) {
+    const bool any_camp = location == "FACTION_CAMP_ANY";
+    const oter_str_id location_id( location );
+    condition = [any_camp, location_id, is_npc]( const T & d ) {
         player *actor = d.alpha;
         if( is_npc ) {
             actor = dynamic_cast<player *>( d.beta );
@@ -359,7 +363,7 @@ void conditional_t<T>::set_at_om_location( JsonObject &jo, const std::string &me
         const tripoint omt_pos = actor->global_omt_location();
         oter_id &omt_ref = overmap_buffer.ter( omt_pos );
 
-        if( location == "FACTION_CAMP_ANY" ) {
+        if( any_camp ) {
             cata::optional<basecamp *> bcp = overmap_buffer.find_camp( omt_pos.xy() );
             if( bcp ) {
                 return true;
@@ -368,7 +372,7 @@ void conditional_t<T>::set_at_om_location( JsonObject &jo, const std::string &me
             const std::string &omt_str = omt_ref.id().c_str();
             return omt_str.find( "faction_base_camp" ) != std::string::npos;
         } else {
-            return omt_ref == oter_id( location );
+            return omt_ref.id() == location_id;
         }
     };
 }
@@ -854,10 +858,10 @@ void conditional_t<T>::set_has_skill( JsonObject &jo, const std::string &member,
 template<class T>
 void conditional_t<T>::set_u_know_recipe( JsonObject &jo, const std::string &member )
 {
-    const std::string &known_recipe_id = jo.get_string( member );
+    const recipe_id known_recipe_id( jo.get_string( member ) );
     condition = [known_recipe_id]( const T & d ) {
         player *actor = d.alpha;
-        const recipe &r = recipe_id( known_recipe_id ).obj();
+        const recipe &r = known_recipe_id.obj();
         return actor->knows_recipe( &r );
     };
 }
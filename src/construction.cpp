@@ -5,6 +5,8 @@
 #include <array>
 #include <iterator>
 #include <memory>
+#include <map>
+#include <unordered_set>
 #include <utility>
 
 #include "action.h"
@@ -140,19 +142,13 @@ static void load_available_constructions( std::vector<std::string> &available,
 {
     cat_available.clear();
     available.clear();
+    std::unordered_set<std::string> already_have;
     for( auto &it : constructions ) {
-        if( it.on_display && ( !hide_unconstructable || can_construct( it ) ) ) {
-            bool already_have_it = false;
-            for( auto &avail_it : available ) {
-                if( avail_it == it.description ) {
-                    already_have_it = true;
-                    break;
-                }
-            }
-            if( !already_have_it ) {
-                available.push_back( it.description );
-                cat_available[it.category].push_back( it.description );
-            }
+        if( it.on_display && !already_have.count( it.description ) &&
+            ( !hide_unconstructable || can_construct( it ) ) ) {
+            already_have.insert( it.description );
+            available.push_back( it.description );
+            cat_available[it.category].push_back( it.description );
         }
     }
 }
@@ -173,7 +169,7 @@ static void draw_grid( const catacurses::window &w, const int list_width )
     wrefresh( w );
 }
 
-static nc_color construction_color( const std::string &con_name, bool highlight )
+static nc_color construction_color( const std::string &con_name )
 {
     nc_color col = c_dark_gray;
     if( g->u.has_trait( trait_id( "DEBUG_HS" ) ) ) {
@@ -200,7 +196,7 @@ static nc_color construction_color( const std::string &con_name, bool highlight
             }
         }
     }
-    return highlight ? hilite( col ) : col;
+    return col;
 }
 
 const std::vector<construction> &get_constructions()
@@ -267,6 +263,9 @@ int construction_menu( bool blueprint )
     int previous_select = -1;
 
     const inventory &total_inv = g->u.crafting_inventory();
+    // Nothing the colors depend on changes while the menu is open, but finding one checks the
+    // requirements of every variant and the tiles around the player.
+    std::map<std::string, nc_color> colors;
 
     input_context ctxt( "CONSTRUCTION" );
     ctxt.register_action( "UP", translate_marker( "Move cursor up" ) );
@@ -327,11 +326,15 @@ int construction_menu( bool blueprint )
         for( size_t i = 0; static_cast<int>( i ) < w_list_height &&
              ( i + offset ) < constructs.size(); i++ ) {
             int current = i + offset;
-            std::string con_name = constructs[current];
+            const std::string &con_name = constructs[current];
             bool highlight = ( current == select );
 
+            auto found = colors.find( con_name );
+            if( found == colors.end() ) {
+                found = colors.emplace( con_name, construction_color( con_name ) ).first;
+            }
             trim_and_print( w_list, point( 0, i ), w_list_width,
-                            construction_color( con_name, highlight ), _( con_name ) );
+                            highlight ? hilite( found->second ) : found->second, _( con_name ) );
         }
 
         if( update_info ) {
@@ -435,8 +435,8 @@ std::vector<const item *> player::get_eligible_containers_for_crafting() const
             conts.push_back( &it );
         }
     }
-    for( size_t i = 0; i < inv.size(); i++ ) {
-        for( const auto &it : inv.const_stack( i ) ) {
+    for( const std::list<item> *stack : inv.const_slice() ) {
+        for( const auto &it : *stack ) {
             if( is_container_eligible_for_crafting( it, false ) ) {
                 conts.push_back( &it );
             }
@@ -9,6 +9,7 @@
 #include <list>
 #include <memory>
 #include <set>
+#include <unordered_map>
 #include <utility>
 
 #include "avatar.h"
@@ -150,6 +151,80 @@ static int print_items( const recipe &r, const catacurses::window &w, int ypos,
     return ypos - oldy;
 }
 
+static std::vector<const recipe *> filter_recipes( const recipe_subset &available_recipes,
+        const std::string &filterstring )
+{
+    auto qry = trim( filterstring );
+    size_t qry_begin = 0;
+    size_t qry_end = 0;
+    recipe_subset filtered_recipes = available_recipes;
+    do {
+        // Find next ','
+        qry_end = qry.find_first_of( ',', qry_begin );
+
+        auto qry_filter_str = trim( qry.substr( qry_begin, qry_end - qry_begin ) );
+        // Process filter
+        if( qry_filter_str.size() > 2 && qry_filter_str[1] == ':' ) {
+            switch( qry_filter_str[0] ) {
+                case 't':
+                    filtered_recipes = filtered_recipes.reduce( qry_filter_str.substr( 2 ),
+                                       recipe_subset::search_type::tool );
+                    break;
+
+                case 'c':
+                    filtered_recipes = filtered_recipes.reduce( qry_filter_str.substr( 2 ),
+                                       recipe_subset::search_type::component );
+                    break;
+
+                case 's':
+                    filtered_recipes = filtered_recipes.reduce( qry_filter_str.substr( 2 ),
+                                       recipe_subset::search_type::skill );
+                    break;
+
+                case 'p':
+                    filtered_recipes = filtered_recipes.reduce( qry_filter_str.substr( 2 ),
+                                       recipe_subset::search_type::primary_skill );
+                    break;
+
+                case 'Q':
+                    filtered_recipes = filtered_recipes.reduce( qry_filter_str.substr( 2 ),
+                                       recipe_subset::search_type::quality );
+                    break;
+
+                case 'q':
+                    filtered_recipes = filtered_recipes.reduce( qry_filter_str.substr( 2 ),
+                                       recipe_subset::search_type::quality_result );
+                    break;
+
+                case 'd':
+                    filtered_recipes = filtered_recipes.reduce( qry_filter_str.substr( 2 ),
+                                       recipe_subset::search_type::description_result );
+                    break;
+
+                case 'm': {
+                    auto &learned = g->u.get_learned_recipes();
+                    recipe_subset temp_subset;
+                    if( query_is_yes( qry_filter_str ) ) {
+                        temp_subset = available_recipes.intersection( learned );
+                    } else {
+                        temp_subset = available_recipes.difference( learned );
+                    }
+                    filtered_recipes = filtered_recipes.intersection( temp_subset );
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        } else {
+            filtered_recipes = filtered_recipes.reduce( qry_filter_str );
+        }
+
+        qry_begin = qry_end + 1;
+    } while( qry_end != std::string::npos );
+    return std::vector<const recipe *>( filtered_recipes.begin(), filtered_recipes.end() );
+}
+
 const recipe *select_crafting_recipe( int &batch_size )
 {
     // always re-translate the category names in case the language has changed
@@ -170,6 +245,8 @@ const recipe *select_crafting_recipe( int &batch_size )
     const int infoWidth = width - FULL_SCREEN_WIDTH - 1;
 
     const recipe *last_recipe = nullptr;
+    // Batch size the description in thisItem is for, it's only built again when that changes
+    int last_info_count = 0;
 
     catacurses::window w_head = catacurses::newwin( headHeight, width, point( wStart, 0 ) );
     catacurses::window w_subhead = catacurses::newwin( subHeadHeight, width, point( wStart, 3 ) );
@@ -239,7 +316,13 @@ const recipe *select_crafting_recipe( int &batch_size )
     std::string filterstring;
 
     const auto &available_recipes = g->u.get_available_recipes( crafting_inv, &helpers );
-    std::map<const recipe *, bool> availability_cache;
+    std::unordered_map<const recipe *, bool> availability_cache;
+    // batch sizes 1-20 of this recipe, kept until another recipe is batched
+    const recipe *batch_cached = nullptr;
+    std::vector<bool> batch_availability;
+    // results of the last filter query, reused until the filter changes
+    std::string filtered_for;
+    std::vector<const recipe *> filter_results;
 
     do {
         if( redraw ) {
@@ -263,83 +346,23 @@ const recipe *select_crafting_recipe( int &batch_size )
             available.clear();
 
             if( batch ) {
-                current.clear();
-                for( int i = 1; i <= 20; i++ ) {
-                    current.push_back( chosen );
-                    available.push_back( g->u.can_start_craft( chosen, i ) );
+                if( batch_cached != chosen ) {
+                    batch_availability.clear();
+                    for( int i = 1; i <= 20; i++ ) {
+                        batch_availability.push_back( g->u.can_start_craft( chosen, i ) );
+                    }
+                    batch_cached = chosen;
                 }
+                current.assign( batch_availability.size(), chosen );
+                available = batch_availability;
             } else {
                 std::vector<const recipe *> picking;
                 if( !filterstring.empty() ) {
-                    auto qry = trim( filterstring );
-                    size_t qry_begin = 0;
-                    size_t qry_end = 0;
-                    recipe_subset filtered_recipes = available_recipes;
-                    do {
-                        // Find next ','
-                        qry_end = qry.find_first_of( ',', qry_begin );
-
-                        auto qry_filter_str = trim( qry.substr( qry_begin, qry_end - qry_begin ) );
-                        // Process filter
-                        if( qry_filter_str.size() > 2 && qry_filter_str[1] == ':' ) {
-                            switch( qry_filter_str[0] ) {
-                                case 't':
-                                    filtered_recipes = filtered_recipes.reduce( qry_filter_str.substr( 2 ),
-                                                       recipe_subset::search_type::tool );
-                                    break;
-
-                                case 'c':
-                                    filtered_recipes = filtered_recipes.reduce( qry_filter_str.substr( 2 ),
-                                                       recipe_subset::search_type::component );
-                                    break;
-
-                                case 's':
-                                    filtered_recipes = filtered_recipes.reduce( qry_filter_str.substr( 2 ),
-                                                       recipe_subset::search_type::skill );
-                                    break;
-
-                                case 'p':
-                                    filtered_recipes = filtered_recipes.reduce( qry_filter_str.substr( 2 ),
-                                                       recipe_subset::search_type::primary_skill );
-                                    break;
-
-                                case 'Q':
-                                    filtered_recipes = filtered_recipes.reduce( qry_filter_str.substr( 2 ),
-                                                       recipe_subset::search_type::quality );
-                                    break;
-
-                                case 'q':
-                                    filtered_recipes = filtered_recipes.reduce( qry_filter_str.substr( 2 ),
-                                                       recipe_subset::search_type::quality_result );
-                                    break;
-
-                                case 'd':
-                                    filtered_recipes = filtered_recipes.reduce( qry_filter_str.substr( 2 ),
-                                                       recipe_subset::search_type::description_result );
-                                    break;
-
-                                case 'm': {
-                                    auto &learned = g->u.get_learned_recipes();
-                                    recipe_subset temp_subset;
-                                    if( query_is_yes( qry_filter_str ) ) {
-                                        temp_subset = available_recipes.intersection( learned );
-                                    } else {
-                                        temp_subset = available_recipes.difference( learned );
-                                    }
-                                    filtered_recipes = filtered_recipes.intersection( temp_subset );
-                                    break;
-                                }
-
-                                default:
-                                    current.clear();
-                            }
-                        } else {
-                            filtered_recipes = filtered_recipes.reduce( qry_filter_str );
-                        }
-
-                        qry_begin = qry_end + 1;
-                    } while( qry_end != std::string::npos );
-                    picking.insert( picking.end(), filtered_recipes.begin(), filtered_recipes.end() );
+                    if( filterstring != filtered_for ) {
+                        filter_results = filter_recipes( available_recipes, filterstring );
+                        filtered_for = filterstring;
+                    }
+                    picking = filter_results;
                 } else if( subtab.cur() == "CSC_*_FAVORITE" ) {
                     picking = available_recipes.favorite();
                 } else if( subtab.cur() == "CSC_*_RECENT" ) {
@@ -608,8 +631,12 @@ const recipe *select_crafting_recipe( int &batch_size )
             if( last_recipe != current[line] ) {
                 last_recipe = current[line];
                 tmp = current[line]->create_result();
+                last_info_count = 0;
+            }
+            if( last_info_count != count ) {
+                tmp.info( true, thisItem, count );
+                last_info_count = count;
             }
-            tmp.info( true, thisItem, count );
 
             // If it's food that can have variable nutrition, add disclaimer.
             // Hidden if the user is attempting to page through components.
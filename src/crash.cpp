@@ -21,6 +21,7 @@
 #   endif
 #endif
 
+#include "debug.h"
 #include "get_version.h"
 #include "path_info.h"
 
@@ -114,6 +115,8 @@ extern "C" {
 
     static void log_crash( const char *type, const char *msg )
     {
+        // Whatever was logged before the crash is the most useful part of the log
+        debug_flush_log();
         dump_to( ".core" );
         const char *crash_log_file = "config/crash.log";
         char *beg = buf, *end = buf + BUF_SIZE;
@@ -223,8 +226,6 @@ void init_crash_handlers()
 
 #include <sstream>
 
-#include "debug.h"
-
 extern "C" {
 
     static const char *get_crash_log_file_name()
@@ -244,6 +245,7 @@ extern "C" {
         // reasons, including the memory allocations and the SDL message box.
         // But it should usually work in practice, unless for example the
         // program segfaults inside malloc.
+        debug_flush_log();
         const char *crash_log_file = get_crash_log_file_name();
         std::ostringstream log_text;
         log_text << "The program has crashed."
@@ -306,7 +306,29 @@ static bool overlaps_vehicle( const std::set<tripoint> &veh_area, const tripoint
     return false;
 }
 
+std::vector<Creature *> Creature::hostile_target_candidates()
+{
+    return g->get_creatures_if( []( const Creature & critter ) {
+        if( critter.is_monster() ) {
+            // friendly to the player, not a target for us
+            return static_cast<const monster *>( &critter )->friendly == 0;
+        }
+        if( critter.is_npc() ) {
+            // friendly to the player, not a target for us
+            return static_cast<const npc *>( &critter )->get_attitude() == NPCATT_KILL;
+        }
+        // TODO: what about g->u?
+        return false;
+    } );
+}
+
 Creature *Creature::auto_find_hostile_target( int range, int &boo_hoo, int area )
+{
+    return auto_find_hostile_target( hostile_target_candidates(), range, boo_hoo, area );
+}
+
+Creature *Creature::auto_find_hostile_target( const std::vector<Creature *> &candidates,
+        int range, int &boo_hoo, int area )
 {
     Creature *target = nullptr;
     player &u = g->u; // Could easily protect something that isn't the player
@@ -339,19 +361,16 @@ Creature *Creature::auto_find_hostile_target( int range, int &boo_hoo, int area
         self_area_iff = true;
     }
 
-    std::vector<Creature *> targets = g->get_creatures_if( [&]( const Creature & critter ) {
-        if( critter.is_monster() ) {
-            // friendly to the player, not a target for us
-            return static_cast<const monster *>( &critter )->friendly == 0;
+    for( Creature *const m : candidates ) {
+        if( m->is_dead_state() ) {
+            // Killed by an earlier search's shots
+            continue;
         }
-        if( critter.is_npc() ) {
-            // friendly to the player, not a target for us
-            return static_cast<const npc *>( &critter )->get_attitude() == NPCATT_KILL;
+        int dist = rl_dist( pos(), m->pos() ) + 1; // rl_dist can be 0
+        if( dist > range + 1 || dist < area ) {
+            // Too near or too far, checked first as it's much cheaper than sees()
+            continue;
         }
-        // TODO: what about g->u?
-        return false;
-    } );
-    for( auto &m : targets ) {
         if( !sees( *m ) ) {
             // can't see nor sense it
             if( is_fake() && in_veh ) {
@@ -385,11 +404,6 @@ Creature *Creature::auto_find_hostile_target( int range, int &boo_hoo, int area
                 continue;
             }
         }
-        int dist = rl_dist( pos(), m->pos() ) + 1; // rl_dist can be 0
-        if( dist > range + 1 || dist < area ) {
-            // Too near or too far
-            continue;
-        }
         // Prioritize big, armed and hostile stuff
         float mon_rating = m->power_rating();
         float target_rating = mon_rating / dist;
@@ -1087,6 +1101,10 @@ bool Creature::remove_effect( const efftype_id &eff_id, body_part bp )
 }
 bool Creature::has_effect( const efftype_id &eff_id, body_part bp ) const
 {
+    // Most creatures have no effects at all, don't bother hashing the id then
+    if( effects->empty() ) {
+        return false;
+    }
     // num_bp means anything targeted or not
     if( bp == num_bp ) {
         return effects->find( eff_id ) != effects->end();
@@ -1105,7 +1123,7 @@ bool Creature::has_effect( const efftype_id &eff_id, body_part bp ) const
 bool Creature::has_effect_with_flag( const std::string &flag, body_part bp ) const
 {
     for( auto &elem : *effects ) {
-        for( const std::pair<body_part, effect> &_it : elem.second ) {
+        for( const std::pair<const body_part, effect> &_it : elem.second ) {
             if( bp == _it.first && _it.second.has_flag( flag ) ) {
                 return true;
             }
@@ -1121,6 +1139,9 @@ effect &Creature::get_effect( const efftype_id &eff_id, body_part bp )
 
 const effect &Creature::get_effect( const efftype_id &eff_id, body_part bp ) const
 {
+    if( effects->empty() ) {
+        return effect::null_effect;
+    }
     auto got_outer = effects->find( eff_id );
     if( got_outer != effects->end() ) {
         auto got_inner = got_outer->second.find( bp );
@@ -206,6 +206,15 @@ class Creature
          * @param area The area of effect of the projectile aimed.
          */
         Creature *auto_find_hostile_target( int range, int &boo_hoo, int area = 0 );
+        /**
+         * The same, but only the given candidates are considered. Callers searching several
+         * times in a row (like the turrets of a vehicle) get them once from
+         * @ref hostile_target_candidates, candidates that died since are skipped.
+         */
+        Creature *auto_find_hostile_target( const std::vector<Creature *> &candidates, int range,
+                                            int &boo_hoo, int area = 0 );
+        /** The creatures @ref auto_find_hostile_target may choose from. */
+        static std::vector<Creature *> hostile_target_candidates();
 
         /**
          * Size of the target this creature presents to ranged weapons.
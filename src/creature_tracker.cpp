@@ -1,10 +1,12 @@
 #include "creature_tracker.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <ostream>
 #include <string>
 #include <utility>
 
+#include "coordinate_conversions.h"
 #include "debug.h"
 #include "mongroup.h"
 #include "monster.h"
@@ -81,7 +83,7 @@ bool Creature_tracker::add( monster &critter )
     }
 
     monsters_list.emplace_back( std::make_shared<monster>( critter ) );
-    monsters_by_location[critter.pos()] = monsters_list.back();
+    set_location( critter.pos(), monsters_list.back() );
     add_to_faction_map( monsters_list.back() );
     return true;
 }
@@ -101,6 +103,19 @@ void Creature_tracker::add_to_faction_map( std::shared_ptr<monster> critter_ptr
     }
 }
 
+void Creature_tracker::remove_from_faction_map( const std::shared_ptr<monster> &critter_ptr )
+{
+    for( auto &pair : monster_faction_map_ ) {
+        const auto fac_iter = pair.second.find( critter_ptr );
+        if( fac_iter != pair.second.end() ) {
+            // Need to do this manually because the shared pointer containing critter is kept valid
+            // within removed_ and so the weak pointer in monster_faction_map_ is also valid.
+            pair.second.erase( fac_iter );
+            break;
+        }
+    }
+}
+
 size_t Creature_tracker::size() const
 {
     return monsters_list.size();
@@ -132,8 +147,11 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
         return ptr.get() == &critter;
     } );
     if( iter != monsters_list.end() ) {
-        monsters_by_location.erase( critter.pos() );
-        monsters_by_location[new_pos] = *iter;
+        const auto old_iter = monsters_by_location.find( critter.pos() );
+        if( old_iter != monsters_by_location.end() ) {
+            erase_location( old_iter );
+        }
+        set_location( new_pos, *iter );
         return true;
     } else {
         const tripoint &old_pos = critter.pos();
@@ -152,7 +170,7 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
 {
     const auto pos_iter = monsters_by_location.find( critter.pos() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
-        monsters_by_location.erase( pos_iter );
+        erase_location( pos_iter );
         return;
     }
 
@@ -163,10 +181,93 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
         return v.second.get() == &critter;
     } );
     if( iter != monsters_by_location.end() ) {
-        monsters_by_location.erase( iter );
+        erase_location( iter );
     }
 }
 
+void Creature_tracker::set_location( const tripoint &pos, const std::shared_ptr<monster> &critter )
+{
+    const auto iter = monsters_by_location.find( pos );
+    if( iter != monsters_by_location.end() ) {
+        erase_location( iter );
+    }
+    monsters_by_location[pos] = critter;
+    monsters_by_submap[ms_to_sm_copy( pos )].push_back( critter.get() );
+}
+
+void Creature_tracker::erase_location( const location_map::iterator iter )
+{
+    const auto bucket_iter = monsters_by_submap.find( ms_to_sm_copy( iter->first ) );
+    if( bucket_iter != monsters_by_submap.end() ) {
+        std::vector<monster *> &bucket = bucket_iter->second;
+        const auto mon_iter = std::find( bucket.begin(), bucket.end(), iter->second.get() );
+        if( mon_iter != bucket.end() ) {
+            *mon_iter = bucket.back();
+            bucket.pop_back();
+        }
+        if( bucket.empty() ) {
+            monsters_by_submap.erase( bucket_iter );
+        }
+    }
+    monsters_by_location.erase( iter );
+}
+
+template<typename T>
+static void append_near( const std::unordered_map<tripoint, std::vector<monster *>>
+                         &monsters_by_submap, const tripoint &center, const int radius,
+                         const int radiusz, std::vector<T *> &ret )
+{
+    const tripoint sm_min = ms_to_sm_copy( center - tripoint( radius, radius, radiusz ) );
+    const tripoint sm_max = ms_to_sm_copy( center + tripoint( radius, radius, radiusz ) );
+    const auto add_bucket = [&]( const std::vector<monster *> &bucket ) {
+        for( monster *const critter : bucket ) {
+            const tripoint &pos = critter->pos();
+            if( std::abs( pos.x - center.x ) <= radius && std::abs( pos.y - center.y ) <= radius &&
+                std::abs( pos.z - center.z ) <= radiusz ) {
+                ret.push_back( critter );
+            }
+        }
+    };
+
+    const size_t cells = static_cast<size_t>( sm_max.x - sm_min.x + 1 ) *
+                         ( sm_max.y - sm_min.y + 1 ) * ( sm_max.z - sm_min.z + 1 );
+    if( cells >= monsters_by_submap.size() ) {
+        // Fewer occupied submaps than there are in range
+        for( const auto &elem : monsters_by_submap ) {
+            const tripoint &sm = elem.first;
+            if( sm.x >= sm_min.x && sm.x <= sm_max.x && sm.y >= sm_min.y && sm.y <= sm_max.y &&
+                sm.z >= sm_min.z && sm.z <= sm_max.z ) {
+                add_bucket( elem.second );
+            }
+        }
+        return;
+    }
+    for( int z = sm_min.z; z <= sm_max.z; z++ ) {
+        for( int x = sm_min.x; x <= sm_max.x; x++ ) {
+            for( int y = sm_min.y; y <= sm_max.y; y++ ) {
+                const auto iter = monsters_by_submap.find( tripoint( x, y, z ) );
+                if( iter != monsters_by_submap.end() ) {
+                    add_bucket( iter->second );
+                }
+            }
+        }
+    }
+}
+
+std::vector<monster *> Creature_tracker::find_near( const tripoint &center, const int radius,
+        const int radiusz ) const
+{
+    std::vector<monster *> ret;
+    append_near( monsters_by_submap, center, radius, radiusz, ret );
+    return ret;
+}
+
+void Creature_tracker::find_near( const tripoint &center, const int radius, const int radiusz,
+                                  std::vector<Creature *> &ret ) const
+{
+    append_near( monsters_by_submap, center, radius, radiusz, ret );
+}
+
 void Creature_tracker::remove( const monster &critter )
 {
     const auto iter = std::find_if( monsters_list.begin(), monsters_list.end(),
@@ -178,15 +279,7 @@ void Creature_tracker::remove( const monster &critter )
         return;
     }
 
-    for( auto &pair : monster_faction_map_ ) {
-        const auto fac_iter = pair.second.find( *iter );
-        if( fac_iter != pair.second.end() ) {
-            // Need to do this manually because the shared pointer containing critter is kept valid
-            // within removed_ and so the weak pointer in monster_faction_map_ is also valid.
-            pair.second.erase( fac_iter );
-            break;
-        }
-    }
+    remove_from_faction_map( *iter );
     remove_from_location_map( critter );
     removed_.push_back( *iter );
     monsters_list.erase( iter );
@@ -196,6 +289,7 @@ void Creature_tracker::clear()
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    monsters_by_submap.clear();
     monster_faction_map_.clear();
     removed_.clear();
 }
@@ -203,9 +297,10 @@ void Creature_tracker::clear()
 void Creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
+    monsters_by_submap.clear();
     monster_faction_map_.clear();
     for( const std::shared_ptr<monster> &mon_ptr : monsters_list ) {
-        monsters_by_location[mon_ptr->pos()] = mon_ptr;
+        set_location( mon_ptr->pos(), mon_ptr );
         add_to_faction_map( mon_ptr );
     }
 }
@@ -224,13 +319,13 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     std::shared_ptr<monster> first_ptr;
     if( first_iter != monsters_by_location.end() ) {
         first_ptr = first_iter->second;
-        monsters_by_location.erase( first_iter );
+        erase_location( first_iter );
     }
 
     std::shared_ptr<monster> second_ptr;
     if( second_iter != monsters_by_location.end() ) {
         second_ptr = second_iter->second;
-        monsters_by_location.erase( second_iter );
+        erase_location( second_iter );
     }
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
@@ -240,10 +335,10 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
 
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
-        monsters_by_location[first.pos()] = first_ptr;
+        set_location( first.pos(), first_ptr );
     }
     if( second_ptr ) {
-        monsters_by_location[second.pos()] = second_ptr;
+        set_location( second.pos(), second_ptr );
     }
 }
 
@@ -274,15 +369,20 @@ bool Creature_tracker::kill_marked_for_death()
 void Creature_tracker::remove_dead()
 {
     // Can't use game::all_monsters() as it would not contain *dead* monsters.
-    for( auto iter = monsters_list.begin(); iter != monsters_list.end(); ) {
-        const monster &critter = **iter;
-        if( critter.is_dead() ) {
-            remove_from_location_map( critter );
-            iter = monsters_list.erase( iter );
-        } else {
-            ++iter;
+    // A single pass that keeps the order of the survivors, erasing one by one is
+    // quadratic when a horde dies at once.
+    const auto new_end = std::remove_if( monsters_list.begin(), monsters_list.end(),
+    [this]( const std::shared_ptr<monster> &mon_ptr ) {
+        if( !mon_ptr->is_dead() ) {
+            return false;
         }
-    }
+        // Dropping the faction entry as well lets the monster's storage be freed,
+        // the weak pointer would otherwise keep the allocation around.
+        remove_from_faction_map( mon_ptr );
+        remove_from_location_map( *mon_ptr );
+        return true;
+    } );
+    monsters_list.erase( new_end, monsters_list.end() );
 
     removed_.clear();
 }
@@ -11,6 +11,7 @@
 #include "point.h"
 #include "type_id.h"
 
+class Creature;
 class monster;
 class JsonIn;
 class JsonOut;
@@ -19,12 +20,16 @@ class Creature_tracker
 {
     private:
         void add_to_faction_map( std::shared_ptr<monster> critter );
+        void remove_from_faction_map( const std::shared_ptr<monster> &critter );
 
         class weak_ptr_comparator
         {
             public:
+                // Orders by the shared control block, which the monsters share an allocation
+                // with (see @ref add). Unlike comparing locked pointers this doesn't touch the
+                // reference counts, and an entry keeps its place when its monster is gone.
                 bool operator()( const std::weak_ptr<monster> &lhs, const std::weak_ptr<monster> &rhs ) const {
-                    return lhs.lock().get() < rhs.lock().get();
+                    return lhs.owner_before( rhs );
                 }
         };
 
@@ -72,6 +77,15 @@ class Creature_tracker
         /** Removes dead monsters from. Their pointers are invalidated. */
         void remove_dead();
 
+        /**
+         * Returns the monsters located at most `radius` tiles away from `center` along x and y,
+         * and at most `radiusz` along z, in no particular order. Dead monsters are included.
+         */
+        std::vector<monster *> find_near( const tripoint &center, int radius, int radiusz ) const;
+        /** The same, appending to ret so that callers can reuse its storage. */
+        void find_near( const tripoint &center, int radius, int radiusz,
+                        std::vector<Creature *> &ret ) const;
+
         const std::vector<std::shared_ptr<monster>> &get_monsters_list() const {
             return monsters_list;
         }
@@ -85,9 +99,18 @@ class Creature_tracker
 
     private:
         std::vector<std::shared_ptr<monster>> monsters_list;
-        std::unordered_map<tripoint, std::shared_ptr<monster>> monsters_by_location;
+        using location_map = std::unordered_map<tripoint, std::shared_ptr<monster>>;
+        location_map monsters_by_location;
+        /**
+         * The monsters of @ref monsters_by_location grouped by the submap their location is in,
+         * so @ref find_near only has to look at a few of them.
+         */
+        std::unordered_map<tripoint, std::vector<monster *>> monsters_by_submap;
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
+        /** Puts `critter` at `pos` in @ref monsters_by_location, replacing any monster there. */
+        void set_location( const tripoint &pos, const std::shared_ptr<monster> &critter );
+        void erase_location( location_map::iterator iter );
 };
 
 #endif
@@ -97,6 +97,8 @@ void wborder( const window &win, chtype ls, chtype rs, chtype ts, chtype bs, cht
 void mvwhline( const window &win, const point &p, chtype ch, int n );
 void mvwvline( const window &win, const point &p, chtype ch, int n );
 void wrefresh( const window &win );
+/** Marks the whole window as changed, so the next @ref wrefresh outputs all of it again. */
+void touchwin( const window &win );
 void refresh();
 void wredrawln( const window &win, int beg_line, int num_lines );
 void mvwprintw( const window &win, const point &p, const std::string &text );
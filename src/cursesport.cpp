@@ -240,6 +240,19 @@ void catacurses::wrefresh( const window &win_ )
     }
 }
 
+void catacurses::touchwin( const window &win_ )
+{
+    cata_cursesport::WINDOW *const win = win_.get<cata_cursesport::WINDOW>();
+    if( win == nullptr ) {
+        return;
+    }
+
+    for( int j = 0; j < win->height; j++ ) {
+        win->line[j].touched = true;
+    }
+    win->draw = true;
+}
+
 //Refreshes the main window, causing it to redraw on top.
 void catacurses::refresh()
 {
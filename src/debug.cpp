@@ -4,7 +4,9 @@
 #include <cctype>
 #include <cstdio>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
@@ -15,8 +17,10 @@
 #include <locale>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -35,6 +39,10 @@
 #include "mod_manager.h"
 #include "type_id.h"
 
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
 #if !defined(_MSC_VER)
 #include <sys/time.h>
 #endif
@@ -296,16 +304,69 @@ static time_info get_time() noexcept
 }
 #endif
 
-struct DebugFile {
-    DebugFile();
-    ~DebugFile();
-    void init( DebugOutput, const std::string &filename );
-    void deinit();
+/**
+ * The log is written by a thread of its own, so logging only costs the formatting. Every
+ * thread formats into a buffer of its own (see @ref thread_log), which is queued whole when
+ * the thread starts its next message or flushes. The writer takes everything queued at once.
+ */
+class DebugFile
+{
+    public:
+        DebugFile();
+        ~DebugFile();
+        void init( DebugOutput, const std::string &filename );
+        void deinit();
+        /** Queues text for the writer, dropped if the log isn't open. */
+        void write( std::string &&text );
+        /** Writes what has been queued so far on the calling thread. */
+        void write_queued();
+        /**
+         * Writes what has been queued and then text on the calling thread, but gives up instead
+         * of waiting when the locks are taken: a crash may have interrupted their holder.
+         * @return false if it gave up.
+         */
+        bool try_write_now( const std::string &text );
+
+        // Using shared_ptr for the type-erased deleter support, not because
+        // it needs to be shared.
+        std::shared_ptr<std::ostream> file;
+        std::string filename;
+        // Whether DebugLog should log at all, checked without a lock
+        std::atomic<bool> active{ false };
+
+    private:
+        void run_writer();
+
+        std::thread writer;
+        std::mutex queue_mutex;
+        std::condition_variable queue_wake;
+        std::string queued;
+        bool stopping = false;
+        // Held while writing to file, taken before queue_mutex
+        std::mutex file_mutex;
+};
 
-    // Using shared_ptr for the type-erased deleter support, not because
-    // it needs to be shared.
-    std::shared_ptr<std::ostream> file;
-    std::string filename;
+/** Collects the log text of one thread until it is finished. */
+class log_buffer : public std::stringbuf
+{
+    public:
+        ~log_buffer() override {
+            submit();
+        }
+    protected:
+        int sync() override {
+            submit();
+            return 0;
+        }
+    public:
+        /** Removes what hasn't been submitted yet and returns it. */
+        std::string take() {
+            std::string text = str();
+            str( std::string() );
+            return text;
+        }
+    private:
+        void submit();
 };
 
 static NullBuf nullBuf;
@@ -323,21 +384,130 @@ DebugFile::~DebugFile()
     deinit();
 }
 
+static log_buffer &thread_buffer()
+{
+    static thread_local log_buffer buffer;
+    return buffer;
+}
+
+static std::ostream &thread_log()
+{
+    static thread_local std::ostream stream( &thread_buffer() );
+    return stream;
+}
+
+void log_buffer::submit()
+{
+    if( pptr() == pbase() ) {
+        return;
+    }
+    std::string text = str();
+    str( std::string() );
+    debugFile.write( std::move( text ) );
+}
+
+void DebugFile::write( std::string &&text )
+{
+    {
+        std::lock_guard<std::mutex> lock( queue_mutex );
+        if( !active ) {
+            return;
+        }
+        if( queued.empty() ) {
+            queued = std::move( text );
+        } else {
+            queued += text;
+        }
+    }
+    queue_wake.notify_one();
+}
+
+void DebugFile::write_queued()
+{
+    std::lock_guard<std::mutex> file_lock( file_mutex );
+    std::string text;
+    {
+        std::lock_guard<std::mutex> lock( queue_mutex );
+        text.swap( queued );
+    }
+    if( !text.empty() && file ) {
+        *file << text;
+        file->flush();
+    }
+}
+
+bool DebugFile::try_write_now( const std::string &text )
+{
+    std::unique_lock<std::mutex> file_lock( file_mutex, std::try_to_lock );
+    if( !file_lock.owns_lock() ) {
+        return false;
+    }
+    std::string queued_text;
+    {
+        std::unique_lock<std::mutex> lock( queue_mutex, std::try_to_lock );
+        if( !lock.owns_lock() ) {
+            return false;
+        }
+        queued_text.swap( queued );
+    }
+    if( file ) {
+        *file << queued_text << text;
+        file->flush();
+    }
+    return true;
+}
+
+void DebugFile::run_writer()
+{
+    while( true ) {
+        {
+            std::unique_lock<std::mutex> lock( queue_mutex );
+            queue_wake.wait( lock, [this]() {
+                return stopping || !queued.empty();
+            } );
+            if( queued.empty() ) {
+                return;
+            }
+        }
+        write_queued();
+    }
+}
+
 void DebugFile::deinit()
 {
-    if( file && file.get() != &std::cerr ) {
-        *file << "\n";
-        *file << get_time() << " : Log shutdown.\n";
-        *file << "-----------------------------------------\n\n";
+    if( active ) {
+        if( file.get() != &std::cerr ) {
+            std::ostringstream shutdown;
+            shutdown << "\n";
+            shutdown << get_time() << " : Log shutdown.\n";
+            shutdown << "-----------------------------------------\n\n";
+            write( shutdown.str() );
+        }
+        {
+            std::lock_guard<std::mutex> lock( queue_mutex );
+            active = false;
+            stopping = true;
+        }
+        queue_wake.notify_all();
+        writer.join();
+        write_queued();
     }
     file.reset();
 }
 
 void DebugFile::init( DebugOutput output_mode, const std::string &filename )
 {
+    const auto start_writer = [this]() {
+        stopping = false;
+        active = true;
+        writer = std::thread( [this]() {
+            run_writer();
+        } );
+    };
     switch( output_mode ) {
         case DebugOutput::std_err:
             file = std::shared_ptr<std::ostream>( &std::cerr, null_deleter() );
+            start_writer();
             return;
         case DebugOutput::file: {
             this->filename = filename;
@@ -354,6 +524,7 @@ void DebugFile::init( DebugOutput output_mode, const std::string &filename )
                        filename.c_str(), std::ios::out | std::ios::app );
             *file << "\n\n-----------------------------------------\n";
             *file << get_time() << " : Starting log.";
+            start_writer();
             DebugLog( D_INFO, D_MAIN ) << "Cataclysm DDA version " << getVersionString();
             if( rename_failed ) {
                 DebugLog( D_ERROR, DC_ALL ) << "Moving the previous log file to "
@@ -421,9 +592,19 @@ void setupDebug( DebugOutput output_mode )
 
 void deinitDebug()
 {
+    if( debugFile.active ) {
+        thread_log().flush();
+    }
     debugFile.deinit();
 }
 
+void debug_flush_log()
+{
+    if( debugFile.active ) {
+        debugFile.try_write_now( thread_buffer().take() );
+    }
+}
+
 // OStream Operators                                                {{{2
 // ---------------------------------------------------------------------
 
@@ -759,15 +940,17 @@ std::ostream &DebugLog( DebugLevel lev, DebugClass cl )
 
     // If debugging has not been initialized then stop
     // (we could instead use std::cerr in this case?)
-    if( !debugFile.file ) {
+    if( !debugFile.active ) {
         return nullStream;
     }
 
     // Error are always logged, they are important,
     // Messages from D_MAIN come from debugmsg and are equally important.
     if( ( lev & debugLevel && cl & debugClass ) || lev & D_ERROR || cl & D_MAIN ) {
-        std::ostream &out = *debugFile.file;
-        out << std::endl;
+        std::ostream &out = thread_log();
+        // The previous message of this thread is finished, hand it to the writer
+        out.flush();
+        out << '\n';
         out << get_time() << " ";
         out << lev;
         if( cl != debugClass ) {
@@ -161,6 +161,13 @@ enum class DebugOutput {
 void setupDebug( DebugOutput );
 /** Opposite of setupDebug, shuts the debugging system down. */
 void deinitDebug();
+/**
+ * Writes everything logged so far to the log on the calling thread, instead of leaving it to
+ * the writer thread. For crashes, the message the calling thread is in the middle of is
+ * included, those of other threads aren't. It never waits for the log's locks, the crash may
+ * have interrupted whoever holds them (even on this thread), the flush is skipped then.
+ */
+void debug_flush_log();
 
 // Function Declarations                                            {{{1
 // ---------------------------------------------------------------------
@@ -26,6 +26,7 @@
 #include "filesystem.h"
 #include "game.h"
 #include "map_extras.h"
+#include "memory_census.h"
 #include "messages.h"
 #include "mission.h"
 #include "morale_types.h"
@@ -36,9 +37,12 @@
 #include "overmap.h"
 #include "overmap_ui.h"
 #include "overmapbuffer.h"
+#include "path_info.h"
 #include "player.h"
 #include "string_formatter.h"
 #include "string_input_popup.h"
+#include "sampling_profiler.h"
+#include "turn_profile.h"
 #include "ui.h"
 #include "vitamin.h"
 #include "color.h"
@@ -141,7 +145,11 @@ enum debug_menu_index {
     DEBUG_DISPLAY_VISIBILITY,
     DEBUG_DISPLAY_RADIATION,
     DEBUG_LEARN_SPELLS,
-    DEBUG_LEVEL_SPELLS
+    DEBUG_LEVEL_SPELLS,
+    DEBUG_TURN_PROFILE,
+    DEBUG_MEMORY_CENSUS,
+    DEBUG_DISPLAY_RENDER_PROFILE,
+    DEBUG_SAMPLE_STACKS
 };
 
 class mission_debug
@@ -198,8 +206,12 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( DEBUG_DISPLAY_TEMP, true, 'T', _( "Toggle display temperature" ) ) },
             { uilist_entry( DEBUG_DISPLAY_VISIBILITY, true, 'v', _( "Toggle display visibility" ) ) },
             { uilist_entry( DEBUG_DISPLAY_RADIATION, true, 'R', _( "Toggle display radiation" ) ) },
+            { uilist_entry( DEBUG_DISPLAY_RENDER_PROFILE, true, 'F', _( "Toggle display render profile" ) ) },
             { uilist_entry( DEBUG_SHOW_MUT_CAT, true, 'm', _( "Show mutation category levels" ) ) },
             { uilist_entry( DEBUG_BENCHMARK, true, 'b', _( "Draw benchmark (X seconds)" ) ) },
+            { uilist_entry( DEBUG_TURN_PROFILE, true, 'P', _( "Profile turn phases" ) ) },
+            { uilist_entry( DEBUG_MEMORY_CENSUS, true, 'M', _( "Estimate memory use" ) ) },
+            { uilist_entry( DEBUG_SAMPLE_STACKS, sampling_profiler::available(), 'J', _( "Sample the main thread stack" ) ) },
             { uilist_entry( DEBUG_TRAIT_GROUP, true, 't', _( "Test trait group" ) ) },
             { uilist_entry( DEBUG_SHOW_MSG, true, 'd', _( "Show debug message" ) ) },
             { uilist_entry( DEBUG_CRASH_GAME, true, 'C', _( "Crash game (test crash handling)" ) ) },
@@ -1368,6 +1380,10 @@ void debug()
                 g->displaying_radiation = !g->displaying_radiation;
             }
             break;
+            case DEBUG_DISPLAY_RENDER_PROFILE:
+                // Only drawn with tiles, the curses map has no layers
+                g->displaying_render_profile = !g->displaying_render_profile;
+                break;
             case DEBUG_CHANGE_TIME: {
                 auto set_turn = [&]( const int initial, const time_duration factor, const char *const msg ) {
                     const auto text = string_input_popup()
@@ -1461,6 +1477,50 @@ void debug()
             }
                      break;
 
+            case DEBUG_TURN_PROFILE: {
+                if( !turn_profile::enabled() ) {
+                    turn_profile::enable();
+                    popup( _( "Recording the phases of each turn.  Play some turns and open this entry again to see where the time went." ) );
+                    break;
+                }
+                popup( turn_profile::recent_summary() + "\n" + turn_profile::histogram(), PF_NONE );
+                const std::string path = g->get_world_base_save_path() + "/turn_profile.json";
+                if( query_yn( _( "Write a trace of the recorded turns to %s?" ), path ) ) {
+                    if( !turn_profile::write_trace( path ) ) {
+                        popup( _( "Could not write the trace." ) );
+                    }
+                }
+                if( query_yn( _( "Stop recording turn phases?" ) ) ) {
+                    turn_profile::disable();
+                }
+            }
+            break;
+
+            case DEBUG_MEMORY_CENSUS: {
+                const memory_census::census census = memory_census::take();
+                DebugLog( DL_ALL, DC_ALL ) << " MEMORY CENSUS: \n" << memory_census::report( census, 20 );
+                popup( memory_census::report( census, 0 ) + "\n" + _( "Details written to debug.log" ),
+                       PF_NONE );
+            }
+            break;
+
+            case DEBUG_SAMPLE_STACKS: {
+                if( !sampling_profiler::running() ) {
+                    const std::string path = FILENAMES["config_dir"] + "profile_samples.folded";
+                    sampling_profiler::start( path );
+                    popup( _( "Sampling the stack of the game.  Do what is slow, then open this entry again to write the samples to %s." ),
+                           path );
+                    break;
+                }
+                const int samples = sampling_profiler::stop();
+                if( samples > 0 ) {
+                    popup( _( "Wrote %d samples.  flamegraph.pl or speedscope.app can show them." ), samples );
+                } else {
+                    popup( _( "No samples were written." ) );
+                }
+            }
+            break;
+
             case DEBUG_OM_TELEPORT:
                 debug_menu::teleport_overmap();
                 break;
@@ -1,9 +1,9 @@
 #include "effect.h"
 
-#include <map>
 #include <sstream>
 #include <algorithm>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "debug.h"
@@ -19,7 +19,8 @@
 
 namespace
 {
-std::map<efftype_id, effect_type> effect_types;
+// Looked up for every effect of every creature each turn; never iterated, so unordered.
+std::unordered_map<efftype_id, effect_type> effect_types;
 } // namespace
 
 /** @relates string_id */
@@ -36,6 +36,11 @@ event_bus::~event_bus()
 void event_bus::subscribe( event_subscriber *s )
 {
     subscribers.push_back( s );
+    for( size_t i = 0; i < subscribers_by_type.size(); ++i ) {
+        if( s->wants_event( static_cast<event_type>( i ) ) ) {
+            subscribers_by_type[i].push_back( s );
+        }
+    }
     s->on_subscribe( this );
 }
 
@@ -47,12 +52,16 @@ void event_bus::unsubscribe( event_subscriber *s )
     } else {
         ( *it )->on_unsubscribe( this );
         subscribers.erase( it );
+        for( std::vector<event_subscriber *> &type_subscribers : subscribers_by_type ) {
+            type_subscribers.erase( std::remove( type_subscribers.begin(), type_subscribers.end(), s ),
+                                    type_subscribers.end() );
+        }
     }
 }
 
 void event_bus::send( const cata::event &e ) const
 {
-    for( event_subscriber *s : subscribers ) {
+    for( event_subscriber *s : subscribers_by_type[static_cast<size_t>( e.type() )] ) {
         s->notify( e );
     }
 }
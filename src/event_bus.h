@@ -2,6 +2,9 @@
 #ifndef EVENT_BUS_H
 #define EVENT_BUS_H
 
+#include <array>
+#include <vector>
+
 #include "event.h"
 
 class event_bus;
@@ -14,6 +17,11 @@ class event_subscriber
         event_subscriber &operator=( const event_subscriber & ) = delete;
         virtual ~event_subscriber();
         virtual void notify( const cata::event & ) = 0;
+        // Queried once on subscription; the bus only delivers events of the
+        // types for which this returns true.
+        virtual bool wants_event( event_type ) const {
+            return true;
+        }
     private:
         friend class event_bus;
         void on_subscribe( event_bus * );
@@ -38,6 +46,8 @@ class event_bus
         }
     private:
         std::vector<event_subscriber *> subscribers;
+        std::array < std::vector<event_subscriber *>,
+            static_cast<size_t>( event_type::num_event_types ) > subscribers_by_type;
 };
 
 #endif // EVENT_BUS_H
@@ -10,7 +10,8 @@
 #include <limits>
 #include <map>
 #include <memory>
-#include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -150,22 +151,26 @@ static void do_blast( const tripoint &p, const float power,
 
     std::priority_queue< std::pair<float, tripoint>, std::vector< std::pair<float, tripoint> >, pair_greater_cmp_first >
     open;
-    std::set<tripoint> closed;
-    std::map<tripoint, float> dist_map;
+    // Hashed for the many membership checks during the flood fill; blasted keeps
+    // the same points for the damage passes below.
+    std::unordered_set<tripoint> closed;
+    std::vector<tripoint> blasted;
+    std::unordered_map<tripoint, float> dist_map;
     open.push( std::make_pair( 0.0f, p ) );
     dist_map[p] = 0.0f;
-    // Find all points to blast
+    // Find all points to blast. This stays on the main thread rather than going to the
+    // thread_pool: each step draws from the shared rng and bashes the map, and the next
+    // steps look at what the bashing left behind.
     while( !open.empty() ) {
         // Add some random factor to effective distance to make it look cooler
         const float distance = open.top().first * rng_float( 1.0f, 1.2f );
         const tripoint pt = open.top().second;
         open.pop();
 
-        if( closed.count( pt ) != 0 ) {
+        if( !closed.insert( pt ).second ) {
             continue;
         }
-
-        closed.insert( pt );
+        blasted.push_back( pt );
 
         const float force = power * std::pow( distance_factor, distance );
         if( force <= 1.0f ) {
@@ -222,16 +227,20 @@ static void do_blast( const tripoint &p, const float power,
                 next_dist += zlev_dist;
             }
 
-            if( dist_map.count( dest ) == 0 || dist_map[dest] > next_dist ) {
+            const auto dist_iter = dist_map.find( dest );
+            if( dist_iter == dist_map.end() || dist_iter->second > next_dist ) {
                 open.push( std::make_pair( next_dist, dest ) );
                 dist_map[dest] = next_dist;
             }
         }
     }
 
+    // Apply effects in the same order as before, so the rng is consumed deterministically.
+    std::sort( blasted.begin(), blasted.end() );
+
     // Draw the explosion
     std::map<tripoint, nc_color> explosion_colors;
-    for( auto &pt : closed ) {
+    for( const tripoint &pt : blasted ) {
         if( g->m.impassable( pt ) ) {
             continue;
         }
@@ -249,7 +258,7 @@ static void do_blast( const tripoint &p, const float power,
 
     draw_custom_explosion( g->u.pos(), explosion_colors );
 
-    for( const tripoint &pt : closed ) {
+    for( const tripoint &pt : blasted ) {
         const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
         if( force < 1.0f ) {
             // Too weak to matter
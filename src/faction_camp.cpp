@@ -1866,8 +1866,11 @@ static std::pair<size_t, std::string> farm_action( const tripoint &omt_tgt, farm
     }
 
     //farm_json is what the area should look like according to jsons
+    //only plowing compares against it, so skip running mapgen for the other operations
     tinymap farm_json;
-    farm_json.generate( tripoint( omt_tgt.x * 2, omt_tgt.y * 2, omt_tgt.z ), calendar::turn );
+    if( op == farm_ops::plow ) {
+        farm_json.generate( tripoint( omt_tgt.x * 2, omt_tgt.y * 2, omt_tgt.z ), calendar::turn );
+    }
     //farm_map is what the area actually looks like
     tinymap farm_map;
     farm_map.load( tripoint( omt_tgt.x * 2, omt_tgt.y * 2, omt_tgt.z ), false );
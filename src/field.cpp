@@ -178,16 +178,18 @@ Intensity defaults to 1, and age to 0 (permanent) if not specified.
 bool field::add_field( const field_type_id field_type_to_add, const int new_intensity,
                        const time_duration &new_age )
 {
-    auto it = _field_type_list.find( field_type_to_add );
+    // One descent finds both an existing entry and the insertion point for a new one.
+    const auto it = _field_type_list.lower_bound( field_type_to_add );
     if( field_type_to_add.obj().priority >= _displayed_field_type.obj().priority ) {
         _displayed_field_type = field_type_to_add;
     }
-    if( it != _field_type_list.end() ) {
+    if( it != _field_type_list.end() && it->first == field_type_to_add ) {
         //Already exists, but lets update it. This is tentative.
         it->second.set_field_intensity( it->second.get_field_intensity() + new_intensity );
         return false;
     }
-    _field_type_list[field_type_to_add] = field_entry( field_type_to_add, new_intensity, new_age );
+    _field_type_list.emplace_hint( it, field_type_to_add,
+                                   field_entry( field_type_to_add, new_intensity, new_age ) );
     return true;
 }
 
@@ -203,10 +205,11 @@ bool field::remove_field( field_type_id const field_to_remove )
 
 void field::remove_field( std::map<field_type_id, field_entry>::iterator const it )
 {
+    const bool was_displayed = it->first == _displayed_field_type;
     _field_type_list.erase( it );
     if( _field_type_list.empty() ) {
         _displayed_field_type = fd_null;
-    } else {
+    } else if( was_displayed ) {
         _displayed_field_type = fd_null;
         for( auto &fld : _field_type_list ) {
             if( fld.first.obj().priority >= _displayed_field_type.obj().priority ) {
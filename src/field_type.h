@@ -170,6 +170,10 @@ struct field_type {
                 return elem.transparent;
             } );
         }
+        /** Whether adding, removing or changing the intensity of this field can change the transparency cache. */
+        bool affects_transparency() const {
+            return dirty_transparency_cache || !is_transparent();
+        }
         int get_max_intensity() const {
             return intensity_levels.size();
         }
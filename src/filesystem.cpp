@@ -73,6 +73,20 @@ bool file_exist( const std::string &path )
     return ( stat( path.c_str(), &buffer ) == 0 );
 }
 
+std::string file_stamp( const std::string &path )
+{
+    struct stat buffer;
+    if( stat( path.c_str(), &buffer ) != 0 ) {
+        return std::string();
+    }
+    std::string stamp = std::to_string( buffer.st_mtime );
+#if defined(__linux__)
+    // Whole seconds can't tell apart two writes right after each other
+    stamp += "." + std::to_string( buffer.st_mtim.tv_nsec );
+#endif
+    return stamp + ":" + std::to_string( buffer.st_size );
+}
+
 #if defined(_WIN32)
 bool remove_file( const std::string &path )
 {
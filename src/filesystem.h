@@ -8,6 +8,11 @@
 bool assure_dir_exist( const std::string &path );
 bool dir_exist( const std::string &path );
 bool file_exist( const std::string &path );
+/**
+ * Modification time and size of a file or directory, an empty string if it doesn't exist.
+ * Only meant to be compared to an earlier result for the same path.
+ */
+std::string file_stamp( const std::string &path );
 // Remove a file, does not remove folders,
 // returns true on success
 bool remove_file( const std::string &path );
@@ -108,7 +108,7 @@ void fungal_effects::marlossify( const tripoint &p )
         return;
     }
     for( int i = 0; i < 25; i++ ) {
-        bool is_fungi = m.has_flag_ter( "FUNGUS", p );
+        bool is_fungi = m.has_flag_ter( TFLAG_FUNGUS, p );
         spread_fungus( p );
         if( is_fungi ) {
             return;
@@ -120,12 +120,12 @@ void fungal_effects::spread_fungus_one_tile( const tripoint &p, const int growth
 {
     bool converted = false;
     // Terrain conversion
-    if( m.has_flag_ter( "DIGGABLE", p ) ) {
+    if( m.has_flag_ter( TFLAG_DIGGABLE, p ) ) {
         if( x_in_y( growth * 10, 100 ) ) {
             m.ter_set( p, t_fungus );
             converted = true;
         }
-    } else if( m.has_flag( "FLAT", p ) ) {
+    } else if( m.has_flag( TFLAG_FLAT, p ) ) {
         if( m.has_flag( TFLAG_INDOORS, p ) ) {
             if( x_in_y( growth * 10, 500 ) ) {
                 m.ter_set( p, t_fungus_floor_in );
@@ -142,7 +142,7 @@ void fungal_effects::spread_fungus_one_tile( const tripoint &p, const int growth
                 converted = true;
             }
         }
-    } else if( m.has_flag( "SHRUB", p ) ) {
+    } else if( m.has_flag( TFLAG_SHRUB, p ) ) {
         if( x_in_y( growth * 10, 200 ) ) {
             m.ter_set( p, t_shrub_fungal );
             converted = true;
@@ -150,12 +150,12 @@ void fungal_effects::spread_fungus_one_tile( const tripoint &p, const int growth
             m.ter_set( p, t_marloss );
             converted = true;
         }
-    } else if( m.has_flag( "THIN_OBSTACLE", p ) ) {
+    } else if( m.has_flag( TFLAG_THIN_OBSTACLE, p ) ) {
         if( x_in_y( growth * 10, 150 ) ) {
             m.ter_set( p, t_fungus_mound );
             converted = true;
         }
-    } else if( m.has_flag( "YOUNG", p ) ) {
+    } else if( m.has_flag( TFLAG_YOUNG, p ) ) {
         if( x_in_y( growth * 10, 500 ) ) {
             if( m.get_field_intensity( p, fd_fungal_haze ) != 0 ) {
                 if( x_in_y( growth * 10, 800 ) ) { // young trees are vulnerable
@@ -172,7 +172,7 @@ void fungal_effects::spread_fungus_one_tile( const tripoint &p, const int growth
             }
             converted = true;
         }
-    } else if( m.has_flag( "TREE", p ) ) {
+    } else if( m.has_flag( TFLAG_TREE, p ) ) {
         if( one_in( 10 ) ) {
             if( m.get_field_intensity( p, fd_fungal_haze ) != 0 ) {
                 if( x_in_y( growth * 10, 100 ) ) {
@@ -189,7 +189,7 @@ void fungal_effects::spread_fungus_one_tile( const tripoint &p, const int growth
             }
             converted = true;
         }
-    } else if( m.has_flag( "WALL", p ) && m.has_flag( "FLAMMABLE", p ) ) {
+    } else if( m.has_flag( TFLAG_WALL, p ) && m.has_flag( TFLAG_FLAMMABLE, p ) ) {
         if( x_in_y( growth * 10, 5000 ) ) {
             m.ter_set( p, t_fungus_wall );
             converted = true;
@@ -229,12 +229,12 @@ void fungal_effects::spread_fungus( const tripoint &p )
         if( tmp == p ) {
             continue;
         }
-        if( m.has_flag( "FUNGUS", tmp ) ) {
+        if( m.has_flag( TFLAG_FUNGUS, tmp ) ) {
             growth += 1;
         }
     }
 
-    if( !m.has_flag_ter( "FUNGUS", p ) ) {
+    if( !m.has_flag_ter( TFLAG_FUNGUS, p ) ) {
         spread_fungus_one_tile( p, growth );
     } else {
         // Everything is already fungus
@@ -243,7 +243,7 @@ void fungal_effects::spread_fungus( const tripoint &p )
         }
         for( const tripoint &dest : g->m.points_in_radius( p, 1 ) ) {
             // One spread on average
-            if( !m.has_flag( "FUNGUS", dest ) && one_in( 9 - growth ) ) {
+            if( !m.has_flag( TFLAG_FUNGUS, dest ) && one_in( 9 - growth ) ) {
                 //growth chance is 100 in X simplified
                 spread_fungus_one_tile( dest, 10 );
             }
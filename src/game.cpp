@@ -102,15 +102,18 @@
 #include "scenario.h"
 #include "scent_map.h"
 #include "sdltiles.h"
+#include "shadowcasting.h"
 #include "sounds.h"
 #include "start_location.h"
 #include "stats_tracker.h"
 #include "string_formatter.h"
 #include "string_input_popup.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "timed_event.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_profile.h"
 #include "uistate.h"
 #include "veh_interact.h"
 #include "veh_type.h"
@@ -216,6 +219,7 @@ const efftype_id effect_riding( "riding" );
 const efftype_id effect_has_bag( "has_bag" );
 const efftype_id effect_harnessed( "harnessed" );
 
+static const bionic_id bio_alarm( "bio_alarm" );
 static const bionic_id bio_remote( "bio_remote" );
 
 static const trait_id trait_GRAZER( "GRAZER" );
@@ -630,6 +634,8 @@ void game::setup()
 {
     popup_status( _( "Please wait while the world data loads..." ), _( "Loading core data" ) );
     loading_ui ui( true );
+    // The player is waiting, leave checks of rarely used data for later
+    DynamicDataLoader::get_instance().set_defer_rare_checks( true );
     load_core_data( ui );
 
     load_world_modfiles( ui );
@@ -706,6 +712,7 @@ bool game::start_game()
     safe_mode = ( get_option<bool>( "SAFEMODE" ) ? SAFE_MODE_ON : SAFE_MODE_OFF );
     mostseen = 0; // ...and mostseen is 0, we haven't seen any monsters yet.
     get_safemode().load_global();
+    reset_panel_caches();
 
     init_autosave();
 
@@ -1170,9 +1177,10 @@ bool game::cleanup_at_end()
         death_screen();
         const bool is_suicide = uquit == QUIT_SUICIDE;
         events().send<event_type::game_over>( is_suicide, sLastWords );
+        // Written before the save goes to the graveyard, the memorial log it holds is part of it
+        write_memorial_file( sLastWords );
         // Struck the save_player_data here to forestall Weirdness
         move_save_to_graveyard();
-        write_memorial_file( sLastWords );
         memorial().clear();
         std::vector<std::string> characters = list_active_characters();
         // remove current player from the active characters list, as they are dead
@@ -1368,6 +1376,7 @@ bool game::do_turn()
     if( is_game_over() ) {
         return cleanup_at_end();
     }
+    turn_profile::begin_turn();
     // Actual stuff
     if( new_game ) {
         new_game = false;
@@ -1446,11 +1455,15 @@ bool game::do_turn()
                 if( !u.activity && !u.has_distant_destination() && uquit != QUIT_WATCH ) {
                     draw();
                 }
+                // Only does something on the first turn after loading
+                DynamicDataLoader::get_instance().check_deferred_data();
 
                 if( handle_action() ) {
                     ++moves_since_last_save;
                     u.action_taken();
                 }
+                // Even free actions (like toggling an item setting) can change what the panels show
+                handled_actions++;
 
                 if( is_game_over() ) {
                     return cleanup_at_end();
@@ -1555,8 +1568,16 @@ bool game::do_turn()
     update_stair_monsters();
     u.process_turn();
     if( u.moves < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
-        draw();
-        refresh_display();
+        // Pace these redraws by wall clock time rather than by turns: when turns pass
+        // quickly a frame per turn is mostly never seen, but drawing it still stalls
+        // the simulation.
+        static auto last_forced_redraw = std::chrono::steady_clock::time_point();
+        const auto now = std::chrono::steady_clock::now();
+        if( now - last_forced_redraw >= std::chrono::milliseconds( 25 ) ) {
+            draw();
+            refresh_display();
+            last_forced_redraw = now;
+        }
     }
     u.process_active_items();
 
@@ -1612,6 +1633,7 @@ bool game::do_turn()
     // reset player noise
     u.volume = 0;
 
+    turn_profile::end_turn();
     return false;
 }
 
@@ -1843,6 +1865,11 @@ int game::assign_mission_id()
 
 npc *game::find_npc( character_id id )
 {
+    for( const std::shared_ptr<npc> &guy : active_npc ) {
+        if( guy->getID() == id ) {
+            return guy.get();
+        }
+    }
     return overmap_buffer.find_npc( id ).get();
 }
 
@@ -1923,7 +1950,7 @@ void game::validate_camps()
     }
 }
 
-std::set<character_id> game::get_follower_list()
+const std::set<character_id> &game::get_follower_list() const
 {
     return follower_ids;
 }
@@ -2659,8 +2686,7 @@ void game::load( const save_t &name )
                              this, _1 ) );
     weather.nextweather = calendar::turn;
 
-    read_from_file_optional( worldpath + name.base_path() + ".log",
-                             std::bind( &memorial_logger::load, &memorial(), _1 ) );
+    memorial().load( worldpath + name.base_path() + ".log" );
 
 #if defined(__ANDROID__)
     read_from_file_optional( worldpath + name.base_path() + ".shortcuts",
@@ -2715,6 +2741,7 @@ void game::load( const save_t &name )
     calendar::set_season_length( ::get_option<int>( "SEASON_LENGTH" ) );
 
     u.reset();
+    reset_panel_caches();
     draw();
 }
 
@@ -2868,9 +2895,7 @@ bool game::save_player_data()
     const bool saved_weather = write_to_file( playerfile + ".weather", [&]( std::ostream & fout ) {
         save_weather( fout );
     }, _( "weather state" ) );
-    const bool saved_log = write_to_file( playerfile + ".log", [&]( std::ostream & fout ) {
-        fout << memorial().dump();
-    }, _( "player memorial" ) );
+    const bool saved_log = memorial().save( playerfile + ".log", _( "player memorial" ) );
 #if defined(__ANDROID__)
     const bool saved_shortcuts = write_to_file( playerfile + ".shortcuts", [&]( std::ostream & fout ) {
         save_shortcuts( fout );
@@ -3182,6 +3207,7 @@ void game::draw()
     if( test_mode ) {
         return;
     }
+    turn_profile::frame frame_timer;
 
     //temporary fix for updating visibility for minimap
     ter_view_p.z = ( u.pos() + u.view_offset ).z;
@@ -3192,7 +3218,7 @@ void game::draw()
     draw_ter();
     wrefresh( w_terrain );
 
-    draw_panels( true );
+    draw_panels( 0, 1, true, true );
 }
 
 void game::draw_panels( bool force_draw )
@@ -3200,12 +3226,25 @@ void game::draw_panels( bool force_draw )
     draw_panels( 0, 1, force_draw );
 }
 
-void game::draw_panels( size_t column, size_t index, bool force_draw )
+void game::draw_panels( size_t column, size_t index, bool force_draw, bool reuse_unchanged )
 {
     static int previous_turn = -1;
     const int current_turn = to_turns<int>( calendar::turn - calendar::turn_zero );
     const bool draw_this_turn = current_turn > previous_turn || force_draw;
     auto &mgr = panel_manager::get_manager();
+
+    // Panels only show the state of the game, which can't change while the same action
+    // is being looked at (redraws after closing a menu, moving the look around cursor).
+    panel_state state;
+    state.moment = game_moment::now();
+    state.handled_actions = handled_actions;
+    state.layout = mgr.get_current_layout_id();
+    const bool reuse = reuse_unchanged && !show_panel_adm && state == panels_drawn_state;
+    if( draw_this_turn ) {
+        panels_drawn_state = state;
+    }
+    panel_windows.resize( mgr.get_current_layout().size() );
+    size_t panel_index = 0;
     int y = 0;
     const bool sidebar_right = get_option<std::string>( "SIDEBAR_POSITION" ) == "right";
     int spacer = get_option<bool>( "SIDEBAR_SPACERS" ) ? 1 : 0;
@@ -3217,6 +3256,7 @@ void game::draw_panels( size_t column, size_t index, bool force_draw )
     }
     log_height = std::max( TERMY - log_height, 3 );
     for( const window_panel &panel : mgr.get_current_layout() ) {
+        catacurses::window &panel_window = panel_windows[panel_index++];
         if( panel.render() ) {
             // height clamped to window height.
             int h = std::min( panel.get_height(), TERMY - y );
@@ -3226,8 +3266,18 @@ void game::draw_panels( size_t column, size_t index, bool force_draw )
             h += spacer;
             if( panel.toggle && panel.render() && h > 0 ) {
                 if( panel.always_draw || draw_this_turn ) {
-                    panel.draw( u, catacurses::newwin( h, panel.get_width(),
-                                                       point( sidebar_right ? TERMX - panel.get_width() : 0, y ) ) );
+                    const point pos( sidebar_right ? TERMX - panel.get_width() : 0, y );
+                    if( reuse && !panel.always_draw && panel_window &&
+                        catacurses::getbegx( panel_window ) == pos.x &&
+                        catacurses::getbegy( panel_window ) == pos.y &&
+                        catacurses::getmaxx( panel_window ) == panel.get_width() &&
+                        catacurses::getmaxy( panel_window ) == h ) {
+                        catacurses::touchwin( panel_window );
+                        wrefresh( panel_window );
+                    } else {
+                        panel_window = catacurses::newwin( h, panel.get_width(), pos );
+                        panel.draw( u, panel_window );
+                    }
                 }
                 if( show_panel_adm ) {
                     const std::string panel_name = _( panel.get_name() );
@@ -4142,10 +4192,51 @@ void game::cleanup_dead()
     critter_died = false;
 }
 
+// The parts of the player that monsters seeing them depends on and that a monster's turn can
+// change, through knockback, EMP, stolen or destroyed gear and the like.
+static std::tuple<tripoint, bool, int, size_t, size_t> player_sight_state( const player &u )
+{
+    return std::make_tuple( u.pos(), u.movement_mode_is( PMM_CROUCH ), u.power_level,
+                            u.worn.size(), u.inv.size() );
+}
+
+void game::plan_monster_sight()
+{
+    monster::forget_planned_sights();
+    const int num_threads = get_option<int>( "MONSTER_PLAN_THREADS" );
+    if( num_threads <= 1 ) {
+        return;
+    }
+    std::vector<monster *> planners;
+    for( monster &critter : all_monsters() ) {
+        if( !critter.is_dead() && critter.friendly == 0 && !critter.has_effect( effect_ridden ) ) {
+            planners.push_back( &critter );
+        }
+    }
+    if( planners.size() < 2 ) {
+        return;
+    }
+    // Natural light levels are cached on first use, fill that in before the workers read it.
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        natural_light_level( z );
+    }
+    // Each monster only writes its own answer, so the results are the same whichever
+    // thread handles it.
+    thread_pool::parallel_for( 0, planners.size(), num_threads, [&planners]( const int i ) {
+        planners[i]->plan_player_sight();
+    } );
+}
+
 void game::monmove()
 {
+    turn_profile::phase timer( "monmove" );
     cleanup_dead();
 
+    // Seeing the player is the part of planning that only reads the world, so work it out for
+    // everyone up front. Each monster still plans and moves in order below.
+    plan_monster_sight();
+    auto sight_state = player_sight_state( u );
+
     for( monster &critter : all_monsters() ) {
         // Critters in impassable tiles get pushed away, unless it's not impassable for them
         if( !critter.is_dead() && m.impassable( critter.pos() ) && !critter.can_move_to( critter.pos() ) ) {
@@ -4175,6 +4266,12 @@ void game::monmove()
 
         m.creature_in_field( critter );
 
+        const auto new_sight_state = player_sight_state( u );
+        if( new_sight_state != sight_state ) {
+            monster::forget_planned_sights();
+            sight_state = new_sight_state;
+        }
+
         while( critter.moves > 0 && !critter.is_dead() && !critter.has_effect( effect_ridden ) ) {
             critter.made_footstep = false;
             // Controlled critters don't make their own plans
@@ -4190,16 +4287,17 @@ void game::monmove()
             m.creature_in_field( critter );
         }
 
+        // Cheapest checks first, most monsters are nowhere near the player
         if( !critter.is_dead() &&
-            u.has_active_bionic( bionic_id( "bio_alarm" ) ) &&
-            u.power_level >= 25 &&
             rl_dist( u.pos(), critter.pos() ) <= 5 &&
-            !critter.is_hallucination() ) {
+            u.power_level >= 25 &&
+            !critter.is_hallucination() &&
+            u.has_active_bionic( bio_alarm ) ) {
             u.charge_power( -25 );
             add_msg( m_warning, _( "Your motion alarm goes off!" ) );
             cancel_activity_or_ignore_query( distraction_type::motion_alarm,
                                              _( "Your motion alarm goes off!" ) );
-            if( u.has_effect( efftype_id( "sleep" ) ) ) {
+            if( u.has_effect( effect_sleep ) ) {
                 u.wake_up();
             }
         }
@@ -4220,6 +4318,7 @@ void game::monmove()
     }
 
     // Now, do active NPCs.
+    turn_profile::phase npc_timer( "npcs" );
     for( npc &guy : g->all_npcs() ) {
         int turns = 0;
         m.creature_in_field( guy );
@@ -4260,6 +4359,7 @@ void game::monmove()
 
 void game::overmap_npc_move()
 {
+    turn_profile::phase timer( "overmap_npcs" );
     std::vector<npc *> travelling_npcs;
     for( auto &elem : overmap_buffer.get_npcs_near_player( 75 ) ) {
         if( !elem ) {
@@ -4271,6 +4371,7 @@ void game::overmap_npc_move()
             travelling_npcs.push_back( npc_to_add );
         }
     }
+    bool any_travelled = false;
     for( auto &elem : travelling_npcs ) {
         if( elem->has_omt_destination() ) {
             if( elem->omt_path.empty() ) {
@@ -4281,9 +4382,13 @@ void game::overmap_npc_move()
                 }
                 elem->travel_overmap( omt_to_sm_copy( elem->omt_path.back() ) );
             }
-            reload_npcs();
+            any_travelled = true;
         }
     }
+    // One reload picks up every NPC that arrived in or left the reality bubble this turn.
+    if( any_travelled ) {
+        reload_npcs();
+    }
     return;
 }
 
@@ -6863,26 +6968,29 @@ std::vector<map_item_stack> game::find_nearby_items( int iRadius )
     std::vector<tripoint> points = closest_tripoints_first( iRadius, u.pos() );
 
     for( auto &points_p_it : points ) {
+        // Cheapest check first, most tiles have no items
         if( points_p_it.y >= u.posy() - iRadius && points_p_it.y <= u.posy() + iRadius &&
-            u.sees( points_p_it ) &&
-            m.sees_some_items( points_p_it, u ) ) {
+            m.sees_some_items( points_p_it, u ) &&
+            u.sees( points_p_it ) ) {
 
             for( auto &elem : m.i_at( points_p_it ) ) {
                 const std::string name = elem.tname();
                 const tripoint relative_pos = points_p_it - u.pos();
 
-                if( std::find( item_order.begin(), item_order.end(), name ) == item_order.end() ) {
+                const auto found = temp_items.find( name );
+                if( found == temp_items.end() ) {
                     item_order.push_back( name );
-                    temp_items[name] = map_item_stack( &elem, relative_pos );
+                    temp_items.emplace( name, map_item_stack( &elem, relative_pos ) );
                 } else {
-                    temp_items[name].add_at_pos( &elem, relative_pos );
+                    found->second.add_at_pos( &elem, relative_pos );
                 }
             }
         }
     }
 
+    ret.reserve( item_order.size() );
     for( auto &elem : item_order ) {
-        ret.push_back( temp_items[elem] );
+        ret.push_back( std::move( temp_items[elem] ) );
     }
 
     return ret;
@@ -10633,9 +10741,20 @@ point game::update_map( int &x, int &y )
     // Update what parts of the world map we can see
     update_overmap_seen();
 
+    // Don't let the submaps left behind pile up until the next save.
+    MAPBUFFER.limit_size( get_option<int>( "MAX_LOADED_SUBMAPS" ) );
+
     return shift;
 }
 
+static void set_seen_down( tripoint seen )
+{
+    do {
+        overmap_buffer.set_seen( seen, true );
+        --seen.z;
+    } while( seen.z >= 0 );
+}
+
 void game::update_overmap_seen()
 {
     const tripoint ompos = u.global_omt_location();
@@ -10643,6 +10762,47 @@ void game::update_overmap_seen()
     const int dist_squared = dist * dist;
     // We can always see where we're standing
     overmap_buffer.set_seen( ompos, true );
+
+    // One shadowcasting pass over the see costs, in a grid of the size of the map caches.
+    // The sight points left at each tile are what the sight lines to it have left over.
+    constexpr point center( MAPSIZE_X / 2, MAPSIZE_Y / 2 );
+    // castLight goes no further than 60 tiles
+    if( dist < 60 ) {
+        struct sight_grids {
+            float costs[MAPSIZE_X][MAPSIZE_Y];
+            float sight_points[MAPSIZE_X][MAPSIZE_Y];
+        };
+        std::unique_ptr<sight_grids> grids = std::make_unique<sight_grids>();
+        for( int x = 0; x < MAPSIZE_X; ++x ) {
+            for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                const point d = point( x, y ) - center;
+                // Beyond the range the casting should stop right away
+                grids->costs[x][y] = std::abs( d.x ) > dist || std::abs( d.y ) > dist ? 999 :
+                                     overmap_buffer.ter( ompos + d )->get_see_cost();
+                grids->sight_points[x][y] = -1;
+            }
+        }
+        castLightAll<float, float, overmap_sight_calc, overmap_sight_check, update_light,
+                     accumulate_transparency>( grids->sight_points, grids->costs, center.x, center.y, 0,
+                                               dist );
+        for( int dx = -dist; dx <= dist; dx++ ) {
+            for( int dy = -dist; dy <= dist; dy++ ) {
+                const int h_squared = dx * dx + dy * dy;
+                if( ( trigdist && h_squared > dist_squared ) || ( dx == 0 && dy == 0 ) ) {
+                    continue;
+                }
+                // If circular distances are enabled, the casting measured them the same way
+                const float multiplier = trigdist ? std::sqrt( h_squared ) / std::max<float>( std::abs( dx ),
+                                         std::abs( dy ) ) : 1;
+                const point p = center + point( dx, dy );
+                if( grids->sight_points[p.x][p.y] - grids->costs[p.x][p.y] * multiplier >= 0 ) {
+                    set_seen_down( ompos + point( dx, dy ) );
+                }
+            }
+        }
+        return;
+    }
+
     for( int dx = -dist; dx <= dist; dx++ ) {
         for( int dy = -dist; dy <= dist; dy++ ) {
             const int h_squared = dx * dx + dy * dy;
@@ -10661,11 +10821,7 @@ void game::update_overmap_seen()
                 sight_points -= static_cast<int>( ter->get_see_cost() ) * multiplier;
             }
             if( sight_points >= 0 ) {
-                tripoint seen( p );
-                do {
-                    overmap_buffer.set_seen( seen, true );
-                    --seen.z;
-                } while( seen.z >= 0 );
+                set_seen_down( p );
             }
         }
     }
@@ -11833,6 +11989,29 @@ std::vector<Creature *> game::get_creatures_if( const std::function<bool( const
     return result;
 }
 
+void game::get_creatures_near( const tripoint &center, const int radius,
+                               std::vector<Creature *> &result )
+{
+    result.clear();
+    const auto in_range = [&center, radius]( const tripoint & p ) {
+        return std::abs( p.x - center.x ) <= radius && std::abs( p.y - center.y ) <= radius &&
+               std::abs( p.z - center.z ) <= radius;
+    };
+    // Monsters in the tracker's (spatial) order, then NPCs, then the avatar
+    critter_tracker->find_near( center, radius, radius, result );
+    result.erase( std::remove_if( result.begin(), result.end(), []( const Creature * critter ) {
+        return static_cast<const monster *>( critter )->is_dead();
+    } ), result.end() );
+    for( const std::shared_ptr<npc> &guy : active_npc ) {
+        if( !guy->is_dead() && in_range( guy->pos() ) ) {
+            result.push_back( guy.get() );
+        }
+    }
+    if( in_range( u.pos() ) ) {
+        result.push_back( &u );
+    }
+}
+
 std::vector<npc *> game::get_npcs_if( const std::function<bool( const npc & )> &pred )
 {
     std::vector<npc *> result;
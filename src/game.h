@@ -21,6 +21,7 @@
 #include "cursesdef.h"
 #include "enums.h"
 #include "game_constants.h"
+#include "game_moment.h"
 #include "item_location.h"
 #include "optional.h"
 #include "pimpl.h"
@@ -44,6 +45,7 @@ extern std::unique_ptr<game> g;
 extern bool trigdist;
 extern bool use_tiles;
 extern bool fov_3d;
+extern int fov_3d_z_range;
 extern bool tile_iso;
 
 extern const int core_version;
@@ -219,7 +221,10 @@ class game
         void draw_panels( bool force_draw = false );
         // when force_redraw is true, redraw all panel instead of just animated panels
         // mostly used after UI updates
-        void draw_panels( size_t column, size_t index, bool force_draw = false );
+        // when reuse_unchanged is true, panels still showing the current game state
+        // are output again from their last window instead of being drawn anew
+        void draw_panels( size_t column, size_t index, bool force_draw = false,
+                          bool reuse_unchanged = false );
         /**
          * Returns the location where the indicator should go relative to the reality bubble,
          * or nothing to indicate no indicator should be drawn.
@@ -382,6 +387,13 @@ class game
          * are checked ( and returned ). Returned pointers are never null.
          */
         std::vector<Creature *> get_creatures_if( const std::function<bool( const Creature & )> &pred );
+        /**
+         * Replaces the content of result with the living creatures at most radius tiles away
+         * from center along each axis: the monsters in no particular order, then the NPCs,
+         * then the avatar. Only the monsters near center are looked at, and the storage of
+         * result is reused, so callers that ask often can keep it around.
+         */
+        void get_creatures_near( const tripoint &center, int radius, std::vector<Creature *> &result );
         std::vector<npc *> get_npcs_if( const std::function<bool( const npc & )> &pred );
         /**
          * Returns a creature matching a predicate. Only living (not dead) creatures
@@ -425,7 +437,10 @@ class game
 
         /** Returns the next available mission id. */
         int assign_mission_id();
-        /** Find the npc with the given ID. Returns NULL if the npc could not be found. Searches all loaded overmaps. */
+        /**
+         * Find the npc with the given ID. Returns NULL if the npc could not be found.
+         * Checks the active NPCs first, then searches all loaded overmaps.
+         */
         npc *find_npc( character_id id );
         /** Makes any nearby NPCs on the overmap active. */
         void load_npcs();
@@ -447,7 +462,7 @@ class game
         /** Remove follower id from follower set. */
         void remove_npc_follower( const character_id &id );
         /** Get set of followers. */
-        std::set<character_id> get_follower_list();
+        const std::set<character_id> &get_follower_list() const;
         /** validate list of followers to account for overmap buffers */
         void validate_npc_followers();
         void validate_mounted_npcs();
@@ -825,6 +840,7 @@ class game
         void perhaps_add_random_npc();
 
         // Routine loop functions, approximately in order of execution
+        void plan_monster_sight(); // Monsters check if they see the player ahead of monmove
         void monmove();          // Monster movement
         void overmap_npc_move(); // NPC overmap movement
         void process_activity(); // Processes and enacts the player's activity
@@ -943,8 +959,25 @@ class game
         /** Creature for which to display the visibility map */
         Creature *displaying_visibility_creature;
         bool displaying_radiation;
+        /** Draw counts and times of each map layer over the map, in tiles builds. */
+        bool displaying_render_profile = false;
 
         bool show_panel_adm;
+
+        /** What the side panels were last fully drawn for, see @ref draw_panels. */
+        struct panel_state {
+            game_moment moment;
+            int handled_actions = 0;
+            std::string layout;
+
+            bool operator==( const panel_state &rhs ) const {
+                return moment == rhs.moment && handled_actions == rhs.handled_actions &&
+                       layout == rhs.layout;
+            }
+        };
+        panel_state panels_drawn_state;
+        /** The window each panel of the layout was last drawn to. */
+        std::vector<catacurses::window> panel_windows;
         bool right_sidebar;
         bool fullscreen;
         bool was_fullscreen;
@@ -993,6 +1026,8 @@ class game
         std::unique_ptr<special_game> gamemode;
 
         int user_action_counter; // Times the user has input an action
+        /** Times @ref handle_action has returned, including for actions that took no time. */
+        int handled_actions = 0;
 
         /** How far the tileset should be zoomed out, 16 is default. 32 is zoomed in by x2, 8 is zoomed out by x0.5 */
         int tileset_zoom;
@@ -0,0 +1,15 @@
+#include "game_moment.h"
+
+#include "avatar.h"
+#include "calendar.h"
+#include "game.h"
+#include "map.h"
+
+game_moment game_moment::now()
+{
+    game_moment result;
+    result.turn = to_turn<int>( calendar::turn );
+    result.moves = g->u.moves;
+    result.abs_sub = g->m.get_abs_sub();
+    return result;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#ifndef GAME_MOMENT_H
+#define GAME_MOMENT_H
+
+#include "point.h"
+
+/**
+ * The state of the game most of what is drawn depends on: the turn, the moves the avatar has
+ * left in it and where the reality bubble is. None of it changes while the game only waits for
+ * input, so a redraw at the same moment as the last one (after closing a menu, while moving the
+ * look around cursor) can reuse what that one drew.
+ */
+struct game_moment {
+    int turn = -1;
+    int moves = 0;
+    tripoint abs_sub;
+
+    /** The moment the game is at. */
+    static game_moment now();
+
+    bool operator==( const game_moment &rhs ) const {
+        return turn == rhs.turn && moves == rhs.moves && abs_sub == rhs.abs_sub;
+    }
+    bool operator!=( const game_moment &rhs ) const {
+        return !operator==( rhs );
+    }
+};
+
+#endif
@@ -61,6 +61,7 @@
 #include "rng.h"
 #include "string_formatter.h"
 #include "translations.h"
+#include "turn_profile.h"
 #include "ui.h"
 #include "units.h"
 #include "string_id.h"
@@ -1466,7 +1467,8 @@ bool game::handle_action()
         u.start_destination_activity();
         return false;
     } else {
-        // No auto-move, ask player for input
+        // No auto-move, ask player for input. The animations drawn meanwhile are idle time too.
+        turn_profile::input_wait waiting;
         ctxt = get_player_input( action );
     }
 
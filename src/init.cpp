@@ -1,5 +1,6 @@
 #include "init.h"
 
+#include <chrono>
 #include <cstddef>
 #include <cassert>
 #include <fstream>
@@ -10,12 +11,19 @@
 #include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <set>
+#include <algorithm>
+
+#if defined(__GLIBC__)
+#   include <malloc.h>
+#endif
 
 #include "activity_type.h"
 #include "ammo.h"
 #include "anatomy.h"
 #include "behavior.h"
 #include "bionics.h"
+#include "cata_utility.h"
 #include "construction.h"
 #include "crafting_gui.h"
 #include "debug.h"
@@ -26,6 +34,7 @@
 #include "fault.h"
 #include "filesystem.h"
 #include "flag.h"
+#include "get_version.h"
 #include "gates.h"
 #include "harvest.h"
 #include "item_action.h"
@@ -52,6 +61,7 @@
 #include "overlay_ordering.h"
 #include "overmap_connection.h"
 #include "overmap_location.h"
+#include "path_info.h"
 #include "profession.h"
 #include "recipe_dictionary.h"
 #include "recipe_groups.h"
@@ -65,8 +75,10 @@
 #include "sounds.h"
 #include "speech.h"
 #include "start_location.h"
+#include "startup_trace.h"
 #include "string_formatter.h"
 #include "text_snippets.h"
+#include "thread_pool.h"
 #include "trap.h"
 #include "tutorial.h"
 #include "veh_type.h"
@@ -102,7 +114,13 @@ void DynamicDataLoader::load_object( JsonObject &jo, const std::string &src,
     if( it == type_function_map.end() ) {
         jo.throw_error( "unrecognized JSON object", "type" );
     }
+    if( !startup_trace::enabled() ) {
+        it->second( jo, src, base_path, full_path );
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
     it->second( jo, src, base_path, full_path );
+    startup_trace::add_type_time( type, std::chrono::steady_clock::now() - start );
 }
 
 void DynamicDataLoader::load_deferred( deferred_json &data )
@@ -383,6 +401,22 @@ void DynamicDataLoader::initialize()
 #endif
 }
 
+/** Stuffs the whole file into ram in one read, parsing from memory is much faster. */
+static std::string read_whole_file( const std::string &file )
+{
+    std::ifstream infile( file.c_str(), std::ifstream::in | std::ifstream::binary );
+    std::string contents;
+    infile.seekg( 0, std::ios::end );
+    const std::streamoff size = infile.tellg();
+    if( size > 0 ) {
+        contents.resize( static_cast<size_t>( size ) );
+        infile.seekg( 0 );
+        infile.read( &contents[0], size );
+        contents.resize( static_cast<size_t>( infile.gcount() ) );
+    }
+    return contents;
+}
+
 void DynamicDataLoader::load_data_from_path( const std::string &path, const std::string &src,
         loading_ui &ui )
 {
@@ -393,6 +427,7 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
     // the first loaded mode might provide a vehicle that uses that frame
     // But not the other way round.
 
+    startup_trace::scope trace( src + " " + path, "load" );
     // get a list of all files in the directory
     str_vec files = get_files_from_path( ".json", path, true, true );
     if( files.empty() ) {
@@ -403,18 +438,21 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
+    // Reading is independent per file, so it is spread over up to four threads.
+    // Parsing stays on this thread: the loaders consume the stream directly and
+    // touch global state, and must see the files in this order.
+    std::vector<std::string> contents( files.size() );
+    thread_pool::parallel_for( 0, files.size(), 4, [&files, &contents]( const int i ) {
+        contents[i] = read_whole_file( files[i] );
+    } );
     // iterate over each file
-    for( auto &files_i : files ) {
-        const std::string &file = files_i;
-        // open the file as a stream
-        std::ifstream infile( file.c_str(), std::ifstream::in | std::ifstream::binary );
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                ( std::istreambuf_iterator<char>( infile ) ),
-                std::istreambuf_iterator<char>()
-            )
-        );
+    for( size_t i = 0; i < files.size(); ++i ) {
+        const std::string &file = files[i];
+        data_fingerprint ^= std::hash<std::string>()( src + '\n' + file + '\n' + contents[i] ) +
+                            0x9e3779b9 + ( data_fingerprint << 6 ) + ( data_fingerprint >> 2 );
+        startup_trace::add_bytes( contents[i].size() );
+        std::istringstream iss( contents[i] );
+        std::string().swap( contents[i] );
         try {
             // parse it
             JsonIn jsin( iss );
@@ -455,6 +493,9 @@ void DynamicDataLoader::load_all_from_json( JsonIn &jsin, const std::string &src
 void DynamicDataLoader::unload_data()
 {
     finalized = false;
+    data_fingerprint = 0;
+    unchecked_stamp.clear();
+    deferred_checks.clear();
 
     harvest_list::reset();
     json_flag::reset();
@@ -595,12 +636,63 @@ void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
 
     ui.show();
     for( const named_entry &e : entries ) {
+        startup_trace::scope trace( e.first, "finalize" );
         e.second();
         ui.proceed();
     }
 
-    check_consistency( ui );
+    // The checks only depend on the data and the code checking it, so a stamp
+    // of both is kept after a clean run and the checks are skipped next time.
+    // That is why a check must never change the data it checks, anything the
+    // game relies on belongs in the finalize functions above.
+    const std::string stamp = std::string( getVersionString() ) + " " +
+                              std::to_string( data_fingerprint );
+    const std::string &stamp_path = FILENAMES["checked_data"];
+    std::string previous_stamp;
+    read_from_file_optional( stamp_path, [&previous_stamp]( std::istream & fin ) {
+        std::getline( fin, previous_stamp );
+    } );
+    if( previous_stamp == stamp ) {
+        DebugLog( D_INFO, DC_ALL ) << "Data unchanged since it was last checked, skipping checks";
+    } else {
+        unchecked_stamp = stamp;
+        check_consistency( ui );
+        if( deferred_checks.empty() ) {
+            record_checked_data();
+        }
+    }
     finalized = true;
+    startup_trace::write();
+#if defined(__GLIBC__)
+    // Reading the JSON leaves a lot of freed memory behind that the allocator keeps. Handing
+    // it back matters most with many game processes on one host (see --shared).
+    malloc_trim( 0 );
+#endif
+}
+
+void DynamicDataLoader::record_checked_data()
+{
+    if( !unchecked_stamp.empty() && !debug_has_error_been_observed() ) {
+        const std::string &stamp = unchecked_stamp;
+        write_to_file( FILENAMES["checked_data"], [&stamp]( std::ostream & fout ) {
+            fout << stamp << std::endl;
+        }, nullptr );
+    }
+    unchecked_stamp.clear();
+}
+
+void DynamicDataLoader::check_deferred_data()
+{
+    if( deferred_checks.empty() ) {
+        return;
+    }
+    // Swapped out first, so a check that throws is not run again
+    std::vector<std::function<void()>> checks;
+    checks.swap( deferred_checks );
+    for( const std::function<void()> &check : checks ) {
+        check();
+    }
+    record_checked_data();
 }
 
 void DynamicDataLoader::check_consistency( loading_ui &ui )
@@ -671,13 +763,31 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
         }
     };
 
+    // Types that are rarely exercised early in a session. These may run after the game has
+    // started using the data, so like every check they must only report problems; whatever
+    // the data needs is done when it is finalized (mapgen functions set themselves up on
+    // their first use, the check only does that early).
+    const std::set<std::string> rare = {{
+            _( "Vehicle parts" ), _( "Mapgen definitions" ), _( "Martial arts" ),
+            _( "Overmap specials" ), _( "NPC classes" ), _( "Mission types" ),
+            _( "NPC templates" )
+        }
+    };
+
     for( const named_entry &e : entries ) {
-        ui.add_entry( e.first );
+        if( defer_rare_checks && rare.count( e.first ) ) {
+            deferred_checks.push_back( e.second );
+        } else {
+            ui.add_entry( e.first );
+        }
     }
 
     ui.show();
     for( const named_entry &e : entries ) {
-        e.second();
-        ui.proceed();
+        if( !defer_rare_checks || !rare.count( e.first ) ) {
+            startup_trace::scope trace( e.first, "check" );
+            e.second();
+            ui.proceed();
+        }
     }
 }
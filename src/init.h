@@ -65,6 +65,20 @@ class DynamicDataLoader
 
     private:
         bool finalized = false;
+        /**
+         * Hash over the names, sources and contents of every file loaded since
+         * the last @ref unload_data. Together with the game version it identifies
+         * data that has already passed @ref check_consistency.
+         */
+        size_t data_fingerprint = 0;
+        /** Stamp to record once all checks of the current data have passed. */
+        std::string unchecked_stamp;
+        /** Checks of rarely used data left for @ref check_deferred_data. */
+        std::vector<std::function<void()>> deferred_checks;
+        bool defer_rare_checks = false;
+
+        /** Writes @ref unchecked_stamp if no error has been reported. */
+        void record_checked_data();
 
     protected:
         /**
@@ -139,7 +153,8 @@ class DynamicDataLoader
          * after all the mods have been loaded.
          * It must be called once after loading all data.
          * It also checks the consistency of the loaded data with
-         * @ref check_consistency
+         * @ref check_consistency, unless this exact data was already
+         * checked without errors by this version of the game.
          * @param ui Finalization status display.
          * @throw std::exception if the loaded data is not valid. The
          * game should *not* proceed in that case.
@@ -154,6 +169,23 @@ class DynamicDataLoader
          */
         void load_deferred( deferred_json &data );
 
+        /**
+         * If enabled, the next @ref check_consistency only verifies the data
+         * needed to start playing, the checks of rarely used types (missions,
+         * martial arts, mapgen, overmap specials, vehicle parts, NPCs) wait for
+         * @ref check_deferred_data. Tools and tests leave this disabled.
+         * Only checks that never change the data may be deferred, everything
+         * a type needs to be usable has to happen in its finalize.
+         */
+        void set_defer_rare_checks( bool defer ) {
+            defer_rare_checks = defer;
+        }
+        /**
+         * Runs the checks deferred by @ref set_defer_rare_checks, if any.
+         * Cheap to call when there are none.
+         */
+        void check_deferred_data();
+
         /**
          * Returns whether the data is finalized and ready to be utilized.
          */
@@ -30,6 +30,7 @@
 #include "string_formatter.h"
 #include "string_input_popup.h"
 #include "translations.h"
+#include "turn_profile.h"
 #include "color.h"
 #include "point.h"
 
@@ -845,7 +846,10 @@ const std::string &input_context::handle_input( const int timeout )
     next_action.type = CATA_INPUT_ERROR;
     const std::string *result = &CATA_ERROR;
     while( true ) {
-        next_action = inp_mngr.get_input_event();
+        {
+            turn_profile::input_wait waiting;
+            next_action = inp_mngr.get_input_event();
+        }
         if( next_action.type == CATA_INPUT_TIMEOUT ) {
             result = &TIMEOUT;
             break;
@@ -153,8 +153,8 @@ size_t inventory::size() const
 
 inventory &inventory::operator+= ( const inventory &rhs )
 {
-    for( size_t i = 0; i < rhs.size(); i++ ) {
-        push_back( rhs.const_stack( i ) );
+    for( const auto &stack : rhs.items ) {
+        push_back( stack );
     }
     return *this;
 }
@@ -349,16 +349,26 @@ void inventory::restack( player &p )
 
     // combine matching stacks
     // separate loop to ensure that ALL stacks are homogeneous
+    // Only stacks of the same type can match, so compare within each type, in inventory order.
+    std::unordered_map<const itype *, std::vector<invstack::iterator>> stacks_by_type;
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter ) {
-        for( invstack::iterator other = iter; other != items.end(); ++other ) {
-            if( iter != other && iter->front().stacks_with( other->front() ) ) {
-                if( other->front().count_by_charges() ) {
-                    iter->front().charges += other->front().charges;
+        stacks_by_type[iter->front().type].push_back( iter );
+    }
+    for( auto &type_stacks : stacks_by_type ) {
+        std::vector<invstack::iterator> &stacks = type_stacks.second;
+        for( auto iter = stacks.begin(); iter != stacks.end(); ++iter ) {
+            for( auto other = std::next( iter ); other != stacks.end(); ) {
+                if( ( *iter )->front().stacks_with( ( *other )->front() ) ) {
+                    if( ( *other )->front().count_by_charges() ) {
+                        ( *iter )->front().charges += ( *other )->front().charges;
+                    } else {
+                        ( *iter )->splice( ( *iter )->begin(), **other );
+                    }
+                    items.erase( *other );
+                    other = stacks.erase( other );
                 } else {
-                    iter->splice( iter->begin(), *other );
+                    ++other;
                 }
-                other = items.erase( other );
-                --other;
             }
         }
     }
@@ -417,19 +427,21 @@ void inventory::form_from_map( map &m, const tripoint &origin, int range, const
 
     items.clear();
     for( const tripoint &p : reachable_pts ) {
+        // Looked up once per tile, several of the checks below need them.
+        const furn_t &f = m.furn( p ).obj();
+        map_stack here = m.i_at( p );
         if( m.has_furn( p ) ) {
-            const furn_t &f = m.furn( p ).obj();
             const itype *type = f.crafting_pseudo_item_type();
             if( type != nullptr ) {
                 const itype *ammo = f.crafting_ammo_item_type();
                 item furn_item( type, calendar::turn, 0 );
                 furn_item.item_tags.insert( "PSEUDO" );
-                furn_item.charges = ammo ? count_charges_in_list( ammo, m.i_at( p ) ) : 0;
+                furn_item.charges = ammo ? count_charges_in_list( ammo, here ) : 0;
                 add_item( furn_item );
             }
         }
         if( m.accessible_items( p ) ) {
-            for( auto &i : m.i_at( p ) ) {
+            for( auto &i : here ) {
                 // if its *the* player requesting this from from map inventory
                 // then dont allow items owned by another faction to be factored into recipe components etc.
                 if( pl && i.has_owner() && i.get_owner() != pl->get_faction() ) {
@@ -453,25 +465,23 @@ void inventory::form_from_map( map &m, const tripoint &origin, int range, const
         }
         // kludge that can probably be done better to check specifically for toilet water to use in
         // crafting
-        if( m.furn( p ).obj().examine == &iexamine::toilet ) {
+        if( f.examine == &iexamine::toilet ) {
             // get water charges at location
-            auto toilet = m.i_at( p );
-            auto water = toilet.end();
-            for( auto candidate = toilet.begin(); candidate != toilet.end(); ++candidate ) {
+            auto water = here.end();
+            for( auto candidate = here.begin(); candidate != here.end(); ++candidate ) {
                 if( candidate->typeId() == "water" ) {
                     water = candidate;
                     break;
                 }
             }
-            if( water != toilet.end() && water->charges > 0 ) {
+            if( water != here.end() && water->charges > 0 ) {
                 add_item( *water );
             }
         }
 
         // keg-kludge
-        if( m.furn( p ).obj().examine == &iexamine::keg ) {
-            auto liq_contained = m.i_at( p );
-            for( auto &i : liq_contained ) {
+        if( f.examine == &iexamine::keg ) {
+            for( auto &i : here ) {
                 if( i.made_of( LIQUID ) ) {
                     add_item( i );
                 }
@@ -500,8 +510,9 @@ void inventory::form_from_map( map &m, const tripoint &origin, int range, const
         const cata::optional<vpart_reference> cargo = vp.part_with_feature( "CARGO", true );
 
         if( cargo ) {
-            const auto items = veh->get_items( cargo->part_index() );
-            *this += std::list<item>( items.begin(), items.end() );
+            for( const item &it : veh->get_items( cargo->part_index() ) ) {
+                add_item( it, false, false );
+            }
         }
 
         if( faupart ) {
@@ -1102,6 +1113,7 @@ const itype_bin &inventory::get_binned_items() const
     }
 
     binned_items.clear();
+    quality_levels.clear();
 
     // Hack warning
     inventory *this_nonconst = const_cast<inventory *>( this );
@@ -1114,6 +1126,27 @@ const itype_bin &inventory::get_binned_items() const
     return binned_items;
 }
 
+const std::map<int, int> &inventory::get_quality_levels( const quality_id &qual ) const
+{
+    const itype_bin &bins = get_binned_items();
+    const auto found = quality_levels.find( qual );
+    if( found != quality_levels.end() ) {
+        return found->second;
+    }
+
+    std::map<int, int> &levels = quality_levels[ qual ];
+    for( const auto &kv : bins ) {
+        for( const item *e : kv.second ) {
+            const int level = e->get_quality( qual );
+            if( level != INT_MIN ) {
+                int &qty = levels[ level ];
+                qty = std::min<long>( static_cast<long>( qty ) + e->count(), INT_MAX );
+            }
+        }
+    }
+    return levels;
+}
+
 void inventory::copy_invlet_of( const inventory &other )
 {
     assigned_invlet = other.assigned_invlet;
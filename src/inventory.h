@@ -219,6 +219,12 @@ class inventory : public visitable<inventory>
          */
         const itype_bin &get_binned_items() const;
 
+        /**
+         * Returns the total count of visitable items providing each level of @p qual.
+         * Levels with no items are absent. Cached and invalidated together with the binned items.
+         */
+        const std::map<int, int> &get_quality_levels( const quality_id &qual ) const;
+
         void update_cache_with_item( item &newit );
 
         void copy_invlet_of( const inventory &other );
@@ -236,6 +242,8 @@ class inventory : public visitable<inventory>
          * `mutable` because this is a pure cache that doesn't affect the contained items.
          */
         mutable itype_bin binned_items;
+        /** Item counts per quality level, filled on demand from @ref binned_items. */
+        mutable std::map<quality_id, std::map<int, int>> quality_levels;
 };
 
 #endif
@@ -1077,17 +1077,20 @@ std::string item::info( std::vector<iteminfo> &info, const iteminfo_query *parts
                                       "<header>" + get_category().name() + "</header>",
                                       iteminfo::no_newline ) );
         }
-        const int price_preapoc = price( false ) * batch;
-        const int price_postapoc = price( true ) * batch;
-        if( parts->test( iteminfo_parts::BASE_PRICE ) ) {
-            info.push_back( iteminfo( "BASE", space + _( "Price: " ), _( "$<num>" ),
-                                      iteminfo::is_decimal | iteminfo::lower_is_better,
-                                      static_cast<double>( price_preapoc ) / 100 ) );
-        }
-        if( price_preapoc != price_postapoc && parts->test( iteminfo_parts::BASE_BARTER ) ) {
-            info.push_back( iteminfo( "BASE", _( "Barter value: " ), _( "$<num>" ),
-                                      iteminfo::is_decimal | iteminfo::lower_is_better,
-                                      static_cast<double>( price_postapoc ) / 100 ) );
+        // Prices add up the contents, only worked out if shown
+        if( parts->test( iteminfo_parts::BASE_PRICE ) || parts->test( iteminfo_parts::BASE_BARTER ) ) {
+            const int price_preapoc = price( false ) * batch;
+            const int price_postapoc = price( true ) * batch;
+            if( parts->test( iteminfo_parts::BASE_PRICE ) ) {
+                info.push_back( iteminfo( "BASE", space + _( "Price: " ), _( "$<num>" ),
+                                          iteminfo::is_decimal | iteminfo::lower_is_better,
+                                          static_cast<double>( price_preapoc ) / 100 ) );
+            }
+            if( price_preapoc != price_postapoc && parts->test( iteminfo_parts::BASE_BARTER ) ) {
+                info.push_back( iteminfo( "BASE", _( "Barter value: " ), _( "$<num>" ),
+                                          iteminfo::is_decimal | iteminfo::lower_is_better,
+                                          static_cast<double>( price_postapoc ) / 100 ) );
+            }
         }
 
         int converted_volume_scale = 0;
@@ -1163,7 +1166,7 @@ std::string item::info( std::vector<iteminfo> &info, const iteminfo_query *parts
             if( type->min_per > 0 ) {
                 req.push_back( string_format( "%s %d", _( "perception" ), type->min_per ) );
             }
-            for( const std::pair<skill_id, int> &sk : type->min_skills ) {
+            for( const std::pair<const skill_id, int> &sk : type->min_skills ) {
                 req.push_back( string_format( "%s %d", skill_id( sk.first )->name(), sk.second ) );
             }
             if( !req.empty() ) {
@@ -1724,7 +1727,7 @@ std::string item::info( std::vector<iteminfo> &info, const iteminfo_query *parts
 
         if( parts->test( iteminfo_parts::GUN_FIRE_MODES ) ) {
             std::vector<std::string> fm;
-            for( const std::pair<gun_mode_id, gun_mode> &e : fire_modes ) {
+            for( const std::pair<const gun_mode_id, gun_mode> &e : fire_modes ) {
                 if( e.second.target == this && !e.second.melee() ) {
                     fm.emplace_back( string_format( "%s (%i)", e.second.tname(), e.second.qty ) );
                 }
@@ -2171,23 +2174,29 @@ std::string item::info( std::vector<iteminfo> &info, const iteminfo_query *parts
                 info.push_back( iteminfo( "BOOK", "", fmt, iteminfo::no_flags, unread ) );
             }
 
+            // Looking up which recipes are known is only done if they are shown
+            const bool show_recipes = parts->test( iteminfo_parts::DESCRIPTION_BOOK_RECIPES ) ||
+                                      parts->test( iteminfo_parts::DESCRIPTION_BOOK_ADDITIONAL_RECIPES );
             std::vector<std::string> recipe_list;
-            for( const islot_book::recipe_with_description_t &elem : book.recipes ) {
-                const bool knows_it = g->u.knows_recipe( elem.recipe );
-                const bool can_learn = g->u.get_skill_level( elem.recipe->skill_used )  >= elem.skill_level;
-                // If the player knows it, they recognize it even if it's not clearly stated.
-                if( elem.is_hidden() && !knows_it ) {
-                    continue;
-                }
-                if( knows_it ) {
-                    // In case the recipe is known, but has a different name in the book, use the
-                    // real name to avoid confusing the player.
-                    const std::string name = elem.recipe->result_name();
-                    recipe_list.push_back( "<bold>" + name + "</bold>" );
-                } else if( !can_learn ) {
-                    recipe_list.push_back( "<color_brown>" + elem.name + "</color>" );
-                } else {
-                    recipe_list.push_back( "<dark>" + elem.name + "</dark>" );
+            if( show_recipes ) {
+                for( const islot_book::recipe_with_description_t &elem : book.recipes ) {
+                    const bool knows_it = g->u.knows_recipe( elem.recipe );
+                    const bool can_learn = g->u.get_skill_level( elem.recipe->skill_used ) >=
+                                           elem.skill_level;
+                    // If the player knows it, they recognize it even if it's not clearly stated.
+                    if( elem.is_hidden() && !knows_it ) {
+                        continue;
+                    }
+                    if( knows_it ) {
+                        // In case the recipe is known, but has a different name in the book, use the
+                        // real name to avoid confusing the player.
+                        const std::string name = elem.recipe->result_name();
+                        recipe_list.push_back( "<bold>" + name + "</bold>" );
+                    } else if( !can_learn ) {
+                        recipe_list.push_back( "<color_brown>" + elem.name + "</color>" );
+                    } else {
+                        recipe_list.push_back( "<dark>" + elem.name + "</dark>" );
+                    }
                 }
             }
 
@@ -2202,7 +2211,7 @@ std::string item::info( std::vector<iteminfo> &info, const iteminfo_query *parts
                 info.push_back( iteminfo( "DESCRIPTION", recipe_line ) );
             }
 
-            if( recipe_list.size() != book.recipes.size() &&
+            if( show_recipes && recipe_list.size() != book.recipes.size() &&
                 parts->test( iteminfo_parts::DESCRIPTION_BOOK_ADDITIONAL_RECIPES ) ) {
                 info.push_back( iteminfo(
                                     "DESCRIPTION",
@@ -2307,10 +2316,10 @@ std::string item::info( std::vector<iteminfo> &info, const iteminfo_query *parts
             info.push_back( iteminfo( "DESCRIPTION", string_format( _( "Made from: %s" ),
                                       _( components_to_string() ) ) ) );
         }
-    } else {
+    } else if( parts->test( iteminfo_parts::DESCRIPTION_COMPONENTS_DISASSEMBLE ) ) {
         const recipe &dis = recipe_dictionary::get_uncraft( typeId() );
         const requirement_data &req = dis.disassembly_requirements();
-        if( !req.is_empty() && parts->test( iteminfo_parts::DESCRIPTION_COMPONENTS_DISASSEMBLE ) ) {
+        if( !req.is_empty() ) {
             const requirement_data::alter_item_comp_vector &components = req.get_components();
             const std::string components_list = enumerate_as_string( components.begin(), components.end(),
             []( const std::vector<item_comp> &comps ) {
@@ -2340,7 +2349,7 @@ std::string item::info( std::vector<iteminfo> &info, const iteminfo_query *parts
     };
 
     if( parts->test( iteminfo_parts::QUALITIES ) ) {
-        for( const std::pair<quality_id, int> &q : type->qualities ) {
+        for( const std::pair<const quality_id, int> &q : type->qualities ) {
             name_quality( q );
         }
     }
@@ -2353,14 +2362,14 @@ std::string item::info( std::vector<iteminfo> &info, const iteminfo_query *parts
         info.emplace_back( "QUALITIES", "", _( "Contains items with qualities:" ) );
         std::map<quality_id, int> most_quality;
         for( const item &e : contents ) {
-            for( const std::pair<quality_id, int> &q : e.type->qualities ) {
+            for( const std::pair<const quality_id, int> &q : e.type->qualities ) {
                 auto emplace_result = most_quality.emplace( q );
                 if( !emplace_result.second && most_quality.at( emplace_result.first->first ) < q.second ) {
                     most_quality[ q.first ] = q.second;
                 }
             }
         }
-        for( const std::pair<quality_id, int> &q : most_quality ) {
+        for( const std::pair<const quality_id, int> &q : most_quality ) {
             name_quality( q );
         }
     }
@@ -2474,7 +2483,7 @@ std::string item::info( std::vector<iteminfo> &info, const iteminfo_query *parts
         }
 
         if( parts->test( iteminfo_parts::DESCRIPTION_USE_METHODS ) ) {
-            for( const std::pair<std::string, use_function> &method : type->use_methods ) {
+            for( const std::pair<const std::string, use_function> &method : type->use_methods ) {
                 insert_separation_line();
                 method.second.dump_info( *this, info );
             }
@@ -2933,10 +2942,12 @@ std::string item::info( std::vector<iteminfo> &info, const iteminfo_query *parts
         } else { // use the contained item
             tid = contents.front().typeId();
         }
-        const std::set<const recipe *> &known_recipes = g->u.get_learned_recipes().of_component( tid );
-        if( !known_recipes.empty() && parts->test( iteminfo_parts::DESCRIPTION_APPLICABLE_RECIPES ) ) {
+        static const std::set<const recipe *> no_recipes;
+        const std::set<const recipe *> &known_recipes =
+            parts->test( iteminfo_parts::DESCRIPTION_APPLICABLE_RECIPES ) ?
+            g->u.get_learned_recipes().of_component( tid ) : no_recipes;
+        if( !known_recipes.empty() ) {
             temp1.str( "" );
-            const inventory &inv = g->u.crafting_inventory();
 
             if( known_recipes.size() > 24 ) {
                 insert_separation_line();
@@ -2946,6 +2957,8 @@ std::string item::info( std::vector<iteminfo> &info, const iteminfo_query *parts
                 insert_separation_line();
                 info.push_back( iteminfo( "DESCRIPTION", _( "You could use it to craft various other things." ) ) );
             } else {
+                // Gathering what is around is costly, only the short list needs it
+                const inventory &inv = g->u.crafting_inventory();
                 const std::string recipes = enumerate_as_string( known_recipes.begin(), known_recipes.end(),
                 [ &inv ]( const recipe * r ) {
                     if( r->requirements().can_make_with_inventory( inv, r->get_component_filter() ) ) {
@@ -2978,7 +2991,7 @@ std::map<gunmod_location, int> item::get_mod_locations() const
         if( !mod->type->gunmod->add_mod.empty() ) {
             std::map<gunmod_location, int> add_locations = mod->type->gunmod->add_mod;
 
-            for( const std::pair<gunmod_location, int> &add_location : add_locations ) {
+            for( const std::pair<const gunmod_location, int> &add_location : add_locations ) {
                 mod_locations[add_location.first] += add_location.second;
             }
         }
@@ -3029,7 +3042,7 @@ nc_color item::color_in_inventory() const
         const use_function *iuse = get_use( "learn_spell" );
         const learn_spell_actor *actor_ptr =
             static_cast<const learn_spell_actor *>( iuse->get_actor_ptr() );
-        for( const std::string spell_id_str : actor_ptr->spells ) {
+        for( const std::string &spell_id_str : actor_ptr->spells ) {
             const spell_id sp_id( spell_id_str );
             if( u.magic.knows_spell( sp_id ) && !u.magic.get_spell( sp_id ).is_max_level() ) {
                 ret = c_yellow;
@@ -3715,12 +3728,18 @@ int item::price( bool practical ) const
 // TODO: MATERIALS add a density field to materials.json
 units::mass item::weight( bool include_contents, bool integral ) const
 {
+    // Called for every item in every container whenever a character's load is summed.
+    static const std::string flag_NO_DROP( "NO_DROP" );
+    static const std::string flag_REDUCED_WEIGHT( "REDUCED_WEIGHT" );
+    static const std::string var_integral_weight( "integral_weight" );
+    static const std::string var_weight( "weight" );
+
     if( is_null() ) {
         return 0_gram;
     }
 
     // Items that don't drop aren't really there, they're items just for ease of implementation
-    if( has_flag( "NO_DROP" ) ) {
+    if( has_flag( flag_NO_DROP ) ) {
         return 0_gram;
     }
 
@@ -3734,12 +3753,12 @@ units::mass item::weight( bool include_contents, bool integral ) const
 
     units::mass ret;
     if( integral ) {
-        ret = units::from_gram( get_var( "integral_weight", to_gram( type->integral_weight ) ) );
+        ret = units::from_gram( get_var( var_integral_weight, to_gram( type->integral_weight ) ) );
     } else {
-        ret = units::from_gram( get_var( "weight", to_gram( type->weight ) ) );
+        ret = units::from_gram( get_var( var_weight, to_gram( type->weight ) ) );
     }
 
-    if( has_flag( "REDUCED_WEIGHT" ) ) {
+    if( has_flag( flag_REDUCED_WEIGHT ) ) {
         ret *= 0.75;
     }
 
@@ -3868,7 +3887,9 @@ units::volume item::volume( bool integral ) const
         return ret;
     }
 
-    const int local_volume = get_var( "volume", -1 );
+    static const std::string var_volume( "volume" );
+
+    const int local_volume = get_var( var_volume, -1 );
     units::volume ret;
     if( local_volume >= 0 ) {
         ret = local_volume * units::legacy_volume_factor;
@@ -3900,8 +3921,8 @@ units::volume item::volume( bool integral ) const
     }
 
     // Some magazines sit (partly) flush with the item so add less extra volume
-    if( magazine_current() != nullptr ) {
-        ret += std::max( magazine_current()->volume() - type->magazine_well, 0_ml );
+    if( const item *mag = magazine_current() ) {
+        ret += std::max( mag->volume() - type->magazine_well, 0_ml );
     }
 
     if( is_gun() ) {
@@ -3912,7 +3933,7 @@ units::volume item::volume( bool integral ) const
         // TODO: implement stock_length property for guns
         if( has_flag( "COLLAPSIBLE_STOCK" ) ) {
             // consider only the base size of the gun (without mods)
-            int tmpvol = get_var( "volume",
+            int tmpvol = get_var( var_volume,
                                   ( type->volume - type->gun->barrel_length ) / units::legacy_volume_factor );
             if( tmpvol <= 3 ) {
                 // intentional NOP
@@ -3984,7 +4005,7 @@ int item::damage_melee( damage_type dt ) const
     // consider any melee gunmods
     if( is_gun() ) {
         std::vector<int> opts = { res };
-        for( const std::pair<gun_mode_id, gun_mode> &e : gun_all_modes() ) {
+        for( const std::pair<const gun_mode_id, gun_mode> &e : gun_all_modes() ) {
             if( e.second.target != this && e.second.melee() ) {
                 opts.push_back( e.second.target->damage_melee( dt ) );
             }
@@ -4027,7 +4048,7 @@ int item::reach_range( const player &p ) const
 
     // for guns consider any attached gunmods
     if( is_gun() && !is_gunmod() ) {
-        for( const std::pair<gun_mode_id, gun_mode> &m : gun_all_modes() ) {
+        for( const std::pair<const gun_mode_id, gun_mode> &m : gun_all_modes() ) {
             if( p.is_npc() && m.second.flags.count( "NPC_AVOID" ) ) {
                 continue;
             }
@@ -4054,7 +4075,9 @@ bool item::has_flag( const std::string &f ) const
 {
     bool ret = false;
 
-    if( json_flag::get( f ).inherit() ) {
+    // Inherited flags can only come from installed mods, so items without
+    // contents skip the flag definition lookup entirely.
+    if( !contents.empty() && json_flag::get( f ).inherit() ) {
         for( const item *e : is_gun() ? gunmods() : toolmods() ) {
             // gunmods fired separately do not contribute to base gun flags
             if( !e->is_gun() && e->has_flag( f ) ) {
@@ -4152,7 +4175,7 @@ int item::get_quality( const quality_id &id ) const
         return INT_MIN;
     }
 
-    for( const std::pair<quality_id, int> &quality : type->qualities ) {
+    for( const std::pair<const quality_id, int> &quality : type->qualities ) {
         if( quality.first == id ) {
             return_quality = quality.second;
         }
@@ -6518,7 +6541,7 @@ std::map<gun_mode_id, gun_mode> item::gun_all_modes() const
 gun_mode item::gun_get_mode( const gun_mode_id &mode ) const
 {
     if( is_gun() ) {
-        for( const std::pair<gun_mode_id, gun_mode> &e : gun_all_modes() ) {
+        for( const std::pair<const gun_mode_id, gun_mode> &e : gun_all_modes() ) {
             if( e.first == mode ) {
                 return e.second;
             }
@@ -7719,10 +7742,17 @@ void item::process_temperature_rot( float insulation, const tripoint &pos,
             local_mod += 5; // body heat increases inventory temperature
         }
 
+        // Underground and in root cellars the environment temperature never changes,
+        // so everything older than the heat simulation window can be done in one step.
+        const bool constant_environment = pos.z < 0 || flag == TEMP_ROOT_CELLAR;
+
         // Process the past of this item since the last time it was processed
         while( time < now - 1_hours ) {
             // Get the enviroment temperature
             time_duration time_delta = std::min( 1_hours, now - 1_hours - time );
+            if( constant_environment && now - time > 2_days + 2_hours ) {
+                time_delta = now - 2_days - 1_hours - time;
+            }
             time += time_delta;
 
             //Use weather if above ground, use map temp if below
@@ -2807,7 +2807,7 @@ void item_group::debug_spawn()
 
 bool Item_factory::has_template( const itype_id &id ) const
 {
-    return m_templates.count( id ) || m_runtimes.count( id );
+    return m_templates.find( id ) != m_templates.end() || m_runtimes.find( id ) != m_runtimes.end();
 }
 
 std::vector<const itype *> Item_factory::all() const
@@ -248,7 +248,8 @@ class Item_factory
 
         std::unordered_map<itype_id, itype> m_templates;
 
-        mutable std::map<itype_id, std::unique_ptr<itype>> m_runtimes;
+        /** Generated on demand for ids without a definition; looked up right after m_templates */
+        mutable std::unordered_map<itype_id, std::unique_ptr<itype>> m_runtimes;
 
         using GroupMap = std::map<Group_tag, std::unique_ptr<Item_spawn_data>>;
         GroupMap m_template_groups;
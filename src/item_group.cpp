@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <list>
 #include <set>
 
@@ -63,7 +64,8 @@ item Single_item_creator::create_single( const time_point &birthday, RecursionLi
     } else if( type == S_NONE ) {
         return item( null_item_id, birthday );
     }
-    if( one_in( 3 ) && tmp.has_flag( "VARSIZE" ) ) {
+    static const std::string varsize( "VARSIZE" );
+    if( one_in( 3 ) && tmp.has_flag( varsize ) ) {
         tmp.item_tags.insert( "FIT" );
     }
     if( modifier ) {
@@ -86,9 +88,9 @@ Item_spawn_data::ItemList Single_item_creator::create( const time_point &birthda
     }
     for( ; cnt > 0; cnt-- ) {
         if( type == S_ITEM ) {
-            const auto itm = create_single( birthday, rec );
+            item itm = create_single( birthday, rec );
             if( !itm.is_null() ) {
-                result.push_back( itm );
+                result.push_back( std::move( itm ) );
             }
         } else {
             if( std::find( rec.begin(), rec.end(), id ) != rec.end() ) {
@@ -108,7 +110,8 @@ Item_spawn_data::ItemList Single_item_creator::create( const time_point &birthda
                     modifier->modify( elem );
                 }
             }
-            result.insert( result.end(), tmplist.begin(), tmplist.end() );
+            result.insert( result.end(), std::make_move_iterator( tmplist.begin() ),
+                           std::make_move_iterator( tmplist.end() ) );
         }
     }
     return result;
@@ -384,7 +387,8 @@ Item_spawn_data::ItemList Item_group::create( const time_point &birthday, Recurs
                 continue;
             }
             ItemList tmp = ( elem )->create( birthday, rec );
-            result.insert( result.end(), tmp.begin(), tmp.end() );
+            result.insert( result.end(), std::make_move_iterator( tmp.begin() ),
+                           std::make_move_iterator( tmp.end() ) );
         }
     } else if( type == G_DISTRIBUTION ) {
         int p = rng( 0, sum_prob - 1 );
@@ -394,7 +398,8 @@ Item_spawn_data::ItemList Item_group::create( const time_point &birthday, Recurs
                 continue;
             }
             ItemList tmp = ( elem )->create( birthday, rec );
-            result.insert( result.end(), tmp.begin(), tmp.end() );
+            result.insert( result.end(), std::make_move_iterator( tmp.begin() ),
+                           std::make_move_iterator( tmp.end() ) );
             break;
         }
     }
@@ -80,14 +80,20 @@ JsonObject::JsonObject( JsonIn &j )
     while( !jsin->end_object() ) {
         std::string n = jsin->get_member_name();
         int p = jsin->tell();
-        // FIXME: Fix corrupted bionic power data loading (see #31627). Temporary.
-        if( n != "//" && n != "comment" && n != "power_level" && n != "max_power_level" &&
-            positions.count( n ) > 0 ) {
+        const auto found = std::find_if( positions.begin(), positions.end(),
+        [&n]( const std::pair<std::string, int> &member ) {
+            return member.first == n;
+        } );
+        if( found == positions.end() ) {
+            positions.emplace_back( std::move( n ), p );
+        } else if( n != "//" && n != "comment" && n != "power_level" && n != "max_power_level" ) {
+            // FIXME: Fix corrupted bionic power data loading (see #31627). Temporary.
             // members with name "//" or "comment" are used for comments and
             // should be ignored anyway.
             j.error( "duplicate entry in json object" );
+        } else {
+            found->second = p;
         }
-        positions[n] = p;
         jsin->skip_value();
     }
     end = jsin->tell();
@@ -122,10 +128,20 @@ bool JsonObject::empty()
     return positions.empty();
 }
 
+int JsonObject::find_position( const std::string &name ) const
+{
+    for( const std::pair<std::string, int> &member : positions ) {
+        if( member.first == name ) {
+            return member.second;
+        }
+    }
+    return 0;
+}
+
 int JsonObject::verify_position( const std::string &name,
                                  const bool throw_exception )
 {
-    int pos = positions[name]; // initialized to 0 if it doesn't exist
+    int pos = find_position( name );
     if( pos > start ) {
         return pos;
     } else if( throw_exception && !jsin ) {
@@ -210,7 +226,7 @@ bool JsonObject::get_bool( const std::string &name )
 
 bool JsonObject::get_bool( const std::string &name, const bool fallback )
 {
-    int pos = positions[name];
+    int pos = find_position( name );
     if( pos <= start ) {
         return fallback;
     }
@@ -227,7 +243,7 @@ int JsonObject::get_int( const std::string &name )
 
 int JsonObject::get_int( const std::string &name, const int fallback )
 {
-    int pos = positions[name];
+    int pos = find_position( name );
     if( pos <= start ) {
         return fallback;
     }
@@ -244,7 +260,7 @@ double JsonObject::get_float( const std::string &name )
 
 double JsonObject::get_float( const std::string &name, const double fallback )
 {
-    int pos = positions[name];
+    int pos = find_position( name );
     if( pos <= start ) {
         return fallback;
     }
@@ -261,7 +277,7 @@ std::string JsonObject::get_string( const std::string &name )
 
 std::string JsonObject::get_string( const std::string &name, const std::string &fallback )
 {
-    int pos = positions[name];
+    int pos = find_position( name );
     if( pos <= start ) {
         return fallback;
     }
@@ -273,7 +289,7 @@ std::string JsonObject::get_string( const std::string &name, const std::string &
 
 JsonArray JsonObject::get_array( const std::string &name )
 {
-    int pos = positions[name];
+    int pos = find_position( name );
     if( pos <= start ) {
         return JsonArray(); // empty array
     }
@@ -303,7 +319,7 @@ std::vector<std::string> JsonObject::get_string_array( const std::string &name )
 
 JsonObject JsonObject::get_object( const std::string &name )
 {
-    int pos = positions[name];
+    int pos = find_position( name );
     if( pos <= start ) {
         return JsonObject(); // empty object
     }
@@ -689,8 +705,15 @@ void JsonIn::seek( int pos )
 
 void JsonIn::eat_whitespace()
 {
-    while( is_whitespace( peek() ) ) {
-        stream->get();
+    // Straight from the stream buffer, istream::get and peek set up a sentry for every char.
+    std::streambuf *buf = stream->rdbuf();
+    int ch = buf->sgetc();
+    while( ch != EOF && is_whitespace( static_cast<char>( ch ) ) ) {
+        ch = buf->snextc();
+    }
+    if( ch == EOF ) {
+        // Like peek would.
+        stream->setstate( std::ios::eofbit );
     }
 }
 
@@ -918,7 +941,30 @@ std::string JsonIn::get_string()
     }
     // add chars to the string, one at a time, converting:
     // \", \\, \/, \b, \f, \n, \r, \t and \uxxxx according to JSON spec.
+    std::streambuf *buf = stream->rdbuf();
     while( stream->good() ) {
+        // Runs of plain characters are copied straight from the stream buffer, only escapes,
+        // control characters and the closing quote go through the checks below.
+        if( !backslash ) {
+            // Collected in a local chunk, appending to s char by char is much slower
+            char run[256];
+            size_t run_size = 0;
+            int next = buf->sgetc();
+            while( next != EOF && next != '\\' && next != '"' &&
+                   static_cast<unsigned char>( next ) >= 0x20 ) {
+                run[run_size++] = static_cast<char>( next );
+                if( run_size == sizeof( run ) ) {
+                    s.append( run, run_size );
+                    run_size = 0;
+                }
+                next = buf->snextc();
+            }
+            s.append( run, run_size );
+            if( next == EOF ) {
+                stream->setstate( std::ios::eofbit | std::ios::failbit );
+                break;
+            }
+        }
         stream->get( ch );
         if( ch == '\\' ) {
             if( backslash ) {
@@ -1000,66 +1046,72 @@ std::int64_t JsonIn::get_int64()
 double JsonIn::get_float()
 {
     // this could maybe be prettier?
-    char ch;
+    // Digits are read straight from the stream buffer, ch always holds the next unread character.
     bool neg = false;
     int i = 0;
     int e = 0;
     int mod_e = 0;
     eat_whitespace();
-    stream->get( ch );
+    std::streambuf *buf = stream->rdbuf();
+    int ch = buf->sgetc();
+    const auto is_digit = []( const int c ) {
+        return c >= '0' && c <= '9';
+    };
     if( ch == '-' ) {
         neg = true;
-        stream->get( ch );
-    } else if( ch != '.' && ( ch < '0' || ch > '9' ) ) {
+        ch = buf->snextc();
+    } else if( ch != '.' && !is_digit( ch ) ) {
         // not a valid float
         std::stringstream err;
-        err << "expecting number but found '" << ch << "'";
-        error( err.str(), -1 );
+        err << "expecting number but found '" << static_cast<char>( ch ) << "'";
+        error( err.str() );
     }
     if( ch == '0' ) {
         // allow a single leading zero in front of a '.' or 'e'/'E'
-        stream->get( ch );
-        if( ch >= '0' && ch <= '9' ) {
-            error( "leading zeros not strictly allowed", -1 );
+        ch = buf->snextc();
+        if( is_digit( ch ) ) {
+            error( "leading zeros not strictly allowed" );
         }
     }
-    while( ch >= '0' && ch <= '9' ) {
+    while( is_digit( ch ) ) {
         i *= 10;
         i += ( ch - '0' );
-        stream->get( ch );
+        ch = buf->snextc();
     }
     if( ch == '.' ) {
-        stream->get( ch );
-        while( ch >= '0' && ch <= '9' ) {
+        ch = buf->snextc();
+        while( is_digit( ch ) ) {
             i *= 10;
             i += ( ch - '0' );
             mod_e -= 1;
-            stream->get( ch );
+            ch = buf->snextc();
         }
     }
     if( neg ) {
         i *= -1;
     }
     if( ch == 'e' || ch == 'E' ) {
-        stream->get( ch );
+        ch = buf->snextc();
         neg = false;
         if( ch == '-' ) {
             neg = true;
-            stream->get( ch );
+            ch = buf->snextc();
         } else if( ch == '+' ) {
-            stream->get( ch );
+            ch = buf->snextc();
         }
-        while( ch >= '0' && ch <= '9' ) {
+        while( is_digit( ch ) ) {
             e *= 10;
             e += ( ch - '0' );
-            stream->get( ch );
+            ch = buf->snextc();
         }
         if( neg ) {
             e *= -1;
         }
     }
-    // unget the final non-number character (probably a separator)
-    stream->unget();
+    if( ch == EOF ) {
+        stream->setstate( std::ios::eofbit );
+    }
+    // the final non-number character (probably a separator) is left in the stream
     end_value();
     // now put it all together!
     return i * std::pow( 10.0f, e + mod_e );
@@ -1662,15 +1714,19 @@ void JsonOut::write( const std::string &val )
         write_separator();
     }
     stream->put( '"' );
+    // Characters that need no escaping are written in runs, most strings are a single run.
+    const char *run_start = val.data();
     for( const auto &i : val ) {
         unsigned char ch = i;
+        if( ch >= 0x20 && ch != '"' && ch != '\\' ) {
+            continue;
+        }
+        stream->write( run_start, &i - run_start );
+        run_start = &i + 1;
         if( ch == '"' ) {
             stream->write( "\\\"", 2 );
         } else if( ch == '\\' ) {
             stream->write( "\\\\", 2 );
-        } else if( ch == '/' ) {
-            // don't technically need to escape this
-            stream->put( '/' );
         } else if( ch == '\b' ) {
             stream->write( "\\b", 2 );
         } else if( ch == '\f' ) {
@@ -1691,14 +1747,27 @@ void JsonOut::write( const std::string &val )
             } else {
                 stream->put( 'A' + ( remainder - 0x0A ) );
             }
-        } else {
-            stream->put( ch );
         }
     }
+    stream->write( run_start, val.data() + val.size() - run_start );
     stream->put( '"' );
     need_separator = true;
 }
 
+void JsonOut::write_integer( unsigned long long val, bool negative )
+{
+    char digits[24];
+    char *start = std::end( digits );
+    do {
+        *--start = static_cast<char>( '0' + val % 10 );
+        val /= 10;
+    } while( val != 0 );
+    if( negative ) {
+        *--start = '-';
+    }
+    stream->write( start, std::end( digits ) - start );
+}
+
 template<size_t N>
 void JsonOut::write( const std::bitset<N> &b )
 {
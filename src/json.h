@@ -12,6 +12,7 @@
 #include <map>
 #include <set>
 #include <stdexcept>
+#include <utility>
 
 #include "colony.h"
 #include "enum_conversions.h"
@@ -536,6 +537,27 @@ class JsonOut
         int indent_level = 0;
         bool need_separator = false;
 
+        void write_integer( unsigned long long val, bool negative );
+
+        // Integers are formatted by write_integer, anything else by the stream.
+        template < typename T, typename std::enable_if < std::is_integral<T>::value &&
+                   std::is_signed<T>::value, int >::type = 0 >
+        void write_value( T val ) {
+            // Negated as unsigned, so the most negative value works too.
+            write_integer( val < 0 ? 0ULL - static_cast<unsigned long long>( val ) :
+                           static_cast<unsigned long long>( val ), val < 0 );
+        }
+        template < typename T, typename std::enable_if < std::is_integral<T>::value &&
+                   !std::is_signed<T>::value && !std::is_same<T, bool>::value, int >::type = 0 >
+        void write_value( T val ) {
+            write_integer( val, false );
+        }
+        template < typename T, typename std::enable_if < !std::is_integral<T>::value ||
+                   std::is_same<T, bool>::value, int >::type = 0 >
+        void write_value( T val ) {
+            *stream << val;
+        }
+
     public:
         JsonOut( std::ostream &stream, bool pretty_print = false, int depth = 0 );
         JsonOut( const JsonOut & ) = delete;
@@ -572,7 +594,7 @@ class JsonOut
             if( need_separator ) {
                 write_separator();
             }
-            *stream << val;
+            write_value( val );
             need_separator = true;
         }
 
@@ -762,11 +784,15 @@ class JsonOut
 class JsonObject
 {
     private:
-        std::map<std::string, int> positions;
+        // Each member's name and where its value starts, in the order they appear.
+        // Objects have few members, scanning them in order is faster than a tree lookup.
+        std::vector<std::pair<std::string, int>> positions;
         int start;
         int end;
         bool final_separator;
         JsonIn *jsin;
+        // 0 if there's no such member, which is never a valid position.
+        int find_position( const std::string &name ) const;
         int verify_position( const std::string &name,
                              bool throw_exception = true );
 
@@ -852,7 +878,7 @@ class JsonObject
         // but the read fails.
         template <typename T>
         bool read( const std::string &name, T &t, bool throw_on_error = true ) {
-            int pos = positions[name];
+            int pos = find_position( name );
             if( pos <= start ) {
                 return false;
             }
@@ -1053,7 +1079,7 @@ template <typename T>
 std::set<T> JsonObject::get_tags( const std::string &name )
 {
     std::set<T> res;
-    int pos = positions[ name ];
+    int pos = find_position( name );
     if( pos <= start ) {
         return res;
     }
@@ -28,6 +28,7 @@ class kill_tracker : public event_subscriber
 
         void clear();
 
+        bool wants_event( event_type ) const override;
         void notify( const cata::event & ) override;
 
         void serialize( JsonOut & ) const;
@@ -33,6 +33,7 @@
 #include "player.h"
 #include "string_formatter.h"
 #include "tileray.h"
+#include "turn_profile.h"
 #include "type_id.h"
 #include "colony.h"
 #include "item_stack.h"
@@ -80,21 +81,28 @@ bool map::build_transparency_cache( const int zlev )
     auto &transparency_cache = map_cache.transparency_cache;
     auto &outside_cache = map_cache.outside_cache;
 
-    if( !map_cache.transparency_cache_dirty ) {
+    if( map_cache.transparency_cache_dirty.none() ) {
         return false;
     }
 
-    // Default to just barely not transparent.
-    std::uninitialized_fill_n(
-        &transparency_cache[0][0], MAPSIZE_X * MAPSIZE_Y,
-        static_cast<float>( LIGHT_TRANSPARENCY_OPEN_AIR ) );
-
     const float sight_penalty = weather::sight_penalty( g->weather.weather );
+    // Whether any rebuilt submap ended up different from what was cached before.
+    bool changed = false;
 
     // Traverse the submaps in order
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
-            const auto cur_submap = get_submap_at_grid( {smx, smy, zlev} );
+            if( !map_cache.transparency_cache_dirty[smx + smy * MAPSIZE] ) {
+                continue;
+            }
+            float old_values[SEEX][SEEY];
+            for( int sx = 0; sx < SEEX; ++sx ) {
+                float *const column = &transparency_cache[sx + smx * SEEX][smy * SEEY];
+                std::copy_n( column, SEEY, old_values[sx] );
+                // Default to just barely not transparent.
+                std::uninitialized_fill_n( column, SEEY, static_cast<float>( LIGHT_TRANSPARENCY_OPEN_AIR ) );
+            }
+            const submap *const cur_submap = get_submap_at_grid( {smx, smy, zlev} );
 
             float zero_value = LIGHT_TRANSPARENCY_OPEN_AIR;
             for( int sx = 0; sx < SEEX; ++sx ) {
@@ -115,7 +123,7 @@ bool map::build_transparency_cache( const int zlev )
                         continue;
                     }
 
-                    if( outside_cache[x][y] ) {
+                    if( outside_cache.get( { x, y } ) ) {
                         // FIXME: Places inside vehicles haven't been marked as
                         // inside yet so this is incorrectly penalising for
                         // weather in vehicles.
@@ -139,9 +147,19 @@ bool map::build_transparency_cache( const int zlev )
                     // TODO: [lightmap] Have glass reduce light as well
                 }
             }
+            for( int sx = 0; sx < SEEX && !changed; ++sx ) {
+                changed = !std::equal( old_values[sx], old_values[sx] + SEEY,
+                                       &transparency_cache[sx + smx * SEEX][smy * SEEY] );
+            }
         }
     }
-    map_cache.transparency_cache_dirty = false;
+    map_cache.transparency_cache_dirty.reset();
+    // Most rebuilds are caused by fields being processed without changing anything,
+    // so let everything derived from this cache keep its results in that case.
+    if( !changed ) {
+        return false;
+    }
+    map_cache.transparency_cache_version++;
     return true;
 }
 
@@ -181,7 +199,7 @@ void map::build_sunlight_cache( int zlev )
         const auto &outside_cache = map_cache.outside_cache;
         for( int x = 0; x < MAPSIZE_X; x++ ) {
             for( int y = 0; y < MAPSIZE_Y; y++ ) {
-                if( outside_cache[x][y] ) {
+                if( outside_cache.get( { x, y } ) ) {
                     lm[x][y].fill( outside_light_level );
                 } else {
                     lm[x][y].fill( inside_light_level );
@@ -211,30 +229,46 @@ void map::build_sunlight_cache( int zlev )
     const auto &prev_floor_cache = prev_map_cache.floor_cache;
     const auto &outside_cache = map_cache.outside_cache;
     const float sight_penalty = weather::sight_penalty( g->weather.weather );
-    for( int x = 0, prev_x = offset.x; x < MAPSIZE_X; x++, prev_x++ ) {
-        bool x_inbounds = prev_x >= 0 && prev_x < MAPSIZE_X;
-        for( int y = 0, prev_y = offset.y; y < MAPSIZE_Y; y++, prev_y++ ) {
-            bool inbounds = x_inbounds && prev_y >= 0 && prev_y < MAPSIZE_Y;
-            four_quadrants prev_light( outside_light_level );
-            float prev_transparency = static_cast<float>( LIGHT_TRANSPARENCY_OPEN_AIR );
-            if( inbounds ) {
-                prev_light = prev_lm[ prev_x ][ prev_y ];
-                prev_transparency = prev_transparency_cache[ prev_x ][ prev_y ];
-                // This is pretty gross, this cancels out the per-tile transparency effect
-                // derived from weather.
-                if( outside_cache[x][y] ) {
-                    prev_transparency /= sight_penalty;
+    for( int smx = 0; smx < MAPSIZE; smx++ ) {
+        for( int smy = 0; smy < MAPSIZE; smy++ ) {
+            const size_t sm = smx + smy * MAPSIZE;
+            // Without an outside tile below or a hole in the floor above, no sunlight gets in.
+            if( !map_cache.submap_has_outside[sm] || prev_map_cache.submap_fully_floored[sm] ) {
+                for( int x = smx * SEEX; x < ( smx + 1 ) * SEEX; x++ ) {
+                    for( int y = smy * SEEY; y < ( smy + 1 ) * SEEY; y++ ) {
+                        lm[x][y].fill( inside_light_level );
+                    }
                 }
+                continue;
             }
-            // The formula to apply transparency to the light rays doesn't handle full opacity,
-            // so handle that seperately.
-            if( prev_transparency > LIGHT_TRANSPARENCY_SOLID &&
-                !prev_floor_cache[x][y] && prev_light.max() > 0.0 && outside_cache[x][y] ) {
-                lm[x][y].fill( std::max( inside_light_level,
-                                         prev_light.max() * static_cast<float>( LIGHT_TRANSPARENCY_OPEN_AIR )
-                                         / prev_transparency ) );
-            } else {
-                lm[x][y].fill( inside_light_level );
+            for( int x = smx * SEEX; x < ( smx + 1 ) * SEEX; x++ ) {
+                const int prev_x = x + offset.x;
+                bool x_inbounds = prev_x >= 0 && prev_x < MAPSIZE_X;
+                for( int y = smy * SEEY; y < ( smy + 1 ) * SEEY; y++ ) {
+                    const int prev_y = y + offset.y;
+                    bool inbounds = x_inbounds && prev_y >= 0 && prev_y < MAPSIZE_Y;
+                    four_quadrants prev_light( outside_light_level );
+                    float prev_transparency = static_cast<float>( LIGHT_TRANSPARENCY_OPEN_AIR );
+                    if( inbounds ) {
+                        prev_light = prev_lm[ prev_x ][ prev_y ];
+                        prev_transparency = prev_transparency_cache[ prev_x ][ prev_y ];
+                        // This is pretty gross, this cancels out the per-tile transparency effect
+                        // derived from weather.
+                        if( outside_cache.get( { x, y } ) ) {
+                            prev_transparency /= sight_penalty;
+                        }
+                    }
+                    // The formula to apply transparency to the light rays doesn't handle full opacity,
+                    // so handle that seperately.
+                    if( prev_transparency > LIGHT_TRANSPARENCY_SOLID &&
+                        !prev_floor_cache[x][y] && prev_light.max() > 0.0 && outside_cache.get( { x, y } ) ) {
+                        lm[x][y].fill( std::max( inside_light_level,
+                                                 prev_light.max() * static_cast<float>( LIGHT_TRANSPARENCY_OPEN_AIR )
+                                                 / prev_transparency ) );
+                    } else {
+                        lm[x][y].fill( inside_light_level );
+                    }
+                }
             }
         }
     }
@@ -242,12 +276,14 @@ void map::build_sunlight_cache( int zlev )
 
 void map::generate_lightmap( const int zlev )
 {
+    turn_profile::phase timer( "lightmap" );
     auto &map_cache = get_cache( zlev );
     auto &lm = map_cache.lm;
     auto &sm = map_cache.sm;
     auto &outside_cache = map_cache.outside_cache;
     std::memset( lm, 0, sizeof( lm ) );
     std::memset( sm, 0, sizeof( sm ) );
+    map_cache.light_cache_version++;
 
     /* Bulk light sources wastefully cast rays into neighbors; a burning hospital can produce
          significant slowdown, so for stuff like fire and lava:
@@ -287,7 +323,7 @@ void map::generate_lightmap( const int zlev )
     // Traverse the submaps in order
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
-            const auto cur_submap = get_submap_at_grid( { smx, smy, zlev } );
+            const submap *const cur_submap = get_submap_at_grid( { smx, smy, zlev } );
 
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
@@ -295,12 +331,12 @@ void map::generate_lightmap( const int zlev )
                     const int y = sy + smy * SEEY;
                     const tripoint p( x, y, zlev );
                     // Project light into any openings into buildings.
-                    if( !outside_cache[p.x][p.y] ) {
+                    if( !outside_cache.get( p.xy() ) ) {
                         // Apply light sources for external/internal divide
                         for( int i = 0; i < 4; ++i ) {
                             point neighbour = p.xy() + point( dir_x[i], dir_y[i] );
                             if( lightmap_boundaries.contains_half_open( neighbour )
-                                && outside_cache[neighbour.x][neighbour.y]
+                                && outside_cache.get( neighbour )
                               ) {
                                 if( light_transparency( p ) > LIGHT_TRANSPARENCY_SOLID ) {
                                     update_light_quadrants(
@@ -437,9 +473,31 @@ void map::generate_lightmap( const int zlev )
     */
     const tripoint cache_start( 0, 0, zlev );
     const tripoint cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
-    for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
-        if( light_source_buffer[p.x][p.y] > 0.0 ) {
-            apply_light_source( p, light_source_buffer[p.x][p.y] );
+    /* Lamps, fires and lit terrain mostly stay put from one turn to the next, so keep what they
+      cast and only cast it again when a source or the transparency it was cast through changed.
+      All the light layers are combined by taking the maximum, so the order doesn't matter.
+    */
+    if( !bulk_light || bulk_light->zlev != zlev ||
+        bulk_light->transparency_cache_version != map_cache.transparency_cache_version ||
+        std::memcmp( bulk_light->sources, light_source_buffer, sizeof( light_source_buffer ) ) != 0 ) {
+        if( !bulk_light ) {
+            bulk_light = std::make_unique<bulk_light_cache>();
+        }
+        std::memset( bulk_light->lm, 0, sizeof( bulk_light->lm ) );
+        std::memset( bulk_light->sm, 0, sizeof( bulk_light->sm ) );
+        for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
+            if( light_source_buffer[p.x][p.y] > 0.0 ) {
+                apply_light_source( p, light_source_buffer[p.x][p.y], bulk_light->lm, bulk_light->sm );
+            }
+        }
+        std::memcpy( bulk_light->sources, light_source_buffer, sizeof( light_source_buffer ) );
+        bulk_light->zlev = zlev;
+        bulk_light->transparency_cache_version = map_cache.transparency_cache_version;
+    }
+    for( int x = 0; x < LIGHTMAP_CACHE_X; x++ ) {
+        for( int y = 0; y < LIGHTMAP_CACHE_Y; y++ ) {
+            lm[x][y] = elementwise_max( lm[x][y], bulk_light->lm[x][y] );
+            sm[x][y] = std::max( sm[x][y], bulk_light->sm[x][y] );
         }
     }
 
@@ -706,6 +764,8 @@ void cast_zlight_segment(
         delta.y = distance;
         bool started_block = false;
         T current_transparency = 0.0f;
+        // As in castLight, calc() only depends on the distance within one row.
+        int last_dist = -1;
 
         // TODO: Precalculate min/max delta.z based on start/end and distance
         for( delta.z = 0; delta.z <= distance; delta.z++ ) {
@@ -720,8 +780,13 @@ void cast_zlight_segment(
                 break;
             }
 
-            bool started_span = false;
             const int z_index = current.z + OVERMAP_DEPTH;
+            // Levels without an input are out of range, like the ones beyond the map
+            if( input_arrays[z_index] == nullptr ) {
+                continue;
+            }
+
+            bool started_span = false;
             for( delta.x = 0; delta.x <= distance; delta.x++ ) {
                 current.x = offset.x + delta.x * xx + delta.y * xy + delta.z * xz;
                 current.y = offset.y + delta.x * yx + delta.y * yy + delta.z * yz;
@@ -759,7 +824,10 @@ void cast_zlight_segment(
                 }
 
                 const int dist = rl_dist( tripoint_zero, delta ) + offset_distance;
-                last_intensity = calc( numerator, cumulative_transparency, dist );
+                if( dist != last_dist ) {
+                    last_intensity = calc( numerator, cumulative_transparency, dist );
+                    last_dist = dist;
+                }
 
                 if( !floor_block ) {
                     ( *output_caches[z_index] )[current.x][current.y] =
@@ -969,6 +1037,9 @@ void castLight( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
         delta.y = -distance;
         bool started_row = false;
         T current_transparency = 0.0;
+        // calc() is the costliest part of each step, but while cumulative_transparency is fixed
+        // for the whole row it only depends on the distance, so reuse it between cells.
+        int last_dist = -1;
         float away = start - ( -distance + 0.5f ) / ( -distance -
                      0.5f ); //The distance between our first leadingEdge and start
 
@@ -994,7 +1065,10 @@ void castLight( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
             }
 
             const int dist = rl_dist( tripoint_zero, delta ) + offsetDistance;
-            last_intensity = calc( numerator, cumulative_transparency, dist );
+            if( dist != last_dist ) {
+                last_intensity = calc( numerator, cumulative_transparency, dist );
+                last_dist = dist;
+            }
 
             T new_transparency = input_array[ currentX ][ currentY ];
 
@@ -1075,6 +1149,12 @@ template void castLightAll<float, four_quadrants, sight_calc, sight_check,
                                const float ( &input_array )[MAPSIZE_X][MAPSIZE_Y],
                                const int offsetX, const int offsetY, int offsetDistance, float numerator );
 
+template void castLightAll<float, float, overmap_sight_calc, overmap_sight_check,
+                           update_light, accumulate_transparency>(
+                               float ( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
+                               const float ( &input_array )[MAPSIZE_X][MAPSIZE_Y],
+                               const int offsetX, const int offsetY, int offsetDistance, float numerator );
+
 template void
 castLightAll<fragment_cloud, fragment_cloud, shrapnel_calc, shrapnel_check,
              update_fragment_cloud, accumulate_fragment_cloud>
@@ -1097,10 +1177,12 @@ castLightAll<fragment_cloud, fragment_cloud, shrapnel_calc, shrapnel_check,
  */
 void map::build_seen_cache( const tripoint &origin, const int target_z )
 {
+    turn_profile::phase timer( "seen_cache" );
     auto &map_cache = get_cache( target_z );
     float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.transparency_cache;
     float ( &seen_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.seen_cache;
     float ( &camera_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.camera_cache;
+    seen_cache_version++;
 
     constexpr float light_transparency_solid = LIGHT_TRANSPARENCY_SOLID;
     constexpr int map_dimensions = MAPSIZE_X * MAPSIZE_Y;
@@ -1121,7 +1203,9 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
         std::array<const bool ( * )[MAPSIZE_X][MAPSIZE_Y], OVERMAP_LAYERS> floor_caches;
         for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
             auto &cur_cache = get_cache( z );
-            transparency_caches[z + OVERMAP_DEPTH] = &cur_cache.transparency_cache;
+            // Levels out of the vertical range are left unseen and aren't cast into at all
+            transparency_caches[z + OVERMAP_DEPTH] = std::abs( z - origin.z ) <= fov_3d_z_range ?
+                    &cur_cache.transparency_cache : nullptr;
             seen_caches[z + OVERMAP_DEPTH] = &cur_cache.seen_cache;
             floor_caches[z + OVERMAP_DEPTH] = &cur_cache.floor_cache;
             std::uninitialized_fill_n(
@@ -1219,8 +1303,14 @@ static bool light_check( const float &transparency, const float &intensity )
 void map::apply_light_source( const tripoint &p, float luminance )
 {
     auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
+    apply_light_source( p, luminance, cache.lm, cache.sm );
+}
+
+void map::apply_light_source( const tripoint &p, float luminance,
+                              four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                              float ( &sm )[MAPSIZE_X][MAPSIZE_Y] )
+{
+    auto &cache = get_cache( p.z );
     float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
     float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
 
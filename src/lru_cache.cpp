@@ -2,6 +2,8 @@
 
 #include <cstddef>
 #include <iterator>
+#include <string>
+#include <vector>
 
 #include "map_memory.h"
 #include "point.h"
@@ -16,6 +18,17 @@ Value lru_cache<Key, Value>::get( const Key &pos, const Value &default_ ) const
     return default_;
 }
 
+template<typename Key, typename Value>
+Value lru_cache<Key, Value>::touch( const Key &pos, const Value &default_ )
+{
+    auto found = map.find( pos );
+    if( found != map.end() ) {
+        ordered_list.splice( ordered_list.end(), ordered_list, found->second );
+        return found->second->second;
+    }
+    return default_;
+}
+
 template<typename Key, typename Value>
 void lru_cache<Key, Value>::remove( const Key &pos )
 {
@@ -72,3 +85,4 @@ const std::list<typename lru_cache<Key, Value>::Pair> &lru_cache<Key, Value>::li
 template class lru_cache<tripoint, memorized_terrain_tile>;
 template class lru_cache<tripoint, int>;
 template class lru_cache<point, char>;
+template class lru_cache<std::string, std::vector<std::string>>;
@@ -16,6 +16,8 @@ class lru_cache
 
         void insert( int limit, const Key &, const Value & );
         Value get( const Key &, const Value &default_ ) const;
+        /** Like get, but a found entry also becomes the most recently used one. */
+        Value touch( const Key &, const Value &default_ );
         void remove( const Key & );
 
         void clear();
@@ -102,8 +102,39 @@ void spell_effect::pain_split( const spell &sp, Creature &caster, const tripoint
     }
 }
 
+namespace
+{
+// Remembers which tiles around a point can be moved through, so that the many lines drawn
+// over the same tiles for one area of effect look at each tile of the map only once.
+class passable_cache
+{
+    public:
+        passable_cache( const tripoint &center, const int radius ) :
+            corner( center.x - radius, center.y - radius, center.z ), size( 2 * radius + 1 ),
+            known( size * size, unknown ) {}
+
+        bool passable( const tripoint &p ) {
+            const int x = p.x - corner.x;
+            const int y = p.y - corner.y;
+            if( p.z != corner.z || x < 0 || y < 0 || x >= size || y >= size ) {
+                return g->m.passable( p );
+            }
+            char &k = known[y * size + x];
+            if( k == unknown ) {
+                k = g->m.passable( p ) ? yes : no;
+            }
+            return k == yes;
+        }
+    private:
+        enum : char { unknown, yes, no };
+        tripoint corner;
+        int size;
+        std::vector<char> known;
+};
+} // namespace
+
 static bool in_spell_aoe( const tripoint &start, const tripoint &end, const int &radius,
-                          const bool ignore_walls )
+                          const bool ignore_walls, passable_cache &walls )
 {
     if( rl_dist( start, end ) > radius ) {
         return false;
@@ -113,7 +144,7 @@ static bool in_spell_aoe( const tripoint &start, const tripoint &end, const int
     }
     const std::vector<tripoint> trajectory = line_to( start, end );
     for( const tripoint &pt : trajectory ) {
-        if( g->m.impassable( pt ) ) {
+        if( !walls.passable( pt ) ) {
             return false;
         }
     }
@@ -124,12 +155,14 @@ std::set<tripoint> spell_effect::spell_effect_blast( const spell &, const tripoi
         const tripoint &target, const int aoe_radius, const bool ignore_walls )
 {
     std::set<tripoint> targets;
+    passable_cache walls( target, aoe_radius );
     // TODO: Make this breadth-first
     for( int x = target.x - aoe_radius; x <= target.x + aoe_radius; x++ ) {
         for( int y = target.y - aoe_radius; y <= target.y + aoe_radius; y++ ) {
             const tripoint potential_target( x, y, target.z );
-            if( in_spell_aoe( target, potential_target, aoe_radius, ignore_walls ) ) {
-                targets.emplace( potential_target );
+            if( in_spell_aoe( target, potential_target, aoe_radius, ignore_walls, walls ) ) {
+                // Visited in the set's order
+                targets.emplace_hint( targets.end(), potential_target );
             }
         }
     }
@@ -144,6 +177,7 @@ std::set<tripoint> spell_effect::spell_effect_cone( const spell &sp, const tripo
     const int range = sp.range() + 1;
     const int initial_angle = coord_to_angle( source, target );
     std::set<tripoint> end_points;
+    passable_cache walls( source, range );
     for( int angle = initial_angle - floor( aoe_radius / 2.0 );
          angle <= initial_angle + ceil( aoe_radius / 2.0 ); angle++ ) {
         tripoint potential;
@@ -153,7 +187,7 @@ std::set<tripoint> spell_effect::spell_effect_cone( const spell &sp, const tripo
     for( const tripoint &ep : end_points ) {
         std::vector<tripoint> trajectory = line_to( source, ep );
         for( const tripoint &tp : trajectory ) {
-            if( ignore_walls || g->m.passable( tp ) ) {
+            if( ignore_walls || walls.passable( tp ) ) {
                 targets.emplace( tp );
             } else {
                 break;
@@ -169,6 +203,7 @@ std::set<tripoint> spell_effect::spell_effect_line( const spell &, const tripoin
         const tripoint &target, const int aoe_radius, const bool ignore_walls )
 {
     std::set<tripoint> targets;
+    passable_cache walls( source, rl_dist( source, target ) + aoe_radius );
     const int initial_angle = coord_to_angle( source, target );
     tripoint clockwise_starting_point;
     calc_ray_end( initial_angle - 90, floor( aoe_radius / 2.0 ), source, clockwise_starting_point );
@@ -192,7 +227,7 @@ std::set<tripoint> spell_effect::spell_effect_line( const spell &, const tripoin
     for( const tripoint &start_line_pt : start_width ) {
         bool passable = true;
         for( const tripoint &potential_target : line_to( source, start_line_pt ) ) {
-            passable = g->m.passable( potential_target ) || ignore_walls;
+            passable = ignore_walls || walls.passable( potential_target );
             if( passable ) {
                 targets.emplace( potential_target );
             } else {
@@ -208,7 +243,7 @@ std::set<tripoint> spell_effect::spell_effect_line( const spell &, const tripoin
         for( const tripoint &end_line_pt : end_width ) {
             std::vector<tripoint> temp_line = line_to( start_line_pt, end_line_pt );
             for( const tripoint &potential_target : temp_line ) {
-                if( ignore_walls || g->m.passable( potential_target ) ) {
+                if( ignore_walls || walls.passable( potential_target ) ) {
                     targets.emplace( potential_target );
                 } else {
                     break;
@@ -218,7 +253,7 @@ std::set<tripoint> spell_effect::spell_effect_line( const spell &, const tripoin
         for( const tripoint &cwise_line_pt : cwise_line ) {
             std::vector<tripoint> temp_line = line_to( start_line_pt, cwise_line_pt );
             for( const tripoint &potential_target : temp_line ) {
-                if( ignore_walls || g->m.passable( potential_target ) ) {
+                if( ignore_walls || walls.passable( potential_target ) ) {
                     targets.emplace( potential_target );
                 } else {
                     break;
@@ -228,7 +263,7 @@ std::set<tripoint> spell_effect::spell_effect_line( const spell &, const tripoin
         for( const tripoint &ccwise_line_pt : ccwise_line ) {
             std::vector<tripoint> temp_line = line_to( start_line_pt, ccwise_line_pt );
             for( const tripoint &potential_target : temp_line ) {
-                if( ignore_walls || g->m.passable( potential_target ) ) {
+                if( ignore_walls || walls.passable( potential_target ) ) {
                     targets.emplace( potential_target );
                 } else {
                     break;
@@ -256,9 +291,11 @@ static std::set<tripoint> spell_effect_area( const spell &sp, const tripoint &ta
     const int aoe_radius = sp.aoe();
     targets = aoe_func( sp, caster.pos(), target, aoe_radius, ignore_walls );
 
-    for( const tripoint &p : targets ) {
-        if( !sp.is_valid_target( caster, p ) ) {
-            targets.erase( p );
+    for( auto it = targets.begin(); it != targets.end(); ) {
+        if( !sp.is_valid_target( caster, *it ) ) {
+            it = targets.erase( it );
+        } else {
+            ++it;
         }
     }
 
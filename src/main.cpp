@@ -1,6 +1,7 @@
 /* Entry point and main loop for Cataclysm
  */
 
+#include <algorithm>
 #include <clocale>
 #include <cstdio>
 #include <cstdlib>
@@ -29,12 +30,18 @@
 #include "game.h"
 #include "loading_ui.h"
 #include "main_menu.h"
+#include "mapgen_profile.h"
+#include "memory_census.h"
 #include "mapsharing.h"
 #include "options.h"
 #include "output.h"
 #include "path_info.h"
 #include "rng.h"
+#include "sampling_profiler.h"
+#include "save_benchmark.h"
+#include "startup_trace.h"
 #include "translations.h"
+#include "turn_profile.h"
 #include "input.h"
 #include "type_id.h"
 
@@ -141,6 +148,13 @@ int main( int argc, char *argv[] )
     dump_mode dmode = dump_mode::TSV;
     std::vector<std::string> opts;
     std::string world; /** if set try to load first save in this world on startup */
+    int benchmark_turns = 0;
+    std::string benchmark_path;
+    std::string benchmark_scenario;
+    std::string memory_census_path;
+    std::string profile_samples_path;
+    save_benchmark::world_size save_benchmark_size;
+    std::string save_benchmark_path;
 
 #if defined(__ANDROID__)
     // Start the standard output logging redirector
@@ -181,7 +195,7 @@ int main( int argc, char *argv[] )
         const char *section_default = nullptr;
         const char *section_map_sharing = "Map sharing";
         const char *section_user_directory = "User directories";
-        const std::array<arg_handler, 12> first_pass_arguments = {{
+        const std::array<arg_handler, 19> first_pass_arguments = {{
                 {
                     "--seed", "<string of letters and or numbers>",
                     "Sets the random number generator's seed value",
@@ -249,6 +263,101 @@ int main( int argc, char *argv[] )
                         return 0;
                     }
                 },
+                {
+                    "--startup-trace", "<filename>",
+                    "Writes the time spent loading each mod and data type as a Chrome trace",
+                    section_default,
+                    []( int n, const char *params[] ) -> int {
+                        if( n < 1 )
+                        {
+                            return -1;
+                        }
+                        startup_trace::enable( params[0] );
+                        return 1;
+                    }
+                },
+                {
+                    "--mapgen-profile", "<filename>",
+                    "Writes the time and spawns of each mapgen entry to a file on exit",
+                    section_default,
+                    []( int n, const char *params[] ) -> int {
+                        if( n < 1 )
+                        {
+                            return -1;
+                        }
+                        mapgen_profile::enable( params[0] );
+                        return 1;
+                    }
+                },
+                {
+                    "--profile-samples", "<filename>",
+                    "Samples the stack of the main thread until exit and writes the stacks for flame graphs to a file",
+                    section_default,
+                    [&profile_samples_path]( int n, const char *params[] ) -> int {
+                        if( n < 1 )
+                        {
+                            return -1;
+                        }
+                        profile_samples_path = params[0];
+                        return 1;
+                    }
+                },
+                {
+                    "--benchmark-turns", "<turns> <filename>",
+                    "Runs that many turns of the --world save, writes their timings to a file and exits",
+                    section_default,
+                    [&benchmark_turns, &benchmark_path]( int n, const char *params[] ) -> int {
+                        if( n < 2 )
+                        {
+                            return -1;
+                        }
+                        benchmark_turns = std::max( atoi( params[0] ), 1 );
+                        benchmark_path = params[1];
+                        return 2;
+                    }
+                },
+                {
+                    "--benchmark-scenario", "<name>",
+                    "Sets up a stress scenario (horde_night, burning_city, convoy, mega_base) before --benchmark-turns",
+                    section_default,
+                    [&benchmark_scenario]( int n, const char *params[] ) -> int {
+                        if( n < 1 )
+                        {
+                            return -1;
+                        }
+                        benchmark_scenario = params[0];
+                        return 1;
+                    }
+                },
+                {
+                    "--memory-census", "<filename>",
+                    "Writes estimated memory use of the loaded --world save per subsystem to a file and exits",
+                    section_default,
+                    [&memory_census_path]( int n, const char *params[] ) -> int {
+                        if( n < 1 )
+                        {
+                            return -1;
+                        }
+                        memory_census_path = params[0];
+                        return 1;
+                    }
+                },
+                {
+                    "--benchmark-save", "<overmaps> <submaps> <items> <filename>",
+                    "Adds that much content to a copy of the --world save, writes save and load timings to a file and exits",
+                    section_default,
+                    [&save_benchmark_size, &save_benchmark_path]( int n, const char *params[] ) -> int {
+                        if( n < 4 )
+                        {
+                            return -1;
+                        }
+                        save_benchmark_size.overmaps = std::max( atoi( params[0] ), 0 );
+                        save_benchmark_size.submaps = std::max( atoi( params[1] ), 0 );
+                        save_benchmark_size.items_per_submap = std::max( atoi( params[2] ), 0 );
+                        save_benchmark_path = params[3];
+                        return 4;
+                    }
+                },
                 {
                     "--world", "<name>",
                     "Load world",
@@ -551,6 +660,12 @@ int main( int argc, char *argv[] )
 
     setupDebug( DebugOutput::file );
 
+    // Started once the debug log can say why it didn't, all the loading is still ahead
+    if( !profile_samples_path.empty() && !sampling_profiler::start( profile_samples_path ) ) {
+        DebugLog( D_ERROR, DC_ALL ) <<
+                                    "--profile-samples needs a build with BACKTRACE support on Linux or macOS";
+    }
+
     /**
      * OS X does not populate locale env vars correctly (they usually default to
      * "C") so don't bother trying to set the locale based on them.
@@ -671,6 +786,27 @@ int main( int argc, char *argv[] )
     }
 #endif
 
+    if( benchmark_turns > 0 ) {
+        if( world.empty() ||
+            !turn_profile::run_benchmark( world, benchmark_turns, benchmark_path, benchmark_scenario ) ) {
+            DebugLog( D_ERROR, DC_ALL ) <<
+                                        "--benchmark-turns needs a world with a save, given with --world, and a known --benchmark-scenario";
+        }
+        exit_handler( 0 );
+    }
+    if( !memory_census_path.empty() ) {
+        if( world.empty() || !memory_census::run( world, memory_census_path ) ) {
+            DebugLog( D_ERROR, DC_ALL ) << "--memory-census needs a world with a save, given with --world";
+        }
+        exit_handler( 0 );
+    }
+    if( !save_benchmark_path.empty() ) {
+        if( world.empty() || !save_benchmark::run( world, save_benchmark_size, save_benchmark_path ) ) {
+            DebugLog( D_ERROR, DC_ALL ) << "--benchmark-save needs a world with a save, given with --world";
+        }
+        exit_handler( 0 );
+    }
+
     while( true ) {
         if( !world.empty() ) {
             if( !g->load( world ) ) {
@@ -747,6 +883,8 @@ void exit_handler( int s )
     if( s != 2 || query_yn( _( "Really Quit? All unsaved changes will be lost." ) ) ) {
         catacurses::erase(); // Clear screen
 
+        mapgen_profile::write();
+        sampling_profiler::stop();
         deinitDebug();
 
         int exit_status = 0;
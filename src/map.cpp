@@ -9,7 +9,11 @@
 #include <limits>
 #include <queue>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
 
 #include "ammo.h"
 #include "artifact.h"
@@ -37,6 +41,8 @@
 #include "map_iterator.h"
 #include "map_selector.h"
 #include "mapbuffer.h"
+#include "mapgen_profile.h"
+#include "memory_census.h"
 #include "mapdata.h"
 #include "messages.h"
 #include "mongroup.h"
@@ -54,9 +60,11 @@
 #include "sounds.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "timed_event.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_profile.h"
 #include "veh_type.h"
 #include "vehicle.h"
 #include "vpart_position.h"
@@ -136,14 +144,6 @@ map::map( int mapsize, bool zlev )
         grid.resize( my_MAPSIZE * my_MAPSIZE, nullptr );
     }
 
-    for( auto &ptr : caches ) {
-        ptr = std::make_unique<level_cache>();
-    }
-
-    for( auto &ptr : pathfinding_caches ) {
-        ptr = std::make_unique<pathfinding_cache>();
-    }
-
     dbg( D_INFO ) << "map::map(): my_MAPSIZE: " << my_MAPSIZE << " z-levels enabled:" << zlevels;
     traplocs.resize( trap::count() );
 }
@@ -228,11 +228,18 @@ void map::add_vehicle_to_cache( vehicle *veh )
             continue;
         }
         const tripoint p = veh->global_part_pos3( *it );
-        ch.veh_cached_parts.insert( std::make_pair( p,
-                                    std::make_pair( veh, partid ) ) );
         if( inbounds( p ) ) {
-            ch.veh_exists_at[p.x][p.y] = true;
+            if( ch.veh_exists_at.get( p.xy() ) ) {
+                // The first part cached on a tile is the one found there
+                continue;
+            }
+            if( ch.veh_parts_grid.empty() ) {
+                ch.veh_parts_grid.resize( MAPSIZE_X * MAPSIZE_Y );
+            }
+            ch.veh_part_at( p.xy() ) = std::make_pair( veh, partid );
+            ch.veh_exists_at.set( p.xy() );
         }
+        ch.veh_cached_parts.emplace_back( p, veh );
     }
 }
 
@@ -245,19 +252,19 @@ void map::update_vehicle_cache( vehicle *veh, const int old_zlevel )
 
     // Existing must be cleared
     auto &ch = get_cache( old_zlevel );
-    auto it = ch.veh_cached_parts.begin();
-    const auto end = ch.veh_cached_parts.end();
-    while( it != end ) {
-        if( it->second.first == veh ) {
-            const tripoint p = it->first;
+    auto &cached_parts = ch.veh_cached_parts;
+    for( size_t i = 0; i < cached_parts.size(); ) {
+        if( cached_parts[i].second == veh ) {
+            const tripoint p = cached_parts[i].first;
             if( inbounds( p ) ) {
-                ch.veh_exists_at[p.x][p.y] = false;
+                ch.veh_exists_at.reset( p.xy() );
             }
-            ch.veh_cached_parts.erase( it++ );
+            cached_parts[i] = cached_parts.back();
+            cached_parts.pop_back();
             // If something was resting on vehicle, drop it
             support_dirty( tripoint( p.xy(), old_zlevel + 1 ) );
         } else {
-            ++it;
+            ++i;
         }
     }
 
@@ -267,14 +274,13 @@ void map::update_vehicle_cache( vehicle *veh, const int old_zlevel )
 void map::clear_vehicle_cache( const int zlev )
 {
     auto &ch = get_cache( zlev );
-    while( !ch.veh_cached_parts.empty() ) {
-        const auto part = ch.veh_cached_parts.begin();
-        const auto &p = part->first;
+    for( const auto &part : ch.veh_cached_parts ) {
+        const tripoint &p = part.first;
         if( inbounds( p ) ) {
-            ch.veh_exists_at[p.x][p.y] = false;
+            ch.veh_exists_at.reset( p.xy() );
         }
-        ch.veh_cached_parts.erase( part );
     }
+    ch.veh_cached_parts.clear();
 }
 
 void map::clear_vehicle_list( const int zlev )
@@ -326,6 +332,7 @@ std::unique_ptr<vehicle> map::detach_vehicle( vehicle *veh )
             ch.vehicle_list.erase( veh );
             ch.zone_vehicles.erase( veh );
             reset_vehicle_cache( z );
+            set_pathfinding_cache_dirty( *veh );
             std::unique_ptr<vehicle> result = std::move( current_submap->vehicles[i] );
             current_submap->vehicles.erase( current_submap->vehicles.begin() + i );
             if( veh->tracking_on ) {
@@ -350,11 +357,11 @@ void map::on_vehicle_moved( const int smz )
     set_outside_cache_dirty( smz );
     set_transparency_cache_dirty( smz );
     set_floor_cache_dirty( smz );
-    set_pathfinding_cache_dirty( smz );
 }
 
 void map::vehmove()
 {
+    turn_profile::phase timer( "vehicles" );
     // give vehicles movement points
     VehicleList vehicle_list;
     int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
@@ -902,20 +909,14 @@ const vehicle *map::veh_at_internal( const tripoint &p, int &part_num ) const
 {
     // This function is called A LOT. Move as much out of here as possible.
     const auto &ch = get_cache_ref( p.z );
-    if( !ch.veh_in_active_range || !ch.veh_exists_at[p.x][p.y] ) {
+    if( !ch.veh_in_active_range || !ch.veh_exists_at.get( p.xy() ) ) {
         part_num = -1;
         return nullptr; // Clear cache indicates no vehicle. This should optimize a great deal.
     }
 
-    const auto it = ch.veh_cached_parts.find( p );
-    if( it != ch.veh_cached_parts.end() ) {
-        part_num = it->second.second;
-        return it->second.first;
-    }
-
-    debugmsg( "vehicle part cache indicated vehicle not found: %d %d %d", p.x, p.y, p.z );
-    part_num = -1;
-    return nullptr;
+    const auto &part = ch.veh_part_at( p.xy() );
+    part_num = part.second;
+    return part.first;
 }
 
 vehicle *map::veh_at_internal( const tripoint &p, int &part_num )
@@ -1099,6 +1100,8 @@ vehicle *map::displace_vehicle( tripoint &p, const tripoint &dp )
         }
     }
 
+    // Pathfinding only needs updating where the vehicle was and where it ends up.
+    set_pathfinding_cache_dirty( *veh );
     veh->shed_loose_parts();
     for( auto &prt : veh->parts ) {
         prt.precalc[0] = prt.precalc[1];
@@ -1117,6 +1120,7 @@ vehicle *map::displace_vehicle( tripoint &p, const tripoint &dp )
         src_submap->vehicles.erase( src_submap_veh_it );
         dst_submap->is_uniform = false;
     }
+    set_pathfinding_cache_dirty( *veh );
 
     p = p2;
 
@@ -1295,7 +1299,7 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture )
         field_furn_locs.push_back( p );
     }
     if( old_t.transparent != new_t.transparent ) {
-        set_transparency_cache_dirty( p.z );
+        set_transparency_cache_dirty( p );
     }
 
     if( old_t.has_flag( TFLAG_INDOORS ) != new_t.has_flag( TFLAG_INDOORS ) ) {
@@ -1308,7 +1312,7 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture )
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     // Make sure the furniture falls if it needs to
     support_dirty( p );
@@ -1408,7 +1412,7 @@ ter_id map::ter( const tripoint &p ) const
 }
 
 uint8_t map::get_known_connections( const tripoint &p, int connect_group,
-                                    const std::map<tripoint, ter_id> &override ) const
+                                    const std::unordered_map<tripoint, ter_id> &override ) const
 {
     constexpr std::array<point, 4> offsets = {{
             point_south, point_east, point_west, point_north
@@ -1569,7 +1573,7 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
     }
 
     if( old_t.transparent != new_t.transparent ) {
-        set_transparency_cache_dirty( p.z );
+        set_transparency_cache_dirty( p );
     }
 
     if( old_t.has_flag( TFLAG_INDOORS ) != new_t.has_flag( TFLAG_INDOORS ) ) {
@@ -1584,7 +1588,7 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     tripoint above( p.xy(), p.z + 1 );
     // Make sure that if we supported something and no longer do so, it falls down
@@ -2613,7 +2617,7 @@ bool map::is_outside( const point &p ) const
     }
 
     const auto &outside_cache = get_cache_ref( abs_sub.z ).outside_cache;
-    return outside_cache[p.x][p.y];
+    return outside_cache.get( p );
 }
 
 bool map::is_outside( const tripoint &p ) const
@@ -2623,7 +2627,7 @@ bool map::is_outside( const tripoint &p ) const
     }
 
     const auto &outside_cache = get_cache_ref( p.z ).outside_cache;
-    return outside_cache[p.x][p.y];
+    return outside_cache.get( p.xy() );
 }
 
 bool map::is_last_ter_wall( const bool no_furn, const point &p,
@@ -2672,6 +2676,9 @@ bool map::is_last_ter_wall( const bool no_furn, const point &p,
 
 bool map::tinder_at( const tripoint &p )
 {
+    if( !has_items( p ) ) {
+        return false;
+    }
     for( const auto &i : i_at( p ) ) {
         if( i.has_flag( "TINDER" ) ) {
             return true;
@@ -2756,7 +2763,7 @@ void map::decay_fields_and_scent( const time_duration &amount )
                     const int y = sy + smy * SEEY;
 
                     field &fields = cur_submap->fld[sx][sy];
-                    if( !outside_cache[x][y] ) {
+                    if( !outside_cache.get( { x, y } ) ) {
                         to_proc -= fields.field_count();
                         continue;
                     }
@@ -4156,6 +4163,9 @@ void map::i_clear( const tripoint &p )
 {
     point l;
     submap *const current_submap = get_submap_at( p, l );
+    if( !current_submap->itm.allocated() ) {
+        return;
+    }
 
     for( item &it : current_submap->itm[l.x][l.y] ) {
         // remove from the active items cache (if it isn't there does nothing)
@@ -4184,7 +4194,11 @@ item &map::spawn_an_item( const tripoint &p, item new_item,
 
     new_item.set_damage( damlevel );
 
-    return add_item_or_charges( p, new_item );
+    item &added = add_item_or_charges( p, new_item );
+    if( !added.is_null() ) {
+        mapgen_profile::add_items( 1 );
+    }
+    return added;
 }
 
 std::vector<item *> map::spawn_items( const tripoint &p, const std::vector<item> &new_items )
@@ -4205,6 +4219,7 @@ std::vector<item *> map::spawn_items( const tripoint &p, const std::vector<item>
         }
     }
 
+    mapgen_profile::add_items( static_cast<int>( ret.size() ) );
     return ret;
 }
 
@@ -4584,6 +4599,7 @@ static void process_vehicle_items( vehicle &cur_veh, int part )
 
 void map::process_active_items()
 {
+    turn_profile::phase timer( "items" );
     process_items( true, process_map_items, std::string {} );
 }
 
@@ -4670,30 +4686,37 @@ void map::process_items_in_vehicle( vehicle &cur_veh, submap &current_submap, co
     }
 
     auto cargo_parts = cur_veh.get_parts_including_carried( VPFLAG_CARGO );
+    // First cargo part at each mount point, so active items don't each scan the whole list.
+    std::unordered_map<point, vpart_reference> cargo_at;
+    const auto index_cargo = [&cargo_at]( const vehicle_part_with_feature_range<vpart_bitflags>
+    &range ) {
+        cargo_at.clear();
+        for( const vpart_reference &vp : range ) {
+            cargo_at.emplace( vp.mount(), vp );
+        }
+    };
+    index_cargo( cargo_parts );
     for( const vpart_reference &vp : cargo_parts ) {
         process_vehicle_items( cur_veh, vp.part_index() );
     }
 
     for( item_reference &active_item_ref : cur_veh.active_items.get_for_processing() ) {
-        if( empty( cargo_parts ) ) {
+        if( cargo_at.empty() ) {
             return;
         } else if( !active_item_ref.item_ref ) {
             // The item was destroyed, so skip it.
             continue;
         }
-        const auto it = std::find_if( begin( cargo_parts ),
-        end( cargo_parts ), [&]( const vpart_reference & part ) {
-            return active_item_ref.location == part.mount();
-        } );
-
-        if( it == end( cargo_parts ) ) {
+        const auto it = cargo_at.find( active_item_ref.location );
+        if( it == cargo_at.end() ) {
             continue; // Can't find a cargo part matching the active item.
         }
+        const vpart_reference &cargo = it->second;
         const item &target = *active_item_ref.item_ref;
         // Find the cargo part and coordinates corresponding to the current active item.
-        const vehicle_part &pt = it->part();
-        const tripoint item_loc = it->pos();
-        auto items = cur_veh.get_items( static_cast<int>( it->part_index() ) );
+        const vehicle_part &pt = cargo.part();
+        const tripoint item_loc = cargo.pos();
+        auto items = cur_veh.get_items( static_cast<int>( cargo.part_index() ) );
         float it_insulation = 1.0;
         temperature_flag flag = temperature_flag::TEMP_NORMAL;
         if( target.has_temperature() || target.is_food_container() ) {
@@ -4731,7 +4754,7 @@ void map::process_items_in_vehicle( vehicle &cur_veh, submap &current_submap, co
         // the list of cargo parts might have changed (imagine a part with
         // a low index has been removed by an explosion, all the other
         // parts would move up to fill the gap).
-        cargo_parts = cur_veh.get_any_parts( VPFLAG_CARGO );
+        index_cargo( cur_veh.get_any_parts( VPFLAG_CARGO ) );
     }
 }
 
@@ -4781,7 +4804,7 @@ bool map::has_items( const tripoint &p ) const
     }
 
     point l;
-    submap *const current_submap = get_submap_at( p, l );
+    const submap *const current_submap = get_submap_at( p, l );
 
     return !current_submap->itm[l.x][l.y].empty();
 }
@@ -5245,6 +5268,7 @@ void map::trap_set( const tripoint &p, const trap_id &type )
     if( type != tr_null ) {
         traplocs[type].push_back( p );
     }
+    set_pathfinding_cache_dirty( p );
 }
 
 void map::disarm_trap( const tripoint &p )
@@ -5326,6 +5350,7 @@ void map::remove_trap( const tripoint &p )
         if( iter != traps.end() ) {
             traps.erase( iter );
         }
+        set_pathfinding_cache_dirty( p );
     }
 }
 /*
@@ -5339,7 +5364,7 @@ const field &map::field_at( const tripoint &p ) const
     }
 
     point l;
-    submap *const current_submap = get_submap_at( p, l );
+    const submap *const current_submap = get_submap_at( p, l );
 
     return current_submap->fld[l.x][l.y];
 }
@@ -5424,11 +5449,15 @@ field_entry *map::get_field( const tripoint &p, const field_type_id type )
 
     point l;
     submap *const current_submap = get_submap_at( p, l );
+    if( !current_submap->fld.allocated() ) {
+        // Nothing to find, and no need to allocate the fields to find that out
+        return nullptr;
+    }
 
     return current_submap->fld[l.x][l.y].find_field( type );
 }
 
-bool map::dangerous_field_at( const tripoint &p )
+bool map::dangerous_field_at( const tripoint &p ) const
 {
     for( auto &pr : field_at( p ) ) {
         auto &fd = pr.second;
@@ -5463,6 +5492,7 @@ bool map::add_field( const tripoint &p, const field_type_id type, int intensity,
     current_submap->is_uniform = false;
 
     if( current_submap->fld[l.x][l.y].add_field( type, intensity, age ) ) {
+        current_submap->field_tiles.set( l );
         //Only adding it to the count if it doesn't exist.
         if( ! current_submap->field_count++ ) {
             get_cache( p.z ).field_cache.set( static_cast<size_t>( p.x / SEEX + ( (
@@ -5475,11 +5505,12 @@ bool map::add_field( const tripoint &p, const field_type_id type, int intensity,
     }
 
     // Dirty the transparency cache now that field processing doesn't always do it
-    // TODO: Make it skip transparent fields
-    set_transparency_cache_dirty( p.z );
+    if( type.obj().affects_transparency() ) {
+        set_transparency_cache_dirty( p );
+    }
 
     if( type.obj().is_dangerous() ) {
-        set_pathfinding_cache_dirty( p.z );
+        set_pathfinding_cache_dirty( p );
     }
 
     // Ensure blood type fields don't hang in the air
@@ -5498,6 +5529,9 @@ void map::remove_field( const tripoint &p, const field_type_id field_to_remove )
 
     point l;
     submap *const current_submap = get_submap_at( p, l );
+    if( !current_submap->fld.allocated() ) {
+        return;
+    }
 
     if( current_submap->fld[l.x][l.y].remove_field( field_to_remove ) ) {
         // Only adjust the count if the field actually existed.
@@ -5506,11 +5540,11 @@ void map::remove_field( const tripoint &p, const field_type_id field_to_remove )
                                                   p.y / SEEX ) * MAPSIZE ) ) );
         }
         const auto &fdata = field_to_remove.obj();
-        if( fdata.is_transparent() ) {
-            set_transparency_cache_dirty( p.z );
+        if( fdata.affects_transparency() ) {
+            set_transparency_cache_dirty( p );
         }
         if( fdata.is_dangerous() ) {
-            set_pathfinding_cache_dirty( p.z );
+            set_pathfinding_cache_dirty( p );
         }
     }
 }
@@ -5616,10 +5650,26 @@ void map::update_visibility_cache( const int zlev )
     visibility_variables_cache.u_sight_impaired = g->u.sight_impaired();
     visibility_variables_cache.u_is_boomered = g->u.has_effect( effect_boomered );
 
+    level_cache &ch = get_cache( zlev );
+    visibility_cache_inputs inputs;
+    inputs.valid = true;
+    inputs.abs_sub = abs_sub;
+    inputs.viewer = g->u.pos();
+    inputs.unimpaired_range = g->u.unimpaired_range();
+    inputs.variables = visibility_variables_cache;
+    inputs.light_cache_version = ch.light_cache_version;
+    inputs.transparency_cache_version = ch.transparency_cache_version;
+    inputs.seen_cache_version = seen_cache_version;
+    // Redraws without a turn passing (look around, targeting, animations) land here.
+    if( inputs == ch.visibility_inputs ) {
+        return;
+    }
+    ch.visibility_inputs = inputs;
+
     int sm_squares_seen[MAPSIZE][MAPSIZE];
     std::memset( sm_squares_seen, 0, sizeof( sm_squares_seen ) );
 
-    auto &visibility_cache = get_cache( zlev ).visibility_cache;
+    auto &visibility_cache = ch.visibility_cache;
 
     tripoint p;
     p.z = zlev;
@@ -5676,52 +5726,70 @@ visibility_type map::get_visibility( const lit_level ll, const visibility_variab
     return VIS_HIDDEN;
 }
 
-bool map::apply_vision_effects( const catacurses::window &w, const visibility_type vis ) const
-{
-    int symbol = ' ';
+/** What the curses view shows on one tile. */
+struct map_glyph {
     nc_color color = c_black;
+    int sym = ' ';
+    /** Drawn instead of sym if set, item symbols are strings. */
+    std::string str;
+
+    void set( const nc_color &col, const int symbol ) {
+        color = col;
+        sym = symbol;
+        str.clear();
+    }
+};
 
+/** Returns false if the tile is seen clearly and has to be drawn normally. */
+static bool vision_effect_glyph( const visibility_type vis, map_glyph &out )
+{
     switch( vis ) {
         case VIS_CLEAR:
             // Drew the tile, so bail out now.
             return false;
         case VIS_LIT: // can only tell that this square is bright
-            symbol = '#';
-            color = c_light_gray;
+            out.set( c_light_gray, '#' );
             break;
         case VIS_BOOMER:
-            symbol = '#';
-            color = c_pink;
+            out.set( c_pink, '#' );
             break;
         case VIS_BOOMER_DARK:
-            symbol = '#';
-            color = c_magenta;
+            out.set( c_magenta, '#' );
             break;
         case VIS_DARK: // can't see this square at all
         case VIS_HIDDEN:
-            symbol = ' ';
-            color = c_black;
+            out.set( c_black, ' ' );
             break;
     }
-    wputch( w, color, symbol );
     return true;
 }
 
-bool map::draw_maptile_from_memory( const catacurses::window &w, const tripoint &p,
-                                    const tripoint &view_center, bool move_cursor ) const
+/** Writes a whole row of the window, switching the colour only between runs of one colour. */
+static void draw_glyph_row( const catacurses::window &w, const int y,
+                            const std::vector<map_glyph> &row )
 {
-    int sym = g->u.get_memorized_symbol( getabs( p ) );
-    if( sym == 0 ) {
-        return false;
+    wmove( w, point( 0, y ) );
+    for( auto it = row.begin(); it != row.end(); ) {
+        const nc_color color = it->color;
+        wattron( w, color );
+        for( ; it != row.end() && it->color == color; ++it ) {
+            if( it->str.empty() ) {
+                waddch( w, it->sym );
+            } else {
+                wprintw( w, it->str );
+            }
+        }
+        wattroff( w, color );
     }
-    if( move_cursor ) {
-        const int k = p.x + getmaxx( w ) / 2 - view_center.x;
-        const int j = p.y + getmaxy( w ) / 2 - view_center.y;
+}
 
-        mvwputch( w, point( k, j ), c_brown, sym );
-    } else {
-        wputch( w, c_brown, sym );
+bool map::apply_vision_effects( const catacurses::window &w, const visibility_type vis ) const
+{
+    map_glyph glyph;
+    if( !vision_effect_glyph( vis, glyph ) ) {
+        return false;
     }
+    wputch( w, glyph.color, glyph.sym );
     return true;
 }
 
@@ -5739,62 +5807,68 @@ void map::draw( const catacurses::window &w, const tripoint &center )
 
     const auto &visibility_cache = get_cache_ref( center.z ).visibility_cache;
 
+    const bool do_map_memory = g->u.should_show_map_memory();
+    // Tiles outside of the map (and ones that can't be seen) are drawn from the map memory
+    const auto draw_memory = [&]( map_glyph & out, const tripoint & p ) {
+        const int sym = do_map_memory ? g->u.get_memorized_symbol( getabs( p ) ) : 0;
+        if( sym != 0 ) {
+            out.set( c_brown, sym );
+        } else {
+            out.set( c_black, ' ' );
+        }
+    };
+
+    const int width = getmaxx( w );
+    const int height = getmaxy( w );
+    // A row is put together first and then written at once
+    std::vector<map_glyph> row( width );
+    const int min_x = center.x - width / 2;
+    const int maxxrender = min_x + width;
+    const int maxx = std::min( MAPSIZE_X, maxxrender );
+
     // X and y are in map coordinates, but might be out of range of the map.
-    // When they are out of range, we just draw '#'s.
     tripoint p;
     p.z = center.z;
     int &x = p.x;
     int &y = p.y;
-    const bool do_map_memory = g->u.should_show_map_memory();
-    for( y = center.y - getmaxy( w ) / 2; y <= center.y + getmaxy( w ) / 2; y++ ) {
-        if( y - center.y + getmaxy( w ) / 2 >= getmaxy( w ) ) {
-            continue;
-        }
-
-        wmove( w, point( 0, y - center.y + getmaxy( w ) / 2 ) );
-
-        const int maxxrender = center.x - getmaxx( w ) / 2 + getmaxx( w );
-        x = center.x - getmaxx( w ) / 2;
+    for( int j = 0; j < height; j++ ) {
+        y = center.y - height / 2 + j;
+        x = min_x;
         if( y < 0 || y >= MAPSIZE_Y ) {
             for( ; x < maxxrender; x++ ) {
-                if( !do_map_memory || !draw_maptile_from_memory( w, p, center, false ) ) {
-                    wputch( w, c_black, ' ' );
-                }
+                draw_memory( row[x - min_x], p );
             }
+            draw_glyph_row( w, j, row );
             continue;
         }
 
-        while( x < 0 ) {
-            if( !do_map_memory || !draw_maptile_from_memory( w, p, center, false ) ) {
-                wputch( w, c_black, ' ' );
-            }
-            x++;
+        for( ; x < 0 && x < maxxrender; x++ ) {
+            draw_memory( row[x - min_x], p );
         }
 
         point l;
-        const int maxx = std::min( MAPSIZE_X, maxxrender );
         while( x < maxx ) {
             submap *cur_submap = get_submap_at( p, l );
             submap *sm_below = p.z > -OVERMAP_DEPTH ?
                                get_submap_at( {p.xy(), p.z - 1}, l ) : cur_submap;
             while( l.x < SEEX && x < maxx )  {
+                map_glyph &glyph = row[x - min_x];
                 const lit_level lighting = visibility_cache[x][y];
                 const visibility_type vis = get_visibility( lighting, cache );
-                if( !apply_vision_effects( w, vis ) ) {
+                if( !vision_effect_glyph( vis, glyph ) ) {
                     const maptile curr_maptile = maptile( cur_submap, l );
                     const bool just_this_zlevel =
-                        draw_maptile( w, g->u, p, curr_maptile,
-                                      false, true, center,
-                                      lighting == LL_LOW, lighting == LL_BRIGHT, true );
+                        draw_maptile( glyph, g->u, p, curr_maptile, false, true,
+                                      lighting == LL_LOW, lighting == LL_BRIGHT );
                     if( !just_this_zlevel ) {
                         p.z--;
                         const maptile tile_below = maptile( sm_below, l );
-                        draw_from_above( w, g->u, p, tile_below, false, center,
-                                         lighting == LL_LOW, lighting == LL_BRIGHT, false );
+                        draw_from_above( glyph, g->u, p, tile_below, false,
+                                         lighting == LL_LOW, lighting == LL_BRIGHT );
                         p.z++;
                     }
-                } else if( do_map_memory && ( vis == VIS_HIDDEN || vis == VIS_DARK ) ) {
-                    draw_maptile_from_memory( w, p, center );
+                } else if( vis == VIS_HIDDEN || vis == VIS_DARK ) {
+                    draw_memory( glyph, p );
                 }
 
                 l.x++;
@@ -5802,12 +5876,10 @@ void map::draw( const catacurses::window &w, const tripoint &center )
             }
         }
 
-        while( x < maxxrender ) {
-            if( !do_map_memory || !draw_maptile_from_memory( w, p, center, false ) ) {
-                wputch( w, c_black, ' ' );
-            }
-            x++;
+        for( ; x < maxxrender; x++ ) {
+            draw_memory( row[x - min_x], p );
         }
+        draw_glyph_row( w, j, row );
     }
 }
 
@@ -5833,15 +5905,32 @@ void map::drawsq( const catacurses::window &w, player &u, const tripoint &p, con
         return;
     }
 
+    map_glyph glyph;
     const maptile tile = maptile_at( p );
-    const bool done = draw_maptile( w, u, p, tile, invert_arg, show_items_arg,
-                                    view_center, low_light, bright_light, inorder );
+    const bool done = draw_maptile( glyph, u, p, tile, invert_arg, show_items_arg,
+                                    low_light, bright_light );
     if( !done ) {
         tripoint below( p.xy(), p.z - 1 );
         const maptile tile_below = maptile_at( below );
-        draw_from_above( w, u, below, tile_below,
-                         invert_arg, view_center,
-                         low_light, bright_light, false );
+        draw_from_above( glyph, u, below, tile_below, invert_arg, low_light, bright_light );
+    }
+
+    if( inorder ) {
+        // Rastering the whole map, take advantage of automatically moving the cursor.
+        if( glyph.str.empty() ) {
+            wputch( w, glyph.color, glyph.sym );
+        } else {
+            wprintz( w, glyph.color, glyph.str );
+        }
+    } else {
+        // Otherwise move the cursor before drawing.
+        const point pos( p.x + getmaxx( w ) / 2 - view_center.x,
+                         p.y + getmaxy( w ) / 2 - view_center.y );
+        if( glyph.str.empty() ) {
+            mvwputch( w, pos, glyph.color, glyph.sym );
+        } else {
+            mvwprintz( w, pos, glyph.color, glyph.str );
+        }
     }
 }
 
@@ -5851,11 +5940,9 @@ bool map::need_draw_lower_floor( const tripoint &p )
     return !( !zlevels || p.z <= -OVERMAP_DEPTH || !ter( p ).obj().has_flag( TFLAG_NO_FLOOR ) );
 }
 
-bool map::draw_maptile( const catacurses::window &w, const player &u, const tripoint &p,
-                        const maptile &curr_maptile,
-                        bool invert, bool show_items,
-                        const tripoint &view_center,
-                        const bool low_light, const bool bright_light, const bool inorder ) const
+bool map::draw_maptile( map_glyph &out, const player &u, const tripoint &p,
+                        const maptile &curr_maptile, bool invert, bool show_items,
+                        const bool low_light, const bool bright_light ) const
 {
     nc_color tercol;
     const ter_t &curr_ter = curr_maptile.get_ter_t();
@@ -6023,33 +6110,16 @@ bool map::draw_maptile( const catacurses::window &w, const player &u, const trip
         tercol = red_background( tercol );
     }
 
-    if( inorder ) {
-        // Rastering the whole map, take advantage of automatically moving the cursor.
-        if( item_sym.empty() ) {
-            wputch( w, tercol, sym );
-        } else {
-            wprintz( w, tercol, item_sym );
-        }
-    } else {
-        // Otherwise move the cursor before drawing.
-        const int k = p.x + getmaxx( w ) / 2 - view_center.x;
-        const int j = p.y + getmaxy( w ) / 2 - view_center.y;
-        if( item_sym.empty() ) {
-            mvwputch( w, point( k, j ), tercol, sym );
-        } else {
-            mvwprintz( w, point( k, j ), tercol, item_sym );
-        }
-    }
+    out.set( tercol, sym );
+    out.str = item_sym;
 
     return !zlevels || sym != ' ' || !item_sym.empty() || p.z <= -OVERMAP_DEPTH ||
            !curr_ter.has_flag( TFLAG_NO_FLOOR );
 }
 
-void map::draw_from_above( const catacurses::window &w, const player &u, const tripoint &p,
-                           const maptile &curr_tile,
-                           const bool invert,
-                           const tripoint &view_center,
-                           bool low_light, bool bright_light, bool inorder ) const
+void map::draw_from_above( map_glyph &out, const player &u, const tripoint &p,
+                           const maptile &curr_tile, const bool invert,
+                           bool low_light, bool bright_light ) const
 {
     static const int AUTO_WALL_PLACEHOLDER = 2; // this should never appear as a real symbol!
 
@@ -6117,13 +6187,7 @@ void map::draw_from_above( const catacurses::window &w, const player &u, const t
         tercol = invert_color( tercol );
     }
 
-    if( inorder ) {
-        wputch( w, tercol, sym );
-    } else {
-        const int k = p.x + getmaxx( w ) / 2 - view_center.x;
-        const int j = p.y + getmaxy( w ) / 2 - view_center.y;
-        mvwputch( w, point( k, j ), tercol, sym );
-    }
+    out.set( tercol, sym );
 }
 
 bool map::sees( const tripoint &F, const tripoint &T, const int range ) const
@@ -6142,6 +6206,29 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range, int &bres
         bresenham_slope = 0;
         return false; // Out of range!
     }
+    return sees_in_range( F, T, bresenham_slope );
+}
+
+std::vector<bool> map::sees( const std::vector<tripoint> &observers, const tripoint &T,
+                             const int range ) const
+{
+    std::vector<bool> result( observers.size(), false );
+    if( !inbounds( T ) ) {
+        return result;
+    }
+    for( size_t i = 0; i < observers.size(); i++ ) {
+        const tripoint &F = observers[i];
+        if( range >= 0 && range < rl_dist( F, T ) ) {
+            continue;
+        }
+        int dummy = 0;
+        result[i] = sees_in_range( F, T, dummy );
+    }
+    return result;
+}
+
+bool map::sees_in_range( const tripoint &F, const tripoint &T, int &bresenham_slope ) const
+{
     // Cannonicalize the order of the tripoints so the cache is reflexive.
     const tripoint &min = F < T ? F : T;
     const tripoint &max = !( F < T ) ? F : T;
@@ -6153,15 +6240,20 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range, int &bres
     }
     bool visible = true;
 
+    if( fov_3d && std::abs( F.z - T.z ) > fov_3d_z_range ) {
+        return false;
+    }
+
     // Ugly `if` for now
     if( !fov_3d || F.z == T.z ) {
+        const auto &transparency_cache = get_cache_ref( T.z ).transparency_cache;
         bresenham( F.xy(), T.xy(), bresenham_slope,
-        [this, &visible, &T]( const point & new_point ) {
+        [&transparency_cache, &visible, &T]( const point & new_point ) {
             // Exit before checking the last square, it's still visible even if opaque.
             if( new_point.x == T.x && new_point.y == T.y ) {
                 return false;
             }
-            if( !this->trans( tripoint( new_point, T.z ) ) ) {
+            if( transparency_cache[new_point.x][new_point.y] <= LIGHT_TRANSPARENCY_SOLID ) {
                 visible = false;
                 return false;
             }
@@ -6526,6 +6618,19 @@ void map::load( const tripoint &w, const bool update_vehicle )
     field_furn_locs.clear();
     submaps_with_active_items.clear();
     set_abs_sub( w );
+    // Read all the saved quads at once, spread over a few threads, instead of one by one
+    // as loadn gets to them.
+    std::vector<tripoint> to_load;
+    const int zmin = zlevels ? -OVERMAP_DEPTH : w.z;
+    const int zmax = zlevels ? OVERMAP_HEIGHT : w.z;
+    for( int gridz = zmin; gridz <= zmax; gridz++ ) {
+        for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
+            for( int gridy = 0; gridy < my_MAPSIZE; gridy++ ) {
+                to_load.emplace_back( w.x + gridx, w.y + gridy, gridz );
+            }
+        }
+    }
+    MAPBUFFER.prefetch( to_load, std::min( 4U, std::max( 1U, std::thread::hardware_concurrency() ) ) );
     for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
         for( int gridy = 0; gridy < my_MAPSIZE; gridy++ ) {
             loadn( point( gridx, gridy ), update_vehicle );
@@ -6623,70 +6728,44 @@ void map::shift( const point &sp )
     // Shift the map sx submaps to the right and sy submaps down.
     // sx and sy should never be bigger than +/-1.
     // absx and absy are our position in the world, for saving/loading purposes.
+    // Moving the origin of the grid leaves the submaps that are still in range where they are,
+    // the slots of those that went out of range now hold the exposed edge and get loaded.
+    grid_origin.x = ( ( grid_origin.x + sp.x ) % my_MAPSIZE + my_MAPSIZE ) % my_MAPSIZE;
+    grid_origin.y = ( ( grid_origin.y + sp.y ) % my_MAPSIZE + my_MAPSIZE ) % my_MAPSIZE;
+    const auto exposed = [this, &sp]( const int gridx, const int gridy ) {
+        return gridx + sp.x < 0 || gridx + sp.x >= my_MAPSIZE ||
+               gridy + sp.y < 0 || gridy + sp.y >= my_MAPSIZE;
+    };
     for( int gridz = zmin; gridz <= zmax; gridz++ ) {
         // Clear vehicle list and rebuild after shift
         clear_vehicle_cache( gridz );
         clear_vehicle_list( gridz );
         shift_bitset_cache<MAPSIZE_X, SEEX>( get_cache( gridz ).map_memory_seen_cache, sp );
         shift_bitset_cache<MAPSIZE, 1>( get_cache( gridz ).field_cache, sp );
-        if( sp.x >= 0 ) {
-            for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
-                if( sp.y >= 0 ) {
-                    for( int gridy = 0; gridy < my_MAPSIZE; gridy++ ) {
-                        if( gridx == 0 || gridy == 0 ) {
-                            submaps_with_active_items.erase( { abs.x + gridx, abs.y + gridy, gridz } );
-                        }
-                        if( gridx + sp.x < my_MAPSIZE && gridy + sp.y < my_MAPSIZE ) {
-                            copy_grid( tripoint( gridx, gridy, gridz ),
-                                       tripoint( gridx + sp.x, gridy + sp.y, gridz ) );
-                            update_vehicle_list( get_submap_at_grid( {gridx, gridy, gridz} ), gridz );
-                        } else {
-                            loadn( tripoint( gridx, gridy, gridz ), true );
-                        }
-                    }
-                } else { // sy < 0; work through it backwards
-                    for( int gridy = my_MAPSIZE - 1; gridy >= 0; gridy-- ) {
-                        if( gridx == 0 || gridy == my_MAPSIZE - 1 ) {
-                            submaps_with_active_items.erase( { abs.x + gridx, abs.y + gridy, gridz } );
-                        }
-                        if( gridx + sp.x < my_MAPSIZE && gridy + sp.y >= 0 ) {
-                            copy_grid( tripoint( gridx, gridy, gridz ),
-                                       tripoint( gridx + sp.x, gridy + sp.y, gridz ) );
-                            update_vehicle_list( get_submap_at_grid( { gridx, gridy, gridz } ), gridz );
-                        } else {
-                            loadn( tripoint( gridx, gridy, gridz ), true );
-                        }
-                    }
+        for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
+            for( int gridy = 0; gridy < my_MAPSIZE; gridy++ ) {
+                // The submap that was at these grid coordinates before the shift went out of range
+                if( gridx - sp.x < 0 || gridx - sp.x >= my_MAPSIZE ||
+                    gridy - sp.y < 0 || gridy - sp.y >= my_MAPSIZE ) {
+                    submaps_with_active_items.erase( { abs.x + gridx, abs.y + gridy, gridz } );
+                }
+                if( exposed( gridx, gridy ) ) {
+                    continue;
                 }
+                submap *const smap = get_submap_at_grid( { gridx, gridy, gridz } );
+                // Anything can change it while it's part of the map.
+                smap->modified = true;
+                for( auto &veh : smap->vehicles ) {
+                    veh->sm_pos = tripoint( gridx, gridy, gridz );
+                }
+                update_vehicle_list( smap, gridz );
             }
-        } else { // sx < 0; work through it backwards
-            for( int gridx = my_MAPSIZE - 1; gridx >= 0; gridx-- ) {
-                if( sp.y >= 0 ) {
-                    for( int gridy = 0; gridy < my_MAPSIZE; gridy++ ) {
-                        if( gridx == my_MAPSIZE - 1 || gridy == 0 ) {
-                            submaps_with_active_items.erase( { abs.x + gridx, abs.y + gridy, gridz } );
-                        }
-                        if( gridx + sp.x >= 0 && gridy + sp.y < my_MAPSIZE ) {
-                            copy_grid( tripoint( gridx, gridy, gridz ),
-                                       tripoint( gridx + sp.x, gridy + sp.y, gridz ) );
-                            update_vehicle_list( get_submap_at_grid( { gridx, gridy, gridz } ), gridz );
-                        } else {
-                            loadn( tripoint( gridx, gridy, gridz ), true );
-                        }
-                    }
-                } else { // sy < 0; work through it backwards
-                    for( int gridy = my_MAPSIZE - 1; gridy >= 0; gridy-- ) {
-                        if( gridx == my_MAPSIZE - 1 || gridy == my_MAPSIZE - 1 ) {
-                            submaps_with_active_items.erase( { abs.x + gridx, abs.y + gridy, gridz } );
-                        }
-                        if( gridx + sp.x >= 0 && gridy + sp.y >= 0 ) {
-                            copy_grid( tripoint( gridx, gridy, gridz ),
-                                       tripoint( gridx + sp.x, gridy + sp.y, gridz ) );
-                            update_vehicle_list( get_submap_at_grid( { gridx, gridy, gridz } ), gridz );
-                        } else {
-                            loadn( tripoint( gridx, gridy, gridz ), true );
-                        }
-                    }
+        }
+        // Only once everything that stayed is in place, loading can look at the neighbours
+        for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
+            for( int gridy = 0; gridy < my_MAPSIZE; gridy++ ) {
+                if( exposed( gridx, gridy ) ) {
+                    loadn( tripoint( gridx, gridy, gridz ), true );
                 }
             }
         }
@@ -6703,6 +6782,27 @@ void map::shift( const point &sp )
             support_cache_dirty.insert( pt + point( -sp.x * SEEX, -sp.y * SEEY ) );
         }
     }
+
+    // Whoever moved the map is likely to keep going the same way, so start reading the
+    // submaps the next shift would load. Quads are two submaps wide, so look two columns
+    // (or rows) past the edge.
+    std::vector<tripoint> ahead;
+    const tripoint new_abs = get_abs_sub();
+    for( int gridz = zmin; gridz <= zmax; gridz++ ) {
+        for( int i = -1; i <= my_MAPSIZE; i++ ) {
+            for( int past_edge = 0; past_edge < 2; past_edge++ ) {
+                if( sp.x != 0 ) {
+                    const int gridx = sp.x > 0 ? my_MAPSIZE + past_edge : -1 - past_edge;
+                    ahead.emplace_back( new_abs.x + gridx, new_abs.y + i, gridz );
+                }
+                if( sp.y != 0 ) {
+                    const int gridy = sp.y > 0 ? my_MAPSIZE + past_edge : -1 - past_edge;
+                    ahead.emplace_back( new_abs.x + i, new_abs.y + gridy, gridz );
+                }
+            }
+        }
+    }
+    MAPBUFFER.prefetch( ahead );
 }
 
 void map::vertical_shift( const int newz )
@@ -7270,7 +7370,7 @@ void map::actualize( const tripoint &grid )
                 field_furn_locs.push_back( pnt );
             }
             // plants contain a seed item which must not be removed under any circumstances
-            if( !furn.has_flag( "DONT_REMOVE_ROTTEN" ) ) {
+            if( !furn.has_flag( "DONT_REMOVE_ROTTEN" ) && tmpsub->itm.allocated() ) {
                 remove_rotten_items( tmpsub->itm[x][y], pnt );
             }
 
@@ -7295,7 +7395,9 @@ void map::actualize( const tripoint &grid )
 
             rad_scorch( pnt, time_since_last_actualize );
 
-            decay_cosmetic_fields( pnt, time_since_last_actualize );
+            if( tmpsub->fld.allocated() ) {
+                decay_cosmetic_fields( pnt, time_since_last_actualize );
+            }
         }
     }
 
@@ -7350,21 +7452,11 @@ void map::add_roofs( const tripoint &grid )
     }
 }
 
-void map::copy_grid( const tripoint &to, const tripoint &from )
-{
-    const auto smap = get_submap_at_grid( from );
-    setsubmap( get_nonant( to ), smap );
-    for( auto &it : smap->vehicles ) {
-        it->sm_pos = to;
-    }
-}
-
-void map::spawn_monsters_submap_group( const tripoint &gp, mongroup &group, bool ignore_sight )
+bool map::group_spawn_locations( const tripoint &gp, bool ignore_sight,
+                                 std::vector<tripoint> &locations )
 {
     const int s_range = std::min( HALF_MAPSIZE_X,
                                   g->u.sight_range( g->light_level( g->u.posz() ) ) );
-    int pop = group.population;
-    std::vector<tripoint> locations;
     if( !ignore_sight ) {
         // If the submap is one of the outermost submaps, assume that monsters are
         // invisible there.
@@ -7378,7 +7470,7 @@ void map::spawn_monsters_submap_group( const tripoint &gp, mongroup &group, bool
         ignore_sight = true;
     }
 
-    static const auto allow_on_terrain = [&]( const tripoint & p ) {
+    const auto allow_on_terrain = [this]( const tripoint & p ) {
         // @todo flying creatures should be allowed to spawn without a floor,
         // but the new creature is created *after* determining the terrain, so
         // we can't check for it here.
@@ -7393,17 +7485,14 @@ void map::spawn_monsters_submap_group( const tripoint &gp, mongroup &group, bool
         const tripoint upper_left{ SEEX * gp.x, SEEY * gp.y, gp.z };
         if( !allow_on_terrain( upper_left ) ||
             ( !ignore_inside_checks && has_flag_ter_or_furn( TFLAG_INDOORS, upper_left ) ) ) {
-            const tripoint glp = getabs( gp );
-            dbg( D_WARNING ) << "Empty locations for group " << group.type.str() <<
-                             " at uniform submap " << gp.x << "," << gp.y << "," << gp.z <<
-                             " global " << glp.x << "," << glp.y << "," << glp.z;
-            return;
+            return false;
         }
 
         ignore_terrain_checks = true;
         ignore_inside_checks = true;
     }
 
+    locations.reserve( SEEX * SEEY );
     for( int x = 0; x < SEEX; ++x ) {
         for( int y = 0; y < SEEY; ++y ) {
             int fx = x + SEEX * gp.x;
@@ -7428,7 +7517,13 @@ void map::spawn_monsters_submap_group( const tripoint &gp, mongroup &group, bool
             locations.push_back( fp );
         }
     }
+    return true;
+}
 
+void map::spawn_monsters_submap_group( const tripoint &gp, mongroup &group,
+                                       std::vector<tripoint> &locations )
+{
+    int pop = group.population;
     if( locations.empty() ) {
         // TODO: what now? there is no possible place to spawn monsters, most
         // likely because the player can see all the places.
@@ -7499,8 +7594,22 @@ void map::spawn_monsters_submap( const tripoint &gp, bool ignore_sight )
 
     // Only spawn new monsters after existing monsters are loaded.
     auto groups = overmap_buffer.groups_at( gp + abs_sub.xy() );
-    for( auto &mgp : groups ) {
-        spawn_monsters_submap_group( gp, *mgp, ignore_sight );
+    if( !groups.empty() ) {
+        // The candidate tiles are the same for every group here, except for the ones
+        // that earlier groups have taken, so gather them once.
+        std::vector<tripoint> locations;
+        if( group_spawn_locations( gp, ignore_sight, locations ) ) {
+            for( auto &mgp : groups ) {
+                spawn_monsters_submap_group( gp, *mgp, locations );
+            }
+        } else {
+            const tripoint glp = getabs( gp );
+            for( auto &mgp : groups ) {
+                dbg( D_WARNING ) << "Empty locations for group " << mgp->type.str() <<
+                                 " at uniform submap " << gp.x << "," << gp.y << "," << gp.z <<
+                                 " global " << glp.x << "," << glp.y << "," << glp.z;
+            }
+        }
     }
 
     submap *const current_submap = get_submap_at_grid( gp );
@@ -7756,8 +7865,8 @@ void map::build_outside_cache( const int zlev )
 
     auto &outside_cache = ch.outside_cache;
     if( zlev < 0 ) {
-        std::uninitialized_fill_n(
-            &outside_cache[0][0], ( MAPSIZE_X ) * ( MAPSIZE_Y ), false );
+        outside_cache.fill( false );
+        ch.submap_has_outside.reset();
         return;
     }
 
@@ -7768,6 +7877,18 @@ void map::build_outside_cache( const int zlev )
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
             const auto cur_submap = get_submap_at_grid( { smx, smy, zlev } );
 
+            if( cur_submap->is_uniform ) {
+                // A solid block of terrain, so one tile decides for the whole submap
+                if( cur_submap->get_ter( point_zero ).obj().has_flag( TFLAG_INDOORS ) ) {
+                    for( int x = smx * SEEX; x < ( smx + 1 ) * SEEX + 2; x++ ) {
+                        for( int y = smy * SEEY; y < ( smy + 1 ) * SEEY + 2; y++ ) {
+                            padded_cache[x][y] = false;
+                        }
+                    }
+                }
+                continue;
+            }
+
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
                     point sp( sx, sy );
@@ -7789,10 +7910,27 @@ void map::build_outside_cache( const int zlev )
 
     // Copy the padded cache back to the proper one, but with no padding
     for( int x = 0; x < SEEX * my_MAPSIZE; x++ ) {
-        std::copy_n( &padded_cache[x + 1][1], SEEX * my_MAPSIZE, &outside_cache[x][0] );
+        for( int y = 0; y < SEEY * my_MAPSIZE; y++ ) {
+            outside_cache.set( { x, y }, padded_cache[x + 1][y + 1] );
+        }
+    }
+
+    // Submaps past my_MAPSIZE are left marked as possibly having outside tiles
+    for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            bool has_outside = false;
+            for( int x = smx * SEEX; x < ( smx + 1 ) * SEEX && !has_outside; x++ ) {
+                for( int y = smy * SEEY; y < ( smy + 1 ) * SEEY && !has_outside; y++ ) {
+                    has_outside = outside_cache.get( { x, y } );
+                }
+            }
+            ch.submap_has_outside.set( smx + smy * MAPSIZE, has_outside );
+        }
     }
 
     ch.outside_cache_dirty = false;
+    // Weather sight penalty in the transparency cache depends on the outside cache
+    ch.transparency_cache_dirty.set();
 }
 
 void map::build_obstacle_cache( const tripoint &start, const tripoint &end,
@@ -7877,9 +8015,23 @@ bool map::build_floor_cache( const int zlev )
     std::uninitialized_fill_n(
         &floor_cache[0][0], ( MAPSIZE_X ) * ( MAPSIZE_Y ), true );
 
+    ch.submap_fully_floored.reset();
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
             const auto cur_submap = get_submap_at_grid( { smx, smy, zlev } );
+            bool fully_floored = true;
+
+            if( cur_submap->is_uniform ) {
+                // A solid block of terrain, so one tile decides for the whole submap
+                if( cur_submap->get_ter( point_zero ).obj().has_flag( TFLAG_NO_FLOOR ) ) {
+                    fully_floored = false;
+                    for( int x = smx * SEEX; x < ( smx + 1 ) * SEEX; x++ ) {
+                        std::fill_n( &floor_cache[x][smy * SEEY], SEEY, false );
+                    }
+                }
+                ch.submap_fully_floored.set( smx + smy * MAPSIZE, fully_floored );
+                continue;
+            }
 
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
@@ -7889,18 +8041,39 @@ bool map::build_floor_cache( const int zlev )
                         const int x = sx + smx * SEEX;
                         const int y = sy + smy * SEEY;
                         floor_cache[x][y] = false;
+                        fully_floored = false;
                     }
                 }
             }
+            ch.submap_fully_floored.set( smx + smy * MAPSIZE, fully_floored );
         }
     }
 
     ch.floor_cache_dirty = false;
+    ch.floor_cache_version++;
     return zlevels;
 }
 
+void map::memory_usage( memory_census::census &c ) const
+{
+    for( const std::unique_ptr<level_cache> &cache : caches ) {
+        if( cache ) {
+            c.add( "map caches", "level cache", 1, sizeof( level_cache ) );
+        }
+    }
+    for( const std::unique_ptr<pathfinding_cache> &cache : pathfinding_caches ) {
+        if( cache ) {
+            c.add( "map caches", "pathfinding cache", 1, sizeof( pathfinding_cache ) );
+        }
+    }
+    if( bulk_light ) {
+        c.add( "map caches", "bulk light cache", 1, sizeof( bulk_light_cache ) );
+    }
+}
+
 void map::build_floor_caches()
 {
+    turn_profile::phase timer( "caches" );
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int z = minz; z <= maxz; z++ ) {
@@ -7914,6 +8087,9 @@ void map::do_vehicle_caching( int z )
     auto &outside_cache = ch.outside_cache;
     auto &transparency_cache = ch.transparency_cache;
     auto &floor_cache = ch.floor_cache;
+    // What the caches look like is what the seen cache is reused by, so changes count
+    bool transparency_changed = false;
+    bool floor_changed = false;
     for( vehicle *v : ch.vehicle_list ) {
         for( const vpart_reference &vp : v->get_all_parts() ) {
             const size_t part = vp.part_index();
@@ -7930,49 +8106,105 @@ void map::do_vehicle_caching( int z )
             if( vehicle_is_opaque ) {
                 int dpart = v->part_with_feature( part, VPFLAG_OPENABLE, true );
                 if( dpart < 0 || !v->parts[dpart].open ) {
-                    transparency_cache[px][py] = LIGHT_TRANSPARENCY_SOLID;
+                    if( transparency_cache[px][py] != LIGHT_TRANSPARENCY_SOLID ) {
+                        transparency_cache[px][py] = LIGHT_TRANSPARENCY_SOLID;
+                        transparency_changed = true;
+                    }
                 } else {
                     vehicle_is_opaque = false;
                 }
             }
 
             if( vehicle_is_opaque || vp.is_inside() ) {
-                outside_cache[px][py] = false;
+                outside_cache.reset( { px, py } );
             }
 
-            if( vp.has_feature( VPFLAG_BOARDABLE ) && !vp.part().is_broken() ) {
+            if( vp.has_feature( VPFLAG_BOARDABLE ) && !vp.part().is_broken() && !floor_cache[px][py] ) {
                 floor_cache[px][py] = true;
+                floor_changed = true;
             }
         }
     }
+    if( transparency_changed ) {
+        ch.transparency_cache_version++;
+    }
+    if( floor_changed ) {
+        ch.floor_cache_version++;
+    }
 }
 
 void map::build_map_cache( const int zlev, bool skip_lightmap )
 {
+    turn_profile::phase timer( "caches" );
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
-    for( int z = minz; z <= maxz; z++ ) {
-        build_outside_cache( z );
-        seen_cache_dirty |= build_transparency_cache( z );
-        seen_cache_dirty |= build_floor_cache( z );
-        do_vehicle_caching( z );
+    const int num_threads = zlevels ?
+                            std::min( get_option<int>( "MAP_CACHE_THREADS" ), maxz - minz + 1 ) : 1;
+    if( num_threads > 1 ) {
+        // The outside, transparency and floor caches of a level only read that level's submaps
+        // and only write that level's cache, so the levels can be built independently.
+        // Each level writes its own result and they are only combined once all of them are
+        // done, so the outcome doesn't depend on how the threads were scheduled.
+        std::array<bool, OVERMAP_LAYERS> level_dirty = {};
+        // Level caches are allocated on first access, do that before the threads share them.
+        for( int z = minz; z <= maxz; z++ ) {
+            get_cache( z );
+        }
+        thread_pool::parallel_for( minz, maxz + 1, num_threads, [&]( const int z ) {
+            build_outside_cache( z );
+            const bool transparency_dirty = build_transparency_cache( z );
+            const bool floor_dirty = build_floor_cache( z );
+            level_dirty[z + OVERMAP_DEPTH] = transparency_dirty || floor_dirty;
+        } );
+        // Vehicles span levels and touch shared state, so they are still cached in order.
+        for( int z = minz; z <= maxz; z++ ) {
+            seen_cache_dirty |= level_dirty[z + OVERMAP_DEPTH];
+            do_vehicle_caching( z );
+        }
+    } else {
+        for( int z = minz; z <= maxz; z++ ) {
+            build_outside_cache( z );
+            seen_cache_dirty |= build_transparency_cache( z );
+            seen_cache_dirty |= build_floor_cache( z );
+            do_vehicle_caching( z );
+        }
     }
 
     // The tile player is standing on should always be transparent
     const tripoint &p = g->u.pos();
     if( ( has_furn( p ) && !furn( p ).obj().transparent ) || !ter( p ).obj().transparent ) {
-        get_cache( p.z ).transparency_cache[p.x][p.y] = LIGHT_TRANSPARENCY_CLEAR;
+        auto &player_cache = get_cache( p.z );
+        float &player_transparency = player_cache.transparency_cache[p.x][p.y];
+        if( player_transparency != LIGHT_TRANSPARENCY_CLEAR ) {
+            player_transparency = LIGHT_TRANSPARENCY_CLEAR;
+            player_cache.transparency_cache_version++;
+            seen_cache_dirty = true;
+        }
     }
 
+    // The seen cache only depends on where it's seen from, on the transparency and floor
+    // caches and on how far vision is 3D, so if none of them changed since it was last built
+    // (the player is waiting, crafting, reading...) the old result is still valid.
+    std::array<std::pair<unsigned int, unsigned int>, OVERMAP_LAYERS> seen_inputs;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        const level_cache &ch = get_cache( z );
+        seen_inputs[z + OVERMAP_DEPTH] = { ch.transparency_cache_version, ch.floor_cache_version };
+    }
+    seen_cache_dirty |= seen_inputs != seen_cache_inputs || fov_3d != seen_cache_fov_3d ||
+                        ( fov_3d && fov_3d_z_range != seen_cache_fov_3d_z_range );
+
     if( seen_cache_dirty ) {
         skew_vision_cache.clear();
     }
-    // Initial value is illegal player position.
-    static tripoint player_prev_pos;
-    if( seen_cache_dirty || player_prev_pos != p ) {
+    // Mirrors and cameras depend on the state of the vehicle's parts, which no version
+    // follows, so in a vehicle it is always rebuilt.
+    if( seen_cache_dirty || seen_cache_origin != p || veh_at( p ) ) {
         build_seen_cache( g->u.pos(), zlev );
-        player_prev_pos = p;
+        seen_cache_origin = p;
+        seen_cache_inputs = seen_inputs;
+        seen_cache_fov_3d = fov_3d;
+        seen_cache_fov_3d_z_range = fov_3d_z_range;
     }
     if( !skip_lightmap ) {
         generate_lightmap( zlev );
@@ -8083,6 +8315,8 @@ void map::setsubmap( const size_t grididx, submap *const smap )
         debugmsg( "Tried to set NULL submap pointer at index %d", grididx );
         return;
     }
+    // Anything can change it while it's part of the map.
+    smap->modified = true;
     grid[grididx] = smap;
 }
 
@@ -8140,11 +8374,13 @@ size_t map::get_nonant( const tripoint &gridp ) const
         return 0;
     }
 
+    const int x = ( gridp.x + grid_origin.x ) % my_MAPSIZE;
+    const int y = ( gridp.y + grid_origin.y ) % my_MAPSIZE;
     if( zlevels ) {
         const int indexz = gridp.z + OVERMAP_HEIGHT; // Can't be lower than 0
-        return indexz + ( gridp.x + gridp.y * my_MAPSIZE ) * OVERMAP_LAYERS;
+        return indexz + ( x + y * my_MAPSIZE ) * OVERMAP_LAYERS;
     } else {
-        return gridp.x + gridp.y * my_MAPSIZE;
+        return x + y * my_MAPSIZE;
     }
 }
 
@@ -8513,7 +8749,7 @@ std::list<Creature *> map::get_creatures_in_radius( const tripoint &center, size
 level_cache &map::access_cache( int zlev )
 {
     if( zlev >= -OVERMAP_DEPTH && zlev <= OVERMAP_HEIGHT ) {
-        return *caches[zlev + OVERMAP_DEPTH];
+        return get_cache( zlev );
     }
 
     debugmsg( "access_cache called with invalid z-level: %d", zlev );
@@ -8523,7 +8759,7 @@ level_cache &map::access_cache( int zlev )
 const level_cache &map::access_cache( int zlev ) const
 {
     if( zlev >= -OVERMAP_DEPTH && zlev <= OVERMAP_HEIGHT ) {
-        return *caches[zlev + OVERMAP_DEPTH];
+        return get_cache( zlev );
     }
 
     debugmsg( "access_cache called with invalid z-level: %d", zlev );
@@ -8533,39 +8769,64 @@ const level_cache &map::access_cache( int zlev ) const
 level_cache::level_cache()
 {
     const int map_dimensions = MAPSIZE_X * MAPSIZE_Y;
-    transparency_cache_dirty = true;
+    transparency_cache_dirty.set();
+    transparency_cache_version = 0;
     outside_cache_dirty = true;
+    submap_has_outside.set();
     floor_cache_dirty = false;
+    floor_cache_version = 0;
+    light_cache_version = 0;
     constexpr four_quadrants four_zeros( 0.0f );
     std::fill_n( &lm[0][0], map_dimensions, four_zeros );
     std::fill_n( &sm[0][0], map_dimensions, 0.0f );
     std::fill_n( &light_source_buffer[0][0], map_dimensions, 0.0f );
-    std::fill_n( &outside_cache[0][0], map_dimensions, false );
+    outside_cache.fill( false );
     std::fill_n( &floor_cache[0][0], map_dimensions, false );
     std::fill_n( &transparency_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &seen_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &camera_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &visibility_cache[0][0], map_dimensions, LL_DARK );
     veh_in_active_range = false;
-    std::fill_n( &veh_exists_at[0][0], map_dimensions, false );
+    veh_exists_at.fill( false );
 }
 
 pathfinding_cache::pathfinding_cache()
 {
-    dirty = true;
+    dirty.set();
 }
 
 pathfinding_cache::~pathfinding_cache() = default;
 
 pathfinding_cache &map::get_pathfinding_cache( int zlev ) const
 {
-    return *pathfinding_caches[zlev + OVERMAP_DEPTH];
+    std::unique_ptr<pathfinding_cache> &cache = pathfinding_caches[zlev + OVERMAP_DEPTH];
+    if( !cache ) {
+        cache = std::make_unique<pathfinding_cache>();
+    }
+    return *cache;
 }
 
 void map::set_pathfinding_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
-        get_pathfinding_cache( zlev ).dirty = true;
+        get_pathfinding_cache( zlev ).dirty.set();
+    }
+}
+
+void map::set_pathfinding_cache_dirty( const tripoint &p )
+{
+    if( inbounds( p ) ) {
+        get_pathfinding_cache( p.z ).dirty.set( static_cast<size_t>(
+                p.x / SEEX + ( p.y / SEEY ) * MAPSIZE ) );
+    }
+}
+
+void map::set_pathfinding_cache_dirty( const vehicle &veh )
+{
+    for( const vehicle_part &part : veh.parts ) {
+        if( !part.removed ) {
+            set_pathfinding_cache_dirty( veh.global_part_pos3( part ) );
+        }
     }
 }
 
@@ -8573,10 +8834,10 @@ const pathfinding_cache &map::get_pathfinding_cache_ref( int zlev ) const
 {
     if( !inbounds_z( zlev ) ) {
         debugmsg( "Tried to get pathfinding cache for out of bounds z-level %d", zlev );
-        return *pathfinding_caches[ OVERMAP_DEPTH ];
+        return get_pathfinding_cache( 0 );
     }
     auto &cache = get_pathfinding_cache( zlev );
-    if( cache.dirty ) {
+    if( cache.dirty.any() ) {
         update_pathfinding_cache( zlev );
     }
 
@@ -8586,14 +8847,23 @@ const pathfinding_cache &map::get_pathfinding_cache_ref( int zlev ) const
 void map::update_pathfinding_cache( int zlev ) const
 {
     auto &cache = get_pathfinding_cache( zlev );
-    if( !cache.dirty ) {
+    if( cache.dirty.none() ) {
         return;
     }
 
-    std::uninitialized_fill_n( &cache.special[0][0], MAPSIZE_X * MAPSIZE_Y, PF_NORMAL );
+    if( cache.dirty.all() ) {
+        std::uninitialized_fill_n( &cache.special[0][0], MAPSIZE_X * MAPSIZE_Y, PF_NORMAL );
+    }
+    // These are built from all of `special`, so any change invalidates them.
+    cache.flow_fields.clear();
+    cache.submap_graph.built = false;
+    cache.route_memo.clear();
 
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            if( !cache.dirty[smx + smy * MAPSIZE] ) {
+                continue;
+            }
             const auto cur_submap = get_submap_at_grid( { smx, smy, zlev } );
 
             tripoint p( 0, 0, zlev );
@@ -8651,7 +8921,7 @@ void map::update_pathfinding_cache( int zlev ) const
         }
     }
 
-    cache.dirty = false;
+    cache.dirty.reset();
 }
 
 void map::clip_to_bounds( tripoint &p ) const
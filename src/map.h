@@ -10,12 +10,14 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <functional>
 #include <string>
 #include <tuple>
 
+#include "bit_grid.h"
 #include "calendar.h"
 #include "colony.h"
 #include "enums.h"
@@ -42,6 +44,10 @@ namespace catacurses
 {
 class window;
 } // namespace catacurses
+namespace memory_census
+{
+class census;
+} // namespace memory_census
 class optional_vpart_position;
 class player;
 class monster;
@@ -58,6 +64,7 @@ class submap;
 class item_location;
 class map_cursor;
 struct maptile;
+struct map_glyph;
 struct mapgendata;
 class basecamp;
 class computer;
@@ -90,6 +97,7 @@ class map;
 enum ter_bitflags : int;
 struct pathfinding_cache;
 struct pathfinding_settings;
+struct path_flow_field;
 template<typename T>
 struct weighted_int_list;
 
@@ -119,6 +127,35 @@ struct visibility_variables {
     float vision_threshold;
 };
 
+/**
+ * Everything visibility_cache of a level was last computed from, so
+ * map::update_visibility_cache can skip recomputing it when none of it changed.
+ */
+struct visibility_cache_inputs {
+    // False until the cache has been computed once.
+    bool valid = false;
+    tripoint abs_sub;
+    tripoint viewer;
+    int unimpaired_range = 0;
+    visibility_variables variables = {};
+    unsigned int light_cache_version = 0;
+    unsigned int transparency_cache_version = 0;
+    unsigned int seen_cache_version = 0;
+
+    bool operator==( const visibility_cache_inputs &rhs ) const {
+        return valid == rhs.valid && abs_sub == rhs.abs_sub && viewer == rhs.viewer &&
+               unimpaired_range == rhs.unimpaired_range &&
+               variables.u_sight_impaired == rhs.variables.u_sight_impaired &&
+               variables.u_is_boomered == rhs.variables.u_is_boomered &&
+               variables.g_light_level == rhs.variables.g_light_level &&
+               variables.u_clairvoyance == rhs.variables.u_clairvoyance &&
+               variables.vision_threshold == rhs.variables.vision_threshold &&
+               light_cache_version == rhs.light_cache_version &&
+               transparency_cache_version == rhs.transparency_cache_version &&
+               seen_cache_version == rhs.seen_cache_version;
+    }
+};
+
 struct bash_params {
     int strength; // Initial strength
 
@@ -149,29 +186,68 @@ struct level_cache {
     level_cache(); // Zeros all relevant values
     level_cache( const level_cache &other ) = default;
 
-    bool transparency_cache_dirty;
+    // One bit per submap, set when that submap's part of transparency_cache is stale.
+    std::bitset<MAPSIZE *MAPSIZE> transparency_cache_dirty;
+    // Bumped whenever transparency_cache changes, so results derived from it can be reused.
+    unsigned int transparency_cache_version;
     bool outside_cache_dirty;
+    // One bit per submap, cleared when none of its tiles are outside.
+    std::bitset<MAPSIZE *MAPSIZE> submap_has_outside;
+    // One bit per submap, set when all of its tiles have a floor.
+    std::bitset<MAPSIZE *MAPSIZE> submap_fully_floored;
     bool floor_cache_dirty;
+    // Bumped whenever floor_cache is rebuilt.
+    unsigned int floor_cache_version;
+    // Bumped whenever lm and sm are regenerated.
+    unsigned int light_cache_version;
 
     four_quadrants lm[MAPSIZE_X][MAPSIZE_Y];
     float sm[MAPSIZE_X][MAPSIZE_Y];
     // To prevent redundant ray casting into neighbors: precalculate bulk light source positions.
     // This is only valid for the duration of generate_lightmap
     float light_source_buffer[MAPSIZE_X][MAPSIZE_Y];
-    bool outside_cache[MAPSIZE_X][MAPSIZE_Y];
+    bit_grid<MAPSIZE_X, MAPSIZE_Y> outside_cache;
     bool floor_cache[MAPSIZE_X][MAPSIZE_Y];
     float transparency_cache[MAPSIZE_X][MAPSIZE_Y];
     float seen_cache[MAPSIZE_X][MAPSIZE_Y];
     float camera_cache[MAPSIZE_X][MAPSIZE_Y];
     lit_level visibility_cache[MAPSIZE_X][MAPSIZE_Y];
+    visibility_cache_inputs visibility_inputs;
     std::bitset<MAPSIZE_X *MAPSIZE_Y> map_memory_seen_cache;
     std::bitset<MAPSIZE *MAPSIZE> field_cache;
 
     bool veh_in_active_range;
-    bool veh_exists_at[MAPSIZE_X][MAPSIZE_Y];
-    std::map< tripoint, std::pair<vehicle *, int> > veh_cached_parts;
+    bit_grid<MAPSIZE_X, MAPSIZE_Y> veh_exists_at;
+    /**
+     * Vehicle and part index on every tile of the level, only meaningful where veh_exists_at
+     * is set. Allocated the first time a vehicle is cached on this level.
+     */
+    std::vector<std::pair<vehicle *, int>> veh_parts_grid;
+    // Every cached part position with its vehicle, including positions outside the map.
+    std::vector<std::pair<tripoint, vehicle *>> veh_cached_parts;
     std::set<vehicle *> vehicle_list;
     std::set<vehicle *> zone_vehicles;
+
+    std::pair<vehicle *, int> &veh_part_at( const point &p ) {
+        return veh_parts_grid[p.x * MAPSIZE_Y + p.y];
+    }
+    const std::pair<vehicle *, int> &veh_part_at( const point &p ) const {
+        return veh_parts_grid[p.x * MAPSIZE_Y + p.y];
+    }
+};
+
+/**
+ * Light cast by the buffered bulk light sources (see map::add_light_source).
+ * Kept between calls to map::generate_lightmap, so it only has to be cast again
+ * when the sources or the transparency of the level they light change.
+ */
+struct bulk_light_cache {
+    int zlev = 0;
+    unsigned int transparency_cache_version = 0;
+    // Copy of level_cache::light_source_buffer these results were cast from.
+    float sources[MAPSIZE_X][MAPSIZE_Y];
+    four_quadrants lm[MAPSIZE_X][MAPSIZE_Y];
+    float sm[MAPSIZE_X][MAPSIZE_Y];
 };
 
 /**
@@ -190,7 +266,8 @@ struct level_cache {
  *     0 1 2
  *     3 4 5
  *     6 7 8
- * In this example, the top-right submap would be at `grid[2]`.
+ * In this example, the top-right submap would be at `grid[2]`, as long as the map has not been
+ * shifted. Shifting the map moves @ref grid_origin instead of the pointers, see @ref get_nonant.
  *
  * When the player moves between submaps, the whole map is shifted, so that if the player moves one submap to the right,
  * (0, 0) now points to a tile one submap to the right from before
@@ -218,7 +295,15 @@ class map
         /*@{*/
         void set_transparency_cache_dirty( const int zlev ) {
             if( inbounds_z( zlev ) ) {
-                get_cache( zlev ).transparency_cache_dirty = true;
+                get_cache( zlev ).transparency_cache_dirty.set();
+            }
+        }
+
+        // Only dirty the submap containing p, for changes local to one tile.
+        void set_transparency_cache_dirty( const tripoint &p ) {
+            if( inbounds( p ) ) {
+                get_cache( p.z ).transparency_cache_dirty.set( static_cast<size_t>(
+                            p.x / SEEX + ( p.y / SEEY ) * MAPSIZE ) );
             }
         }
 
@@ -235,6 +320,8 @@ class map
         }
 
         void set_pathfinding_cache_dirty( int zlev );
+        // Only dirty the submap containing p, for changes local to one tile.
+        void set_pathfinding_cache_dirty( const tripoint &p );
         /*@}*/
 
         void set_memory_seen_cache_dirty( const tripoint &p ) {
@@ -248,7 +335,7 @@ class map
             if( inbounds_z( zlev ) ) {
                 level_cache &ch = get_cache( zlev );
                 ch.floor_cache_dirty = true;
-                ch.transparency_cache_dirty = true;
+                ch.transparency_cache_dirty.set();
                 ch.outside_cache_dirty = true;
             }
         }
@@ -442,6 +529,13 @@ class map
         * Returns whether `F` sees `T` with a view range of `range`.
         */
         bool sees( const tripoint &F, const tripoint &T, int range ) const;
+        /**
+         * Returns for every one of `observers` whether it sees `T` with a view range of `range`,
+         * with the same answers as calling the single-pair sees() for each of them.
+         * Checks on `T` are done once, and all the rays share the results cached per turn.
+         */
+        std::vector<bool> sees( const std::vector<tripoint> &observers, const tripoint &T,
+                                int range ) const;
     private:
         /**
          * Don't expose the slope adjust outside map functions.
@@ -454,6 +548,8 @@ class map
          * Set to zero if the function returns false.
         **/
         bool sees( const tripoint &F, const tripoint &T, int range, int &bresenham_slope ) const;
+        /** sees() for a `T` already known to be in bounds and within range of `F`. */
+        bool sees_in_range( const tripoint &F, const tripoint &T, int &bresenham_slope ) const;
     public:
         /**
         * Returns coverage of target in relation to the observer. Target is loc2, observer is loc1.
@@ -520,6 +616,23 @@ class map
         std::vector<tripoint> route( const tripoint &f, const tripoint &t,
                                      const pathfinding_settings &settings,
         const std::set<tripoint> &pre_closed = {{ }} ) const;
+        /**
+         * Like route() without pre-closed points, for when many creatures with the same settings
+         * path to the same target, like a horde chasing the player.
+         * Once a target and settings pair is asked for repeatedly in one turn, the cost of reaching
+         * the target from every tile of its z-level is computed once and the routes are just read
+         * off it. Routes between z-levels go through route().
+         */
+        std::vector<tripoint> route_shared( const tripoint &f, const tripoint &t,
+                                            const pathfinding_settings &settings ) const;
+        /**
+         * route(), but same-level results are remembered for the rest of the turn or until the
+         * terrain changes. For activities that ask for the same routes again and again while
+         * going over their candidate tiles.
+         */
+        std::vector<tripoint> route_memoized( const tripoint &f, const tripoint &t,
+                                              const pathfinding_settings &settings,
+        const std::set<tripoint> &pre_closed = {{ }} ) const;
 
         // Vehicles: Common to 2D and 3D
         VehicleList get_vehicles();
@@ -632,7 +745,8 @@ class map
         // at specific positions. This is used to display terrain overview in
         // the map editor.
         uint8_t get_known_connections( const tripoint &p, int connect_group,
-                                       const std::map<tripoint, ter_id> &override = {} ) const;
+                                       const std::unordered_map<tripoint, ter_id> &override = {} )
+        const;
         /**
          * Returns the full harvest list, for spawning.
          */
@@ -669,7 +783,8 @@ class map
         bool could_see_items( const tripoint &p, const Creature &who ) const;
         bool could_see_items( const tripoint &p, const tripoint &from ) const;
         /**
-         * Checks for existence of items. Faster than i_at(p).empty
+         * Checks for existence of items. Faster than i_at(p).empty, and unlike that it doesn't
+         * allocate the item stacks of a submap that has none.
          */
         bool has_items( const tripoint &p ) const;
 
@@ -927,6 +1042,7 @@ class map
         void create_anomaly( const point &c, artifact_natural_property prop );
         // Items: 3D
         // Accessor that returns a wrapped reference to an item stack for safe modification.
+        // Allocates the item stacks of a submap that had none, see has_items() to only read.
         map_stack i_at( const tripoint &p );
         item water_from( const tripoint &p );
         void i_clear( const tripoint &p );
@@ -1075,7 +1191,8 @@ class map
          */
         const field &field_at( const tripoint &p ) const;
         /**
-         * Gets fields that are here. Both for querying and edition.
+         * Gets fields that are here. Both for querying and edition. Allocates the fields of a
+         * submap that had none, only querying is cheaper through the const version.
          */
         field &field_at( const tripoint &p );
         /**
@@ -1128,7 +1245,7 @@ class map
          * @return NULL if there is no such field entry at that place.
          */
         field_entry *get_field( const tripoint &p, field_type_id type );
-        bool dangerous_field_at( const tripoint &p );
+        bool dangerous_field_at( const tripoint &p ) const;
         /**
          * Add field entry at point, or set intensity if present
          * @return false if the field could not be created (out of bounds), otherwise true.
@@ -1247,6 +1364,8 @@ class map
                               bool merge_wrecks = true );
 
         void do_vehicle_caching( int z );
+        /** Adds the caches this map has allocated to the census. */
+        void memory_usage( memory_census::census &c ) const;
         // Note: in 3D mode, will actually build caches on ALL z-levels
         void build_map_cache( int zlev, bool skip_lightmap = false );
         // Unlike the other caches, this populates a supplied cache instead of an internal cache.
@@ -1344,8 +1463,14 @@ class map
     private:
         // Helper #1 - spawns monsters on one submap
         void spawn_monsters_submap( const tripoint &gp, bool ignore_sight );
-        // Helper #2 - spawns monsters on one submap and from one group on this submap
-        void spawn_monsters_submap_group( const tripoint &gp, mongroup &group, bool ignore_sight );
+        // Helper #2 - collects the tiles of one submap that overmap groups may spawn on,
+        // returns false if the submap is uniform and unusable
+        bool group_spawn_locations( const tripoint &gp, bool ignore_sight,
+                                    std::vector<tripoint> &locations );
+        // Helper #3 - spawns monsters from one group on this submap, taking the used
+        // tiles out of locations
+        void spawn_monsters_submap_group( const tripoint &gp, mongroup &group,
+                                          std::vector<tripoint> &locations );
 
     protected:
         void saven( const tripoint &grid );
@@ -1419,7 +1544,6 @@ class map
          */
         void shift_traps( const tripoint &shift );
 
-        void copy_grid( const tripoint &to, const tripoint &from );
         void draw_map( const oter_id &terrain_type, const oter_id &t_north, const oter_id &t_east,
                        const oter_id &t_south, const oter_id &t_west, const oter_id &t_neast,
                        const oter_id &t_seast, const oter_id &t_swest, const oter_id &t_nwest,
@@ -1521,6 +1645,8 @@ class map
          * Get the index of a submap pointer in the grid given by grid coordinates. The grid
          * coordinates must be valid: 0 <= x < my_MAPSIZE, same for y.
          * Version with z-levels checks for z between -OVERMAP_DEPTH and OVERMAP_HEIGHT
+         * The grid is a ring buffer: the coordinates are offset by @ref grid_origin and wrap
+         * around, so the index of a submap only depends on its absolute position.
          */
         size_t get_nonant( const point &gridp ) const;
         size_t get_nonant( const tripoint &gridp ) const;
@@ -1543,27 +1669,26 @@ class map
 
         /**
          * Internal version of the drawsq. Keeps a cached maptile for less re-getting.
+         * Puts what the tile looks like into out instead of drawing it.
          * Returns true if it has drawn all it should, false if `draw_from_above` should be called after.
          */
-        bool draw_maptile( const catacurses::window &w, const player &u, const tripoint &p,
-                           const maptile &tile,
-                           bool invert, bool show_items,
-                           const tripoint &view_center,
-                           bool low_light, bool bright_light, bool inorder ) const;
-        bool draw_maptile_from_memory( const catacurses::window &w, const tripoint &p,
-                                       const tripoint &view_center,
-                                       bool move_cursor = true ) const;
+        bool draw_maptile( map_glyph &out, const player &u, const tripoint &p,
+                           const maptile &tile, bool invert, bool show_items,
+                           bool low_light, bool bright_light ) const;
         /**
-         * Draws the tile as seen from above.
+         * Draws the tile as seen from above, into out like @ref draw_maptile.
          */
-        void draw_from_above( const catacurses::window &w, const player &u, const tripoint &p,
+        void draw_from_above( map_glyph &out, const player &u, const tripoint &p,
                               const maptile &tile, bool invert,
-                              const tripoint &view_center,
-                              bool low_light, bool bright_light, bool inorder ) const;
+                              bool low_light, bool bright_light ) const;
 
         int determine_wall_corner( const tripoint &p ) const;
         // apply a circular light pattern immediately, however it's best to use...
         void apply_light_source( const tripoint &p, float luminance );
+        // Same as above, but lights the given buffers rather than the level cache's.
+        void apply_light_source( const tripoint &p, float luminance,
+                                 four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                                 float ( &sm )[MAPSIZE_X][MAPSIZE_Y] );
         // ...this, which will apply the light after at the end of generate_lightmap, and prevent redundant
         // light rays from causing massive slowdowns, if there's a huge amount of light.
         void add_light_source( const tripoint &p, float luminance );
@@ -1637,6 +1762,11 @@ class map
          * Use @ref getsubmap or @ref setsubmap to access it.
          */
         std::vector<submap *> grid;
+        /**
+         * Where grid coordinates (0, 0) are in @ref grid. @ref shift moves this instead of
+         * every pointer, so only the submaps of the exposed edge are changed.
+         */
+        point grid_origin;
         /**
          * This vector contains an entry for each trap type, it has therefor the same size
          * as the traplist vector. Each entry contains a list of all point on the map that
@@ -1649,9 +1779,14 @@ class map
          */
         std::vector<tripoint> field_furn_locs;
         /**
-         * Holds caches for visibility, light, transparency and vehicles
+         * Holds caches for visibility, light, transparency and vehicles.
+         * Allocated on first access, most z-levels of a tinymap never need them.
+         */
+        mutable std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
+        /**
+         * Bulk light source results from the last generate_lightmap, allocated on first use.
          */
-        std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
+        std::unique_ptr<bulk_light_cache> bulk_light;
 
         mutable std::array< std::unique_ptr<pathfinding_cache>, OVERMAP_LAYERS > pathfinding_caches;
         /**
@@ -1664,24 +1799,53 @@ class map
          */
         mutable lru_cache<point, char> skew_vision_cache;
 
+        /**
+         * Where the seen cache was last built from, the transparency and floor cache
+         * versions of every z-level and the vision options at that time. Initial origin is
+         * an illegal position.
+         */
+        tripoint seen_cache_origin = tripoint_min;
+        std::array<std::pair<unsigned int, unsigned int>, OVERMAP_LAYERS> seen_cache_inputs = {};
+        bool seen_cache_fov_3d = false;
+        int seen_cache_fov_3d_z_range = 0;
+        // Bumped whenever build_seen_cache runs, as it may touch the seen caches of every level.
+        unsigned int seen_cache_version = 0;
+
         // Note: no bounds check
         level_cache &get_cache( int zlev ) const {
-            return *caches[zlev + OVERMAP_DEPTH];
+            std::unique_ptr<level_cache> &cache = caches[zlev + OVERMAP_DEPTH];
+            if( !cache ) {
+                cache = std::make_unique<level_cache>();
+            }
+            return *cache;
         }
 
         pathfinding_cache &get_pathfinding_cache( int zlev ) const;
+        // Dirties the pathfinding cache on every tile the vehicle covers.
+        void set_pathfinding_cache_dirty( const vehicle &veh );
 
         visibility_variables visibility_variables_cache;
 
     public:
         const level_cache &get_cache_ref( int zlev ) const {
-            return *caches[zlev + OVERMAP_DEPTH];
+            return get_cache( zlev );
         }
 
         const pathfinding_cache &get_pathfinding_cache_ref( int zlev ) const;
 
         void update_pathfinding_cache( int zlev ) const;
 
+    private:
+        /**
+         * Cost of the pathing step from `cur` onto the adjacent `p`, not counting the diagonal
+         * penalty, or -1 if the step can't be taken. Sets `closed` when `p` can't be entered from
+         * any direction either, and `ledge` when `p` is a trapped ledge that route() drops down from.
+         */
+        int path_step_cost( const tripoint &cur, const tripoint &p, const pathfinding_settings &settings,
+                            bool &closed, bool &ledge ) const;
+        /** Builds the costs of `field` for the z-level of its target. */
+        void build_flow_field( path_flow_field &field ) const;
+    public:
         void update_visibility_cache( int zlev );
         const visibility_variables &get_visibility_variables_cache() const;
 
@@ -19,6 +19,7 @@
 #include "map_iterator.h"
 #include "mapdata.h"
 #include "mapgen_functions.h"
+#include "mapgen_profile.h"
 #include "overmapbuffer.h"
 #include "overmap.h"
 #include "rng.h"
@@ -2716,6 +2717,7 @@ map_extra_pointer get_function( const std::string &name )
 
 void apply_function( const string_id<map_extra> &id, map &m, const tripoint &abs_sub )
 {
+    mapgen_profile::scope profile( "extra", id.str() );
     const map_extra &extra = id.obj();
     switch( extra.generator_method ) {
         case map_extra_method::map_extra_function: {
@@ -36,6 +36,7 @@
 #include "scent_map.h"
 #include "submap.h"
 #include "translations.h"
+#include "turn_profile.h"
 #include "vehicle.h"
 #include "vpart_position.h"
 #include "weather.h"
@@ -126,32 +127,33 @@ int map::burn_body_part( player &u, field_entry &cur, body_part bp, const int sc
 
 bool map::process_fields()
 {
+    turn_profile::phase timer( "fields" );
     bool dirty_transparency_cache = false;
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int z = minz; z <= maxz; z++ ) {
-        bool zlev_dirty = false;
-        auto &field_cache = get_cache( z ).field_cache;
+        auto &map_cache = get_cache( z );
+        auto &field_cache = map_cache.field_cache;
         for( int x = 0; x < my_MAPSIZE; x++ ) {
             for( int y = 0; y < my_MAPSIZE; y++ ) {
                 if( field_cache[ x + y * MAPSIZE ] ) {
                     submap *const current_submap = get_submap_at_grid( { x, y, z } );
                     const bool cur_dirty = process_fields_in_submap( current_submap, tripoint( x, y, z ) );
-                    zlev_dirty |= cur_dirty;
+                    if( !cur_dirty ) {
+                        continue;
+                    }
+                    // A field that blocks sight changed its intensity.
+                    // Fields spread into neighbouring submaps directly,
+                    // so those have to be dirtied too.
+                    for( int nx = std::max( x - 1, 0 ); nx <= std::min( x + 1, my_MAPSIZE - 1 ); nx++ ) {
+                        for( int ny = std::max( y - 1, 0 ); ny <= std::min( y + 1, my_MAPSIZE - 1 ); ny++ ) {
+                            map_cache.transparency_cache_dirty.set( nx + ny * MAPSIZE );
+                        }
+                    }
+                    dirty_transparency_cache = true;
                 }
             }
         }
-
-        if( zlev_dirty ) {
-            // For now, just always dirty the transparency cache
-            // when a field might possibly be changed.
-            // TODO: check if there are any fields(mostly fire)
-            //       that frequently change, if so set the dirty
-            //       flag, otherwise only set the dirty flag if
-            //       something actually changed
-            set_transparency_cache_dirty( z );
-            dirty_transparency_cache = true;
-        }
     }
 
     return dirty_transparency_cache;
@@ -241,11 +243,6 @@ void map::gas_spread_to( field_entry &cur, maptile &dst )
 void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
                       const time_duration &outdoor_age_speedup, scent_block &sblk )
 {
-    const oter_id &cur_om_ter = overmap_buffer.ter( ms_to_omt_copy( g->m.getabs( p ) ) );
-    const bool sheltered = g->is_sheltered( p );
-    const int winddirection = g->weather.winddirection;
-    const int windpower = get_local_windpower( g->weather.windspeed, cur_om_ter, p, winddirection,
-                          sheltered );
     // Reset nearby scents to zero
     for( const tripoint &tmp : points_in_radius( p, 1 ) ) {
         sblk.apply_gas( tmp );
@@ -258,8 +255,19 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
         cur.set_field_age( current_age + outdoor_age_speedup );
     }
 
-    // Bail out if we don't meet the spread chance or required intensity.
-    if( current_intensity <= 1 || rng( 1, 100 - windpower ) > percent_spread ) {
+    // Thin gas never spreads, so skip the wind lookups for it.
+    if( current_intensity <= 1 ) {
+        return;
+    }
+
+    const oter_id &cur_om_ter = overmap_buffer.ter( ms_to_omt_copy( g->m.getabs( p ) ) );
+    const bool sheltered = g->is_sheltered( p );
+    const int winddirection = g->weather.winddirection;
+    const int windpower = get_local_windpower( g->weather.windspeed, cur_om_ter, p, winddirection,
+                          sheltered );
+
+    // Bail out if we don't meet the spread chance.
+    if( rng( 1, 100 - windpower ) > percent_spread ) {
         return;
     }
 
@@ -276,31 +284,34 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
 
     auto neighs = get_neighbors( p );
     size_t end_it = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
-    std::vector<size_t> spread;
-    std::vector<maptile> neighbour_vec;
+    // Indices into neighs; at most eight of them, so keep them off the heap.
+    std::array<size_t, 8> spread;
+    size_t spread_count = 0;
     // Then, spread to a nearby point.
     // If not possible (or randomly), try to spread up
     // Wind direction will block the field spreading into the wind.
-    spread.reserve( 8 );
     // Start at end_it + 1, then wrap around until all elements have been processed.
     for( size_t i = ( end_it + 1 ) % neighs.size(), count = 0 ;
          count != neighs.size();
          i = ( i + 1 ) % neighs.size(), count++ ) {
         const auto &neigh = neighs[i];
         if( gas_can_spread_to( cur, neigh ) ) {
-            spread.push_back( i );
+            spread[spread_count++] = i;
         }
     }
-    auto maptiles = get_wind_blockers( winddirection, p );
-    // Three map tiles that are facing the wind direction.
-    const maptile remove_tile = std::get<0>( maptiles );
-    const maptile remove_tile2 = std::get<1>( maptiles );
-    const maptile remove_tile3 = std::get<2>( maptiles );
-    if( !zlevels || one_in( spread.size() ) ) {
+    if( !zlevels || one_in( spread_count ) ) {
         // Construct the destination from offset and p
-        if( g->is_sheltered( p ) || windpower < 5 ) {
-            gas_spread_to( cur, neighs[ random_entry( spread ) ] );
+        if( sheltered || windpower < 5 ) {
+            const size_t picked = spread_count == 0 ? 0 : spread[rng( 0, spread_count - 1 )];
+            gas_spread_to( cur, neighs[picked] );
         } else {
+            auto maptiles = get_wind_blockers( winddirection, p );
+            // Three map tiles that are facing the wind direction.
+            const maptile remove_tile = std::get<0>( maptiles );
+            const maptile remove_tile2 = std::get<1>( maptiles );
+            const maptile remove_tile3 = std::get<2>( maptiles );
+            std::array<size_t, 8> neighbour_idx;
+            size_t neighbour_count = 0;
             end_it = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
             // Start at end_it + 1, then wrap around until all elements have been processed.
             for( size_t i = ( end_it + 1 ) % neighs.size(), count = 0 ;
@@ -310,13 +321,13 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
                 if( ( neigh.x != remove_tile.x && neigh.y != remove_tile.y ) ||
                     ( neigh.x != remove_tile2.x && neigh.y != remove_tile2.y ) ||
                     ( neigh.x != remove_tile3.x && neigh.y != remove_tile3.y ) ) {
-                    neighbour_vec.push_back( neigh );
+                    neighbour_idx[neighbour_count++] = i;
                 } else if( x_in_y( 1, std::max( 2, windpower ) ) ) {
-                    neighbour_vec.push_back( neigh );
+                    neighbour_idx[neighbour_count++] = i;
                 }
             }
-            if( !neighbour_vec.empty() ) {
-                gas_spread_to( cur, neighbour_vec[rng( 0, neighbour_vec.size() - 1 )] );
+            if( neighbour_count != 0 ) {
+                gas_spread_to( cur, neighs[neighbour_idx[rng( 0, neighbour_count - 1 )]] );
             }
         }
     } else if( zlevels && p.z < OVERMAP_HEIGHT ) {
@@ -387,6 +398,10 @@ bool map::process_fields_in_submap( submap *const current_submap,
     // Loop through all tiles in this submap indicated by current_submap
     for( locx = 0; locx < SEEX; locx++ ) {
         for( locy = 0; locy < SEEY; locy++ ) {
+            // Fields only spread into tiles through add_field, which marks them
+            if( !current_submap->field_tiles.get( point( locx, locy ) ) ) {
+                continue;
+            }
             // This is a translation from local coordinates to submap coordinates.
             // All submaps are in one long 1d array.
             thep.x = locx + submap.x * SEEX;
@@ -401,7 +416,7 @@ bool map::process_fields_in_submap( submap *const current_submap,
                 field_entry &cur = it->second;
                 // The field might have been killed by processing a neighbor field
                 if( !cur.is_field_alive() ) {
-                    if( !cur.get_field_type().obj().get_transparent( cur.get_field_intensity() - 1 ) ) {
+                    if( cur.get_field_type().obj().affects_transparency() ) {
                         dirty_transparency_cache = true;
                     }
                     --current_submap->field_count;
@@ -417,7 +432,11 @@ bool map::process_fields_in_submap( submap *const current_submap,
                     debugmsg( "Whoooooa intensity of %d", cur.get_field_intensity() );
                 }
 
-                dirty_transparency_cache = curtype.obj().dirty_transparency_cache;
+                // Aging alone never changes how much a field blocks sight, only changes of
+                // intensity (including dying out) do. Fields spawned elsewhere by map::add_field
+                // dirty their own tile, direct maptile additions below mark it explicitly.
+                const bool affects_transparency = curtype.obj().affects_transparency();
+                const int intensity_before = cur.get_field_intensity();
 
                 // Don't process "newborn" fields. This gives the player time to run if they need to.
                 if( cur.get_field_age() == 0_turns ) {
@@ -848,6 +867,7 @@ bool map::process_fields_in_submap( submap *const current_submap,
                                 }
                                 if( nearwebfld ) {
                                     nearwebfld->set_field_intensity( 0 );
+                                    dirty_transparency_cache = true;
                                 }
                             }
                         }
@@ -910,6 +930,7 @@ bool map::process_fields_in_submap( submap *const current_submap,
                                 }
                                 if( nearwebfld ) {
                                     nearwebfld->set_field_intensity( 0 );
+                                    dirty_transparency_cache = true;
                                 }
                             }
                         }
@@ -1288,6 +1309,9 @@ bool map::process_fields_in_submap( submap *const current_submap,
                     cur.set_field_age( 0_turns );
                     cur.set_field_intensity( cur.get_field_intensity() - 1 );
                 }
+                if( affects_transparency && cur.get_field_intensity() != intensity_before ) {
+                    dirty_transparency_cache = true;
+                }
                 if( !cur.is_field_alive() ) {
                     --current_submap->field_count;
                     curfield.remove_field( it++ );
@@ -1295,6 +1319,9 @@ bool map::process_fields_in_submap( submap *const current_submap,
                     ++it;
                 }
             }
+            if( curfield.field_count() == 0 ) {
+                current_submap->field_tiles.reset( point( locx, locy ) );
+            }
         }
     }
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
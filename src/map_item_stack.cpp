@@ -73,43 +73,28 @@ std::vector<map_item_stack> filter_item_stacks( const std::vector<map_item_stack
 //returns the first non priority items.
 int list_filter_high_priority( std::vector<map_item_stack> &stack, const std::string &priorities )
 {
-    // TODO:optimize if necessary
-    std::vector<map_item_stack> tempstack;
-    const auto filter_fn = item_filter_from_string( priorities );
-    for( auto it = stack.begin(); it != stack.end(); ) {
-        if( priorities.empty() || ( it->example != nullptr && !filter_fn( *it->example ) ) ) {
-            tempstack.push_back( *it );
-            it = stack.erase( it );
-        } else {
-            it++;
-        }
-    }
-
-    int id = stack.size();
-    for( auto &elem : tempstack ) {
-        stack.push_back( elem );
+    if( priorities.empty() ) {
+        return 0;
     }
-    return id;
+    const auto filter_fn = item_filter_from_string( priorities );
+    // Stacks without an example stay in front, as they always did
+    const auto end = std::stable_partition( stack.begin(), stack.end(),
+    [&filter_fn]( const map_item_stack & s ) {
+        return s.example == nullptr || filter_fn( *s.example );
+    } );
+    return end - stack.begin();
 }
 
 int list_filter_low_priority( std::vector<map_item_stack> &stack, const int start,
                               const std::string &priorities )
 {
-    // TODO:optimize if necessary
-    std::vector<map_item_stack> tempstack;
-    const auto filter_fn = item_filter_from_string( priorities );
-    for( auto it = stack.begin() + start; it != stack.end(); ) {
-        if( !priorities.empty() && it->example != nullptr && filter_fn( *it->example ) ) {
-            tempstack.push_back( *it );
-            it = stack.erase( it );
-        } else {
-            it++;
-        }
-    }
-
-    int id = stack.size();
-    for( auto &elem : tempstack ) {
-        stack.push_back( elem );
+    if( priorities.empty() ) {
+        return stack.size();
     }
-    return id;
+    const auto filter_fn = item_filter_from_string( priorities );
+    const auto end = std::stable_partition( stack.begin() + start, stack.end(),
+    [&filter_fn]( const map_item_stack & s ) {
+        return s.example == nullptr || !filter_fn( *s.example );
+    } );
+    return end - stack.begin();
 }
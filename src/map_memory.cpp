@@ -1,30 +1,132 @@
 #include "map_memory.h"
 
+#include "coordinate_conversions.h"
+
 static const memorized_terrain_tile default_tile{ "", 0, 0 };
 
+const map_memory::memorized_submap *map_memory::find_block( const tripoint &sm_pos ) const
+{
+    const auto found = blocks.find( sm_pos );
+    return found == blocks.end() ? nullptr : found->second.data.get();
+}
+
+map_memory::memorized_submap &map_memory::touch_block( const tripoint &sm_pos )
+{
+    const auto found = blocks.find( sm_pos );
+    if( found != blocks.end() ) {
+        lru.splice( lru.end(), lru, found->second.lru_pos );
+        return *found->second.data;
+    }
+    lru.push_back( sm_pos );
+    block &b = blocks[sm_pos];
+    b.data = std::make_unique<memorized_submap>();
+    b.lru_pos = std::prev( lru.end() );
+    return *b.data;
+}
+
+uint32_t map_memory::tile_id_index( const std::string &id )
+{
+    const auto found = tile_id_indices.find( id );
+    if( found != tile_id_indices.end() ) {
+        return found->second;
+    }
+    const uint32_t index = tile_ids.size();
+    tile_ids.push_back( id );
+    tile_id_indices.emplace( id, index );
+    return index;
+}
+
+void map_memory::trim( const int limit )
+{
+    // The block just memorized into is the last one and always stays
+    while( ( tile_count > limit || symbol_count > limit ) && lru.size() > 1 ) {
+        const auto found = blocks.find( lru.front() );
+        tile_count -= found->second.data->tile_count;
+        symbol_count -= found->second.data->symbol_count;
+        blocks.erase( found );
+        lru.pop_front();
+    }
+}
+
+void map_memory::clear()
+{
+    blocks.clear();
+    lru.clear();
+    tile_count = 0;
+    symbol_count = 0;
+}
+
 memorized_terrain_tile map_memory::get_tile( const tripoint &pos ) const
 {
-    return tile_cache.get( pos, default_tile );
+    tripoint p = pos;
+    const memorized_submap *sm = find_block( ms_to_sm_remain( p ) );
+    if( sm == nullptr ) {
+        return default_tile;
+    }
+    const tile_entry &t = sm->tiles[p.x][p.y];
+    if( t.id == 0 ) {
+        return default_tile;
+    }
+    return memorized_terrain_tile{ tile_ids[t.id], t.subtile, t.rotation };
 }
 
 void map_memory::memorize_tile( int limit, const tripoint &pos, const std::string &ter,
                                 const int subtile, const int rotation )
 {
-    tile_cache.insert( limit, pos, memorized_terrain_tile{ ter, subtile, rotation } );
+    tripoint p = pos;
+    memorized_submap &sm = touch_block( ms_to_sm_remain( p ) );
+    tile_entry &t = sm.tiles[p.x][p.y];
+    const uint32_t id = tile_id_index( ter );
+    const int change = ( id != 0 ) - ( t.id != 0 );
+    t.id = id;
+    t.subtile = subtile;
+    t.rotation = rotation;
+    sm.tile_count += change;
+    tile_count += change;
+    trim( limit );
 }
 
 int map_memory::get_symbol( const tripoint &pos ) const
 {
-    return symbol_cache.get( pos, 0 );
+    tripoint p = pos;
+    const memorized_submap *sm = find_block( ms_to_sm_remain( p ) );
+    return sm == nullptr ? 0 : sm->symbols[p.x][p.y];
 }
 
 void map_memory::memorize_symbol( int limit, const tripoint &pos, const int symbol )
 {
-    symbol_cache.insert( limit, pos, symbol );
+    tripoint p = pos;
+    memorized_submap &sm = touch_block( ms_to_sm_remain( p ) );
+    int &s = sm.symbols[p.x][p.y];
+    const int change = ( symbol != 0 ) - ( s != 0 );
+    s = symbol;
+    sm.symbol_count += change;
+    symbol_count += change;
+    trim( limit );
 }
 
 void map_memory::clear_memorized_tile( const tripoint &pos )
 {
-    tile_cache.remove( pos );
-    symbol_cache.remove( pos );
+    tripoint p = pos;
+    const auto found = blocks.find( ms_to_sm_remain( p ) );
+    if( found == blocks.end() ) {
+        return;
+    }
+    memorized_submap &sm = *found->second.data;
+    tile_entry &t = sm.tiles[p.x][p.y];
+    if( t.id != 0 ) {
+        t = tile_entry();
+        --sm.tile_count;
+        --tile_count;
+    }
+    int &s = sm.symbols[p.x][p.y];
+    if( s != 0 ) {
+        s = 0;
+        --sm.symbol_count;
+        --symbol_count;
+    }
+    if( sm.tile_count == 0 && sm.symbol_count == 0 ) {
+        lru.erase( found->second.lru_pos );
+        blocks.erase( found );
+    }
 }
@@ -2,9 +2,14 @@
 #ifndef MAP_MEMORY_H
 #define MAP_MEMORY_H
 
+#include <cstdint>
+#include <list>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
-#include "lru_cache.h"
+#include "game_constants.h"
 #include "point.h" // IWYU pragma: keep
 
 class JsonOut;
@@ -17,6 +22,12 @@ struct memorized_terrain_tile {
     int rotation;
 };
 
+/**
+ * What the avatar remembers of the map, kept in blocks of a submap each. Tile ids are stored
+ * as indices into a table of the ids seen so far, the subtile and rotation as a byte each.
+ * When more tiles (or symbols) are memorized than the limit given, the least recently
+ * memorized into blocks are forgotten as a whole.
+ */
 class map_memory
 {
     public:
@@ -35,8 +46,39 @@ class map_memory
 
         void clear_memorized_tile( const tripoint &pos );
     private:
-        lru_cache<tripoint, memorized_terrain_tile> tile_cache;
-        lru_cache<tripoint, int> symbol_cache;
+        struct tile_entry {
+            /** Index into @ref tile_ids, 0 is nothing memorized. */
+            uint32_t id = 0;
+            int8_t subtile = 0;
+            int8_t rotation = 0;
+        };
+        struct memorized_submap {
+            tile_entry tiles[SEEX][SEEY];
+            int symbols[SEEX][SEEY] = {};
+            int tile_count = 0;
+            int symbol_count = 0;
+        };
+        struct block {
+            std::unique_ptr<memorized_submap> data;
+            /** Where the block is in @ref lru, the most recently memorized into is last. */
+            std::list<tripoint>::iterator lru_pos;
+        };
+
+        /** The block with the given position in submaps, nullptr if there is none. */
+        const memorized_submap *find_block( const tripoint &sm_pos ) const;
+        /** Creates the block if needed and marks it as the most recently used one. */
+        memorized_submap &touch_block( const tripoint &sm_pos );
+        uint32_t tile_id_index( const std::string &id );
+        /** Forgets the least recently used blocks until both counts are within the limit. */
+        void trim( int limit );
+        void clear();
+
+        std::unordered_map<tripoint, block> blocks;
+        std::list<tripoint> lru;
+        int tile_count = 0;
+        int symbol_count = 0;
+        std::vector<std::string> tile_ids = { "" };
+        std::unordered_map<std::string, uint32_t> tile_id_indices = { { "", 0 } };
 };
 
 #endif
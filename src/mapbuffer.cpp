@@ -2,9 +2,17 @@
 
 #include <sstream>
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <exception>
+#include <fstream>
 #include <functional>
+#include <iterator>
+#include <memory>
 #include <set>
+#include <unordered_set>
+#include <stdexcept>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -15,6 +23,7 @@
 #include "game.h"
 #include "json.h"
 #include "map.h"
+#include "options.h"
 #include "output.h"
 #include "submap.h"
 #include "translations.h"
@@ -24,19 +33,261 @@
 
 mapbuffer MAPBUFFER;
 
+// A region file holds every saved quad of one map segment: a fixed table that says where
+// each quad's data is, followed by the data itself, the same JSON a quad's own file holds.
+// Saving appends the new data and rewrites the table, the file is only compacted once most
+// of it is outdated.
+static const std::string region_magic = "CDDAREG1";
+static constexpr int region_quads = SEG_SIZE * SEG_SIZE;
+// Each table entry is an 8 byte offset and a 4 byte length, both little endian.
+static constexpr std::streamoff region_entry_size = 12;
+static constexpr std::streamoff region_header_size = 8 + region_quads * region_entry_size;
+// Don't bother compacting region files smaller than this.
+static constexpr std::streamoff region_compact_size = 1 << 20;
+
+struct region_entry {
+    std::uint64_t offset = 0;
+    // 0 if the quad is not in the file.
+    std::uint32_t length = 0;
+};
+using region_table = std::array<region_entry, region_quads>;
+
+static std::string region_path( const tripoint &segment_addr )
+{
+    std::stringstream path;
+    path << g->get_world_base_save_path() << "/maps/" << segment_addr.x << "." <<
+         segment_addr.y << "." << segment_addr.z << ".region";
+    return path.str();
+}
+
+static int region_index( const tripoint &om_addr )
+{
+    const tripoint segment_addr = omt_to_seg_copy( om_addr );
+    return ( om_addr.x - segment_addr.x * SEG_SIZE ) + ( om_addr.y - segment_addr.y * SEG_SIZE ) *
+           SEG_SIZE;
+}
+
+static std::string region_header( const region_table &table )
+{
+    std::string header = region_magic;
+    header.reserve( region_header_size );
+    for( const region_entry &entry : table ) {
+        for( int i = 0; i < 8; i++ ) {
+            header.push_back( static_cast<char>( ( entry.offset >> ( 8 * i ) ) & 0xff ) );
+        }
+        for( int i = 0; i < 4; i++ ) {
+            header.push_back( static_cast<char>( ( entry.length >> ( 8 * i ) ) & 0xff ) );
+        }
+    }
+    return header;
+}
+
+static region_entry decode_region_entry( const char *bytes )
+{
+    region_entry entry;
+    for( int i = 0; i < 8; i++ ) {
+        entry.offset |= static_cast<std::uint64_t>( static_cast<unsigned char>( bytes[i] ) ) << ( 8 * i );
+    }
+    for( int i = 0; i < 4; i++ ) {
+        entry.length |= static_cast<std::uint32_t>( static_cast<unsigned char>( bytes[8 + i] ) ) <<
+                        ( 8 * i );
+    }
+    return entry;
+}
+
+static void check_region_magic( std::istream &fin, const std::string &path )
+{
+    char magic[8];
+    fin.seekg( 0 );
+    if( !fin.read( magic, sizeof( magic ) ) || region_magic.compare( 0, 8, magic, 8 ) != 0 ) {
+        throw std::runtime_error( "bad region file header in " + path );
+    }
+}
+
+static void read_region_table( std::istream &fin, region_table &table, const std::string &path )
+{
+    check_region_magic( fin, path );
+    std::string entries( region_quads * region_entry_size, '\0' );
+    if( !fin.read( &entries[0], entries.size() ) ) {
+        throw std::runtime_error( "bad region file header in " + path );
+    }
+    for( size_t i = 0; i < table.size(); i++ ) {
+        table[i] = decode_region_entry( &entries[i * region_entry_size] );
+    }
+}
+
+// Applies the changes to one region file, problems that don't stop the rest of the save
+// from being written go to errors.
+static void write_region( const std::string &path, const std::map<int, std::string> &quads,
+                          std::vector<std::string> &errors )
+{
+    bool exists = file_exist( path );
+    if( !exists && std::all_of( quads.begin(), quads.end(),
+    []( const std::pair<const int, std::string> &quad ) {
+    return quad.second.empty();
+    } ) ) {
+        return;
+    }
+
+    region_table table;
+    std::fstream file;
+    std::streamoff file_size = region_header_size;
+    if( exists ) {
+        file.open( path, std::ios::in | std::ios::out | std::ios::binary );
+        try {
+            read_region_table( file, table, path );
+            file.seekg( 0, std::ios::end );
+            file_size = file.tellg();
+        } catch( const std::exception &err ) {
+            errors.push_back( std::string( err.what() ) + ", the quads stored in it are lost" );
+            file.close();
+            table = region_table();
+            exists = false;
+        }
+    }
+
+    // Size of the file once the new data is appended, and how much of it would be in use.
+    std::streamoff appended_size = file_size;
+    std::streamoff live_size = region_header_size;
+    for( size_t i = 0; i < table.size(); i++ ) {
+        const auto update = quads.find( i );
+        if( update == quads.end() ) {
+            live_size += table[i].length;
+        } else {
+            live_size += update->second.size();
+            appended_size += update->second.size();
+        }
+    }
+
+    if( exists && ( appended_size < 2 * live_size || appended_size < region_compact_size ) ) {
+        // Append the new data and point the table at it.
+        file.seekp( 0, std::ios::end );
+        for( const auto &quad : quads ) {
+            region_entry &entry = table[quad.first];
+            entry.offset = quad.second.empty() ? 0 : static_cast<std::streamoff>( file.tellp() );
+            entry.length = quad.second.size();
+            file.write( quad.second.data(), quad.second.size() );
+        }
+        const std::string header = region_header( table );
+        file.seekp( 0 );
+        file.write( header.data(), header.size() );
+        if( !file ) {
+            throw std::runtime_error( "failed to write region file " + path );
+        }
+        return;
+    }
+
+    // New file, or most of the old one is outdated: write everything out again.
+    std::vector<std::string> payloads( table.size() );
+    for( size_t i = 0; i < table.size(); i++ ) {
+        const auto update = quads.find( i );
+        if( update != quads.end() ) {
+            payloads[i] = update->second;
+        } else if( table[i].length > 0 ) {
+            payloads[i].resize( table[i].length );
+            file.seekg( table[i].offset );
+            file.read( &payloads[i][0], table[i].length );
+        }
+    }
+    if( file.is_open() && !file ) {
+        throw std::runtime_error( "failed to read region file " + path );
+    }
+    file.close();
+    std::uint64_t offset = region_header_size;
+    for( size_t i = 0; i < table.size(); i++ ) {
+        table[i].offset = payloads[i].empty() ? 0 : offset;
+        table[i].length = payloads[i].size();
+        offset += payloads[i].size();
+    }
+    write_to_file( path, [&]( std::ostream & fout ) {
+        fout << region_header( table );
+        for( const std::string &payload : payloads ) {
+            fout << payload;
+        }
+    } );
+}
+
+// Region file paths to the quads to change in them, see write_region.
+static void write_regions( const std::map<std::string, std::map<int, std::string>> &regions,
+                           std::vector<std::string> &errors )
+{
+    for( const auto &region : regions ) {
+        try {
+            write_region( region.first, region.second, errors );
+        } catch( const std::exception &err ) {
+            errors.push_back( err.what() );
+        }
+    }
+}
+
+// Reads the quad's data from the region file, false if it's not stored there.
+static bool read_region_quad( const std::string &path, const tripoint &om_addr, std::string &quad )
+{
+    if( !file_exist( path ) ) {
+        return false;
+    }
+    std::ifstream fin( path, std::ios::binary );
+    check_region_magic( fin, path );
+    // Only this quad's table entry is needed.
+    char entry_bytes[region_entry_size];
+    fin.seekg( 8 + region_index( om_addr ) * region_entry_size );
+    if( !fin.read( entry_bytes, region_entry_size ) ) {
+        throw std::runtime_error( "bad region file header in " + path );
+    }
+    const region_entry entry = decode_region_entry( entry_bytes );
+    if( entry.length == 0 ) {
+        return false;
+    }
+    quad.assign( entry.length, '\0' );
+    fin.seekg( entry.offset );
+    if( !fin.read( &quad[0], entry.length ) ) {
+        throw std::runtime_error( "failed to read region file " + path );
+    }
+    return true;
+}
+
+// The directory of the quad's own file.
+static std::string quad_dir_path( const tripoint &om_addr )
+{
+    const tripoint segment_addr = omt_to_seg_copy( om_addr );
+    std::stringstream path;
+    path << g->get_world_base_save_path() << "/maps/" <<
+         segment_addr.x << "." << segment_addr.y << "." << segment_addr.z;
+    return path.str();
+}
+
+// The quad's own file.
+static std::string quad_file_path( const tripoint &om_addr )
+{
+    std::stringstream path;
+    path << quad_dir_path( om_addr ) << "/" << om_addr.x << "." << om_addr.y << "." << om_addr.z <<
+         ".map";
+    return path.str();
+}
+
 mapbuffer::mapbuffer() = default;
 
 mapbuffer::~mapbuffer()
 {
+    // Too late to report problems, but the files still need to be written.
+    if( writer.joinable() ) {
+        writer.join();
+    }
+    write_errors.clear();
     reset();
 }
 
 void mapbuffer::reset()
 {
+    // The files may be about to be deleted or read back.
+    finish_writes();
+    finish_prefetch();
+    prefetched_quads.clear();
     for( auto &elem : submaps ) {
         delete elem.second;
     }
     submaps.clear();
+    last_used.clear();
 }
 
 bool mapbuffer::add_submap( const tripoint &p, submap *sm )
@@ -46,6 +297,7 @@ bool mapbuffer::add_submap( const tripoint &p, submap *sm )
     }
 
     submaps[p] = sm;
+    last_used[p] = ++lookups;
 
     return true;
 }
@@ -78,6 +330,7 @@ void mapbuffer::remove_submap( tripoint addr )
     }
     delete m_target->second;
     submaps.erase( m_target );
+    last_used.erase( addr );
 }
 
 submap *mapbuffer::lookup_submap( int x, int y, int z )
@@ -99,11 +352,18 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
         return nullptr;
     }
 
+    last_used[p] = ++lookups;
     return iter->second;
 }
 
 void mapbuffer::save( bool delete_after_save )
 {
+    // Region files are updated from their current content, so the last save must be done.
+    finish_writes();
+    // Anything read ahead may be about to be outdated.
+    finish_prefetch();
+    prefetched_quads.clear();
+
     std::stringstream map_directory;
     map_directory << g->get_world_base_save_path() << "/maps";
     assure_dir_exist( map_directory.str() );
@@ -161,6 +421,172 @@ void mapbuffer::save( bool delete_after_save )
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
+    start_writer();
+}
+
+void mapbuffer::limit_size( size_t max_submaps )
+{
+    if( max_submaps == 0 || submaps.size() <= max_submaps ) {
+        return;
+    }
+    finish_writes();
+    finish_prefetch();
+    prefetched_quads.clear();
+
+    const tripoint map_origin = sm_to_omt_copy( g->m.get_abs_sub() );
+    const bool map_has_zlevels = g->m.has_zlevels();
+    // Quads that may be evicted, by when they were last looked up.
+    std::unordered_map<tripoint, uint64_t> quads;
+    std::unordered_set<tripoint> pinned;
+    for( const auto &elem : submaps ) {
+        const tripoint om_addr = sm_to_omt_copy( elem.first );
+        const bool in_bubble = ( map_has_zlevels || om_addr.z == g->get_levz() ) &&
+                               om_addr.x >= map_origin.x && om_addr.y >= map_origin.y &&
+                               om_addr.x <= map_origin.x + HALF_MAPSIZE &&
+                               om_addr.y <= map_origin.y + HALF_MAPSIZE;
+        // Vehicles keep running off the map, see game::do_turn.
+        if( in_bubble || ( elem.second != nullptr && !elem.second->vehicles.empty() ) ) {
+            pinned.insert( om_addr );
+            continue;
+        }
+        uint64_t &quad_used = quads[om_addr];
+        quad_used = std::max( quad_used, last_used[elem.first] );
+    }
+    std::vector<std::pair<uint64_t, tripoint>> by_age;
+    for( const auto &quad : quads ) {
+        if( pinned.count( quad.first ) == 0 ) {
+            by_age.emplace_back( quad.second, quad.first );
+        }
+    }
+    std::sort( by_age.begin(), by_age.end() );
+
+    // Go a quarter below the limit, so this doesn't run again after the next few loads.
+    const size_t target = max_submaps - max_submaps / 4;
+    std::list<tripoint> submaps_to_delete;
+    for( const auto &quad : by_age ) {
+        if( submaps.size() - submaps_to_delete.size() <= target ) {
+            break;
+        }
+        save_quad( quad_dir_path( quad.second ), quad_file_path( quad.second ), quad.second,
+                   submaps_to_delete, true );
+    }
+    for( const tripoint &elem : submaps_to_delete ) {
+        remove_submap( elem );
+    }
+    start_writer();
+}
+
+void mapbuffer::start_writer()
+{
+    // Everything is serialized now, so the game can go on changing submaps while the files
+    // are written. write_to_file writes to a temporary file renamed into place, so a crash
+    // leaves either the old file or the new one.
+    writer = std::thread( [this, quad_files = std::move( pending_quad_files ),
+                 regions = std::move( pending_region_quads )]() {
+        for( const quad_file &quad : quad_files ) {
+            try {
+                if( quad.data.empty() ) {
+                    if( file_exist( quad.path ) ) {
+                        remove_file( quad.path );
+                    }
+                    continue;
+                }
+                assure_dir_exist( quad.dirname );
+                write_to_file( quad.path, [&quad]( std::ostream & fout ) {
+                    fout << quad.data;
+                } );
+            } catch( const std::exception &err ) {
+                write_errors.push_back( err.what() );
+            }
+        }
+        write_regions( regions, write_errors );
+    } );
+    pending_quad_files.clear();
+    pending_region_quads.clear();
+}
+
+void mapbuffer::finish_writes()
+{
+    if( writer.joinable() ) {
+        writer.join();
+    }
+    for( const std::string &error : write_errors ) {
+        popup( _( "Failed to save the maps: %s" ), error );
+    }
+    write_errors.clear();
+}
+
+void mapbuffer::prefetch( const std::vector<tripoint> &sm_addrs, int threads )
+{
+    // Don't read files that are still being written.
+    finish_writes();
+    finish_prefetch();
+
+    // A quad's own file and its segment's region file, see unserialize_submaps.
+    using quad_paths = std::tuple<tripoint, std::string, std::string>;
+    std::vector<quad_paths> quads;
+    std::set<tripoint> queued;
+    for( const tripoint &p : sm_addrs ) {
+        const tripoint om_addr = sm_to_omt_copy( p );
+        if( submaps.count( p ) == 0 && prefetched_quads.count( om_addr ) == 0 &&
+            queued.insert( om_addr ).second ) {
+            quads.emplace_back( om_addr, quad_file_path( om_addr ),
+                                region_path( omt_to_seg_copy( om_addr ) ) );
+        }
+    }
+    if( quads.empty() ) {
+        return;
+    }
+
+    // Only the file contents are read here, deserializing touches game data that isn't safe
+    // to use from another thread. Quads that are missing or fail to read are left out, loading
+    // them the usual way reports any problems.
+    // Each thread takes every n-th quad and keeps what it reads to itself until
+    // finish_prefetch collects it.
+    const size_t num_threads = std::max<size_t>( 1, std::min<size_t>( threads, quads.size() ) );
+    const std::shared_ptr<const std::vector<quad_paths>> shared_quads =
+        std::make_shared<const std::vector<quad_paths>>( std::move( quads ) );
+    prefetch_results.resize( num_threads );
+    for( size_t t = 0; t < num_threads; t++ ) {
+        prefetchers.emplace_back( [t, num_threads, shared_quads, &results = prefetch_results[t]]() {
+            const std::vector<quad_paths> &quads = *shared_quads;
+            for( size_t i = t; i < quads.size(); i += num_threads ) {
+                const tripoint &om_addr = std::get<0>( quads[i] );
+                try {
+                    std::string data;
+                    if( read_region_quad( std::get<2>( quads[i] ), om_addr, data ) ) {
+                        results.emplace( om_addr, std::move( data ) );
+                        continue;
+                    }
+                    std::ifstream fin( std::get<1>( quads[i] ), std::ios::binary );
+                    if( !fin ) {
+                        continue;
+                    }
+                    std::ostringstream buffer;
+                    buffer << fin.rdbuf();
+                    if( fin.bad() ) {
+                        continue;
+                    }
+                    results.emplace( om_addr, buffer.str() );
+                } catch( const std::exception & ) {
+                    continue;
+                }
+            }
+        } );
+    }
+}
+
+void mapbuffer::finish_prefetch()
+{
+    for( std::thread &prefetcher : prefetchers ) {
+        prefetcher.join();
+    }
+    prefetchers.clear();
+    for( std::map<tripoint, std::string> &results : prefetch_results ) {
+        prefetched_quads.insert( std::make_move_iterator( results.begin() ),
+                                 std::make_move_iterator( results.end() ) );
+    }
+    prefetch_results.clear();
 }
 
 void mapbuffer::save_quad( const std::string &dirname, const std::string &filename,
@@ -175,22 +601,31 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
     offsets.push_back( point_south_east );
 
     bool all_uniform = true;
+    bool any_changed = false;
     for( auto &offsets_offset : offsets ) {
         tripoint submap_addr = omt_to_sm_copy( om_addr );
         submap_addr.x += offsets_offset.x;
         submap_addr.y += offsets_offset.y;
         submap_addrs.push_back( submap_addr );
-        submap *sm = submaps[submap_addr];
+        const auto found = submaps.find( submap_addr );
+        submap *sm = found == submaps.end() ? nullptr : found->second;
         if( sm != nullptr && !sm->is_uniform ) {
             all_uniform = false;
         }
+        // Vehicles, fields and active items change while nobody calls the submap's setters.
+        if( sm != nullptr && ( sm->modified || !sm->vehicles.empty() || sm->field_count > 0 ||
+                               !sm->active_items.empty() ) ) {
+            any_changed = true;
+        }
     }
 
-    if( all_uniform ) {
-        // Nothing to save - this quad will be regenerated faster than it would be re-read
+    if( all_uniform || !any_changed ) {
+        // Nothing to save - this quad will be regenerated faster than it would be re-read,
+        // or the file already has exactly this content.
         if( delete_after_save ) {
             for( auto &submap_addr : submap_addrs ) {
-                if( submaps.count( submap_addr ) > 0 && submaps[submap_addr] != nullptr ) {
+                const auto found = submaps.find( submap_addr );
+                if( found != submaps.end() && found->second != nullptr ) {
                     submaps_to_delete.push_back( submap_addr );
                 }
             }
@@ -199,21 +634,15 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         return;
     }
 
-    // Don't create the directory if it would be empty
-    assure_dir_exist( dirname );
-    write_to_file( filename, [&]( std::ostream & fout ) {
+    const auto write_quad = [&]( std::ostream & fout ) {
         JsonOut jsout( fout );
         jsout.start_array();
         for( auto &submap_addr : submap_addrs ) {
-            if( submaps.count( submap_addr ) == 0 ) {
-                continue;
-            }
-
-            submap *sm = submaps[submap_addr];
-
-            if( sm == nullptr ) {
+            const auto found = submaps.find( submap_addr );
+            if( found == submaps.end() || found->second == nullptr ) {
                 continue;
             }
+            submap *sm = found->second;
 
             jsout.start_object();
 
@@ -236,30 +665,66 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         }
 
         jsout.end_array();
-    } );
+    };
+
+    std::ostringstream quad;
+    write_quad( quad );
+    std::string &region_quad = pending_region_quads[region_path( omt_to_seg_copy( om_addr ) )][region_index(
+                                   om_addr )];
+    if( get_option<bool>( "MAP_REGION_FILES" ) ) {
+        region_quad = quad.str();
+        // The region file is read first, the quad's own file would just be outdated.
+        pending_quad_files.push_back( { dirname, filename, std::string() } );
+        return;
+    }
+
+    // Don't let an older copy in the region file hide this one.
+    region_quad.clear();
+    // Don't create the directory if it would be empty, it's made when the file is written.
+    pending_quad_files.push_back( { dirname, filename, quad.str() } );
+}
+
+bool mapbuffer::unserialize_region_quad( const tripoint &om_addr )
+{
+    std::string quad;
+    if( !read_region_quad( region_path( omt_to_seg_copy( om_addr ) ), om_addr, quad ) ) {
+        return false;
+    }
+    std::istringstream quad_stream( quad );
+    JsonIn jsin( quad_stream );
+    deserialize( jsin );
+    return true;
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
 // seeking around in them, so we're using the json streaming API.
 submap *mapbuffer::unserialize_submaps( const tripoint &p )
 {
+    // The file may still be being written.
+    finish_writes();
+    finish_prefetch();
     // Map the tripoint to the submap quad that stores it.
     const tripoint om_addr = sm_to_omt_copy( p );
-    const tripoint segment_addr = omt_to_seg_copy( om_addr );
-    std::stringstream quad_path;
-    quad_path << g->get_world_base_save_path() << "/maps/" <<
-              segment_addr.x << "." << segment_addr.y << "." << segment_addr.z << "/" <<
-              om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
-
-    using namespace std::placeholders;
-    if( !read_from_file_optional_json( quad_path.str(),
-                                       std::bind( &mapbuffer::deserialize, this, _1 ) ) ) {
-        // If it doesn't exist, trigger generating it.
-        return nullptr;
+    const std::string quad_path = quad_file_path( om_addr );
+
+    const auto prefetched = prefetched_quads.find( om_addr );
+    if( prefetched != prefetched_quads.end() ) {
+        std::istringstream quad_stream( prefetched->second );
+        prefetched_quads.erase( prefetched );
+        JsonIn jsin( quad_stream );
+        deserialize( jsin );
+    } else {
+        using namespace std::placeholders;
+        if( !unserialize_region_quad( om_addr ) &&
+            !read_from_file_optional_json( quad_path,
+                                           std::bind( &mapbuffer::deserialize, this, _1 ) ) ) {
+            // If it doesn't exist, trigger generating it.
+            return nullptr;
+        }
     }
     if( submaps.count( p ) == 0 ) {
         debugmsg( "file %s did not contain the expected submap %d,%d,%d",
-                  quad_path.str(), p.x, p.y, p.z );
+                  quad_path, p.x, p.y, p.z );
         return nullptr;
     }
     return submaps[ p ];
@@ -291,6 +756,8 @@ void mapbuffer::deserialize( JsonIn &jsin )
             }
         }
 
+        // Same as on disk, unless it was just converted from an old format.
+        sm->modified = rubpow_update;
         if( !add_submap( submap_coordinates, sm ) ) {
             debugmsg( "submap %d,%d,%d was already loaded", submap_coordinates.x, submap_coordinates.y,
                       submap_coordinates.z );
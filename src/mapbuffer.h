@@ -2,10 +2,17 @@
 #ifndef MAPBUFFER_H
 #define MAPBUFFER_H
 
+#include <cstdint>
 #include <list>
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
 
 #include "point.h"
 
@@ -22,6 +29,8 @@ class mapbuffer
         ~mapbuffer();
 
         /** Store all submaps in this instance into savefiles.
+         * The submaps are serialized right away, the files are written on a background
+         * thread, see @ref finish_writes.
          * @param delete_after_save If true, the saved submaps are removed
          * from the mapbuffer (and deleted).
          **/
@@ -57,8 +66,30 @@ class mapbuffer
         submap *lookup_submap( int x, int y, int z );
         submap *lookup_submap( const tripoint &p );
 
+        /**
+         * Waits for the files of the last @ref save, which are written in the background, and
+         * reports any that failed.
+         * Saving, @ref reset and loading submaps from disk all wait on their own.
+         */
+        void finish_writes();
+
+        /**
+         * Starts reading the saved quads that hold these submaps (in absolute submap
+         * coordinates) on a background thread, so loading them later doesn't wait on the disk.
+         * Submaps already in the buffer are skipped.
+         * @param threads How many threads share the reading.
+         */
+        void prefetch( const std::vector<tripoint> &sm_addrs, int threads = 1 );
+
+        /**
+         * Saves and frees the least recently looked up quads until no more than a quarter
+         * below max_submaps are left. Quads in the reality bubble or with vehicles in them
+         * are kept. 0 means no limit.
+         */
+        void limit_size( size_t max_submaps );
+
     private:
-        using submap_map_t = std::map<tripoint, submap *>;
+        using submap_map_t = std::unordered_map<tripoint, submap *>;
 
     public:
         inline submap_map_t::iterator begin() {
@@ -77,7 +108,46 @@ class mapbuffer
         void save_quad( const std::string &dirname, const std::string &filename,
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                         bool delete_after_save );
+        /** Hands the files serialized by @ref save_quad to @ref writer. */
+        void start_writer();
+        /** Loads the quad from its segment's region file, false if it's not stored there. */
+        bool unserialize_region_quad( const tripoint &om_addr );
         submap_map_t submaps;
+        /** When each submap was last looked up, in @ref lookups, for @ref limit_size. */
+        std::unordered_map<tripoint, uint64_t> last_used;
+        uint64_t lookups = 0;
+
+        // A quad's own file, as written by the background writer.
+        struct quad_file {
+            std::string dirname;
+            std::string path;
+            // Empty to remove the file instead.
+            std::string data;
+        };
+        /** Quad files serialized by @ref save and not yet handed to @ref writer. */
+        std::vector<quad_file> pending_quad_files;
+        /**
+         * Changes to region files (see MAP_REGION_FILES) serialized by @ref save, by file and by
+         * quad index in the segment. An empty string drops the quad from the region file,
+         * because it was saved to its own file instead.
+         */
+        std::map<std::string, std::map<int, std::string>> pending_region_quads;
+        /** Writes the files of the last @ref save. */
+        std::thread writer;
+        /** Problems the writer ran into, reported by @ref finish_writes. */
+        std::vector<std::string> write_errors;
+
+        /** Waits for the last @ref prefetch, its data is then in @ref prefetched_quads. */
+        void finish_prefetch();
+        /** Read the files of the last @ref prefetch. */
+        std::vector<std::thread> prefetchers;
+        /** What each of @ref prefetchers read, only touched by it while it runs. */
+        std::vector<std::map<tripoint, std::string>> prefetch_results;
+        /**
+         * Saved quads read ahead by @ref prefetch, by overmap terrain address, the same JSON
+         * their files hold.
+         */
+        std::map<tripoint, std::string> prefetched_quads;
 };
 
 extern mapbuffer MAPBUFFER;
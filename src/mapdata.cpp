@@ -166,6 +166,11 @@ static const std::unordered_map<std::string, ter_bitflags> ter_bitflags_map = {
         { "FLAT",                     TFLAG_FLAT },           // This tile is flat.
         { "RAMP",                     TFLAG_RAMP },           // Can be used to move up a z-level
         { "RAIL",                     TFLAG_RAIL },           // Rail tile (used heavily)
+        { "FUNGUS",                   TFLAG_FUNGUS },         // fungal spread, checked around every tile
+        { "SHRUB",                    TFLAG_SHRUB },          // fungal spread
+        { "TREE",                     TFLAG_TREE },           // fungal spread
+        { "YOUNG",                    TFLAG_YOUNG },          // fungal spread
+        { "THIN_OBSTACLE",            TFLAG_THIN_OBSTACLE },  // fungal spread
     }
 };
 
@@ -193,6 +193,11 @@ enum ter_bitflags : int {
     TFLAG_BLOCK_WIND,
     TFLAG_FLAT,
     TFLAG_RAIL,
+    TFLAG_FUNGUS,
+    TFLAG_SHRUB,
+    TFLAG_TREE,
+    TFLAG_YOUNG,
+    TFLAG_THIN_OBSTACLE,
 
     NUM_TERFLAGS
 };
@@ -33,6 +33,7 @@
 #include "map_iterator.h"
 #include "mapdata.h"
 #include "mapgen_functions.h"
+#include "mapgen_profile.h"
 #include "mapgenformat.h"
 #include "mission.h"
 #include "mongroup.h"
@@ -125,6 +126,7 @@ void map::generate( const tripoint &p, const time_point &when )
     tripoint abs_omt = sm_to_omt_copy( p );
     const regional_settings *rsettings = &overmap_buffer.get_settings( abs_omt );
     oter_id terrain_type = overmap_buffer.ter( abs_omt );
+    mapgen_profile::scope profile( "oter", terrain_type.id().str() );
     oter_id t_above = overmap_buffer.ter( abs_omt + tripoint_above );
     oter_id t_below = overmap_buffer.ter( abs_omt + tripoint_below );
     oter_id t_north = overmap_buffer.ter( abs_omt + tripoint_north );
@@ -233,9 +235,26 @@ std::map<std::string, std::vector<std::unique_ptr<update_mapgen_function_json>>
 std::map<std::string, std::map<int, int> > oter_mapgen_weights;
 
 /*
- * setup oter_mapgen_weights which mapgen uses to diceroll. Also setup mapgen_function_json
+ * Compiles the json of a mapgen function the first time it is needed, most are never run in a
+ * session. Errors are reported instead of thrown, as this happens in the middle of the game.
  */
-void calculate_mapgen_weights()   // TODO: rename as it runs jsonfunction setup too
+template<typename Function>
+static bool setup_on_first_use( Function &fn )
+{
+    try {
+        fn.setup();
+        return true;
+    } catch( const std::exception &err ) {
+        debugmsg( "Error setting up mapgen function: %s", err.what() );
+        return false;
+    }
+}
+
+/*
+ * setup oter_mapgen_weights which mapgen uses to diceroll. Json mapgen functions are set up
+ * on first use, or by check_mapgen_definitions.
+ */
+void calculate_mapgen_weights()
 {
     oter_mapgen_weights.clear();
     for( auto &omw : oter_mapgen ) {
@@ -251,41 +270,34 @@ void calculate_mapgen_weights()   // TODO: rename as it runs jsonfunction setup
                 ++funcnum;
                 continue; // rejected!
             }
-            ( *fit )->setup();
             wtotal += weight;
             oter_mapgen_weights[ omw.first ][ wtotal ] = funcnum;
             dbg( D_INFO ) << "wcalc " << omw.first << "(" << funcnum << "): +" << weight << " = " << wtotal;
             ++funcnum;
         }
     }
-    // Not really calculate weights, but let's keep it here for now
-    for( auto &pr : nested_mapgen ) {
-        for( auto &ptr : pr.second ) {
-            ptr->setup();
-        }
-    }
-    for( auto &pr : update_mapgen ) {
-        for( auto &ptr : pr.second ) {
-            ptr->setup();
-        }
-    }
-
 }
 
 void check_mapgen_definitions()
 {
+    // Everything is compiled here, so broken json is found without generating the terrain
     for( auto &oter_definition : oter_mapgen ) {
         for( auto &mapgen_function_ptr : oter_definition.second ) {
+            if( mapgen_function_ptr->weight >= 1 ) {
+                mapgen_function_ptr->setup();
+            }
             mapgen_function_ptr->check( oter_definition.first );
         }
     }
     for( auto &oter_definition : nested_mapgen ) {
         for( auto &mapgen_function_ptr : oter_definition.second ) {
+            mapgen_function_ptr->setup();
             mapgen_function_ptr->check( oter_definition.first );
         }
     }
     for( auto &oter_definition : update_mapgen ) {
         for( auto &mapgen_function_ptr : oter_definition.second ) {
+            mapgen_function_ptr->setup();
             mapgen_function_ptr->check( oter_definition.first );
         }
     }
@@ -1394,13 +1406,15 @@ class jmapgen_terrain : public jmapgen_piece
         jmapgen_terrain( const std::string &tid ) : id( ter_id( tid ) ) {}
         void apply( const mapgendata &dat, const jmapgen_int &x, const jmapgen_int &y,
                     const float /*mdensity*/, mission * ) const override {
-            dat.m.ter_set( point( x.get(), y.get() ), id );
+            const point p( x.get(), y.get() );
+            dat.m.ter_set( p, id );
             // Delete furniture if a wall was just placed over it. TODO: need to do anything for fluid, monsters?
-            if( dat.m.has_flag_ter( "WALL", point( x.get(), y.get() ) ) ) {
-                dat.m.furn_set( point( x.get(), y.get() ), f_null );
+            if( dat.m.has_flag_ter( TFLAG_WALL, p ) ) {
+                dat.m.furn_set( p, f_null );
                 // and items, unless the wall has PLACE_ITEM flag indicating it stores things.
-                if( !dat.m.has_flag_ter( "PLACE_ITEM", point( x.get(), y.get() ) ) ) {
-                    dat.m.i_clear( tripoint( x.get(), y.get(), dat.m.get_abs_sub().z ) );
+                static const std::string place_item( "PLACE_ITEM" );
+                if( !dat.m.has_flag_ter( place_item, p ) ) {
+                    dat.m.i_clear( tripoint( p, dat.m.get_abs_sub().z ) );
                 }
             }
         }
@@ -1761,10 +1775,11 @@ class jmapgen_nested : public jmapgen_piece
 
             // A second roll? Let's allow it for now
             const auto &ptr = random_entry_ref( iter->second );
-            if( ptr == nullptr ) {
+            if( ptr == nullptr || !setup_on_first_use( *ptr ) ) {
                 return;
             }
 
+            mapgen_profile::scope profile( "nested", *res );
             ptr->nest( dat, point( x.get(), y.get() ), d );
         }
 };
@@ -2584,6 +2599,9 @@ void mapgen_function_json_base::formatted_set_incredibly_simple( map &m, const p
 void mapgen_function_json::generate( map *m, const oter_id &terrain_type, const mapgendata &md,
                                      const time_point &turn, float d )
 {
+    if( !setup_on_first_use( *this ) ) {
+        return;
+    }
     if( fill_ter != t_null ) {
         m->draw_fill_background( fill_ter );
     }
@@ -6742,6 +6760,7 @@ std::vector<item *> map::place_items( const items_location &loc, int chance, con
                                       int magazine, int ammo )
 {
     std::vector<item *> res;
+    mapgen_profile::scope profile( "item_group", loc );
 
     if( chance > 100 || chance <= 0 ) {
         debugmsg( "map::place_items() called with an invalid chance (%d)", chance );
@@ -6820,6 +6839,7 @@ void map::add_spawn( const mtype_id &type, int count, const point &p, bool frien
     }
     spawn_point tmp( type, count, offset, faction_id, mission_id, friendly, name );
     place_on_submap->spawns.push_back( tmp );
+    mapgen_profile::add_monsters( count );
 }
 
 vehicle *map::add_vehicle( const vproto_id &type, const point &p, const int dir,
@@ -6880,6 +6900,7 @@ vehicle *map::add_vehicle( const vproto_id &type, const tripoint &p, const int d
         auto &ch = get_cache( placed_vehicle->sm_pos.z );
         ch.vehicle_list.insert( placed_vehicle );
         add_vehicle_to_cache( placed_vehicle );
+        mapgen_profile::add_vehicle();
 
         //debugmsg ("grid[%d]->vehicles.size=%d veh.parts.size=%d", nonant, grid[nonant]->vehicles.size(),veh.parts.size());
     }
@@ -7075,14 +7096,13 @@ void map::rotate( int turns )
         std::swap( *get_submap_at_grid( point_zero ), *get_submap_at_grid( point_south_east ) );
         std::swap( *get_submap_at_grid( point_east ), *get_submap_at_grid( point_south ) );
     } else {
+        // Same cycle as in submap::rotate: three swaps with the first submap, no temporary.
         point p;
-        submap tmp;
-
-        std::swap( *get_submap_at_grid( point_south_east - p ), tmp );
+        submap &first = *get_submap_at_grid( point_south_east - p );
 
-        for( int k = 0; k < 4; ++k ) {
+        for( int k = 0; k < 3; ++k ) {
             p = p.rotate( turns, { 2, 2 } );
-            std::swap( *get_submap_at_grid( point_south_east - p ), tmp );
+            std::swap( first, *get_submap_at_grid( point_south_east - p ) );
         }
     }
 
@@ -8266,7 +8286,8 @@ bool run_mapgen_update_func( const std::string &update_mapgen_id, const tripoint
 {
     const auto update_function = update_mapgen.find( update_mapgen_id );
 
-    if( update_function == update_mapgen.end() || update_function->second.empty() ) {
+    if( update_function == update_mapgen.end() || update_function->second.empty() ||
+        !setup_on_first_use( *update_function->second[0] ) ) {
         return false;
     }
     return update_function->second[0]->update_map( omt_pos, point_zero, miss, cancel_on_collision );
@@ -8280,7 +8301,8 @@ std::pair<std::map<ter_id, int>, std::map<furn_id, int>> get_changed_ids_from_up
 
     const auto update_function = update_mapgen.find( update_mapgen_id );
 
-    if( update_function == update_mapgen.end() || update_function->second.empty() ) {
+    if( update_function == update_mapgen.end() || update_function->second.empty() ||
+        !setup_on_first_use( *update_function->second[0] ) ) {
         return std::make_pair( terrains, furnitures );
     }
 
@@ -8326,6 +8348,7 @@ bool run_mapgen_func( const std::string &mapgen_id, map *m, oter_id terrain_type
         const int rlast = weightit->second.rbegin()->first;
         const int roll = rng( 1, rlast );
         const int fidx = weightit->second.lower_bound( roll )->second;
+        mapgen_profile::scope profile( "mapgen", mapgen_id );
         fmapit->second[fidx]->generate( m, terrain_type, dat, turn, density );
         return true;
     }
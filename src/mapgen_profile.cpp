@@ -0,0 +1,133 @@
+#include "mapgen_profile.h"
+
+#include <algorithm>
+#include <map>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "cata_utility.h"
+#include "debug.h"
+#include "string_formatter.h"
+
+namespace
+{
+
+using profile_clock = std::chrono::steady_clock;
+
+struct profile_entry {
+    profile_clock::duration time = profile_clock::duration::zero();
+    int calls = 0;
+    int items = 0;
+    int vehicles = 0;
+    int monsters = 0;
+};
+
+struct profile_state {
+    std::string path;
+    // (kind, name) -> totals
+    std::map<std::pair<std::string, std::string>, profile_entry> entries;
+    // Entries of the scopes that are still open, innermost last
+    std::vector<profile_entry *> open;
+};
+
+profile_state *state = nullptr;
+
+profile_entry *innermost()
+{
+    return state && !state->open.empty() ? state->open.back() : nullptr;
+}
+
+double to_milliseconds( const profile_clock::duration &d )
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>( d ).count() / 1000.0;
+}
+
+} // namespace
+
+namespace mapgen_profile
+{
+
+void enable( const std::string &path )
+{
+    static profile_state the_state;
+    the_state.path = path;
+    state = &the_state;
+}
+
+bool enabled()
+{
+    return state != nullptr;
+}
+
+void write()
+{
+    if( !state ) {
+        return;
+    }
+    using entry_ref = std::map<std::pair<std::string, std::string>, profile_entry>::const_iterator;
+    std::vector<entry_ref> sorted;
+    for( auto it = state->entries.cbegin(); it != state->entries.cend(); ++it ) {
+        sorted.push_back( it );
+    }
+    std::sort( sorted.begin(), sorted.end(), []( const entry_ref & lhs, const entry_ref & rhs ) {
+        return lhs->second.time > rhs->second.time;
+    } );
+    const bool written = write_to_file( state->path, [&sorted]( std::ostream & fout ) {
+        fout << "kind\tname\tcalls\ttotal_ms\tmean_ms\titems\tvehicles\tmonsters\n";
+        for( const entry_ref &it : sorted ) {
+            const profile_entry &e = it->second;
+            const double total = to_milliseconds( e.time );
+            fout << string_format( "%s\t%s\t%d\t%.3f\t%.3f\t%d\t%d\t%d\n", it->first.first,
+                                   it->first.second, e.calls, total, e.calls ? total / e.calls : 0.0,
+                                   e.items, e.vehicles, e.monsters );
+        }
+    }, nullptr );
+    if( !written ) {
+        DebugLog( D_WARNING, DC_ALL ) << "Could not write the mapgen profile to " << state->path;
+    }
+}
+
+void add_items( const int count )
+{
+    if( profile_entry *e = innermost() ) {
+        e->items += count;
+    }
+}
+
+void add_vehicle()
+{
+    if( profile_entry *e = innermost() ) {
+        ++e->vehicles;
+    }
+}
+
+void add_monsters( const int count )
+{
+    if( profile_entry *e = innermost() ) {
+        e->monsters += count;
+    }
+}
+
+scope::scope( const char *kind, const std::string &name ) : recording( state != nullptr )
+{
+    if( !recording ) {
+        return;
+    }
+    // std::map nodes are stable, so the pointer stays valid while other entries are added.
+    state->open.push_back( &state->entries[std::make_pair( std::string( kind ), name )] );
+    start = profile_clock::now();
+}
+
+scope::~scope()
+{
+    if( !recording || !state || state->open.empty() ) {
+        return;
+    }
+    profile_entry &e = *state->open.back();
+    state->open.pop_back();
+    e.time += profile_clock::now() - start;
+    ++e.calls;
+}
+
+} // namespace mapgen_profile
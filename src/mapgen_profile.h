@@ -0,0 +1,49 @@
+#pragma once
+#ifndef MAPGEN_PROFILE_H
+#define MAPGEN_PROFILE_H
+
+#include <chrono>
+#include <string>
+
+/**
+ * Optional summary of what map generation costs, enabled with the --mapgen-profile
+ * command line flag. Time, spawned items, placed vehicles and monster spawns are
+ * summed per overmap terrain, mapgen function, nested chunk, map extra and item group.
+ * The report is written, most expensive entries first, when the game exits.
+ *
+ * Nothing is recorded (and everything here is cheap) unless it is enabled.
+ */
+namespace mapgen_profile
+{
+
+void enable( const std::string &path );
+bool enabled();
+/** Writes the report to the file given to @ref enable. */
+void write();
+
+/** Attribute spawned things to the innermost open scope. */
+void add_items( int count );
+void add_vehicle();
+void add_monsters( int count );
+
+/**
+ * Adds the time from construction to destruction to the entry of the given kind and name.
+ * Time is inclusive: a nested chunk is also counted in the mapgen that placed it.
+ */
+class scope
+{
+    public:
+        scope( const char *kind, const std::string &name );
+        ~scope();
+
+        scope( const scope & ) = delete;
+        scope &operator=( const scope & ) = delete;
+
+    private:
+        bool recording;
+        std::chrono::steady_clock::time_point start;
+};
+
+} // namespace mapgen_profile
+
+#endif
@@ -4,6 +4,7 @@
 #include "filesystem.h"
 #include "platform_win.h"
 
+#include <atomic>
 #include <cstdlib>
 #include <stdexcept>
 
@@ -101,6 +102,24 @@ void MAP_SHARING::setDefaults()
     MAP_SHARING::addAdmin( "admin" );
 }
 
+// The map buffer writes its files on a background thread
+static std::atomic<uint64_t> files_written( 0 );
+static std::atomic<uint64_t> bytes_written( 0 );
+static thread_local written_totals written_here;
+
+written_totals total_written()
+{
+    written_totals result;
+    result.files = files_written;
+    result.bytes = bytes_written;
+    return result;
+}
+
+written_totals written_on_this_thread()
+{
+    return written_here;
+}
+
 void ofstream_wrapper::open( const std::ios::openmode mode )
 {
     // Create a *unique* temporary path. No other running program should
@@ -122,6 +141,9 @@ void ofstream_wrapper::open( const std::ios::openmode mode )
         remove_file( temp_path );
     }
 
+    // Saves are written in many small pieces, a big buffer turns them into few large writes.
+    buffer.resize( 1 << 16 );
+    file_stream.rdbuf()->pubsetbuf( buffer.data(), buffer.size() );
     file_stream.open( temp_path, mode );
     if( !file_stream.is_open() ) {
         throw std::runtime_error( "opening file failed" );
@@ -140,9 +162,14 @@ void ofstream_wrapper::close()
         remove_file( temp_path );
         throw std::runtime_error( "writing to file failed" );
     }
+    const std::streamoff size = file_stream.tellp();
     file_stream.close();
     if( !rename_file( temp_path, path ) ) {
         // Leave the temp path, so the user can move it if possible.
         throw std::runtime_error( "moving temporary file \"" + temp_path + "\" failed" );
     }
+    ++files_written;
+    bytes_written += size > 0 ? size : 0;
+    ++written_here.files;
+    written_here.bytes += size > 0 ? size : 0;
 }
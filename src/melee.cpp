@@ -2059,7 +2059,9 @@ double player::weapon_value( const item &weap, int ammo ) const
 
     // A small bonus for guns you can also use to hit stuff with (bayonets etc.)
     const double my_val = more + ( less / 2.0 );
-    add_msg( m_debug, "%s (%ld ammo) sum value: %.1f", weap.type->get_id(), ammo, my_val );
+    if( debug_mode ) {
+        add_msg( m_debug, "%s (%ld ammo) sum value: %.1f", weap.type->get_id(), ammo, my_val );
+    }
     if( &weapon == &weap ) {
         cached_info.emplace( "weapon_value", my_val );
     }
@@ -2110,7 +2112,9 @@ double player::melee_value( const item &weap ) const
         my_value *= 1.0f + 0.5f * ( sqrtf( reach ) - 1.0f );
     }
 
-    add_msg( m_debug, "%s as melee: %.1f", weap.type->get_id(), my_value );
+    if( debug_mode ) {
+        add_msg( m_debug, "%s as melee: %.1f", weap.type->get_id(), my_value );
+    }
 
     return std::max( 0.0, my_value );
 }
@@ -1,5 +1,6 @@
 #include "memorial_logger.h"
 
+#include <fstream>
 #include <sstream>
 
 #include "addiction.h"
@@ -62,6 +63,7 @@ static const trait_id trait_SAPIOVORE( "SAPIOVORE" );
 
 void memorial_logger::clear()
 {
+    saved_path.clear();
     log.clear();
 }
 
@@ -90,22 +92,64 @@ void memorial_logger::add( const std::string &male_msg,
 }
 
 /**
- * Loads the data in a memorial file from the given ifstream. All the memorial
+ * Reads the data in a memorial file from the given ifstream. All the memorial
  * entry lines begin with a pipe (|).
  * @param fin The ifstream to read the memorial entries from.
+ * @param output Where the entries are written to, delimited by newlines.
  */
-void memorial_logger::load( std::istream &fin )
+static void copy_entries( std::istream &fin, std::ostream &output )
 {
+    static const char *eol = cata_files::eol();
     std::string entry;
-    log.clear();
     while( fin.peek() == '|' ) {
         getline( fin, entry );
         // strip all \r from end of string
         while( *entry.rbegin() == '\r' ) {
             entry.pop_back();
         }
-        log.push_back( entry );
+        output << entry << eol;
+    }
+}
+
+void memorial_logger::load( const std::string &path )
+{
+    log.clear();
+    saved_path = file_exist( path ) ? path : std::string();
+}
+
+/**
+ * A save only adds the entries since the last one to what is already in the file, which is
+ * copied as it is instead of being split into entries and joined again. The result still goes
+ * through a temporary file, so a failed save leaves the old log intact.
+ */
+bool memorial_logger::save( const std::string &path, const char *const fail_message )
+{
+    static const char *eol = cata_files::eol();
+    if( path != saved_path ) {
+        const bool written = write_to_file( path, [this]( std::ostream & fout ) {
+            fout << dump();
+        }, fail_message );
+        if( !written ) {
+            return false;
+        }
+    } else if( !log.empty() ) {
+        const bool written = write_to_file( path, [this, &path]( std::ostream & fout ) {
+            read_from_file_optional( path, [&fout]( std::istream & fin ) {
+                if( fin.peek() != std::char_traits<char>::eof() ) {
+                    fout << fin.rdbuf();
+                }
+            } );
+            for( const std::string &elem : log ) {
+                fout << elem << eol;
+            }
+        }, fail_message );
+        if( !written ) {
+            return false;
+        }
     }
+    saved_path = path;
+    log.clear();
+    return true;
 }
 
 /**
@@ -118,6 +162,11 @@ std::string memorial_logger::dump() const
     static const char *eol = cata_files::eol();
     std::stringstream output;
 
+    if( !saved_path.empty() ) {
+        read_from_file_optional( saved_path, [&output]( std::istream & fin ) {
+            copy_entries( fin, output );
+        } );
+    }
     for( auto &elem : log ) {
         output << elem << eol;
     }
@@ -347,6 +396,20 @@ void memorial_logger::write( std::ostream &file, const std::string &epitaph ) co
     file << dump();
 }
 
+bool memorial_logger::wants_event( event_type type ) const
+{
+    // These are frequent and never produce a memorial log entry
+    switch( type ) {
+        case event_type::avatar_moves:
+        case event_type::character_gets_headshot:
+        case event_type::character_heals_damage:
+        case event_type::character_takes_damage:
+            return false;
+        default:
+            return true;
+    }
+}
+
 void memorial_logger::notify( const cata::event &e )
 {
     switch( e.type() ) {
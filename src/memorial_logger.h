@@ -2,6 +2,7 @@
 #ifndef CATA_MEMORIAL_LOGGER_H
 #define CATA_MEMORIAL_LOGGER_H
 
+#include <iosfwd>
 #include <map>
 #include <string>
 #include <vector>
@@ -27,8 +28,13 @@ class memorial_logger : public event_subscriber
                         string_format( female_msg, args... ) );
         }
 
-        // Loads the memorial log from a file
-        void load( std::istream &fin );
+        // Takes the memorial log saved in a file as the start of the log. The file is only
+        // read when all of the log is needed, by dump.
+        void load( const std::string &path );
+        // Appends the events logged since the last load or save to the file. All of them
+        // are only written when it is not the file the log was loaded from or saved to.
+        // @param fail_message As for write_to_file.
+        bool save( const std::string &path, const char *fail_message );
         // Dumps all memorial events into a single newline-delimited string
         // (this is the content of the temporary file used to preserve the log
         // over saves, not the final memorial file).
@@ -37,8 +43,12 @@ class memorial_logger : public event_subscriber
         // Prints out the final memorial file
         void write( std::ostream &memorial_file, const std::string &epitaph ) const;
 
+        bool wants_event( event_type ) const override;
         void notify( const cata::event & ) override;
     private:
+        // The file with the events before those in log, empty if there is none
+        std::string saved_path;
+        // The events since the log was loaded or saved
         std::vector<std::string> log;
 };
 
@@ -0,0 +1,267 @@
+#include "memory_census.h"
+
+#include <algorithm>
+#include <ostream>
+
+#include "cata_utility.h"
+#include "construction.h"
+#include "debug.h"
+#include "field.h"
+#include "game.h"
+#include "item.h"
+#include "item_factory.h"
+#include "itype.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "monster.h"
+#include "monstergenerator.h"
+#include "mtype.h"
+#include "npc.h"
+#include "overmapbuffer.h"
+#include "recipe.h"
+#include "recipe_dictionary.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "veh_type.h"
+#include "vehicle.h"
+#include "visitable.h"
+
+namespace
+{
+
+double to_kib( const size_t bytes )
+{
+    return bytes / 1024.0;
+}
+
+void add_submaps( memory_census::census &c )
+{
+    // The skipfield a colony keeps next to each element
+    constexpr size_t colony_item = sizeof( unsigned short );
+    for( auto &pr : MAPBUFFER ) {
+        const submap &sm = *pr.second;
+        memory_census::submap_usage usage;
+        usage.pos = pr.first;
+        usage.bytes = sizeof( submap );
+        // The per square stacks and fields, once anything was put there
+        if( sm.itm.allocated() ) {
+            usage.bytes += sizeof( cata::colony<item> ) * SEEX * SEEY;
+        }
+        if( sm.fld.allocated() ) {
+            usage.bytes += sizeof( field ) * SEEX * SEEY;
+        }
+
+        size_t item_bytes = 0;
+        size_t fields = 0;
+        for( int x = 0; x < SEEX; ++x ) {
+            for( int y = 0; y < SEEY; ++y ) {
+                for( const item &it : sm.itm[x][y] ) {
+                    item_bytes += memory_census::item_bytes( it ) + colony_item;
+                    ++usage.items;
+                }
+                fields += sm.fld[x][y].field_count();
+            }
+        }
+        c.add( "submaps", "item", usage.items, item_bytes );
+        usage.bytes += item_bytes;
+
+        const size_t field_bytes = fields * ( sizeof( field_entry ) + memory_census::node_overhead );
+        c.add( "submaps", "field", fields, field_bytes );
+        usage.bytes += field_bytes;
+
+        for( const std::unique_ptr<vehicle> &veh : sm.vehicles ) {
+            size_t vehicle_bytes = sizeof( vehicle ) + veh->parts.capacity() * sizeof( vehicle_part );
+            size_t cargo = 0;
+            size_t cargo_bytes = 0;
+            for( size_t part = 0; part < veh->parts.size(); ++part ) {
+                for( const item &it : veh->get_items( part ) ) {
+                    cargo_bytes += memory_census::item_bytes( it ) + colony_item;
+                    ++cargo;
+                }
+            }
+            c.add( "submaps", "vehicle", 1, vehicle_bytes );
+            c.add( "submaps", "vehicle cargo", cargo, cargo_bytes );
+            usage.items += cargo;
+            usage.bytes += vehicle_bytes + cargo_bytes;
+        }
+
+        const size_t other_bytes = sm.spawns.capacity() * sizeof( spawn_point ) +
+                                   sm.cosmetics.capacity() * sizeof( submap::cosmetic_t ) +
+                                   sm.partial_constructions.size() *
+                                   ( sizeof( partial_con ) + memory_census::node_overhead );
+        c.add( "submaps", "submap", 1, sizeof( submap ) + other_bytes );
+        usage.bytes += other_bytes;
+        c.submaps.push_back( usage );
+    }
+}
+
+void add_creatures( memory_census::census &c )
+{
+    size_t count = 0;
+    size_t bytes = 0;
+    for( const monster &critter : g->all_monsters() ) {
+        bytes += memory_census::monster_bytes( critter );
+        ++count;
+    }
+    c.add( "creatures", "monster", count, bytes );
+    // NPCs are all owned by the overmaps, active or not, and are counted there
+}
+
+void add_types( memory_census::census &c )
+{
+    const size_t item_types = item_controller->all().size();
+    c.add( "types", "item type", item_types, item_types * sizeof( itype ) );
+    const size_t monster_types = MonsterGenerator::generator().get_all_mtypes().size();
+    c.add( "types", "monster type", monster_types, monster_types * sizeof( mtype ) );
+    c.add( "types", "terrain", ter_t::count(), ter_t::count() * sizeof( ter_t ) );
+    c.add( "types", "furniture", furn_t::count(), furn_t::count() * sizeof( furn_t ) );
+    const size_t vehicle_parts = vpart_info::all().size();
+    c.add( "types", "vehicle part type", vehicle_parts,
+           vehicle_parts * ( sizeof( vpart_info ) + memory_census::node_overhead ) );
+    const size_t vehicle_types = vehicle_prototype::get_all().size();
+    c.add( "types", "vehicle prototype", vehicle_types, vehicle_types * sizeof( vehicle_prototype ) );
+    c.add( "types", "recipe", recipe_dict.size(),
+           recipe_dict.size() * ( sizeof( recipe ) + memory_census::node_overhead ) );
+}
+
+} // namespace
+
+namespace memory_census
+{
+
+void census::add( const std::string &subsystem, const std::string &type, const size_t count,
+                  const size_t bytes )
+{
+    // There are only a few dozen entries, a linear search is fine
+    auto iter = std::find_if( totals.begin(), totals.end(), [&]( const entry & e ) {
+        return e.type == type && e.subsystem == subsystem;
+    } );
+    if( iter == totals.end() ) {
+        totals.push_back( { subsystem, type, count, bytes } );
+    } else {
+        iter->count += count;
+        iter->bytes += bytes;
+    }
+}
+
+size_t census::bytes( const std::string &subsystem ) const
+{
+    size_t result = 0;
+    for( const entry &e : totals ) {
+        if( e.subsystem == subsystem ) {
+            result += e.bytes;
+        }
+    }
+    return result;
+}
+
+size_t item_bytes( const item &it )
+{
+    size_t result = sizeof( item );
+    for( const item &content : it.contents ) {
+        result += item_bytes( content ) + node_overhead;
+    }
+    for( const item &component : it.components ) {
+        result += item_bytes( component ) + node_overhead;
+    }
+    return result;
+}
+
+size_t monster_bytes( const monster &critter )
+{
+    size_t result = sizeof( monster );
+    for( const item &it : critter.inv ) {
+        result += item_bytes( it );
+    }
+    return result;
+}
+
+size_t npc_bytes( const npc &guy )
+{
+    size_t result = sizeof( npc );
+    guy.visit_items( [&result]( const item * it ) {
+        result += item_bytes( *it );
+        // item_bytes already counted the contents
+        return VisitResponse::SKIP;
+    } );
+    return result;
+}
+
+census take()
+{
+    census c;
+    add_submaps( c );
+    g->m.memory_usage( c );
+    overmap_buffer.memory_usage( c );
+    add_creatures( c );
+    add_types( c );
+    return c;
+}
+
+std::string report( const census &c, const size_t top_n )
+{
+    std::vector<std::string> subsystems;
+    for( const entry &e : c.entries() ) {
+        if( std::find( subsystems.begin(), subsystems.end(), e.subsystem ) == subsystems.end() ) {
+            subsystems.push_back( e.subsystem );
+        }
+    }
+    std::sort( subsystems.begin(), subsystems.end(), [&c]( const std::string & lhs,
+    const std::string & rhs ) {
+        return c.bytes( lhs ) > c.bytes( rhs );
+    } );
+    size_t total = 0;
+    for( const std::string &subsystem : subsystems ) {
+        total += c.bytes( subsystem );
+    }
+
+    std::string result = string_format( "Estimated total: %.1f KiB\n\n", to_kib( total ) );
+    for( const std::string &subsystem : subsystems ) {
+        result += string_format( "%-12s %12.1f KiB\n", subsystem, to_kib( c.bytes( subsystem ) ) );
+    }
+    if( top_n == 0 ) {
+        return result;
+    }
+
+    std::vector<entry> sorted = c.entries();
+    std::sort( sorted.begin(), sorted.end(), []( const entry & lhs, const entry & rhs ) {
+        return lhs.bytes > rhs.bytes;
+    } );
+    result += string_format( "\n%-12s %-20s %10s %14s\n", "subsystem", "type", "count", "KiB" );
+    for( const entry &e : sorted ) {
+        result += string_format( "%-12s %-20s %10d %14.1f\n", e.subsystem, e.type, e.count,
+                                 to_kib( e.bytes ) );
+    }
+
+    std::vector<submap_usage> submaps = c.submaps;
+    const size_t shown = std::min( top_n, submaps.size() );
+    std::partial_sort( submaps.begin(), submaps.begin() + shown, submaps.end(),
+    []( const submap_usage & lhs, const submap_usage & rhs ) {
+        return lhs.items > rhs.items;
+    } );
+    result += string_format( "\nSubmaps with the most items, of %d buffered:\n", submaps.size() );
+    for( size_t i = 0; i < shown; ++i ) {
+        const submap_usage &sm = submaps[i];
+        result += string_format( "%s %10d items %12.1f KiB\n", sm.pos.to_string(), sm.items,
+                                 to_kib( sm.bytes ) );
+    }
+    return result;
+}
+
+bool run( const std::string &world, const std::string &path )
+{
+    if( !g->load( world ) ) {
+        return false;
+    }
+    const std::string text = report( take(), 20 );
+    const bool written = write_to_file( path, [&text]( std::ostream & fout ) {
+        fout << text;
+    }, nullptr );
+    if( !written ) {
+        DebugLog( D_WARNING, DC_ALL ) << "Could not write the memory census to " << path;
+    }
+    return true;
+}
+
+} // namespace memory_census
@@ -0,0 +1,83 @@
+#pragma once
+#ifndef MEMORY_CENSUS_H
+#define MEMORY_CENSUS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "point.h"
+
+class item;
+class monster;
+class npc;
+
+/**
+ * Estimates how much memory the resident world state takes: buffered submaps, overmaps, map
+ * caches, creatures and the types loaded from JSON. The estimates add up the objects and what
+ * they own through their containers, allocator overhead is only roughly accounted for.
+ * Available from the debug menu and with the --memory-census command line flag.
+ */
+namespace memory_census
+{
+
+// Rough cost of one element of the node based standard containers, on top of the element
+constexpr size_t node_overhead = 4 * sizeof( void * );
+
+struct entry {
+    std::string subsystem;
+    std::string type;
+    size_t count = 0;
+    size_t bytes = 0;
+};
+
+struct submap_usage {
+    /** Absolute submap coordinates. */
+    tripoint pos;
+    size_t items = 0;
+    size_t bytes = 0;
+};
+
+class census
+{
+    public:
+        /** Adds count objects with bytes in total to the entry of that subsystem and type. */
+        void add( const std::string &subsystem, const std::string &type, size_t count, size_t bytes );
+
+        const std::vector<entry> &entries() const {
+            return totals;
+        }
+        size_t bytes( const std::string &subsystem ) const;
+
+        /** Every buffered submap, for finding the largest ones. */
+        std::vector<submap_usage> submaps;
+
+    private:
+        std::vector<entry> totals;
+};
+
+/** Estimated size of an item, including its contents and components. */
+size_t item_bytes( const item &it );
+/** Estimated size of a monster, including its inventory. */
+size_t monster_bytes( const monster &critter );
+/** Estimated size of an NPC, including everything they carry. */
+size_t npc_bytes( const npc &guy );
+
+/** Walks the world state of the current game. */
+census take();
+
+/**
+ * The census as text: subsystems and types, largest first, then the top_n submaps with the
+ * most items. Without top_n only the subsystem totals are listed.
+ */
+std::string report( const census &c, size_t top_n );
+
+/**
+ * Loads the first save of the given world and writes the report of its census to path.
+ * @return false if the world could not be loaded.
+ */
+bool run( const std::string &world, const std::string &path );
+
+} // namespace memory_census
+
+#endif
@@ -181,7 +181,8 @@ bool monster::can_move_to( const tripoint &p ) const
             }
         }
 
-        const field &target_field = g->m.field_at( p );
+        const map &here = g->m;
+        const field &target_field = here.field_at( p );
 
         // Higher awareness is needed for identifying these as threats.
         if( avoid_complex ) {
@@ -261,6 +262,43 @@ float monster::rate_target( Creature &c, float best, bool smart ) const
     return INT_MAX;
 }
 
+// Bumped whenever the stored player sight checks might no longer be accurate.
+static int planned_sight_generation = 0;
+
+void monster::forget_planned_sights()
+{
+    planned_sight_generation++;
+}
+
+int monster::vision_state() const
+{
+    return ( can_see() ? 1 : 0 ) | ( effect_cache[VISION_IMPAIRED] ? 2 : 0 ) |
+           ( has_effect( effect_no_sight ) ? 4 : 0 ) | ( underwater ? 8 : 0 );
+}
+
+void monster::plan_player_sight()
+{
+    planned_sight.valid = true;
+    planned_sight.generation = planned_sight_generation;
+    planned_sight.pos = pos();
+    planned_sight.player_pos = g->u.pos();
+    planned_sight.vision = vision_state();
+    planned_sight.sees = sees( g->u );
+}
+
+bool monster::sees_player()
+{
+    if( planned_sight.valid ) {
+        // Only the first check of a turn can use it, after that the monster has moved anyway.
+        planned_sight.valid = false;
+        if( planned_sight.generation == planned_sight_generation && planned_sight.pos == pos() &&
+            planned_sight.player_pos == g->u.pos() && planned_sight.vision == vision_state() ) {
+            return planned_sight.sees;
+        }
+    }
+    return sees( g->u );
+}
+
 void monster::plan()
 {
     const auto &factions = g->critter_tracker->factions();
@@ -285,7 +323,7 @@ void monster::plan()
     auto mood = attitude();
 
     // If we can see the player, move toward them or flee, simpleminded animals are too dumb to follow the player.
-    if( friendly == 0 && sees( g->u ) && !has_flag( MF_PET_WONT_FOLLOW ) ) {
+    if( friendly == 0 && sees_player() && !has_flag( MF_PET_WONT_FOLLOW ) ) {
         dist = rate_target( g->u, dist, smart_planning );
         fleeing = fleeing || is_fleeing( g->u );
         target = &g->u;
@@ -381,35 +419,41 @@ void monster::plan()
     }
 
     fleeing = fleeing || ( mood == MATT_FLEE );
+    // Monsters out of sight range rate as INT_MAX, so only look at the ones nearby
+    const int sight_radius = std::max( max_sight_range, 1 );
+    const std::vector<monster *> nearby = g->critter_tracker->find_near( pos(), sight_radius,
+                                          fov_3d ? sight_radius : 0 );
+    static const mfaction_id playerfaction = mfaction_str_id( "player" ).id();
+    const auto faction_of = []( const monster & mon ) {
+        // Same as the faction map of Creature_tracker
+        return mon.friendly == 0 ? mon.faction : playerfaction;
+    };
     if( friendly == 0 ) {
-        for( const auto &fac : factions ) {
-            auto faction_att = faction.obj().attitude( fac.first );
+        for( monster *const critter : nearby ) {
+            monster &mon = *critter;
+            if( mon.is_dead() ) {
+                continue;
+            }
+            auto faction_att = faction.obj().attitude( faction_of( mon ) );
             if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
                 continue;
             }
 
-            for( const std::weak_ptr<monster> &weak : fac.second ) {
-                const std::shared_ptr<monster> shared = weak.lock();
-                if( !shared ) {
-                    continue;
-                }
-                monster &mon = *shared;
-                float rating = rate_target( mon, dist, smart_planning );
-                if( rating < dist ) {
-                    target = &mon;
-                    dist = rating;
-                }
-                if( rating <= 5 ) {
-                    anger += angers_hostile_near;
-                    morale -= fears_hostile_near;
-                }
+            float rating = rate_target( mon, dist, smart_planning );
+            if( rating < dist ) {
+                target = &mon;
+                dist = rating;
+            }
+            if( rating <= 5 ) {
+                anger += angers_hostile_near;
+                morale -= fears_hostile_near;
             }
         }
     }
 
     // Friendly monsters here
     // Avoid for hordes of same-faction stuff or it could get expensive
-    const auto actual_faction = friendly == 0 ? faction : mfaction_str_id( "player" );
+    const mfaction_id actual_faction = friendly == 0 ? faction : playerfaction;
     const auto &myfaction_iter = factions.find( actual_faction );
     if( myfaction_iter == factions.end() ) {
         DebugLog( D_ERROR, D_GAME ) << disp_name() << " tried to find faction "
@@ -420,12 +464,11 @@ void monster::plan()
     }
     swarms = swarms && target == nullptr; // Only swarm if we have no target
     if( group_morale || swarms ) {
-        for( const std::weak_ptr<monster> &weak : myfaction_iter->second ) {
-            const std::shared_ptr<monster> shared = weak.lock();
-            if( !shared ) {
+        for( monster *const critter : nearby ) {
+            monster &mon = *critter;
+            if( mon.is_dead() || faction_of( mon ) != actual_faction ) {
                 continue;
             }
-            monster &mon = *shared;
             float rating = rate_target( mon, dist, smart_planning );
             if( group_morale && rating <= 10 ) {
                 morale += 10 - rating;
@@ -734,7 +777,13 @@ void monster::move()
         if( pf_settings.max_dist >= rl_dist( pos(), goal ) &&
             ( path.empty() || rl_dist( pos(), path.front() ) >= 2 || path.back() != goal ) ) {
             // We need a new path
-            path = g->m.route( pos(), goal, pf_settings, get_path_avoid() );
+            const std::set<tripoint> path_avoid = get_path_avoid();
+            if( path_avoid.empty() ) {
+                // Usually many monsters chase the same target, so share the work between them
+                path = g->m.route_shared( pos(), goal, pf_settings );
+            } else {
+                path = g->m.route( pos(), goal, pf_settings, path_avoid );
+            }
         }
 
         // Try to respect old paths, even if we can't pathfind at the moment
@@ -1068,6 +1117,10 @@ tripoint monster::scent_move()
         ( fleeing && bestsmell == 0 ) ) {
         return next;
     }
+    // Nothing nearby smells strong enough to follow, no need to look at each tile.
+    if( !fleeing && g->scent.peak_near( pos() ) < bestsmell ) {
+        return next;
+    }
     const bool can_bash = bash_skill() > 0;
     for( const auto &dest : g->m.points_in_radius( pos(), 1, SCENT_MAP_Z_REACH ) ) {
         int smell = g->scent.get( dest );
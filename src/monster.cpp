@@ -168,6 +168,9 @@ static const trait_id trait_FLOWERS( "FLOWERS" );
 static const trait_id trait_PACIFIST( "PACIFIST" );
 static const trait_id trait_KILLER( "KILLER" );
 
+// Read for every monster each turn
+static const cached_option<float> option_upgrade_factor( "MONSTER_UPGRADE_FACTOR" );
+
 static const std::map<m_size, std::string> size_names {
     {m_size::MS_TINY, translate_marker( "tiny" )},
     {m_size::MS_SMALL, translate_marker( "small" )},
@@ -302,7 +305,7 @@ void monster::poly( const mtype_id &id )
 
 bool monster::can_upgrade()
 {
-    return upgrades && get_option<float>( "MONSTER_UPGRADE_FACTOR" ) > 0.0;
+    return upgrades && option_upgrade_factor.get() > 0.0;
 }
 
 // For master special attack.
@@ -312,7 +315,7 @@ void monster::hasten_upgrade()
         return;
     }
 
-    const int scaled_half_life = type->half_life * get_option<float>( "MONSTER_UPGRADE_FACTOR" );
+    const int scaled_half_life = type->half_life * option_upgrade_factor.get();
     upgrade_time -= rng( 1, scaled_half_life );
     if( upgrade_time < 0 ) {
         upgrade_time = 0;
@@ -326,7 +329,7 @@ int monster::next_upgrade_time()
     if( type->age_grow > 0 ) {
         return type->age_grow;
     }
-    const int scaled_half_life = type->half_life * get_option<float>( "MONSTER_UPGRADE_FACTOR" );
+    const int scaled_half_life = type->half_life * option_upgrade_factor.get();
     int day = 1; // 1 day of guaranteed evolve time
     for( int i = 0; i < UPGRADE_MAX_ITERS; i++ ) {
         if( one_in( 2 ) ) {
@@ -1994,6 +1997,9 @@ void monster::process_turn()
             }
         } else {
             for( const tripoint &zap : g->m.points_in_radius( pos(), 1 ) ) {
+                if( !g->m.has_items( zap ) ) {
+                    continue;
+                }
                 const bool player_sees = g->u.sees( zap );
                 const auto items = g->m.i_at( zap );
                 for( const auto &item : items ) {
@@ -2045,6 +2051,28 @@ void monster::process_turn()
     Creature::process_turn();
 }
 
+// Applies the adjustments to every monster of the same species as `mon` that can see it.
+static void adjust_witnesses( const monster &mon, const int anger_adjust, const int morale_adjust )
+{
+    std::vector<monster *> witnesses;
+    std::vector<tripoint> witness_positions;
+    for( monster &critter : g->all_monsters() ) {
+        if( critter.type->same_species( *mon.type ) ) {
+            witnesses.push_back( &critter );
+            witness_positions.push_back( critter.pos() );
+        }
+    }
+    // Large groups of one species are common, so do the sight checks as one batch.
+    const std::vector<bool> sees = g->m.sees( witness_positions, mon.pos(),
+                                   g->light_level( mon.posz() ) );
+    for( size_t i = 0; i < witnesses.size(); i++ ) {
+        if( sees[i] ) {
+            witnesses[i]->morale += morale_adjust;
+            witnesses[i]->anger += anger_adjust;
+        }
+    }
+}
+
 void monster::die( Creature *nkiller )
 {
     if( dead ) {
@@ -2182,17 +2210,7 @@ void monster::die( Creature *nkiller )
     }
 
     if( anger_adjust != 0 || morale_adjust != 0 ) {
-        int light = g->light_level( posz() );
-        for( monster &critter : g->all_monsters() ) {
-            if( !critter.type->same_species( *type ) ) {
-                continue;
-            }
-
-            if( g->m.sees( critter.pos(), pos(), light ) ) {
-                critter.morale += morale_adjust;
-                critter.anger += anger_adjust;
-            }
-        }
+        adjust_witnesses( *this, anger_adjust, morale_adjust );
     }
 }
 
@@ -2631,17 +2649,7 @@ void monster::on_hit( Creature *source, body_part,
     }
 
     if( anger_adjust != 0 || morale_adjust != 0 ) {
-        int light = g->light_level( posz() );
-        for( monster &critter : g->all_monsters() ) {
-            if( !critter.type->same_species( *type ) ) {
-                continue;
-            }
-
-            if( g->m.sees( critter.pos(), pos(), light ) ) {
-                critter.morale += morale_adjust;
-                critter.anger += anger_adjust;
-            }
-        }
+        adjust_witnesses( *this, anger_adjust, morale_adjust );
     }
 
     check_dead_state();
@@ -194,6 +194,15 @@ class monster : public Creature
         // How good of a target is given creature (checks for visibility)
         float rate_target( Creature &c, float best, bool smart = false ) const;
         void plan();
+        /**
+         * Works out ahead of @ref plan whether the monster sees the player, so plan can reuse
+         * the answer while nothing it was derived from has changed.
+         * Only reads the monster, the player and the map caches, which lets game::monmove run
+         * it for many monsters at once.
+         */
+        void plan_player_sight();
+        /** Drops every answer stored by @ref plan_player_sight, e.g. after the player changed. */
+        static void forget_planned_sights();
         void move(); // Actual movement
         void footsteps( const tripoint &p ); // noise made by movement
         void shove_vehicle( const tripoint &remote_destination,
@@ -506,6 +515,20 @@ class monster : public Creature
         void process_trigger( mon_trigger trig, int amount );
         void process_trigger( mon_trigger trig, const std::function<int()> &amount_func );
 
+        /** The result of @ref plan_player_sight and the state it was worked out from. */
+        struct player_sight_plan {
+            bool valid = false;
+            int generation = 0;
+            tripoint pos;
+            tripoint player_pos;
+            int vision = 0;
+            bool sees = false;
+        };
+        /** Bit mask of the state of this monster that seeing the player depends on. */
+        int vision_state() const;
+        /** Same as sees( g->u ), using the planned answer if it is still accurate. */
+        bool sees_player();
+
     private:
         int hp;
         std::map<std::string, mon_special_attack> special_attacks;
@@ -527,6 +550,7 @@ class monster : public Creature
         std::vector<tripoint> path;
         std::bitset<NUM_MEFF> effect_cache;
         cata::optional<time_duration> summon_time_limit = cata::nullopt;
+        player_sight_plan planned_sight;
 
         player *find_dragged_foe();
         void nursebot_operate( player *dragged_foe );
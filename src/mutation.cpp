@@ -84,15 +84,11 @@ bool Character::has_trait( const trait_id &b ) const
 
 bool Character::has_trait_flag( const std::string &b ) const
 {
-    // UGLY, SLOW, should be cached as my_mutation_flags or something
-    for( const auto &mut : my_mutations ) {
-        auto &mut_data = mut.first.obj();
-        if( mut_data.flags.count( b ) > 0 ) {
-            return true;
-        }
-    }
-
-    return false;
+    // cached_mutations mirrors my_mutations, without having to resolve each id
+    return std::any_of( cached_mutations.begin(), cached_mutations.end(),
+    [&b]( const mutation_branch * mut ) {
+        return mut->flags.count( b ) > 0;
+    } );
 }
 
 bool Character::has_base_trait( const trait_id &b ) const
@@ -43,6 +43,11 @@ void catacurses::wrefresh( const window &win )
     return curses_check_result( ::wrefresh( win.get<::WINDOW>() ), OK, "wrefresh" );
 }
 
+void catacurses::touchwin( const window &win )
+{
+    return curses_check_result( ::touchwin( win.get<::WINDOW>() ), OK, "touchwin" );
+}
+
 void catacurses::werase( const window &win )
 {
     return curses_check_result( ::werase( win.get<::WINDOW>() ), OK, "werase" );
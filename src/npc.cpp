@@ -2257,9 +2257,12 @@ void npc::on_unload()
 }
 
 // A throtled version of player::update_body since npc's don't need to-the-turn updates.
+// update_body takes care of integrating over the interval, so the ones the player can't see
+// catch up even less often.
 void npc::npc_update_body()
 {
-    if( calendar::once_every( 10_seconds ) ) {
+    const time_duration interval = g->u.sees( *this ) ? 10_seconds : 1_minutes;
+    if( calendar::turn - last_updated >= interval ) {
         update_body( last_updated, calendar::turn );
         last_updated = calendar::turn;
     }
@@ -2288,7 +2291,8 @@ void npc::on_load()
     last_updated = calendar::turn;
     time_point cur = calendar::turn - dt;
     add_msg( m_debug, "on_load() by %s, %d turns", name, to_turns<int>( dt ) );
-    // First update with 30 minute granularity, then 5 minutes, then turns
+    // First update with 30 minute granularity, then 5 minutes, then as often as a loaded NPC
+    // is updated, only the last few turns one by one
     for( ; cur < calendar::turn - 30_minutes; cur += 30_minutes + 1_turns ) {
         update_body( cur, cur + 30_minutes );
         advance_effects( 30_minutes );
@@ -2297,6 +2301,10 @@ void npc::on_load()
         update_body( cur, cur + 5_minutes );
         advance_effects( 5_minutes );
     }
+    for( ; cur < calendar::turn - 10_seconds; cur += 10_seconds + 1_turns ) {
+        update_body( cur, cur + 10_seconds );
+        advance_effects( 10_seconds );
+    }
     for( ; cur < calendar::turn; cur += 1_turns ) {
         update_body( cur, cur + 1_turns );
         process_effects();
@@ -1246,7 +1246,8 @@ class npc : public player
          */
         void on_load();
         /**
-         * Update body, but throttled.
+         * Update body, but throttled: every 10 seconds while the player can see the NPC,
+         * every minute otherwise.
          */
         void npc_update_body();
 
@@ -254,7 +254,9 @@ tripoint npc::good_escape_direction( bool include_pos )
             return MAX_FLOAT;
         }
         float rating = threat_val;
-        for( const auto &e : g->m.field_at( pt ) ) {
+        // Const access, reading doesn't allocate the fields of empty submaps
+        const map &here = g->m;
+        for( const auto &e : here.field_at( pt ) ) {
             if( is_dangerous_field( e.second ) ) {
                 // @todo: Rate fire higher than smoke
                 rating += e.second.get_field_intensity();
@@ -284,7 +286,8 @@ tripoint npc::good_escape_direction( bool include_pos )
 
 bool npc::sees_dangerous_field( const tripoint &p ) const
 {
-    return is_dangerous_fields( g->m.field_at( p ) );
+    const map &here = g->m;
+    return is_dangerous_fields( here.field_at( p ) );
 }
 
 bool npc::could_move_onto( const tripoint &p ) const
@@ -297,8 +300,9 @@ bool npc::could_move_onto( const tripoint &p ) const
         return true;
     }
 
-    const auto fields_here = g->m.field_at( pos() );
-    for( const auto &e : g->m.field_at( p ) ) {
+    const map &here = g->m;
+    const field &fields_here = here.field_at( pos() );
+    for( const auto &e : here.field_at( p ) ) {
         if( !is_dangerous_field( e.second ) ) {
             continue;
         }
@@ -481,7 +485,7 @@ void npc::assess_danger()
 
         // don't ignore monsters that are too close or too close to an ally
         bool is_too_close = dist <= def_radius;
-        const auto test_too_close = [critter, def_radius,
+        const auto test_too_close = [&critter, def_radius,
                  &is_too_close]( const std::weak_ptr<Creature> &guy ) {
             // Bit of a dirty hack - sometimes shared_from, returns nullptr or bad weak_ptr for
             // friendly NPC when the NPC is riding a creature - I dont know why.
@@ -2630,31 +2634,45 @@ void npc::find_item()
         return;
     }
 
+    std::vector<npc *> followers;
+    for( const character_id &elem : g->get_follower_list() ) {
+        if( npc *npc_to_add = g->find_npc( elem ) ) {
+            followers.push_back( npc_to_add );
+        }
+    }
+    // Whether the player or one of their followers can see us; only checked once we
+    // consider taking an item that isn't ours.
+    cata::optional<bool> watched;
+    const auto is_watched = [&followers, &watched, this]() {
+        if( !watched ) {
+            watched = g->u.sees( pos() );
+            for( const npc *elem : followers ) {
+                if( *watched ) {
+                    break;
+                }
+                watched = elem->sees( pos() );
+            }
+        }
+        return *watched;
+    };
+
     const auto consider_item =
-        [&wanted, &best_value, whitelisting, volume_allowed, weight_allowed, this]
+        [&wanted, &best_value, &followers, &is_watched, whitelisting, volume_allowed,
+                  weight_allowed, this]
     ( const item & it, const tripoint & p ) {
         if( it.made_of_from_type( LIQUID ) ) {
             // Don't even consider liquids.
             return;
         }
-        std::vector<npc *> followers;
-        for( auto &elem : g->get_follower_list() ) {
-            std::shared_ptr<npc> npc_to_get = overmap_buffer.find_npc( elem );
-            if( !npc_to_get ) {
-                continue;
-            }
-            npc *npc_to_add = npc_to_get.get();
-            followers.push_back( npc_to_add );
-        }
-        for( auto &elem : followers ) {
-            if( it.has_owner() && it.get_owner() != my_fac && ( elem->sees( this->pos() ) ||
-                    elem->sees( wanted_item_pos ) ) ) {
+        if( it.has_owner() && it.get_owner() != my_fac ) {
+            if( is_watched() || g->u.sees( wanted_item_pos ) ) {
                 return;
             }
-        }
-        if( it.has_owner() && it.get_owner() != my_fac && ( g->u.sees( this->pos() ) ||
-                g->u.sees( wanted_item_pos ) ) ) {
-            return;
+            for( const npc *elem : followers ) {
+                if( elem->sees( wanted_item_pos ) ) {
+                    return;
+                }
+            }
         }
         if( whitelisting && !item_whitelisted( it ) ) {
             return;
@@ -2701,11 +2719,12 @@ void npc::find_item()
         const tripoint abs_p = global_square_location() - pos() + p;
         const int prev_num_items = ai_cache.searched_tiles.get( abs_p, -1 );
         // Prefetch the number of items present so we can bail out if we already checked here.
-        const map_stack m_stack = g->m.i_at( p );
-        int num_items = m_stack.size();
+        // The stack is only looked at where there are items, so empty squares aren't allocated.
+        int num_items = g->m.has_items( p ) ? g->m.i_at( p ).size() : 0;
         const optional_vpart_position vp = g->m.veh_at( p );
+        cata::optional<vpart_reference> cargo;
         if( vp ) {
-            const cata::optional<vpart_reference> cargo = vp.part_with_feature( VPFLAG_CARGO, true );
+            cargo = vp.part_with_feature( VPFLAG_CARGO, true );
             if( cargo ) {
                 vehicle_stack v_stack = cargo->vehicle().get_items( cargo->part_index() );
                 num_items += v_stack.size();
@@ -2719,25 +2738,22 @@ void npc::find_item()
                 ai_cache.searched_tiles.insert( 1000, abs_p, num_items );
             }
         };
-        bool can_see = false;
-        if( g->m.sees_some_items( p, *this ) && sees( p ) ) {
-            can_see = true;
-            for( const item &it : m_stack ) {
+        const bool can_see = sees( p );
+        if( can_see && g->m.sees_some_items( p, *this ) ) {
+            for( const item &it : g->m.i_at( p ) ) {
                 consider_item( it, p );
             }
         }
 
         // Not cached because it gets checked once and isn't expected to change.
-        if( can_see || sees( p ) ) {
-            can_see = true;
+        if( can_see ) {
             consider_terrain( p );
         }
 
-        if( !vp || vp->vehicle().is_moving() || !( can_see || sees( p ) ) ) {
+        if( !vp || vp->vehicle().is_moving() || !can_see ) {
             cache_tile();
             continue;
         }
-        const cata::optional<vpart_reference> cargo = vp.part_with_feature( VPFLAG_CARGO, true );
         static const std::string locked_string( "LOCKED" );
         // TODO: Let player know what parts are safe from NPC thieves
         if( !cargo || cargo->has_feature( locked_string ) ) {
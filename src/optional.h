@@ -65,7 +65,8 @@ class optional
                 construct( other.get() );
             }
         }
-        optional( optional &&other ) : full( false ) {
+        optional( optional &&other ) noexcept( std::is_nothrow_move_constructible<T>::value ) :
+            full( false ) {
             if( other.full ) {
                 construct( std::move( other.get() ) );
             }
@@ -173,7 +174,8 @@ class optional
             }
             return *this;
         }
-        optional &operator=( optional &&other ) {
+        optional &operator=( optional &&other ) noexcept( std::is_nothrow_move_constructible<T>::value
+                && std::is_nothrow_move_assignable<T>::value ) {
             if( full && other.full ) {
                 get() = std::move( other.get() );
             } else if( full ) {
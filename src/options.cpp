@@ -47,12 +47,22 @@ bool log_from_top;
 int message_ttl;
 int message_cooldown;
 bool fov_3d;
+int fov_3d_z_range;
 bool tile_iso;
+int options_generation = 0;
+
+const cached_option<bool> option_sleep_deprivation( "SLEEP_DEPRIVATION" );
 
 std::map<std::string, std::string> TILESETS; // All found tilesets: <name, tileset_dir>
 std::map<std::string, std::string> SOUNDPACKS; // All found soundpacks: <name, soundpack_dir>
 std::map<std::string, int> mOptionsSort;
 
+void invalidate_cached_options()
+{
+    // Never -1, which a cached_option starts out with
+    options_generation = options_generation == INT_MAX ? 0 : options_generation + 1;
+}
+
 options_manager &get_options()
 {
     static options_manager single_instance;
@@ -691,6 +701,7 @@ int options_manager::cOpt::getMaxLength() const
 //set to next item
 void options_manager::cOpt::setNext()
 {
+    invalidate_cached_options();
     if( sType == "string_select" ) {
         int iNext = getItemPos( sSet ) + 1;
         if( iNext >= static_cast<int>( vItems.size() ) ) {
@@ -734,6 +745,7 @@ void options_manager::cOpt::setNext()
 //set to previous item
 void options_manager::cOpt::setPrev()
 {
+    invalidate_cached_options();
     if( sType == "string_select" ) {
         int iPrev = static_cast<int>( getItemPos( sSet ) ) - 1;
         if( iPrev < 0 ) {
@@ -772,6 +784,7 @@ void options_manager::cOpt::setPrev()
 //set value
 void options_manager::cOpt::setValue( float fSetIn )
 {
+    invalidate_cached_options();
     if( sType != "float" ) {
         debugmsg( "tried to set a float value to a %s option", sType );
         return;
@@ -785,6 +798,7 @@ void options_manager::cOpt::setValue( float fSetIn )
 //set value
 void options_manager::cOpt::setValue( int iSetIn )
 {
+    invalidate_cached_options();
     if( sType != "int" ) {
         debugmsg( "tried to set an int value to a %s option", sType );
         return;
@@ -798,6 +812,7 @@ void options_manager::cOpt::setValue( int iSetIn )
 //set value
 void options_manager::cOpt::setValue( std::string sSetIn )
 {
+    invalidate_cached_options();
     if( sType == "string_select" ) {
         if( getItemPos( sSetIn ) != -1 ) {
             sSet = sSetIn;
@@ -1247,6 +1262,13 @@ void options_manager::add_options_general()
        );
 
     get_option( "AMBIENT_SOUND_VOLUME" ).setPrerequisite( "SOUND_ENABLED" );
+
+    add( "SOUND_EFFECT_CACHE", "general", translate_marker( "Sound effect memory" ),
+         translate_marker( "How many megabytes of decoded sound effects are kept after they were played.  Sounds the soundpack preloads don't count and are always kept." ),
+         16, 1024, 128, COPT_NO_SOUND_HIDE
+       );
+
+    get_option( "SOUND_EFFECT_CACHE" ).setPrerequisite( "SOUND_ENABLED" );
 }
 
 void options_manager::add_options_interface()
@@ -1580,7 +1602,7 @@ void options_manager::add_options_graphics()
     get_option( "ANIMATION_DELAY" ).setPrerequisite( "ANIMATIONS" );
 
     add( "FORCE_REDRAW", "graphics", translate_marker( "Force redraw" ),
-         translate_marker( "If true, forces the game to redraw at least once per turn." ),
+         translate_marker( "If true, keeps redrawing the game while the player is busy, at most once every 25 milliseconds." ),
          true
        );
 
@@ -1876,6 +1898,33 @@ void options_manager::add_options_debug()
          false
        );
 
+    add( "FOV_3D_Z_RANGE", "debug", translate_marker( "Vertical range of 3D field of vision" ),
+         translate_marker( "How many z-levels up and down 3D field of vision reaches.  Every level in range is shadowcast each time vision is updated, so a smaller range is cheaper." ),
+         0, OVERMAP_LAYERS, 4
+       );
+
+    get_option( "FOV_3D_Z_RANGE" ).setPrerequisite( "FOV_3D" );
+
+    add( "MAP_CACHE_THREADS", "debug", translate_marker( "Map cache threads" ),
+         translate_marker( "Number of threads used to build the per z-level map caches when z-levels are enabled.  1 builds them all on the main thread." ),
+         1, 16, 1
+       );
+
+    add( "MONSTER_PLAN_THREADS", "debug", translate_marker( "Monster planning threads" ),
+         translate_marker( "Number of threads used to check which monsters see you before they take their turns.  1 leaves it to each monster's own turn." ),
+         1, 16, 1
+       );
+
+    add( "SLOW_TURN_THRESHOLD", "debug", translate_marker( "Slow turn capture threshold" ),
+         translate_marker( "Turns taking longer than this many milliseconds are written to slow_turn_*.json files in the config directory, with where their time went, to attach to bug reports.  0 turns it off." ),
+         0, 10000, 0
+       );
+
+    add( "MAX_LOADED_SUBMAPS", "debug", translate_marker( "Loaded submap limit" ),
+         translate_marker( "Once more submaps than this are in memory, the ones visited longest ago are saved and unloaded.  0 keeps them all until the game is saved." ),
+         0, 1000000, 0
+       );
+
     add( "ENCODING_CONV", "debug", translate_marker( "Experimental path name encoding conversion" ),
          translate_marker( "If true, file path names are going to be transcoded from system encoding to UTF-8 when reading and will be transcoded back when writing.  Mainly for CJK Windows users." ),
          true
@@ -1899,6 +1948,16 @@ void options_manager::add_options_world_default()
     }, "keep"
        );
 
+    add( "MAP_REGION_FILES", "world_default", translate_marker( "Save map in region files" ),
+         translate_marker( "If true, the map is saved in one file per map segment instead of one file per overmap tile, which is faster on slow or networked drives.  Maps saved either way can be loaded with both settings." ),
+         false
+       );
+
+    add( "MAP_COMPACT_SUBMAPS", "world_default", translate_marker( "Save map tiles compactly" ),
+         translate_marker( "If true, the terrain, furniture and traps of the map are saved as indices into a list of ids instead of as names, which makes map files smaller and faster to read and write.  Maps saved either way can be loaded with both settings." ),
+         false
+       );
+
     mOptionsSort["world_default"]++;
 
     add( "CITY_SIZE", "world_default", translate_marker( "Size of cities" ),
@@ -2710,6 +2769,7 @@ std::string options_manager::show( bool ingame, const bool world_options_only )
                 ACTIVE_WORLD_OPTIONS = WOPTIONS_OLD;
             }
         }
+        invalidate_cached_options();
     }
 
     if( lang_changed ) {
@@ -2817,6 +2877,7 @@ bool options_manager::save()
     message_ttl = ::get_option<int>( "MESSAGE_TTL" );
     message_cooldown = ::get_option<int>( "MESSAGE_COOLDOWN" );
     fov_3d = ::get_option<bool>( "FOV_3D" );
+    fov_3d_z_range = ::get_option<int>( "FOV_3D_Z_RANGE" );
 
     update_music_volume();
 
@@ -2828,6 +2889,7 @@ bool options_manager::save()
 
 void options_manager::load()
 {
+    invalidate_cached_options();
     const auto file = FILENAMES["options"];
     if( !read_from_file_optional_json( file, [&]( JsonIn & jsin ) {
     deserialize( jsin );
@@ -2849,6 +2911,7 @@ void options_manager::load()
     message_ttl = ::get_option<int>( "MESSAGE_TTL" );
     message_cooldown = ::get_option<int>( "MESSAGE_COOLDOWN" );
     fov_3d = ::get_option<bool>( "FOV_3D" );
+    fov_3d_z_range = ::get_option<int>( "FOV_3D_Z_RANGE" );
 #if defined(SDL_SOUND)
     sounds::sound_enabled = ::get_option<bool>( "SOUND_ENABLED" );
 #endif
@@ -296,4 +296,39 @@ inline T get_option( const std::string &name )
     return get_options().get_option( name ).value_as<T>();
 }
 
+/**
+ * Changes whenever any option (including the world options of the active world) may have got
+ * a different value, see @ref invalidate_cached_options.
+ */
+extern int options_generation;
+/** Makes every @ref cached_option look its value up again on next use. */
+void invalidate_cached_options();
+
+/**
+ * An option whose value is looked up by name only once and then kept until the options change,
+ * for code that reads it so often that the lookup shows (e.g. every turn for each creature).
+ * Meant to be a const static at namespace scope of the file reading it; options read by several
+ * files are declared once below. Main thread only.
+ */
+template<typename T>
+class cached_option
+{
+    public:
+        explicit cached_option( const char *name ) : name( name ) {}
+
+        const T &get() const {
+            if( generation != options_generation ) {
+                value = ::get_option<T>( name );
+                generation = options_generation;
+            }
+            return value;
+        }
+    private:
+        const char *name;
+        mutable T value = T();
+        mutable int generation = -1;
+};
+
+extern const cached_option<bool> option_sleep_deprivation;
+
 #endif
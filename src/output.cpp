@@ -7,6 +7,7 @@
 #include <cstdarg>
 #include <cstdlib>
 #include <cstring>
+#include <locale>
 #include <map>
 #include <sstream>
 #include <stack>
@@ -15,6 +16,7 @@
 #include <vector>
 #include <array>
 #include <memory>
+#include <mutex>
 #include <type_traits>
 #include <cmath>
 
@@ -26,6 +28,7 @@
 #include "input.h"
 #include "item.h"
 #include "line.h"
+#include "lru_cache.h"
 #include "name.h"
 #include "options.h"
 #include "popup.h"
@@ -66,13 +69,10 @@ extern bool use_tiles;
 extern bool test_mode;
 
 // utf8 version
-std::vector<std::string> foldstring( const std::string &str, int width, const char split )
+static std::vector<std::string> fold_uncached( const std::string &str, const int width,
+        const char split )
 {
     std::vector<std::string> lines;
-    if( width < 1 ) {
-        lines.push_back( str );
-        return lines;
-    }
     std::stringstream sstr( str );
     std::string strline;
     std::vector<std::string> tags;
@@ -129,6 +129,33 @@ std::vector<std::string> foldstring( const std::string &str, int width, const ch
     return lines;
 }
 
+std::vector<std::string> foldstring( const std::string &str, int width, const char split )
+{
+    if( width < 1 ) {
+        return { str };
+    }
+    if( str.empty() ) {
+        return {};
+    }
+    // The same texts (item descriptions, the message log) are folded again for every redraw
+    static constexpr int cache_size = 512;
+    static lru_cache<std::string, std::vector<std::string>> cache;
+    static std::mutex cache_mutex;
+    // The width ends at the newline, split is the character after it
+    std::string key = std::to_string( width ) + '\n' + split + str;
+    {
+        std::lock_guard<std::mutex> lock( cache_mutex );
+        std::vector<std::string> lines = cache.touch( key, {} );
+        if( !lines.empty() ) {
+            return lines;
+        }
+    }
+    std::vector<std::string> lines = fold_uncached( str, width, split );
+    std::lock_guard<std::mutex> lock( cache_mutex );
+    cache.insert( cache_size, key, lines );
+    return lines;
+}
+
 std::vector<std::string> split_by_color( const std::string &s )
 {
     std::vector<std::string> ret;
@@ -1964,44 +1991,58 @@ nc_color msgtype_to_color( const game_message_type type, const bool bOldMsg )
  **/
 bool wildcard_match( const std::string &text_in, const std::string &pattern_in )
 {
-    std::string text = text_in;
+    return wildcard_pattern( pattern_in ).matches( text_in );
+}
+
+wildcard_pattern::wildcard_pattern( const std::string &pattern_in ) :
+    pieces( string_split( wildcard_trim_rule( pattern_in ), '*' ) )
+{
+}
 
+bool wildcard_pattern::matches( const std::string &text ) const
+{
     if( text.empty() ) {
         return false;
     } else if( text == "*" ) {
         return true;
     }
 
-    std::vector<std::string> pattern = string_split( wildcard_trim_rule( pattern_in ), '*' );
+    const std::locale loc;
+    const auto same = [&loc]( const char a, const char b ) {
+        return std::toupper( a, loc ) == std::toupper( b, loc );
+    };
+    // Whether the piece is at text[at]
+    const auto is_at = [&]( const std::string & piece, const size_t at ) {
+        return std::equal( piece.begin(), piece.end(), text.begin() + at, same );
+    };
 
-    if( pattern.size() == 1 ) { // no * found
-        return ( text.length() == pattern[0].length() && ci_find_substr( text, pattern[0] ) != -1 );
+    if( pieces.size() == 1 ) { // no * found
+        return text.length() == pieces[0].length() && is_at( pieces[0], 0 );
     }
 
-    for( auto it = pattern.begin(); it != pattern.end(); ++it ) {
-        if( it == pattern.begin() && !it->empty() ) {
-            if( text.length() < it->length() ||
-                ci_find_substr( text.substr( 0, it->length() ), *it ) == -1 ) {
+    // Where the rest of the text to match begins
+    size_t start = 0;
+    for( auto it = pieces.begin(); it != pieces.end(); ++it ) {
+        if( it->empty() ) {
+            continue;
+        }
+        const size_t rest = text.length() - start;
+        if( it == pieces.begin() ) {
+            if( rest < it->length() || !is_at( *it, start ) ) {
                 return false;
             }
-
-            text = text.substr( it->length(), text.length() - it->length() );
-        } else if( it == pattern.end() - 1 && !it->empty() ) {
-            if( text.length() < it->length() ||
-                ci_find_substr( text.substr( text.length() - it->length(),
-                                             it->length() ), *it ) == -1 ) {
+            start += it->length();
+        } else if( it == pieces.end() - 1 ) {
+            if( rest < it->length() || !is_at( *it, text.length() - it->length() ) ) {
                 return false;
             }
         } else {
-            if( !( *it ).empty() ) {
-                int pos = ci_find_substr( text, *it );
-                if( pos == -1 ) {
-                    return false;
-                }
-
-                text = text.substr( pos + static_cast<int>( it->length() ),
-                                    static_cast<int>( text.length() ) - pos );
+            const auto found = std::search( text.begin() + start, text.end(), it->begin(), it->end(),
+                                            same );
+            if( found == text.end() ) {
+                return false;
             }
+            start = std::min<size_t>( found - text.begin() + it->length(), text.length() );
         }
     }
 
@@ -790,6 +790,18 @@ extern scrollingcombattext SCT;
 
 std::string wildcard_trim_rule( const std::string &pattern_in );
 bool wildcard_match( const std::string &text_in, const std::string &pattern_in );
+/**
+ * A pattern for @ref wildcard_match split up once, for matching it against many texts.
+ */
+class wildcard_pattern
+{
+    public:
+        explicit wildcard_pattern( const std::string &pattern_in );
+        bool matches( const std::string &text ) const;
+    private:
+        /** The parts between the asterisks. */
+        std::vector<std::string> pieces;
+};
 std::vector<std::string> string_split( const std::string &text_in, char delim );
 int ci_find_substr( const std::string &str1, const std::string &str2,
                     const std::locale &loc = std::locale() );
@@ -10,8 +10,10 @@
 #include <queue>
 #include <vector>
 #include <exception>
+#include <iterator>
 #include <unordered_set>
 #include <set>
+#include <utility>
 
 #include "catacharset.h"
 #include "cata_utility.h"
@@ -27,6 +29,7 @@
 #include "mapbuffer.h"
 #include "mapgen.h"
 #include "mapgen_functions.h"
+#include "memory_census.h"
 #include "messages.h"
 #include "mongroup.h"
 #include "mtype.h"
@@ -1223,7 +1226,7 @@ bool overmap::mongroup_check( const mongroup &candidate ) const
 
 bool overmap::monster_check( const std::pair<tripoint, monster> &candidate ) const
 {
-    const auto matching_range = monster_map.equal_range( candidate.first );
+    const auto matching_range = monsters().equal_range( candidate.first );
     return std::find_if( matching_range.first, matching_range.second,
     [candidate]( const std::pair<tripoint, monster> &match ) {
         return candidate.second.pos() == match.second.pos() &&
@@ -1484,6 +1487,10 @@ bool overmap::generate_sub( const int z )
         oter_id( "empty_rock" ), oter_id( "forest" ), oter_id( "field" ),
         oter_id( "forest_thick" ), oter_id( "forest_water" )
     };
+    // Matched against every tile of the level, so build the strings only once.
+    static const std::string microlab_sub_connector( "microlab_sub_connector" );
+    static const std::string sub_station( "sub_station" );
+    static const std::string hidden_lab_stairs( "hidden_lab_stairs" );
 
     for( int i = 0; i < OMAPX; i++ ) {
         for( int j = 0; j < OMAPY; j++ ) {
@@ -1493,7 +1500,7 @@ bool overmap::generate_sub( const int z )
             //oter_id oter_sewer = ter(i, j, -1);
             //oter_id oter_underground = ter(i, j, -2);
 
-            if( is_ot_match( "microlab_sub_connector", ter( p ), ot_match_type::type ) ) {
+            if( is_ot_match( microlab_sub_connector, ter( p ), ot_match_type::type ) ) {
                 om_direction::type rotation = ter( p )->get_dir();
                 ter( p ) = oter_id( "subway_end_north" )->get_rotated( rotation );;
                 subway_points.emplace_back( p.xy() );
@@ -1511,10 +1518,12 @@ bool overmap::generate_sub( const int z )
                 continue;
             }
 
-            if( is_ot_match( "sub_station", oter_ground, ot_match_type::type ) && z == -1 ) {
+            const bool ground_is_sub_station = ( z == -1 || z == -2 ) &&
+                                               is_ot_match( sub_station, oter_ground, ot_match_type::type );
+            if( ground_is_sub_station && z == -1 ) {
                 ter( p ) = oter_id( "sewer_sub_station" );
                 requires_sub = true;
-            } else if( is_ot_match( "sub_station", oter_ground, ot_match_type::type ) && z == -2 ) {
+            } else if( ground_is_sub_station && z == -2 ) {
                 ter( p ) = oter_id( "subway_isolated" );
                 subway_points.emplace_back( i, j - 1 );
                 subway_points.emplace_back( i, j );
@@ -1559,7 +1568,7 @@ bool overmap::generate_sub( const int z )
                 central_lab_points.push_back( city( p.xy(), rng( std::max( 1, 7 + z ), 9 + z ) ) );
             } else if( oter_above == "central_lab_stairs" ) {
                 ter( p ) = oter_id( "central_lab" );
-            } else if( is_ot_match( "hidden_lab_stairs", oter_above, ot_match_type::contains ) ) {
+            } else if( is_ot_match( hidden_lab_stairs, oter_above, ot_match_type::contains ) ) {
                 lab_points.push_back( city( p.xy(), rng( 1, 5 + z ) ) );
             } else if( oter_above == "mine_entrance" ) {
                 shaft_points.push_back( p.xy() );
@@ -1749,11 +1758,23 @@ bool overmap::generate_sub( const int z )
 std::vector<point> overmap::find_terrain( const std::string &term, int zlevel )
 {
     std::vector<point> found;
+    // Whether each terrain type's name matches, by oter_id: 0 not checked yet, 1 no, 2 yes.
+    std::vector<char> name_matches;
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
             tripoint p( x, y, zlevel );
-            if( seen( p ) &&
-                lcmatch( ter( p )->get_name(), term ) ) {
+            if( !seen( p ) ) {
+                continue;
+            }
+            const oter_id &oter = ter( p );
+            const size_t index = oter.to_i();
+            if( index >= name_matches.size() ) {
+                name_matches.resize( index + 1, 0 );
+            }
+            if( name_matches[index] == 0 ) {
+                name_matches[index] = lcmatch( oter->get_name(), term ) ? 2 : 1;
+            }
+            if( name_matches[index] == 2 ) {
                 found.push_back( global_base_point() + p.xy() );
             }
         }
@@ -1816,6 +1837,58 @@ void overmap::clear_mon_groups()
     zg.clear();
 }
 
+void overmap::memory_usage( memory_census::census &c ) const
+{
+    using memory_census::node_overhead;
+    c.add( "overmaps", "overmap", 1, sizeof( overmap ) );
+
+    size_t notes = 0;
+    size_t note_bytes = 0;
+    for( const map_layer &l : layer ) {
+        notes += l.notes.size();
+        note_bytes += l.notes.capacity() * sizeof( om_note );
+        for( const om_note &note : l.notes ) {
+            note_bytes += note.text.capacity();
+        }
+        c.add( "overmaps", "map extra", l.extras.size(), l.extras.capacity() * sizeof( om_map_extra ) );
+    }
+    c.add( "overmaps", "note", notes, note_bytes );
+    c.add( "overmaps", "scent", scents.size(),
+           scents.size() * ( sizeof( std::pair<const tripoint, scent_trace> ) + node_overhead ) );
+    c.add( "overmaps", "special placement", overmap_special_placements.size(),
+           overmap_special_placements.size() * ( sizeof( std::pair<const tripoint, overmap_special_id> ) +
+                   node_overhead ) );
+
+    size_t group_bytes = 0;
+    for( const auto &pr : zg ) {
+        group_bytes += sizeof( pr ) + node_overhead;
+        for( const monster &critter : pr.second.monsters ) {
+            group_bytes += memory_census::monster_bytes( critter );
+        }
+    }
+    c.add( "overmaps", "monster group", zg.size(), group_bytes );
+
+    size_t monster_bytes = 0;
+    for( const auto &pr : monster_map ) {
+        monster_bytes += memory_census::monster_bytes( pr.second ) + node_overhead;
+    }
+    c.add( "overmaps", "stored monster", monster_map.size(), monster_bytes );
+    c.add( "overmaps", "unread monster save", unloaded_monster_map.empty() ? 0 : 1,
+           unloaded_monster_map.capacity() );
+
+    size_t npc_bytes = 0;
+    for( const std::shared_ptr<npc> &guy : npcs ) {
+        npc_bytes += memory_census::npc_bytes( *guy );
+    }
+    c.add( "overmaps", "npc", npcs.size(), npc_bytes );
+    c.add( "overmaps", "city", cities.size() + roads_out.size(),
+           ( cities.capacity() + roads_out.capacity() ) * sizeof( city ) );
+    c.add( "overmaps", "radio tower", radios.size(), radios.capacity() * sizeof( radio_tower ) );
+    c.add( "overmaps", "basecamp", camps.size(), camps.capacity() * sizeof( basecamp ) );
+    c.add( "overmaps", "vehicle", vehicles.size(),
+           vehicles.size() * ( sizeof( std::pair<const int, om_vehicle> ) + node_overhead ) );
+}
+
 void mongroup::wander( const overmap &om )
 {
     const city *target_city = nullptr;
@@ -1904,21 +1977,28 @@ void overmap::move_hordes()
                 mg.pos.y++;
             }
 
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.insert( std::pair<tripoint, mongroup>( mg.pos, mg ) );
+            if( mg.pos == it->first ) {
+                // Already at the target, the group stays where it is in the map.
+                ++it;
+                continue;
+            }
+            // Erase the group at it's old location, add the group with the new location.
+            // Moved rather than copied, hordes can carry a lot of monsters.
+            tmpzg.emplace( mg.pos, std::move( mg ) );
             zg.erase( it++ );
         } else {
             ++it;
         }
     }
     // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    zg.insert( std::make_move_iterator( tmpzg.begin() ), std::make_move_iterator( tmpzg.end() ) );
 
     if( get_option<bool>( "WANDER_SPAWNS" ) ) {
         static const mongroup_id GROUP_ZOMBIE( "GROUP_ZOMBIE" );
 
         // Re-absorb zombies into hordes.
         // Scan over monsters outside the player's view and place them back into hordes.
+        std::unordered_multimap<tripoint, monster> &monster_map = monsters();
         auto monster_map_it = monster_map.begin();
         while( monster_map_it != monster_map.end() ) {
             const auto &p = monster_map_it->first;
@@ -2564,24 +2644,27 @@ void overmap::place_swamps()
     // Get a layer of noise to use in conjunction with our river buffered floodplain.
     const om_noise::om_noise_layer_floodplain f( global_base_point(), g->get_seed() );
 
+    static const std::string forest( "forest" );
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
             const tripoint pos( x, y, 0 );
             // If this location isn't a forest, there's nothing to do here. We'll only grow swamps in existing
             // forest terrain.
-            if( !is_ot_match( "forest", ter( pos ), ot_match_type::contains ) ) {
+            if( !is_ot_match( forest, ter( pos ), ot_match_type::contains ) ) {
                 continue;
             }
 
+            // Both checks below use the same noise value, which is costly to evaluate.
+            const float noise = f.noise_at( pos.xy() );
+
             // If this was a part of our buffered floodplain, and the noise here meets the threshold, and the one_in rng
             // triggers, then we should flood this location and make it a swamp.
-            const bool should_flood = ( floodplain[x][y] > 0 && !one_in( floodplain[x][y] ) && f.noise_at( { x, y } )
-                                        > settings.overmap_forest.noise_threshold_swamp_adjacent_water );
+            const bool should_flood = ( floodplain[x][y] > 0 && !one_in( floodplain[x][y] ) &&
+                                        noise > settings.overmap_forest.noise_threshold_swamp_adjacent_water );
 
             // If this location meets our isolated swamp threshold, regardless of floodplain values, we'll make it
             // into a swamp.
-            const bool should_isolated_swamp = f.noise_at( pos.xy() ) >
-                                               settings.overmap_forest.noise_threshold_swamp_isolated;
+            const bool should_isolated_swamp = noise > settings.overmap_forest.noise_threshold_swamp_isolated;
             if( should_flood || should_isolated_swamp )  {
                 ter( pos ) = forest_water;
             }
@@ -3813,6 +3896,14 @@ bool overmap::can_place_special( const overmap_special &special, const tripoint
             return false;
         }
 
+        // The terrain check is cheaper than the mapbuffer lookup below, so it goes first.
+        const oter_id tid = get_ter( rp );
+        const bool terrain_ok = rp.z == 0 ? elem.can_be_placed_on( tid ) :
+                                tid == get_default_terrain( rp.z );
+        if( !terrain_ok ) {
+            return false;
+        }
+
         if( must_be_unexplored ) {
             // If this must be unexplored, check if we've already got a submap generated.
             const bool existing_submap = is_omt_generated( rp );
@@ -3824,13 +3915,7 @@ bool overmap::can_place_special( const overmap_special &special, const tripoint
             }
         }
 
-        const oter_id tid = get_ter( rp );
-
-        if( rp.z == 0 ) {
-            return elem.can_be_placed_on( tid );
-        } else {
-            return tid == get_default_terrain( rp.z );
-        }
+        return true;
     } );
 }
 
@@ -41,6 +41,10 @@ namespace pf
 {
 struct path;
 } // namespace pf
+namespace memory_census
+{
+class census;
+} // namespace memory_census
 
 struct city {
     // location of the city (in overmap terrain coordinates)
@@ -319,8 +323,17 @@ class overmap
          * map::spawn_monsters will load them and place them into the reality bubble
          * (adding it to the creature tracker and putting it onto the map).
          * This stores each submap worth of monsters in a different bucket of the multimap.
+         * They are only read from the save when first asked for, most overmaps are only
+         * loaded for their terrain.
          */
-        std::unordered_multimap<tripoint, monster> monster_map;
+        std::unordered_multimap<tripoint, monster> &monsters();
+        const std::unordered_multimap<tripoint, monster> &monsters() const;
+    private:
+        mutable std::unordered_multimap<tripoint, monster> monster_map;
+        /** The saved "monster_map" array, until @ref monsters first needs it. */
+        mutable std::string unloaded_monster_map;
+        void load_monster_map() const;
+    public:
 
         // parse data in an opened overmap file
         void unserialize( std::istream &fin );
@@ -330,6 +343,8 @@ class overmap
         void serialize( std::ostream &fout ) const;
         // Save per-player overmap view data.
         void serialize_view( std::ostream &fout ) const;
+        /** Adds what this overmap holds to the census, without reading unread monsters. */
+        void memory_usage( memory_census::census &c ) const;
     private:
         void generate( const overmap *north, const overmap *east,
                        const overmap *south, const overmap *west,
@@ -30,10 +30,21 @@ const overmap_location &string_id<overmap_location>::obj() const
 
 bool overmap_location::test( const int_id<oter_t> &oter ) const
 {
-    return std::any_of( terrains.cbegin(), terrains.cend(),
-    [ &oter ]( const oter_type_str_id & type ) {
-        return oter->type_is( type );
-    } );
+    // Special placement asks this for many tiles of every candidate spot, and
+    // the answer for a given terrain never changes once the data is loaded.
+    const size_t index = oter.to_i();
+    if( index >= test_cache.size() ) {
+        test_cache.resize( index + 1, 0 );
+    }
+    char &cached = test_cache[index];
+    if( cached == 0 ) {
+        const bool matches = std::any_of( terrains.cbegin(), terrains.cend(),
+        [ &oter ]( const oter_type_str_id & type ) {
+            return oter->type_is( type );
+        } );
+        cached = matches ? 2 : 1;
+    }
+    return cached == 2;
 }
 
 oter_type_id overmap_location::get_random_terrain() const
@@ -32,6 +32,9 @@ struct overmap_location {
 
     private:
         std::vector<oter_type_str_id> terrains;
+        // Memoized test() results indexed by oter_id::to_i():
+        // 0 = not computed yet, 1 = doesn't match, 2 = matches.
+        mutable std::vector<char> test_cache;
 };
 
 namespace overmap_locations
@@ -10,6 +10,7 @@
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <set>
@@ -535,8 +536,8 @@ void draw( const catacurses::window &w, const catacurses::window &wbar, const tr
         nc_color color;
         size_t count;
     };
-    std::vector<tripoint> path_route;
-    std::vector<tripoint> player_path_route;
+    std::unordered_set<tripoint> path_route;
+    std::unordered_set<tripoint> player_path_route;
     std::unordered_map<tripoint, npc_coloring> npc_color;
     if( blink ) {
         const auto &npcs = overmap_buffer.get_npcs_near_player( sight_points );
@@ -580,7 +581,7 @@ void draw( const catacurses::window &w, const catacurses::window &wbar, const tr
         }
         for( auto &elem : g->u.omt_path ) {
             tripoint tri_to_add = tripoint( elem.xy(), g->u.posz() );
-            player_path_route.push_back( tri_to_add );
+            player_path_route.insert( tri_to_add );
         }
         for( const auto &np : followers ) {
             if( np->posz() != center.z ) {
@@ -589,7 +590,7 @@ void draw( const catacurses::window &w, const catacurses::window &wbar, const tr
             if( !np->omt_path.empty() ) {
                 for( auto &elem : np->omt_path ) {
                     tripoint tri_to_add = tripoint( elem.xy(), np->posz() );
-                    path_route.push_back( tri_to_add );
+                    path_route.insert( tri_to_add );
                 }
             }
             const tripoint pos = np->global_omt_location();
@@ -621,16 +622,14 @@ void draw( const catacurses::window &w, const catacurses::window &wbar, const tr
                 cur_ter = overmap_buffer.ter( omp );
             }
 
-            // Check if location is within player line-of-sight
-            const bool los = see && g->u.overmap_los( omp, sight_points );
-            const bool los_sky = g->u.overmap_los( omp, sight_points * 2 );
-            int mycount = std::count( path_route.begin(), path_route.end(), omp );
-            bool player_path_count = false;
-            std::vector<tripoint>::iterator it;
-            it = std::find( player_path_route.begin(), player_path_route.end(), omp );
-            if( it != player_path_route.end() ) {
-                player_path_count = true;
-            }
+            // Check if location is within player line-of-sight. Tracing the line is
+            // costly, so only do it for the tiles where the result is used.
+            const bool los = see && blink && ( showhordes || data.debug_mongroup ) &&
+                             g->u.overmap_los( omp, sight_points );
+            const bool los_sky = viewing_weather && !data.debug_weather &&
+                                 g->u.overmap_los( omp, sight_points * 2 );
+            const bool on_path = path_route.count( omp ) != 0;
+            const bool on_player_path = player_path_route.count( omp ) != 0;
             if( blink && omp == orig ) {
                 // Display player pos, should always be visible
                 ter_color = g->u.symbol_color();
@@ -662,10 +661,10 @@ void draw( const catacurses::window &w, const catacurses::window &wbar, const tr
                 // Visible NPCs are cached already
                 ter_color = npc_color[ omp ].color;
                 ter_sym   = "@";
-            } else if( blink && mycount != 0 && g->debug_pathfinding ) {
+            } else if( blink && on_path && g->debug_pathfinding ) {
                 ter_color = c_red;
                 ter_sym   = "!";
-            } else if( blink && player_path_count ) {
+            } else if( blink && on_player_path ) {
                 ter_color = c_blue;
                 ter_sym = "!";
             } else if( blink && showhordes && los &&
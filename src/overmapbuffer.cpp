@@ -210,6 +210,13 @@ void overmapbuffer::clear()
     last_requested_overmap = nullptr;
 }
 
+void overmapbuffer::memory_usage( memory_census::census &c ) const
+{
+    for( const auto &pr : overmaps ) {
+        pr.second->memory_usage( c );
+    }
+}
+
 const regional_settings &overmapbuffer::get_settings( const tripoint &p )
 {
     overmap *om = get_om_global( p ).om;
@@ -510,11 +517,11 @@ std::vector<mongroup *> overmapbuffer::groups_at( const tripoint &p )
     std::vector<mongroup *> result;
     point sm_within_om( p.xy() );
     const point omp = sm_to_om_remain( sm_within_om );
-    if( !has( omp ) ) {
+    overmap *om = get_existing( omp );
+    if( om == nullptr ) {
         return result;
     }
-    overmap &om = get( omp );
-    auto groups_range = om.zg.equal_range( tripoint( sm_within_om, p.z ) );
+    auto groups_range = om->zg.equal_range( tripoint( sm_within_om, p.z ) );
     for( auto it = groups_range.first; it != groups_range.second; ++it ) {
         mongroup &mg = it->second;
         if( mg.empty() ) {
@@ -691,23 +698,36 @@ std::vector<tripoint> overmapbuffer::get_npc_path( const tripoint &src, const tr
         return ter( base + p );
     };
 
+    // Resolve the terrain types once, so the search compares pointers instead of names.
+    const auto find_type = []( const char *id ) -> const oter_type_t * {
+        const string_id<oter_type_t> type_id( id );
+        return type_id.is_valid() ? &type_id.obj() : nullptr;
+    };
+    const oter_type_t *const road = find_type( "road" );
+    const oter_type_t *const bridge = find_type( "bridge" );
+    const oter_type_t *const empty_rock = find_type( "empty_rock" );
+    const oter_type_t *const open_air = find_type( "open_air" );
+    const oter_type_t *const forest = find_type( "forest" );
+    const oter_type_t *const forest_water = find_type( "forest_water" );
+    const auto is_type = []( const oter_id & oter, const oter_type_t *type ) {
+        return type != nullptr && oter->type_is( *type );
+    };
+
     const auto estimate = [&]( const pf::node & cur, const pf::node * ) {
         int res = 0;
         const oter_id oter = get_ter_at( cur.pos );
         int travel_cost = static_cast<int>( oter->get_travel_cost() );
-        if( road_only && ( !is_ot_match( "road", oter, ot_match_type::type ) &&
-                           !is_ot_match( "bridge", oter, ot_match_type::type ) ) ) {
+        const bool is_road = is_type( oter, road ) || is_type( oter, bridge );
+        if( road_only && !is_road ) {
             return pf::rejected;
         }
-        if( is_ot_match( "empty_rock", oter, ot_match_type::type ) ||
-            is_ot_match( "open_air", oter, ot_match_type::type ) || oter->is_lake() ) {
+        if( is_type( oter, empty_rock ) || is_type( oter, open_air ) || oter->is_lake() ) {
             return pf::rejected;
-        } else if( is_ot_match( "forest", oter, ot_match_type::type ) ) {
+        } else if( is_type( oter, forest ) ) {
             travel_cost = 10;
-        } else if( is_ot_match( "forest_water", oter, ot_match_type::type ) ) {
+        } else if( is_type( oter, forest_water ) ) {
             travel_cost = 15;
-        } else if( is_ot_match( "road", oter, ot_match_type::type ) ||
-                   is_ot_match( "bridge", oter, ot_match_type::type ) ) {
+        } else if( is_road ) {
             travel_cost = 1;
         } else if( is_river( oter ) ) {
             travel_cost = 20;
@@ -834,21 +854,57 @@ static omt_find_params assign_params(
     return params;
 }
 
-bool overmapbuffer::is_findable_location( const tripoint &location, const omt_find_params &params )
-{
-    bool type_matches = false;
-    if( params.existing_only ) {
-        type_matches = check_ot_existing( params.type, params.match_type, location );
-    } else {
-        type_matches = check_ot( params.type, params.match_type, location );
+struct omt_find_cache {
+    // By oter_id, whether it matches the search, or unknown yet.
+    enum class match : char { unknown, no, yes };
+    std::vector<match> type_matches;
+    // By overmap position and z-level, whether the layer has any matching terrain.
+    std::unordered_map<tripoint, bool> layer_matches;
+
+    bool matches( const oter_id &oter, const omt_find_params &params ) {
+        const size_t index = oter.to_i();
+        if( index >= type_matches.size() ) {
+            type_matches.resize( index + 1, match::unknown );
+        }
+        if( type_matches[index] == match::unknown ) {
+            type_matches[index] = is_ot_match( params.type, oter, params.match_type ) ? match::yes :
+                                  match::no;
+        }
+        return type_matches[index] == match::yes;
     }
-    if( !type_matches ) {
-        return false;
+
+    bool layer_has_match( const overmap &om, int z, const omt_find_params &params ) {
+        const auto found = layer_matches.find( tripoint( om.pos(), z ) );
+        if( found != layer_matches.end() ) {
+            return found->second;
+        }
+        bool any = false;
+        for( int i = 0; i < OMAPX && !any; i++ ) {
+            for( int j = 0; j < OMAPY && !any; j++ ) {
+                any = matches( om.get_ter( tripoint( i, j, z ) ), params );
+            }
+        }
+        layer_matches.emplace( tripoint( om.pos(), z ), any );
+        return any;
     }
+};
 
+bool overmapbuffer::is_findable_location( const tripoint &location, const omt_find_params &params,
+        omt_find_cache &cache )
+{
+    // Checked first because it never needs to generate an overmap: tiles on overmaps
+    // that don't exist yet can't have been seen.
     if( params.must_see && !seen( location ) ) {
         return false;
     }
+
+    const overmap_with_local_coords om_loc = params.existing_only ?
+            get_existing_om_global( location ) : get_om_global( location );
+    if( !om_loc || !cache.layer_has_match( *om_loc.om, location.z, params ) ||
+        !cache.matches( om_loc.om->get_ter( om_loc.local ), params ) ) {
+        return false;
+    }
+
     if( params.cant_see && seen( location ) ) {
         return false;
     }
@@ -881,7 +937,8 @@ tripoint overmapbuffer::find_closest( const tripoint &origin, const std::string
 tripoint overmapbuffer::find_closest( const tripoint &origin, const omt_find_params &params )
 {
     // Check the origin before searching adjacent tiles!
-    if( params.min_distance == 0 &&  is_findable_location( origin, params ) ) {
+    omt_find_cache cache;
+    if( params.min_distance == 0 && is_findable_location( origin, params, cache ) ) {
         return origin;
     }
 
@@ -910,25 +967,25 @@ tripoint overmapbuffer::find_closest( const tripoint &origin, const omt_find_par
             for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
                 //start at northwest, scan north edge
                 const tripoint n_loc( origin.x - dist + i, origin.y - dist, z );
-                if( is_findable_location( n_loc, params ) ) {
+                if( is_findable_location( n_loc, params, cache ) ) {
                     return n_loc;
                 }
 
                 //start at southeast, scan south
                 const tripoint s_loc( origin.x + dist - i, origin.y + dist, z );
-                if( is_findable_location( s_loc, params ) ) {
+                if( is_findable_location( s_loc, params, cache ) ) {
                     return s_loc;
                 }
 
                 //start at southwest, scan west
                 const tripoint w_loc( origin.x - dist, origin.y + dist - i, z );
-                if( is_findable_location( w_loc, params ) ) {
+                if( is_findable_location( w_loc, params, cache ) ) {
                     return w_loc;
                 }
 
                 //start at northeast, scan east
                 const tripoint e_loc( origin.x + dist, origin.y - dist + i, z );
-                if( is_findable_location( e_loc, params ) ) {
+                if( is_findable_location( e_loc, params, cache ) ) {
                     return e_loc;
                 }
             }
@@ -944,13 +1001,14 @@ std::vector<tripoint> overmapbuffer::find_all( const tripoint &origin,
     // dist == 0 means search a whole overmap diameter.
     const int dist = params.search_range ? params.search_range : OMAPX;
     const int min_distance = std::max( 0, params.min_distance );
+    omt_find_cache cache;
     for( int x = -dist; x <= dist; x++ ) {
         for( int y = -dist; y <= dist; y++ ) {
             if( abs( x ) < min_distance && abs( y ) < min_distance ) {
                 continue;
             }
             const tripoint search_loc( origin + point( x, y ) );
-            if( is_findable_location( search_loc, params ) ) {
+            if( is_findable_location( search_loc, params, cache ) ) {
                 result.push_back( search_loc );
             }
         }
@@ -1305,7 +1363,7 @@ void overmapbuffer::spawn_monster( const tripoint &p )
     const point omp = sm_to_om_remain( sm );
     overmap &om = get( omp );
     const tripoint current_submap_loc( tripoint( sm, p.z ) );
-    auto monster_bucket = om.monster_map.equal_range( current_submap_loc );
+    auto monster_bucket = om.monsters().equal_range( current_submap_loc );
     std::for_each( monster_bucket.first, monster_bucket.second,
     [&]( std::pair<const tripoint, monster> &monster_entry ) {
         monster &this_monster = monster_entry.second;
@@ -1324,7 +1382,7 @@ void overmapbuffer::spawn_monster( const tripoint &p )
         this_monster.spawn( local );
         g->add_zombie( this_monster );
     } );
-    om.monster_map.erase( current_submap_loc );
+    om.monsters().erase( current_submap_loc );
 }
 
 void overmapbuffer::despawn_monster( const monster &critter )
@@ -1335,7 +1393,7 @@ void overmapbuffer::despawn_monster( const monster &critter )
     const point omp = sm_to_om_remain( sm.x, sm.y );
     overmap &om = get( omp );
     // Store the monster using coordinates local to the overmap.
-    om.monster_map.insert( std::make_pair( sm, critter ) );
+    om.monsters().insert( std::make_pair( sm, critter ) );
 }
 
 overmapbuffer::t_notes_vector overmapbuffer::get_notes( int z, const std::string *pattern )
@@ -32,6 +32,11 @@ class vehicle;
 class basecamp;
 class map_extra;
 
+namespace memory_census
+{
+class census;
+} // namespace memory_census
+
 struct radio_tower_reference {
     /** The radio tower itself, points into @ref overmap::radios */
     radio_tower *tower;
@@ -114,6 +119,8 @@ struct omt_find_params {
     cata::optional<overmap_special_id> om_special = cata::nullopt;
 };
 
+struct omt_find_cache;
+
 class overmapbuffer
 {
     public:
@@ -129,6 +136,8 @@ class overmapbuffer
         overmap &get( const point & );
         void save();
         void clear();
+        /** Adds all loaded overmaps to the census. */
+        void memory_usage( memory_census::census &c ) const;
         void create_custom_overmap( const point &, overmap_special_batch &specials );
 
         /**
@@ -461,8 +470,11 @@ class overmapbuffer
          * findable based on the specified criteria.
          * @param location Location of search
          * see omt_find_params for definitions of the terms
+         * @param cache What earlier calls of the same search found out, so terrain types are
+         * only matched once and layers without any matching terrain are skipped.
          */
-        bool is_findable_location( const tripoint &location, const omt_find_params &params );
+        bool is_findable_location( const tripoint &location, const omt_find_params &params,
+                                   omt_find_cache &cache );
 
         std::unordered_map< point, std::unique_ptr< overmap > > overmaps;
         /**
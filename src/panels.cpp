@@ -1771,15 +1771,28 @@ static void draw_veh_padding( const avatar &u, const catacurses::window &w )
     wrefresh( w );
 }
 
+// The needs only change as turns pass, but the sidebar is drawn far more often than that
+// and the predicates search the inventory.
+static time_point ai_goal_turn = calendar::before_time_starts;
+static std::string ai_goal_need;
+
+void reset_panel_caches()
+{
+    ai_goal_turn = calendar::before_time_starts;
+}
+
 static void draw_ai_goal( const avatar &u, const catacurses::window &w )
 {
     werase( w );
-    behavior::tree needs;
-    needs.add( &string_id<behavior::node_t>( "npc_needs" ).obj() );
-    behavior::character_oracle_t player_oracle( &u );
-    std::string current_need = needs.tick( &player_oracle );
+    if( ai_goal_turn != calendar::turn ) {
+        behavior::tree needs;
+        needs.add( &string_id<behavior::node_t>( "npc_needs" ).obj() );
+        behavior::character_oracle_t player_oracle( &u );
+        ai_goal_need = needs.tick( &player_oracle );
+        ai_goal_turn = calendar::turn;
+    }
     // NOLINTNEXTLINE(cata-use-named-point-constants)
-    mvwprintz( w, point( 1, 0 ), c_light_gray, _( "Goal: %s" ), current_need );
+    mvwprintz( w, point( 1, 0 ), c_light_gray, _( "Goal: %s" ), ai_goal_need );
     wrefresh( w );
 }
 
@@ -34,6 +34,11 @@ void draw_overmap_chunk( const catacurses::window &w_minimap, const avatar &you,
 } // namespace overmap_ui
 
 bool default_render();
+/**
+ * Forgets what the panels worked out for the character shown so far, for when another one
+ * (or an earlier save of the same one) is loaded at a turn the panels have already seen.
+ */
+void reset_panel_caches();
 
 class window_panel
 {
@@ -107,6 +107,7 @@ void PATH_INFO::update_config_dir()
     update_pathname( "panel_options", FILENAMES["config_dir"] + "panel_options.json" );
     update_pathname( "keymap", FILENAMES["config_dir"] + "keymap.txt" );
     update_pathname( "debug", FILENAMES["config_dir"] + "debug.log" );
+    update_pathname( "checked_data", FILENAMES["config_dir"] + "checked_data.txt" );
     update_pathname( "crash", FILENAMES["config_dir"] + "crash.log" );
     update_pathname( "fontlist", FILENAMES["config_dir"] + "fontlist.txt" );
     update_pathname( "fontdata", FILENAMES["config_dir"] + "fonts.json" );
@@ -1,10 +1,11 @@
 #include "pathfinding.h"
 
+#include <climits>
 #include <cstdlib>
 #include <algorithm>
-#include <queue>
 #include <set>
 #include <array>
+#include <iterator>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -13,6 +14,7 @@
 #include "coordinates.h"
 #include "debug.h"
 #include "map.h"
+#include "map_iterator.h"
 #include "mapdata.h"
 #include "optional.h"
 #include "submap.h"
@@ -36,43 +38,129 @@ constexpr int flat_index( const int x, const int y )
     return ( x * MAPSIZE_Y ) + y;
 }
 
+// Min-heap of ( score, point ) pairs with four children per node, which makes it
+// shallower than a binary heap. Its storage is kept when cleared.
+class open_list
+{
+    public:
+        using value_type = std::pair<int, tripoint>;
+
+        bool empty() const {
+            return heap.empty();
+        }
+
+        void clear() {
+            heap.clear();
+        }
+
+        const value_type &top() const {
+            return heap.front();
+        }
+
+        void push( const value_type &value ) {
+            size_t i = heap.size();
+            heap.push_back( value );
+            while( i > 0 ) {
+                const size_t parent = ( i - 1 ) / 4;
+                if( heap[parent].first <= value.first ) {
+                    break;
+                }
+                heap[i] = heap[parent];
+                i = parent;
+            }
+            heap[i] = value;
+        }
+
+        void pop() {
+            const value_type last = heap.back();
+            heap.pop_back();
+            if( heap.empty() ) {
+                return;
+            }
+            const size_t size = heap.size();
+            size_t i = 0;
+            while( true ) {
+                const size_t first_child = i * 4 + 1;
+                if( first_child >= size ) {
+                    break;
+                }
+                size_t best = first_child;
+                const size_t last_child = std::min( first_child + 4, size );
+                for( size_t child = first_child + 1; child < last_child; child++ ) {
+                    if( heap[child].first < heap[best].first ) {
+                        best = child;
+                    }
+                }
+                if( last.first <= heap[best].first ) {
+                    break;
+                }
+                heap[i] = heap[best];
+                i = best;
+            }
+            heap[i] = last;
+        }
+
+    private:
+        std::vector<value_type> heap;
+};
+
+struct path_data_cell {
+    astar_state state = ASL_NONE;
+    int score = 0;
+    int gscore = 0;
+    tripoint parent;
+    // Search this cell was last used by, the rest is stale unless it matches
+    unsigned int generation = 0;
+};
+
 // Flattened 2D array representing a single z-level worth of pathfinding data
 struct path_data_layer {
-    // State is accessed way more often than all other values here
-    std::array< astar_state, MAPSIZE_X *MAPSIZE_Y > state;
-    std::array< int, MAPSIZE_X *MAPSIZE_Y > score;
-    std::array< int, MAPSIZE_X *MAPSIZE_Y > gscore;
-    std::array< tripoint, MAPSIZE_X *MAPSIZE_Y > parent;
-
-    void init( const point &min, const point &max ) {
-        for( int x = min.x; x <= max.x; x++ ) {
-            for( int y = min.y; y <= max.y; y++ ) {
-                const int ind = flat_index( x, y );
-                state[ind] = ASL_NONE; // Mark as unvisited
-            }
+    std::array< path_data_cell, MAPSIZE_X *MAPSIZE_Y > cells;
+    // Current search, cells from earlier ones read as unvisited
+    unsigned int generation = 0;
+
+    path_data_cell &at( const int index ) {
+        path_data_cell &cell = cells[index];
+        if( cell.generation != generation ) {
+            cell = path_data_cell();
+            cell.generation = generation;
         }
+        return cell;
     }
 };
 
+// Kept between searches, so starting one doesn't allocate or clear whole layers
 struct pathfinder {
-    point min;
-    point max;
-    pathfinder( int _minx, int _miny, int _maxx, int _maxy ) :
-        min( _minx, _miny ), max( _maxx, _maxy ) {
+    open_list open;
+    std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > path_data;
+    unsigned int generation = 0;
+
+    static pathfinder &get() {
+        static pathfinder instance;
+        return instance;
     }
 
-    std::priority_queue< std::pair<int, tripoint>, std::vector< std::pair<int, tripoint> >, pair_greater_cmp_first >
-    open;
-    std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > path_data;
+    void start() {
+        open.clear();
+        generation++;
+        if( generation == 0 ) {
+            // Wrapped around, so old stamps could look current
+            for( auto &ptr : path_data ) {
+                if( ptr != nullptr ) {
+                    ptr->cells.fill( path_data_cell() );
+                    ptr->generation = 0;
+                }
+            }
+            generation = 1;
+        }
+    }
 
     path_data_layer &get_layer( const int z ) {
         std::unique_ptr< path_data_layer > &ptr = path_data[z + OVERMAP_DEPTH];
-        if( ptr != nullptr ) {
-            return *ptr;
+        if( ptr == nullptr ) {
+            ptr = std::make_unique<path_data_layer>();
         }
-
-        ptr = std::make_unique<path_data_layer>();
-        ptr->init( min, max );
+        ptr->generation = generation;
         return *ptr;
     }
 
@@ -87,30 +175,25 @@ struct pathfinder {
     }
 
     void add_point( const int gscore, const int score, const tripoint &from, const tripoint &to ) {
-        auto &layer = get_layer( to.z );
-        const int index = flat_index( to.x, to.y );
-        if( ( layer.state[index] == ASL_OPEN && gscore >= layer.gscore[index] ) ||
-            layer.state[index] == ASL_CLOSED ) {
+        path_data_cell &cell = get_layer( to.z ).at( flat_index( to.x, to.y ) );
+        if( ( cell.state == ASL_OPEN && gscore >= cell.gscore ) ||
+            cell.state == ASL_CLOSED ) {
             return;
         }
 
-        layer.state [index] = ASL_OPEN;
-        layer.gscore[index] = gscore;
-        layer.parent[index] = from;
-        layer.score [index] = score;
+        cell.state  = ASL_OPEN;
+        cell.gscore = gscore;
+        cell.parent = from;
+        cell.score  = score;
         open.push( std::make_pair( score, to ) );
     }
 
     void close_point( const tripoint &p ) {
-        auto &layer = get_layer( p.z );
-        const int index = flat_index( p.x, p.y );
-        layer.state[index] = ASL_CLOSED;
+        get_layer( p.z ).at( flat_index( p.x, p.y ) ).state = ASL_CLOSED;
     }
 
     void unclose_point( const tripoint &p ) {
-        auto &layer = get_layer( p.z );
-        const int index = flat_index( p.x, p.y );
-        layer.state[index] = ASL_NONE;
+        get_layer( p.z ).at( flat_index( p.x, p.y ) ).state = ASL_NONE;
     }
 };
 
@@ -177,6 +260,258 @@ bool is_disjoint( const Set1 &set1, const Set2 &set2 )
     return true;
 }
 
+// Any of these means a tile is not plain flat ground, and needs closer checks to path over
+static constexpr pf_special non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP;
+
+// Check all points for any special case (including just hard terrain)
+static bool is_plain_line( const pathfinding_cache &pf_cache, const std::vector<tripoint> &line_path )
+{
+    return std::all_of( line_path.begin(), line_path.end(), [&pf_cache]( const tripoint & p ) {
+        return !( pf_cache.special[p.x][p.y] & non_normal );
+    } );
+}
+
+int map::path_step_cost( const tripoint &cur, const tripoint &p,
+                         const pathfinding_settings &settings, bool &closed, bool &ledge ) const
+{
+    closed = false;
+    ledge = false;
+    const int bash = settings.bash_strength;
+    const int climb_cost = settings.climb_cost;
+    const bool doors = settings.allow_open_doors;
+    const bool trapavoid = settings.avoid_traps;
+
+    const auto p_special = get_pathfinding_cache_ref( p.z ).special[p.x][p.y];
+    // TODO: De-uglify, de-huge-n
+    if( !( p_special & non_normal ) ) {
+        // Boring flat dirt - the most common case above the ground
+        return 2;
+    }
+    if( settings.avoid_rough_terrain ) {
+        closed = true; // Close all rough terrain tiles
+        return -1;
+    }
+
+    int part = -1;
+    const maptile &tile = maptile_at_internal( p );
+    const auto &terrain = tile.get_ter_t();
+    const auto &furniture = tile.get_furn_t();
+    const vehicle *veh = veh_at_internal( p, part );
+
+    const int cost = move_cost_internal( furniture, terrain, veh, part );
+    // Don't calculate bash rating unless we intend to actually use it
+    const int rating = ( bash == 0 || cost != 0 ) ? -1 :
+                       bash_rating_internal( bash, furniture, terrain, false, veh, part );
+
+    if( cost == 0 && rating <= 0 && ( !doors || !terrain.open ) && veh == nullptr && climb_cost <= 0 ) {
+        closed = true;
+        return -1;
+    }
+
+    int newg = cost;
+    if( cost == 0 ) {
+        if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
+            // Climbing fences
+            newg += climb_cost;
+        } else if( doors && terrain.open &&
+                   ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !is_outside( cur ) ) ) {
+            // Only try to open INSIDE doors from the inside
+            // To open and then move onto the tile
+            newg += 4;
+        } else if( veh != nullptr ) {
+            const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
+            part = vpobst ? vpobst->part_index() : -1;
+            int dummy = -1;
+            if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
+                ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ||
+                  veh_at_internal( cur, dummy ) == veh ) ) {
+                // Handle car doors, but don't try to path through curtains
+                newg += 10; // One turn to open, 4 to move there
+            } else if( part >= 0 && bash > 0 ) {
+                // Car obstacle that isn't a door
+                // TODO: Account for armor
+                int hp = veh->parts[part].hp();
+                if( hp / 20 > bash ) {
+                    // Threshold damage thing means we just can't bash this down
+                    closed = true;
+                    return -1;
+                } else if( hp / 10 > bash ) {
+                    // Threshold damage thing means we will fail to deal damage pretty often
+                    hp *= 2;
+                }
+
+                newg += 2 * hp / bash + 8 + 4;
+            } else if( part >= 0 ) {
+                // Won't be openable, don't try from other sides
+                closed = !doors || !veh->part_flag( part, VPFLAG_OPENABLE );
+                return -1;
+            }
+        } else if( rating > 1 ) {
+            // Expected number of turns to bash it down, 1 turn to move there
+            // and 5 turns of penalty not to trash everything just because we can
+            newg += ( 20 / rating ) + 2 + 10;
+        } else if( rating == 1 ) {
+            // Desperate measures, avoid whenever possible
+            newg += 500;
+        } else {
+            // Unbashable and unopenable from here, or anywhere else for that matter
+            closed = !doors || !terrain.open;
+            return -1;
+        }
+    }
+
+    if( trapavoid && p_special & PF_TRAP ) {
+        const auto &ter_trp = terrain.trap.obj();
+        const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
+        if( !trp.is_benign() ) {
+            // For now make them detect all traps
+            if( has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR ) ) {
+                // Special case - ledge in z-levels
+                // Warning: really expensive, needs a cache
+                if( valid_move( p, tripoint( p.xy(), p.z - 1 ), false, true ) ) {
+                    ledge = true;
+                    return -1;
+                }
+            } else if( trapavoid ) {
+                // Otherwise it's walkable
+                newg += 500;
+            }
+        }
+    }
+
+    return newg;
+}
+
+// Coarse walkability for path_submap_graph: impassable only if nothing could ever walk
+// through, bashing aside. Overestimating only makes route search a larger area.
+static bool coarse_walkable( const map &m, const pathfinding_cache &pf_cache, const tripoint &p )
+{
+    const pf_special special = pf_cache.special[p.x][p.y];
+    if( !( special & PF_WALL ) || ( special & PF_CLIMBABLE ) ) {
+        return true;
+    }
+    // Doors
+    return !m.ter( p ).obj().open.is_null();
+}
+
+static void build_submap_graph( const map &m, const pathfinding_cache &pf_cache, const int z,
+                                path_submap_graph &graph )
+{
+    graph.tile_area.assign( MAPSIZE_X * MAPSIZE_Y, -1 );
+    graph.area_submap.clear();
+    graph.area_links.clear();
+    const int mapsize = m.getmapsize();
+
+    // Flood fill the areas of every submap
+    std::vector<tripoint> stack;
+    for( int smx = 0; smx < mapsize; smx++ ) {
+        for( int smy = 0; smy < mapsize; smy++ ) {
+            for( int x = smx * SEEX; x < ( smx + 1 ) * SEEX; x++ ) {
+                for( int y = smy * SEEY; y < ( smy + 1 ) * SEEY; y++ ) {
+                    const tripoint start( x, y, z );
+                    if( graph.tile_area[flat_index( x, y )] >= 0 ||
+                        !coarse_walkable( m, pf_cache, start ) ) {
+                        continue;
+                    }
+                    const int area = graph.area_submap.size();
+                    graph.area_submap.emplace_back( smx, smy );
+                    graph.tile_area[flat_index( x, y )] = area;
+                    stack.push_back( start );
+                    while( !stack.empty() ) {
+                        const tripoint cur = stack.back();
+                        stack.pop_back();
+                        for( const tripoint &p : m.points_in_radius( cur, 1 ) ) {
+                            if( p.x / SEEX != smx || p.y / SEEY != smy ||
+                                graph.tile_area[flat_index( p.x, p.y )] >= 0 ||
+                                !coarse_walkable( m, pf_cache, p ) ) {
+                                continue;
+                            }
+                            graph.tile_area[flat_index( p.x, p.y )] = area;
+                            stack.push_back( p );
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Link areas that touch across submap edges
+    graph.area_links.resize( graph.area_submap.size() );
+    for( int x = 0; x < mapsize * SEEX; x++ ) {
+        for( int y = 0; y < mapsize * SEEY; y++ ) {
+            const int area = graph.tile_area[flat_index( x, y )];
+            const bool on_edge = x % SEEX == 0 || x % SEEX == SEEX - 1 ||
+                                 y % SEEY == 0 || y % SEEY == SEEY - 1;
+            if( area < 0 || !on_edge ) {
+                continue;
+            }
+            for( const tripoint &p : m.points_in_radius( tripoint( x, y, z ), 1 ) ) {
+                const int other = graph.tile_area[flat_index( p.x, p.y )];
+                if( other >= 0 && graph.area_submap[other] != graph.area_submap[area] ) {
+                    graph.area_links[area].push_back( other );
+                }
+            }
+        }
+    }
+    for( std::vector<int> &links : graph.area_links ) {
+        std::sort( links.begin(), links.end() );
+        links.erase( std::unique( links.begin(), links.end() ), links.end() );
+    }
+    graph.built = true;
+}
+
+// Finds the tile bounding box of the submaps crossed by the fewest area to area steps
+// from `f` to `t`, returns false if the graph has no such chain.
+static bool find_submap_corridor( const map &m, const path_submap_graph &graph,
+                                  const tripoint &f, const tripoint &t, point &min, point &max )
+{
+    const int start = graph.tile_area[flat_index( f.x, f.y )];
+    if( start < 0 ) {
+        return false;
+    }
+    // The target itself may be a wall or door to get through
+    std::vector<bool> is_goal( graph.area_submap.size(), false );
+    for( const tripoint &p : m.points_in_radius( t, 1 ) ) {
+        const int area = graph.tile_area[flat_index( p.x, p.y )];
+        if( area >= 0 ) {
+            is_goal[area] = true;
+        }
+    }
+
+    std::vector<int> parent( graph.area_submap.size(), -1 );
+    std::vector<int> queue{ start };
+    parent[start] = start;
+    int goal = -1;
+    for( size_t i = 0; i < queue.size() && goal < 0; i++ ) {
+        const int cur = queue[i];
+        if( is_goal[cur] ) {
+            goal = cur;
+            break;
+        }
+        for( const int next : graph.area_links[cur] ) {
+            if( parent[next] < 0 ) {
+                parent[next] = cur;
+                queue.push_back( next );
+            }
+        }
+    }
+    if( goal < 0 ) {
+        return false;
+    }
+
+    point sm_min = graph.area_submap[goal];
+    point sm_max = sm_min;
+    for( int area = goal; area != start; ) {
+        area = parent[area];
+        const point &sm = graph.area_submap[area];
+        sm_min = point( std::min( sm_min.x, sm.x ), std::min( sm_min.y, sm.y ) );
+        sm_max = point( std::max( sm_max.x, sm.x ), std::max( sm_max.y, sm.y ) );
+    }
+    min = point( sm_min.x * SEEX, sm_min.y * SEEY );
+    max = point( ( sm_max.x + 1 ) * SEEX - 1, ( sm_max.y + 1 ) * SEEY - 1 );
+    return true;
+}
+
 std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                                   const pathfinding_settings &settings,
                                   const std::set<tripoint> &pre_closed ) const
@@ -197,14 +532,9 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     }
     // First, check for a simple straight line on flat ground
     // Except when the line contains a pre-closed tile - we need to do regular pathing then
-    static const auto non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP;
     if( f.z == t.z ) {
         const auto line_path = line_to( f, t );
-        const auto &pf_cache = get_pathfinding_cache_ref( f.z );
-        // Check all points for any special case (including just hard terrain)
-        if( std::all_of( line_path.begin(), line_path.end(), [&pf_cache]( const tripoint & p ) {
-        return !( pf_cache.special[p.x][p.y] & non_normal );
-        } ) ) {
+        if( is_plain_line( get_pathfinding_cache_ref( f.z ), line_path ) ) {
             const std::set<tripoint> sorted_line( line_path.begin(), line_path.end() );
 
             if( is_disjoint( sorted_line, pre_closed ) ) {
@@ -219,23 +549,35 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     }
 
     int max_length = settings.max_length;
-    int bash = settings.bash_strength;
-    int climb_cost = settings.climb_cost;
-    bool doors = settings.allow_open_doors;
-    bool trapavoid = settings.avoid_traps;
-    bool roughavoid = settings.avoid_rough_terrain;
 
-    const int pad = 16;  // Should be much bigger - low value makes pathfinders dumb!
+    const int pad = 16;
     int minx = std::min( f.x, t.x ) - pad;
     int miny = std::min( f.y, t.y ) - pad;
     int minz = std::min( f.z, t.z ); // TODO: Make this way bigger
     int maxx = std::max( f.x, t.x ) + pad;
     int maxy = std::max( f.y, t.y ) + pad;
     int maxz = std::max( f.z, t.z ); // Same TODO: as above
+    if( f.z == t.z ) {
+        // The pad alone makes pathfinders dumb around anything big, so also take in
+        // the submaps that a way around passes through
+        pathfinding_cache &pf_cache = get_pathfinding_cache( f.z );
+        if( !pf_cache.submap_graph.built ) {
+            build_submap_graph( *this, pf_cache, f.z, pf_cache.submap_graph );
+        }
+        point corridor_min;
+        point corridor_max;
+        if( find_submap_corridor( *this, pf_cache.submap_graph, f, t, corridor_min, corridor_max ) ) {
+            minx = std::min( minx, corridor_min.x - 1 );
+            miny = std::min( miny, corridor_min.y - 1 );
+            maxx = std::max( maxx, corridor_max.x + 1 );
+            maxy = std::max( maxy, corridor_max.y + 1 );
+        }
+    }
     clip_to_bounds( minx, miny, minz );
     clip_to_bounds( maxx, maxy, maxz );
 
-    pathfinder pf( minx, miny, maxx, maxy );
+    pathfinder &pf = pathfinder::get();
+    pf.start();
     // Make NPCs not want to path through player
     // But don't make player pathing stop working
     for( const auto &p : pre_closed ) {
@@ -256,12 +598,12 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
         const int parent_index = flat_index( cur.x, cur.y );
         auto &layer = pf.get_layer( cur.z );
-        auto &cur_state = layer.state[parent_index];
+        auto &cur_state = layer.at( parent_index ).state;
         if( cur_state == ASL_CLOSED ) {
             continue;
         }
 
-        if( layer.gscore[parent_index] > max_length ) {
+        if( layer.at( parent_index ).gscore > max_length ) {
             // Shortest path would be too long, return empty vector
             return std::vector<tripoint>();
         }
@@ -290,133 +632,43 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                 continue;
             }
 
-            if( layer.state[index] == ASL_CLOSED ) {
+            if( layer.at( index ).state == ASL_CLOSED ) {
                 continue;
             }
 
             // Penalize for diagonals or the path will look "unnatural"
-            int newg = layer.gscore[parent_index] + ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 );
-
-            const auto p_special = pf_cache.special[p.x][p.y];
-            // TODO: De-uglify, de-huge-n
-            if( !( p_special & non_normal ) ) {
-                // Boring flat dirt - the most common case above the ground
-                newg += 2;
-            } else {
-                if( roughavoid ) {
-                    layer.state[index] = ASL_CLOSED; // Close all rough terrain tiles
-                    continue;
+            int newg = layer.at( parent_index ).gscore + ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 );
+
+            bool closed = false;
+            bool ledge = false;
+            const int cost = path_step_cost( cur, p, settings, closed, ledge );
+            if( ledge ) {
+                tripoint below( p.xy(), p.z - 1 );
+                auto &layer = pf.get_layer( p.z - 1 );
+                if( !has_flag( TFLAG_NO_FLOOR, below ) ) {
+                    // Otherwise this would have been a huge fall
+                    // From cur, not p, because we won't be walking on air
+                    pf.add_point( layer.at( parent_index ).gscore + 10,
+                                  layer.at( parent_index ).score + 10 + 2 * rl_dist( below, t ),
+                                  cur, below );
                 }
 
-                int part = -1;
-                const maptile &tile = maptile_at_internal( p );
-                const auto &terrain = tile.get_ter_t();
-                const auto &furniture = tile.get_furn_t();
-                const vehicle *veh = veh_at_internal( p, part );
-
-                const int cost = move_cost_internal( furniture, terrain, veh, part );
-                // Don't calculate bash rating unless we intend to actually use it
-                const int rating = ( bash == 0 || cost != 0 ) ? -1 :
-                                   bash_rating_internal( bash, furniture, terrain, false, veh, part );
-
-                if( cost == 0 && rating <= 0 && ( !doors || !terrain.open ) && veh == nullptr && climb_cost <= 0 ) {
-                    layer.state[index] = ASL_CLOSED; // Close it so that next time we won't try to calculate costs
-                    continue;
-                }
-
-                newg += cost;
-                if( cost == 0 ) {
-                    if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
-                        // Climbing fences
-                        newg += climb_cost;
-                    } else if( doors && terrain.open &&
-                               ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !is_outside( cur ) ) ) {
-                        // Only try to open INSIDE doors from the inside
-                        // To open and then move onto the tile
-                        newg += 4;
-                    } else if( veh != nullptr ) {
-                        const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
-                        part = vpobst ? vpobst->part_index() : -1;
-                        int dummy = -1;
-                        if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
-                            ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ||
-                              veh_at_internal( cur, dummy ) == veh ) ) {
-                            // Handle car doors, but don't try to path through curtains
-                            newg += 10; // One turn to open, 4 to move there
-                        } else if( part >= 0 && bash > 0 ) {
-                            // Car obstacle that isn't a door
-                            // TODO: Account for armor
-                            int hp = veh->parts[part].hp();
-                            if( hp / 20 > bash ) {
-                                // Threshold damage thing means we just can't bash this down
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            } else if( hp / 10 > bash ) {
-                                // Threshold damage thing means we will fail to deal damage pretty often
-                                hp *= 2;
-                            }
-
-                            newg += 2 * hp / bash + 8 + 4;
-                        } else if( part >= 0 ) {
-                            if( !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) ) {
-                                // Won't be openable, don't try from other sides
-                                layer.state[index] = ASL_CLOSED;
-                            }
-
-                            continue;
-                        }
-                    } else if( rating > 1 ) {
-                        // Expected number of turns to bash it down, 1 turn to move there
-                        // and 5 turns of penalty not to trash everything just because we can
-                        newg += ( 20 / rating ) + 2 + 10;
-                    } else if( rating == 1 ) {
-                        // Desperate measures, avoid whenever possible
-                        newg += 500;
-                    } else {
-                        // Unbashable and unopenable from here
-                        if( !doors || !terrain.open ) {
-                            // Or anywhere else for that matter
-                            layer.state[index] = ASL_CLOSED;
-                        }
-
-                        continue;
-                    }
-                }
-
-                if( trapavoid && p_special & PF_TRAP ) {
-                    const auto &ter_trp = terrain.trap.obj();
-                    const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
-                    if( !trp.is_benign() ) {
-                        // For now make them detect all traps
-                        if( has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR ) ) {
-                            // Special case - ledge in z-levels
-                            // Warning: really expensive, needs a cache
-                            if( valid_move( p, tripoint( p.xy(), p.z - 1 ), false, true ) ) {
-                                tripoint below( p.xy(), p.z - 1 );
-                                if( !has_flag( TFLAG_NO_FLOOR, below ) ) {
-                                    // Otherwise this would have been a huge fall
-                                    auto &layer = pf.get_layer( p.z - 1 );
-                                    // From cur, not p, because we won't be walking on air
-                                    pf.add_point( layer.gscore[parent_index] + 10,
-                                                  layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
-                                                  cur, below );
-                                }
-
-                                // Close p, because we won't be walking on it
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            }
-                        } else if( trapavoid ) {
-                            // Otherwise it's walkable
-                            newg += 500;
-                        }
-                    }
-                }
+                // Close p, because we won't be walking on it
+                layer.at( index ).state = ASL_CLOSED;
+                continue;
+            }
+            if( closed ) {
+                // Close it so that next time we won't try to calculate costs
+                layer.at( index ).state = ASL_CLOSED;
             }
+            if( cost < 0 ) {
+                continue;
+            }
+            newg += cost;
 
             // If not visited, add as open
             // If visited, add it only if we can do so with better score
-            if( layer.state[index] == ASL_NONE || newg < layer.gscore[index] ) {
+            if( layer.at( index ).state == ASL_NONE || newg < layer.at( index ).gscore ) {
                 pf.add_point( newg, newg + 2 * rl_dist( p, t ), cur, p );
             }
         }
@@ -432,8 +684,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             tripoint dest( cur.xy(), cur.z - 1 );
             if( vertical_move_destination<TFLAG_GOES_UP>( *this, dest ) ) {
                 auto &layer = pf.get_layer( dest.z );
-                pf.add_point( layer.gscore[parent_index] + 2,
-                              layer.score[parent_index] + 2 * rl_dist( dest, t ),
+                pf.add_point( layer.at( parent_index ).gscore + 2,
+                              layer.at( parent_index ).score + 2 * rl_dist( dest, t ),
                               cur, dest );
             }
         }
@@ -441,8 +693,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             tripoint dest( cur.xy(), cur.z + 1 );
             if( vertical_move_destination<TFLAG_GOES_DOWN>( *this, dest ) ) {
                 auto &layer = pf.get_layer( dest.z );
-                pf.add_point( layer.gscore[parent_index] + 2,
-                              layer.score[parent_index] + 2 * rl_dist( dest, t ),
+                pf.add_point( layer.at( parent_index ).gscore + 2,
+                              layer.at( parent_index ).score + 2 * rl_dist( dest, t ),
                               cur, dest );
             }
         }
@@ -451,8 +703,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             auto &layer = pf.get_layer( cur.z + 1 );
             for( size_t it = 0; it < 8; it++ ) {
                 const tripoint above( cur.x + x_offset[it], cur.y + y_offset[it], cur.z + 1 );
-                pf.add_point( layer.gscore[parent_index] + 4,
-                              layer.score[parent_index] + 4 + 2 * rl_dist( above, t ),
+                pf.add_point( layer.at( parent_index ).gscore + 4,
+                              layer.at( parent_index ).score + 4 + 2 * rl_dist( above, t ),
                               cur, above );
             }
         }
@@ -464,8 +716,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         // Just to limit max distance, in case something weird happens
         for( int fdist = max_length; fdist != 0; fdist-- ) {
             const int cur_index = flat_index( cur.x, cur.y );
-            const auto &layer = pf.get_layer( cur.z );
-            const tripoint &par = layer.parent[cur_index];
+            auto &layer = pf.get_layer( cur.z );
+            const tripoint &par = layer.at( cur_index ).parent;
             if( cur == f ) {
                 break;
             }
@@ -487,3 +739,181 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
     return ret;
 }
+
+// Routes asked for with the same target and settings in one turn before a flow field is built
+static constexpr int flow_field_min_requests = 3;
+// Flow fields kept per z-level, past this route_shared just uses route
+static constexpr size_t max_flow_fields = 8;
+
+// 7 3 5
+// 1 . 2
+// 6 4 8
+static constexpr std::array<point, 8> flow_offsets{{
+        point_west, point_east, point_north, point_south,
+        point_north_east, point_south_west, point_north_west, point_south_east
+    }
+};
+
+void map::build_flow_field( path_flow_field &field ) const
+{
+    const tripoint &t = field.target;
+    const pathfinding_settings &settings = field.settings;
+    field.cost.assign( MAPSIZE_X * MAPSIZE_Y, -1 );
+
+    // Dijkstra outward from the target, over the steps taken toward it
+    open_list open;
+    field.cost[flat_index( t.x, t.y )] = 0;
+    open.push( std::make_pair( 0, t ) );
+    while( !open.empty() ) {
+        const std::pair<int, tripoint> top = open.top();
+        open.pop();
+        const int cur_cost = top.first;
+        const tripoint &cur = top.second;
+        if( cur_cost != field.cost[flat_index( cur.x, cur.y )] ) {
+            // Already reached for less
+            continue;
+        }
+
+        for( const point &offset : flow_offsets ) {
+            const tripoint p( cur.xy() + offset, cur.z );
+            if( !inbounds( p ) ) {
+                continue;
+            }
+
+            bool closed = false;
+            bool ledge = false;
+            const int step = path_step_cost( p, cur, settings, closed, ledge );
+            if( closed || ledge ) {
+                // Nothing steps onto cur
+                break;
+            }
+            if( step < 0 ) {
+                continue;
+            }
+
+            // Penalize for diagonals, as route does
+            const int new_cost = cur_cost + step + ( ( offset.x != 0 && offset.y != 0 ) ? 1 : 0 );
+            int &p_cost = field.cost[flat_index( p.x, p.y )];
+            if( new_cost <= settings.max_length && ( p_cost < 0 || new_cost < p_cost ) ) {
+                p_cost = new_cost;
+                open.push( std::make_pair( new_cost, p ) );
+            }
+        }
+    }
+}
+
+std::vector<tripoint> map::route_shared( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings ) const
+{
+    if( f == t || !inbounds( f ) || !inbounds( t ) || f.z != t.z ) {
+        return route( f, t, settings );
+    }
+
+    const auto line_path = line_to( f, t );
+    if( is_plain_line( get_pathfinding_cache_ref( f.z ), line_path ) ) {
+        return line_path;
+    }
+    if( rl_dist( f, t ) > settings.max_dist ) {
+        return std::vector<tripoint>();
+    }
+
+    // Fields only live for one turn, as their targets move
+    auto &flow_fields = get_pathfinding_cache( t.z ).flow_fields;
+    flow_fields.erase( std::remove_if( flow_fields.begin(), flow_fields.end(),
+    []( const std::unique_ptr<path_flow_field> &field ) {
+        return field->turn != calendar::turn;
+    } ), flow_fields.end() );
+
+    auto iter = std::find_if( flow_fields.begin(), flow_fields.end(),
+    [&t, &settings]( const std::unique_ptr<path_flow_field> &field ) {
+        return field->target == t && field->settings == settings;
+    } );
+    if( iter == flow_fields.end() ) {
+        if( flow_fields.size() >= max_flow_fields ) {
+            return route( f, t, settings );
+        }
+        flow_fields.push_back( std::make_unique<path_flow_field>() );
+        iter = std::prev( flow_fields.end() );
+        ( *iter )->target = t;
+        ( *iter )->settings = settings;
+        ( *iter )->turn = calendar::turn;
+    }
+
+    path_flow_field &field = **iter;
+    if( field.cost.empty() ) {
+        // A lone chaser is cheaper to path with A*
+        if( ++field.requests < flow_field_min_requests ) {
+            return route( f, t, settings );
+        }
+        build_flow_field( field );
+    }
+
+    std::vector<tripoint> ret;
+    if( field.cost[flat_index( f.x, f.y )] < 0 ) {
+        return ret;
+    }
+    // Walk down the field, each step is onto the neighbour it was reached from
+    tripoint cur = f;
+    while( cur != t && static_cast<int>( ret.size() ) < settings.max_length ) {
+        int best_cost = INT_MAX;
+        tripoint best = cur;
+        for( const point &offset : flow_offsets ) {
+            const tripoint p( cur.xy() + offset, cur.z );
+            if( !inbounds( p ) || field.cost[flat_index( p.x, p.y )] < 0 ) {
+                continue;
+            }
+            bool closed = false;
+            bool ledge = false;
+            const int step = path_step_cost( cur, p, settings, closed, ledge );
+            if( step < 0 ) {
+                continue;
+            }
+            const int cost = field.cost[flat_index( p.x, p.y )] + step +
+                             ( ( offset.x != 0 && offset.y != 0 ) ? 1 : 0 );
+            if( cost < best_cost ) {
+                best_cost = cost;
+                best = p;
+            }
+        }
+        if( best == cur ) {
+            return std::vector<tripoint>();
+        }
+        ret.push_back( best );
+        cur = best;
+    }
+
+    return ret;
+}
+
+// Routes remembered per z-level, past this the memo starts over
+static constexpr size_t max_route_memo = 256;
+
+std::vector<tripoint> map::route_memoized( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings,
+        const std::set<tripoint> &pre_closed ) const
+{
+    if( f.z != t.z || !inbounds( f ) || !inbounds( t ) ) {
+        return route( f, t, settings, pre_closed );
+    }
+
+    // Brings the cache up to date, which drops routes through terrain that changed
+    get_pathfinding_cache_ref( f.z );
+    pathfinding_cache &pf_cache = get_pathfinding_cache( f.z );
+    if( pf_cache.route_memo_turn != calendar::turn ) {
+        pf_cache.route_memo.clear();
+        pf_cache.route_memo_turn = calendar::turn;
+    }
+    for( const path_memo_entry &entry : pf_cache.route_memo ) {
+        if( entry.from == f && entry.to == t && entry.settings == settings &&
+            entry.pre_closed == pre_closed ) {
+            return entry.route;
+        }
+    }
+
+    std::vector<tripoint> ret = route( f, t, settings, pre_closed );
+    if( pf_cache.route_memo.size() >= max_route_memo ) {
+        pf_cache.route_memo.clear();
+    }
+    pf_cache.route_memo.push_back( { f, t, settings, pre_closed, ret } );
+    return ret;
+}
@@ -2,7 +2,14 @@
 #ifndef PATHFINDING_H
 #define PATHFINDING_H
 
+#include <bitset>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "calendar.h"
 #include "game_constants.h"
+#include "point.h"
 
 enum pf_special : char {
     PF_NORMAL = 0x00,    // Plain boring tile (grass, dirt, floor etc.)
@@ -37,15 +44,6 @@ inline pf_special &operator &= ( pf_special &lhs, pf_special rhs )
     return lhs;
 }
 
-struct pathfinding_cache {
-    pathfinding_cache();
-    ~pathfinding_cache();
-
-    bool dirty;
-
-    pf_special special[MAPSIZE_X][MAPSIZE_Y];
-};
-
 struct pathfinding_settings {
     int bash_strength = 0;
     int max_dist = 0;
@@ -66,6 +64,72 @@ struct pathfinding_settings {
     pathfinding_settings( int bs, int md, int ml, int cc, bool aod, bool at, bool acs, bool art )
         : bash_strength( bs ), max_dist( md ), max_length( ml ), climb_cost( cc ),
           allow_open_doors( aod ), avoid_traps( at ), allow_climb_stairs( acs ), avoid_rough_terrain( art ) {}
+
+    bool operator==( const pathfinding_settings &rhs ) const {
+        return bash_strength == rhs.bash_strength && max_dist == rhs.max_dist &&
+               max_length == rhs.max_length && climb_cost == rhs.climb_cost &&
+               allow_open_doors == rhs.allow_open_doors && avoid_traps == rhs.avoid_traps &&
+               allow_climb_stairs == rhs.allow_climb_stairs &&
+               avoid_rough_terrain == rhs.avoid_rough_terrain;
+    }
+};
+
+struct path_flow_field;
+
+/**
+ * Coarse view of a z-level for routes spanning many submaps: the connected areas of
+ * walkable tiles inside every submap, and which areas meet across submap edges.
+ */
+struct path_submap_graph {
+    bool built = false;
+    // Area of every tile, indexed by x * MAPSIZE_Y + y, -1 where nothing can walk.
+    std::vector<int> tile_area;
+    // Grid position of the submap each area is in.
+    std::vector<point> area_submap;
+    // Areas in neighbouring submaps that can be stepped into from each area.
+    std::vector<std::vector<int>> area_links;
+};
+
+// A route remembered by map::route_memoized.
+struct path_memo_entry {
+    tripoint from;
+    tripoint to;
+    pathfinding_settings settings;
+    std::set<tripoint> pre_closed;
+    std::vector<tripoint> route;
+};
+
+struct pathfinding_cache {
+    pathfinding_cache();
+    ~pathfinding_cache();
+
+    // One bit per submap ( x + y * MAPSIZE ) whose part of `special` needs to be recomputed.
+    std::bitset<MAPSIZE *MAPSIZE> dirty;
+
+    pf_special special[MAPSIZE_X][MAPSIZE_Y];
+
+    // Built by map::route_shared, dropped whenever `special` is rebuilt.
+    std::vector<std::unique_ptr<path_flow_field>> flow_fields;
+    // Built by map::route on demand, dropped whenever `special` is rebuilt.
+    path_submap_graph submap_graph;
+    // Results of map::route_memoized during route_memo_turn, dropped whenever `special` is rebuilt.
+    std::vector<path_memo_entry> route_memo;
+    time_point route_memo_turn;
+};
+
+/**
+ * Cost of the cheapest path from every tile of a z-level to one target for one set of
+ * pathfinding settings, shared by everything that paths there during a turn.
+ */
+struct path_flow_field {
+    tripoint target;
+    pathfinding_settings settings;
+    time_point turn;
+    // Number of routes asked for this turn, the field is only built once there are several.
+    int requests = 0;
+    // Indexed by x * MAPSIZE_Y + y, -1 where the target can't be reached within max_length.
+    // Empty until built.
+    std::vector<int> cost;
 };
 
 #endif
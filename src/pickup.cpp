@@ -83,19 +83,10 @@ static bool select_autopickup_items( std::vector<std::list<item_stack::iterator>
             item_stack::iterator begin_iterator = here[i].front();
             if( begin_iterator->volume() / units::legacy_volume_factor == static_cast<int>( iVol ) ) {
                 iNumChecked++;
-                const std::string sItemName = begin_iterator->tname( 1, false );
-
                 //Check the Pickup Rules
-                if( get_auto_pickup().check_item( sItemName ) == RULE_WHITELISTED ) {
+                const rule_state pickup_state = get_auto_pickup().check_item( *begin_iterator );
+                if( pickup_state == RULE_WHITELISTED ) {
                     bPickup = true;
-                } else if( get_auto_pickup().check_item( sItemName ) != RULE_BLACKLISTED ) {
-                    //No prematched pickup rule found
-                    //check rules in more detail
-                    get_auto_pickup().create_rule( &*begin_iterator );
-
-                    if( get_auto_pickup().check_item( sItemName ) == RULE_WHITELISTED ) {
-                        bPickup = true;
-                    }
                 }
 
                 //Auto Pickup all items with Volume <= AUTO_PICKUP_VOL_LIMIT * 50 and Weight <= AUTO_PICKUP_ZERO * 50
@@ -106,7 +97,7 @@ static bool select_autopickup_items( std::vector<std::list<item_stack::iterator>
                     if( weight_limit && volume_limit ) {
                         if( begin_iterator->volume() <= units::from_milliliter( volume_limit * 50 ) &&
                             begin_iterator->weight() <= weight_limit * 50_gram &&
-                            get_auto_pickup().check_item( sItemName ) != RULE_BLACKLISTED ) {
+                            pickup_state != RULE_BLACKLISTED ) {
                             bPickup = true;
                         }
                     }
@@ -613,6 +604,9 @@ void Pickup::pick_up( const tripoint &p, int min, from_where get_items_from )
         mvwprintw( w_pickup, point_zero, _( "PICK" ) );
         int selected = 0;
         int iScrollPos = 0;
+        // The description of info_item, kept while the same item stays selected
+        const item *info_item = nullptr;
+        std::vector<iteminfo> vThisItem;
 
         std::string filter;
         std::string new_filter;
@@ -784,9 +778,11 @@ void Pickup::pick_up( const tripoint &p, int min, from_where get_items_from )
 
             werase( w_item_info );
             if( selected >= 0 && selected <= static_cast<int>( stacked_here.size() ) - 1 ) {
-                std::vector<iteminfo> vThisItem;
                 std::vector<iteminfo> vDummy;
-                selected_item.info( true, vThisItem );
+                if( info_item != &selected_item ) {
+                    selected_item.info( true, vThisItem );
+                    info_item = &selected_item;
+                }
 
                 draw_item_info( w_item_info, "", "", vThisItem, vDummy, iScrollPos, true, true );
             }
@@ -3,11 +3,13 @@
 #include "pixel_minimap.h"
 
 #include "avatar.h"
+#include "calendar.h"
 #include "coordinate_conversions.h"
 #include "game.h"
 #include "map.h"
 #include "mapdata.h"
 #include "monster.h"
+#include "npc.h"
 #include "sdl_utils.h"
 #include "vehicle.h"
 #include "vpart_position.h"
@@ -350,8 +352,25 @@ pixel_minimap::submap_cache &pixel_minimap::get_cache_at( const tripoint &abs_sm
     return it->second;
 }
 
+bool pixel_minimap::sample_key::operator==( const sample_key &rhs ) const
+{
+    return valid && rhs.valid && center == rhs.center && moment == rhs.moment;
+}
+
 void pixel_minimap::process_cache( const tripoint &center )
 {
+    sample_key key;
+    key.center = center;
+    key.moment = game_moment::now();
+    key.valid = true;
+
+    // Terrain, lighting and visibility only change while the game advances,
+    // redrawing the same state (e.g. while a menu is open) reuses the cache.
+    if( key == cached_sample ) {
+        return;
+    }
+    cached_sample = key;
+
     prepare_cache_for_updates( center );
 
     for( int y = 0; y < MAPSIZE; ++y ) {
@@ -407,6 +426,7 @@ void pixel_minimap::set_screen_rect( const SDL_Rect &screen_rect )
     }
 
     cache.clear();
+    cached_sample.valid = false;
 
     const auto chunk_size = projector->get_tiles_size( { SEEX, SEEY } );
 
@@ -423,6 +443,7 @@ void pixel_minimap::reset()
 {
     projector.reset();
     cache.clear();
+    cached_sample.valid = false;
     main_tex.reset();
     tex_pool.reset();
 }
@@ -503,27 +524,40 @@ void pixel_minimap::render_critters( const tripoint &center )
         std::max<int>( projector->get_tile_size().y *settings.beacon_size / 2, 2 )
     };
 
-    for( int y = 0; y < total_tiles_count.y; y++ ) {
-        for( int x = 0; x < total_tiles_count.x; x++ ) {
-            const auto p = tripoint{ start_x + x, start_y + y, center.z };
-            const auto lighting = access_cache.visibility_cache[p.x][p.y];
-
-            if( lighting == LL_DARK || lighting == LL_BLANK ) {
-                continue;
-            }
+    const auto draw_critter = [&]( Creature & critter ) {
+        const tripoint p = critter.pos();
+        const point tile( p.x - start_x, p.y - start_y );
 
-            const auto critter = g->critter_at( p, true );
+        if( p.z != center.z || tile.x < 0 || tile.y < 0 ||
+            tile.x >= total_tiles_count.x || tile.y >= total_tiles_count.y ) {
+            return;
+        }
 
-            if( critter == nullptr || !g->u.sees( *critter ) ) {
-                continue;
-            }
+        const auto lighting = access_cache.visibility_cache[p.x][p.y];
 
-            const auto critter_pos = projector->get_tile_pos( { x, y }, total_tiles_count );
-            const auto critter_rect = SDL_Rect{ critter_pos.x, critter_pos.y, beacon_size.x, beacon_size.y };
-            const auto critter_color = get_critter_color( critter, flicker, mixture );
+        if( lighting == LL_DARK || lighting == LL_BLANK ) {
+            return;
+        }
 
-            draw_beacon( critter_rect, critter_color );
+        if( !g->u.sees( critter ) ) {
+            return;
         }
+
+        const auto critter_pos = projector->get_tile_pos( tile, total_tiles_count );
+        const auto critter_rect = SDL_Rect{ critter_pos.x, critter_pos.y, beacon_size.x, beacon_size.y };
+        const auto critter_color = get_critter_color( &critter, flicker, mixture );
+
+        draw_beacon( critter_rect, critter_color );
+    };
+
+    // Walk the creature lists instead of looking up every tile of the minimap.
+    // Monsters go last so they end up on top of their riders, like game::critter_at.
+    draw_critter( g->u );
+    for( npc &guy : g->all_npcs() ) {
+        draw_critter( guy );
+    }
+    for( monster &critter : g->all_monsters() ) {
+        draw_critter( critter );
     }
 }
 
@@ -6,6 +6,7 @@
 #include <map>
 #include <memory>
 
+#include "game_moment.h"
 #include "pixel_minimap_projectors.h"
 #include "point.h"
 #include "sdl_wrappers.h"
@@ -76,6 +77,16 @@ class pixel_minimap
         //track the previous viewing area to determine if the minimap cache needs to be cleared
         tripoint cached_center_sm;
 
+        //the game state the cache was last sampled at, it is not sampled again until that changes
+        struct sample_key {
+            tripoint center;
+            game_moment moment;
+            bool valid = false;
+
+            bool operator==( const sample_key &rhs ) const;
+        };
+        sample_key cached_sample;
+
         SDL_Rect screen_rect;
         SDL_Rect main_tex_clip_rect;
         SDL_Rect screen_clip_rect;
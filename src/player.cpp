@@ -430,6 +430,15 @@ static const trait_id trait_WEB_WALKER( "WEB_WALKER" );
 static const trait_id trait_WEB_WEAVER( "WEB_WEAVER" );
 static const trait_id trait_WOOLALLERGY( "WOOLALLERGY" );
 
+// Read for every character each turn
+static const cached_option<std::string> option_skill_rust( "SKILL_RUST" );
+static const cached_option<bool> option_no_npc_food( "NO_NPC_FOOD" );
+static const cached_option<float> option_thirst_rate( "PLAYER_THIRST_RATE" );
+static const cached_option<float> option_fatigue_rate( "PLAYER_FATIGUE_RATE" );
+static const cached_option<float> option_stamina_regen_rate( "PLAYER_BASE_STAMINA_REGEN_RATE" );
+static const cached_option<int> option_max_stamina( "PLAYER_MAX_STAMINA" );
+static const cached_option<int> option_stamina_burn_rate( "PLAYER_BASE_STAMINA_BURN_RATE" );
+
 stat_mod player::get_pain_penalty() const
 {
     stat_mod ret;
@@ -906,6 +915,14 @@ void player::update_bodytemp()
     const int mutation_heat_bonus = mutation_heat_high - mutation_heat_low;
 
     const int h_radiation = get_heat_radiation( pos(), false );
+    const bool pyromania = has_trait( trait_PYROMANIA );
+    const int humidity = get_local_humidity( weather.humidity, g->weather.weather, sheltered );
+    // If you're standing in water, air temperature is replaced by water temperature. No wind.
+    const ter_id ter_at_pos = g->m.ter( pos() );
+    const bool deep_water = ter_at_pos == t_water_dp || ter_at_pos == t_water_pool ||
+                            ter_at_pos == t_swater_dp || ter_at_pos == t_water_moving_dp;
+    const bool shallow_water = ter_at_pos == t_water_sh || ter_at_pos == t_swater_sh ||
+                               ter_at_pos == t_sewage || ter_at_pos == t_water_moving_sh;
     // Current temperature and converging temperature calculations
     for( const body_part bp : all_body_parts ) {
         // Skip eyes
@@ -928,21 +945,13 @@ void player::update_bodytemp()
                 bp ) );
         // WINDCHILL
 
-        bp_windpower = static_cast<int>( static_cast<float>( bp_windpower ) * ( 1 - get_wind_resistance(
-                                             bp ) / 100.0 ) );
+        bp_windpower = static_cast<int>( static_cast<float>( bp_windpower ) *
+                                         ( 1 - get_wind_resistance( bp ) / 100.0 ) );
         // Calculate windchill
-        int windchill = get_local_windchill( player_local_temp,
-                                             get_local_humidity( weather.humidity, g->weather.weather,
-                                                     sheltered ),
-                                             bp_windpower );
-        // If you're standing in water, air temperature is replaced by water temperature. No wind.
-        const ter_id ter_at_pos = g->m.ter( pos() );
+        int windchill = get_local_windchill( player_local_temp, humidity, bp_windpower );
         // Convert to 0.01C
-        if( ( ter_at_pos == t_water_dp || ter_at_pos == t_water_pool || ter_at_pos == t_swater_dp ||
-              ter_at_pos == t_water_moving_dp ) ||
-            ( ( ter_at_pos == t_water_sh || ter_at_pos == t_swater_sh || ter_at_pos == t_sewage ||
-                ter_at_pos == t_water_moving_sh ) &&
-              ( bp == bp_foot_l || bp == bp_foot_r || bp == bp_leg_l || bp == bp_leg_r ) ) ) {
+        if( deep_water || ( shallow_water &&
+                            ( bp == bp_foot_l || bp == bp_foot_r || bp == bp_leg_l || bp == bp_leg_r ) ) ) {
             adjusted_temp += water_temperature - Ctemperature; // Swap out air temp for water temp.
             windchill = 0;
         }
@@ -967,7 +976,6 @@ void player::update_bodytemp()
         blister_count += h_radiation - 111 > 0 ? std::max( static_cast<int>( sqrt( h_radiation - 111 ) ),
                          0 ) : 0;
 
-        const bool pyromania = has_trait( trait_PYROMANIA );
         // BLISTERS : Skin gets blisters from intense heat exposure.
         // Fire protection protects from blisters.
         // Heatsinks give near-immunity.
@@ -2666,15 +2674,16 @@ int player::read_speed( bool return_stat_effect ) const
 
 int player::rust_rate( bool return_stat_effect ) const
 {
-    if( get_option<std::string>( "SKILL_RUST" ) == "off" ) {
+    const std::string &skill_rust = option_skill_rust.get();
+    if( skill_rust == "off" ) {
         return 0;
     }
 
     // Stat window shows stat effects on based on current stat
     int intel = get_int();
     /** @EFFECT_INT reduces skill rust */
-    int ret = ( ( get_option<std::string>( "SKILL_RUST" ) == "vanilla" ||
-                  get_option<std::string>( "SKILL_RUST" ) == "capped" ) ? 500 : 500 - 35 * ( intel - 8 ) );
+    int ret = ( ( skill_rust == "vanilla" || skill_rust == "capped" ) ? 500 :
+                500 - 35 * ( intel - 8 ) );
 
     ret *= mutation_value( "skill_rust_multiplier" );
 
@@ -3674,7 +3683,7 @@ void player::update_stomach( const time_point &from, const time_point &to )
     // No food/thirst/fatigue clock at all
     const bool debug_ls = has_trait( trait_DEBUG_LS );
     // No food/thirst, capped fatigue clock (only up to tired)
-    const bool npc_no_food = is_npc() && get_option<bool>( "NO_NPC_FOOD" );
+    const bool npc_no_food = is_npc() && option_no_npc_food.get();
     const bool foodless = debug_ls || npc_no_food;
     const bool mouse = has_trait( trait_NO_THIRST );
     const bool mycus = has_trait( trait_M_DEPENDENT );
@@ -4019,13 +4028,13 @@ needs_rates player::calc_needs_rates()
 
     add_msg_if_player( m_debug, "Metabolic rate: %.2f", rates.hunger );
 
-    rates.thirst = get_option< float >( "PLAYER_THIRST_RATE" );
+    rates.thirst = option_thirst_rate.get();
     rates.thirst *= 1.0f +  mutation_value( "thirst_modifier" );
     if( worn_with_flag( "SLOWS_THIRST" ) ) {
         rates.thirst *= 0.7f;
     }
 
-    rates.fatigue = get_option< float >( "PLAYER_FATIGUE_RATE" );
+    rates.fatigue = option_fatigue_rate.get();
     rates.fatigue *= 1.0f + mutation_value( "fatigue_modifier" );
 
     // Note: intentionally not in metabolic rate
@@ -4088,7 +4097,7 @@ void player::update_needs( int rate_multiplier )
     // No food/thirst/fatigue clock at all
     const bool debug_ls = has_trait( trait_DEBUG_LS );
     // No food/thirst, capped fatigue clock (only up to tired)
-    const bool npc_no_food = is_npc() && get_option<bool>( "NO_NPC_FOOD" );
+    const bool npc_no_food = is_npc() && option_no_npc_food.get();
     const bool asleep = !sleep.is_null();
     const bool lying = asleep || has_effect( effect_lying_down ) ||
                        activity.id() == "ACT_TRY_SLEEP";
@@ -4102,7 +4111,7 @@ void player::update_needs( int rate_multiplier )
             int fatigue_roll = roll_remainder( rates.fatigue * rate_multiplier );
             mod_fatigue( fatigue_roll );
 
-            if( get_option< bool >( "SLEEP_DEPRIVATION" ) ) {
+            if( option_sleep_deprivation.get() ) {
                 // Synaptic regen bionic stops SD while awake and boosts it while sleeping
                 if( !has_active_bionic( bio_synaptic_regen ) ) {
                     // fatigue_roll should be around 1 - so the counter increases by 1 every minute on average,
@@ -4128,7 +4137,7 @@ void player::update_needs( int rate_multiplier )
                 mod_fatigue( -25 );
             } else {
                 mod_fatigue( -recovered );
-                if( get_option< bool >( "SLEEP_DEPRIVATION" ) ) {
+                if( option_sleep_deprivation.get() ) {
                     // Sleeping on the ground, no bionic = 1x rest_modifier
                     // Sleeping on a bed, no bionic      = 2x rest_modifier
                     // Sleeping on a comfy bed, no bionic= 3x rest_modifier
@@ -4279,7 +4288,7 @@ void player::update_stamina( int turns )
                                mutation_value( "stamina_regen_modifier" );
     // But mouth encumbrance interferes, even with mutated stamina.
     stamina_recovery += stamina_multiplier * std::max( 1.0f,
-                        get_option<float>( "PLAYER_BASE_STAMINA_REGEN_RATE" ) - ( encumb( bp_mouth ) / 5.0f ) );
+                        option_stamina_regen_rate.get() - ( encumb( bp_mouth ) / 5.0f ) );
     // TODO: recovering stamina causes hunger/thirst/fatigue.
     // TODO: Tiredness slowing recovery
 
@@ -4301,7 +4310,7 @@ void player::update_stamina( int turns )
         int bonus = std::min<int>( power_level / 3, max_stam - stamina - stamina_recovery * turns );
         // so the effective recovery is up to 5x default
         bonus = std::min( bonus, 4 * static_cast<int>
-                          ( get_option<float>( "PLAYER_BASE_STAMINA_REGEN_RATE" ) ) );
+                          ( option_stamina_regen_rate.get() ) );
         if( bonus > 0 ) {
             stamina_recovery += bonus;
             bonus /= 10;
@@ -9731,56 +9740,20 @@ float player::fine_detail_vision_mod( const tripoint &p ) const
 
 int player::get_wind_resistance( body_part bp ) const
 {
-    int coverage = 0;
-    float totalExposed = 1.0;
-    int totalCoverage = 0;
-    int penalty = 100;
-
-    for( auto &i : worn ) {
-        if( i.covers( bp ) ) {
-            if( i.made_of( material_id( "leather" ) ) || i.made_of( material_id( "plastic" ) ) ||
-                i.made_of( material_id( "bone" ) ) ||
-                i.made_of( material_id( "chitin" ) ) || i.made_of( material_id( "nomex" ) ) ) {
-                penalty = 10; // 90% effective
-            } else if( i.made_of( material_id( "cotton" ) ) ) {
-                penalty = 30;
-            } else if( i.made_of( material_id( "wool" ) ) ) {
-                penalty = 40;
-            } else {
-                penalty = 1; // 99% effective
-            }
-
-            coverage = std::max( 0, i.get_coverage() - penalty );
-            totalExposed *= ( 1.0 - coverage / 100.0 ); // Coverage is between 0 and 1?
-        }
-    }
-
     // Your shell provides complete wind protection if you're inside it
     if( has_active_mutation( trait_SHELL2 ) ) {
-        totalCoverage = 100;
-        return totalCoverage;
+        return 100;
     }
-
-    totalCoverage = 100 - totalExposed * 100;
-
-    return totalCoverage;
+    return 100 - worn_aggregates()[bp].wind_exposure * 100;
 }
 
 int player::warmth( body_part bp ) const
 {
-    int ret = 0;
-    int warmth = 0;
-
-    for( auto &i : worn ) {
-        if( i.covers( bp ) ) {
-            warmth = i.get_warmth();
-            // Wool items do not lose their warmth due to being wet.
-            // Warmth is reduced by 0 - 66% based on wetness.
-            if( !i.made_of( material_id( "wool" ) ) ) {
-                warmth *= 1.0 - 0.66 * body_wetness[bp] / drench_capacity[bp];
-            }
-            ret += warmth;
-        }
+    const worn_aggregate_data &aggregate = worn_aggregates()[bp];
+    int ret = aggregate.wool_warmth;
+    for( const int warmth : aggregate.wettable_warmth ) {
+        // Warmth is reduced by 0 - 66% based on wetness.
+        ret += static_cast<int>( warmth * ( 1.0 - 0.66 * body_wetness[bp] / drench_capacity[bp] ) );
     }
     return ret;
 }
@@ -10945,7 +10918,7 @@ int player::get_hp_max( hp_part bp ) const
 
 int player::get_stamina_max() const
 {
-    int maxStamina = get_option< int >( "PLAYER_MAX_STAMINA" );
+    int maxStamina = option_max_stamina.get();
     maxStamina *= Character::mutation_value( "max_stamina_modifier" );
     return maxStamina;
 }
@@ -10959,7 +10932,7 @@ void player::burn_move_stamina( int moves )
         overburden_percentage = ( current_weight - max_weight ) * 100 / max_weight;
     }
 
-    int burn_ratio = get_option<int>( "PLAYER_BASE_STAMINA_BURN_RATE" );
+    int burn_ratio = option_stamina_burn_rate.get();
     if( g->u.has_active_bionic( bionic_id( "bio_torsionratchet" ) ) ) {
         burn_ratio = burn_ratio * 2 - 3;
     }
@@ -11426,9 +11399,22 @@ bool player::is_visible_in_range( const Creature &critter, const int range ) con
     return sees( critter ) && rl_dist( pos(), critter.pos() ) <= range;
 }
 
+// The creatures near center (see game::get_creatures_near) that match pred
+template<typename Pred>
+static std::vector<Creature *> get_creatures_near_if( const tripoint &center, const int range,
+        Pred pred )
+{
+    std::vector<Creature *> result;
+    g->get_creatures_near( center, range, result );
+    result.erase( std::remove_if( result.begin(), result.end(), [&pred]( const Creature * critter ) {
+        return !pred( *critter );
+    } ), result.end() );
+    return result;
+}
+
 std::vector<Creature *> player::get_visible_creatures( const int range ) const
 {
-    return g->get_creatures_if( [this, range]( const Creature & critter ) -> bool {
+    return get_creatures_near_if( pos(), range, [this, range]( const Creature & critter ) -> bool {
         return this != &critter && pos() != critter.pos() && // TODO: get rid of fake npcs (pos() check)
         rl_dist( pos(), critter.pos() ) <= range && sees( critter );
     } );
@@ -11436,7 +11422,7 @@ std::vector<Creature *> player::get_visible_creatures( const int range ) const
 
 std::vector<Creature *> player::get_targetable_creatures( const int range ) const
 {
-    return g->get_creatures_if( [this, range]( const Creature & critter ) -> bool {
+    return get_creatures_near_if( pos(), range, [this, range]( const Creature & critter ) -> bool {
         return this != &critter && pos() != critter.pos() && // TODO: get rid of fake npcs (pos() check)
         rl_dist( pos(), critter.pos() ) <= range &&
         ( sees( critter ) || sees_with_infrared( critter ) );
@@ -11445,7 +11431,7 @@ std::vector<Creature *> player::get_targetable_creatures( const int range ) cons
 
 std::vector<Creature *> player::get_hostile_creatures( int range ) const
 {
-    return g->get_creatures_if( [this, range]( const Creature & critter ) -> bool {
+    return get_creatures_near_if( pos(), range, [this, range]( const Creature & critter ) -> bool {
         float dist_to_creature;
         // Fixes circular distance range for ranged attacks
         if( !trigdist )
@@ -11741,11 +11727,13 @@ void player::on_stat_change( const std::string &stat, int value )
 void player::on_item_wear( const item &it )
 {
     morale->on_item_wear( it );
+    worn_aggregates_dirty = true;
 }
 
 void player::on_item_takeoff( const item &it )
 {
     morale->on_item_takeoff( it );
+    worn_aggregates_dirty = true;
 }
 
 void player::on_worn_item_washed( const item &it )
@@ -362,6 +362,7 @@ int player::fire_gun( const tripoint &target, int shots, item &gun )
     int curshot = 0;
     int hits = 0; // total shots on target
     int delay = 0; // delayed recoil that has yet to be applied
+    projectile_burst burst;
     while( curshot != shots ) {
         if( gun.faults.count( fault_gun_chamber_spent ) && curshot == 0 ) {
             moves -= 50;
@@ -380,7 +381,8 @@ int player::fire_gun( const tripoint &target, int shots, item &gun )
         const vehicle *in_veh = has_effect( effect_on_roof ) ? veh_pointer_or_null( g->m.veh_at(
                                     pos() ) ) : nullptr;
 
-        auto shot = projectile_attack( make_gun_projectile( gun ), pos(), aim, dispersion, this, in_veh );
+        auto shot = projectile_attack( make_gun_projectile( gun ), pos(), aim, dispersion, this, in_veh,
+                                       &burst );
         curshot++;
 
         int qty = gun.gun_recoil( *this, bipod );
@@ -2483,8 +2485,10 @@ double player::gun_value( const item &weap, int ammo ) const
 
     double gun_value = damage_and_accuracy * capacity_factor;
 
-    add_msg( m_debug, "%s as gun: %.1f total, %.1f dispersion, %.1f damage, %.1f capacity",
-             weap.type->get_id(), gun_value, dispersion_factor, damage_factor,
-             capacity_factor );
+    if( debug_mode ) {
+        add_msg( m_debug, "%s as gun: %.1f total, %.1f dispersion, %.1f damage, %.1f capacity",
+                 weap.type->get_id(), gun_value, dispersion_factor, damage_factor,
+                 capacity_factor );
+    }
     return std::max( 0.0, gun_value );
 }
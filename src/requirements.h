@@ -155,7 +155,7 @@ struct quality_requirement {
 */
 struct requirement_data {
         // temporarily break encapsulation pending migration of legacy parts
-        // @see vpart_info::check
+        // @see vpart_info::finalize
         // TODO: remove once all parts specify installation requirements directly
         friend class vpart_info;
 
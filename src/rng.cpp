@@ -121,6 +121,69 @@ double rng_normal( double lo, double hi )
     return clamp( val, lo, hi );
 }
 
+// Seed of all rng_stream objects, follows the seed of the global engine.
+static std::uint64_t &rng_stream_seed()
+{
+    static std::uint64_t seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    return seed;
+}
+
+// splitmix64 finalizer, spreads the bits of its input over the whole result.
+static std::uint64_t mix_bits( std::uint64_t x )
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = ( x ^ ( x >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+    x = ( x ^ ( x >> 27 ) ) * 0x94d049bb133111ebULL;
+    return x ^ ( x >> 31 );
+}
+
+rng_stream::rng_stream( const std::uint64_t key, const std::uint64_t step )
+{
+    // The generator wants a key with well mixed bits, and an odd one.
+    this->key = mix_bits( mix_bits( rng_stream_seed() ^ key ) ^ step ) | 1;
+}
+
+rng_stream::result_type rng_stream::operator()()
+{
+    std::uint64_t y = counter * key;
+    std::uint64_t x = y;
+    const std::uint64_t z = y + key;
+    counter++;
+    x = x * x + y;
+    x = ( x >> 32 ) | ( x << 32 );
+    x = x * x + z;
+    x = ( x >> 32 ) | ( x << 32 );
+    x = x * x + y;
+    x = ( x >> 32 ) | ( x << 32 );
+    return static_cast<result_type>( ( x * x + z ) >> 32 );
+}
+
+int rng_stream::rng( int lo, int hi )
+{
+    if( lo > hi ) {
+        std::swap( lo, hi );
+    }
+    return std::uniform_int_distribution<int>( lo, hi )( *this );
+}
+
+double rng_stream::rng_float( double lo, double hi )
+{
+    if( lo > hi ) {
+        std::swap( lo, hi );
+    }
+    return std::uniform_real_distribution<double>( lo, hi )( *this );
+}
+
+bool rng_stream::one_in( const int chance )
+{
+    return chance <= 1 || rng( 0, chance - 1 ) == 0;
+}
+
+bool rng_stream::x_in_y( const double x, const double y )
+{
+    return rng_float( 0.0, 1.0 ) <= x / y;
+}
+
 cata_default_random_engine &rng_get_engine()
 {
     static cata_default_random_engine eng(
@@ -132,5 +195,6 @@ void rng_set_engine_seed( unsigned int seed )
 {
     if( seed != 0 ) {
         rng_get_engine().seed( seed );
+        rng_stream_seed() = seed;
     }
 }
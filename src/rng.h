@@ -3,6 +3,7 @@
 #define RNG_H
 
 #include <array>
+#include <cstdint>
 #include <functional>
 #include <random>
 #include <iosfwd>
@@ -30,6 +31,47 @@ bool one_turn_in( const time_duration &duration );
 bool x_in_y( double x, double y );
 int dice( int number, int sides );
 
+/**
+ * Random numbers for one entity at one step of the simulation, independent of the
+ * global engine.
+ * The numbers are a pure function of the engine seed (see @ref rng_set_engine_seed), the
+ * key and the step, and of how many numbers were already taken from the stream (Squares
+ * counter based generator, see https://arxiv.org/abs/2004.06278).
+ * Code that gives each entity its own stream can therefore process entities in any order,
+ * or concurrently, and still get the same results.
+ * Satisfies UniformRandomBitGenerator, so it can be used with the <random> distributions
+ * and std::shuffle.
+ */
+class rng_stream
+{
+    public:
+        using result_type = std::uint32_t;
+
+        /**
+         * @param key Identifies the entity, e.g. a monster's or NPC's id.
+         * @param step Identifies when, usually the turn number.
+         */
+        rng_stream( std::uint64_t key, std::uint64_t step );
+
+        static constexpr result_type min() {
+            return 0;
+        }
+        static constexpr result_type max() {
+            return UINT32_MAX;
+        }
+        result_type operator()();
+
+        /** Same as the global functions of the same names, but drawing from this stream. */
+        int rng( int lo, int hi );
+        double rng_float( double lo, double hi );
+        bool one_in( int chance );
+        bool x_in_y( double x, double y );
+
+    private:
+        std::uint64_t key;
+        std::uint64_t counter = 0;
+};
+
 // Returns x + x_in_y( x-int(x), 1 )
 int roll_remainder( double value );
 
@@ -1,16 +1,14 @@
 #include "safe_reference.h"
 
-safe_reference_anchor::safe_reference_anchor()
+safe_reference_anchor &safe_reference_anchor::operator=( const safe_reference_anchor & ) noexcept
 {
-    impl = std::make_shared<empty>();
+    // Invalidates the references handed out so far
+    impl.reset();
+    return *this;
 }
 
-safe_reference_anchor::safe_reference_anchor( const safe_reference_anchor & ) :
-    safe_reference_anchor()
-{}
-
-safe_reference_anchor &safe_reference_anchor::operator=( const safe_reference_anchor & )
+safe_reference_anchor &safe_reference_anchor::operator=( safe_reference_anchor && ) noexcept
 {
-    impl = std::make_shared<empty>();
+    impl.reset();
     return *this;
 }
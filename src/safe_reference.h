@@ -26,8 +26,10 @@ class safe_reference
     public:
         safe_reference() = default;
 
+        // Only whether the anchor is gone is shared, so checking it needs no lock.
+        // Anchors belong to the main thread, like the objects they are in.
         T *get() const {
-            return impl.lock().get();
+            return impl.expired() ? nullptr : object;
         }
 
         explicit operator bool() const {
@@ -48,20 +50,29 @@ class safe_reference
     private:
         friend class safe_reference_anchor;
 
-        safe_reference( const std::shared_ptr<T> &p ) : impl( p ) {}
+        safe_reference( const std::shared_ptr<T> &p ) : impl( p ), object( p.get() ) {}
 
         std::weak_ptr<T> impl;
+        T *object = nullptr;
 };
 
 class safe_reference_anchor
 {
     public:
-        safe_reference_anchor();
-        safe_reference_anchor( const safe_reference_anchor & );
-        safe_reference_anchor &operator=( const safe_reference_anchor & );
+        // The shared state is only allocated once a reference is requested, most
+        // anchors (e.g. of items being copied around) never hand one out.
+        safe_reference_anchor() = default;
+        // Copies and moves are new objects, references to the source don't carry over.
+        safe_reference_anchor( const safe_reference_anchor & ) noexcept {}
+        safe_reference_anchor( safe_reference_anchor && ) noexcept {}
+        safe_reference_anchor &operator=( const safe_reference_anchor & ) noexcept;
+        safe_reference_anchor &operator=( safe_reference_anchor && ) noexcept;
 
         template<typename T>
         safe_reference<T> reference_to( T *object ) {
+            if( !impl ) {
+                impl = std::make_shared<empty>();
+            }
             // Using the shared_ptr aliasing constructor
             return safe_reference<T>( std::shared_ptr<T>( impl, object ) );
         }
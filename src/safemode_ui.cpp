@@ -567,25 +567,27 @@ void safemode::add_rules( const std::vector<rules_class> &rules_in )
     //if a specific monster is being added, all the rules need to be checked now
     //may have some performance issues since exclusion needs to check all monsters also
     for( auto &rule : rules_in ) {
+        const wildcard_pattern pattern( rule.rule );
         if( !rule.whitelist ) {
             //Check include patterns against all monster mtypes
             for( const auto &mtype : MonsterGenerator::generator().get_all_mtypes() ) {
-                set_rule( rule, mtype.nname(), RULE_BLACKLISTED );
+                set_rule( rule, pattern, mtype.nname(), RULE_BLACKLISTED );
             }
         } else {
             //exclude monsters from the existing mapping
             for( const auto &safemode_rule : safemode_rules ) {
-                set_rule( rule, safemode_rule.first, RULE_WHITELISTED );
+                set_rule( rule, pattern, safemode_rule.first, RULE_WHITELISTED );
             }
         }
     }
 }
 
-void safemode::set_rule( const rules_class &rule_in, const std::string &name_in, rule_state rs_in )
+void safemode::set_rule( const rules_class &rule_in, const wildcard_pattern &pattern,
+                         const std::string &name_in, rule_state rs_in )
 {
     static std::vector<Creature::Attitude> attitude_any = {{Creature::A_HOSTILE, Creature::A_NEUTRAL, Creature::A_FRIENDLY}};
 
-    if( !rule_in.rule.empty() && rule_in.active && wildcard_match( name_in, rule_in.rule ) ) {
+    if( !rule_in.rule.empty() && rule_in.active && pattern.matches( name_in ) ) {
         if( rule_in.attitude == Creature::A_ANY ) {
             for( auto &att : attitude_any ) {
                 safemode_rules[ name_in ][ att ] = rule_state_class( rs_in, rule_in.proximity );
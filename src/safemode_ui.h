@@ -12,6 +12,7 @@
 
 class JsonIn;
 class JsonOut;
+class wildcard_pattern;
 
 class safemode
 {
@@ -74,7 +75,9 @@ class safemode
 
         void create_rules();
         void add_rules( const std::vector<rules_class> &rules_in );
-        void set_rule( const rules_class &rule_in, const std::string &name_in, rule_state rs_in );
+        /** pattern is the compiled rule_in.rule. */
+        void set_rule( const rules_class &rule_in, const wildcard_pattern &pattern,
+                       const std::string &name_in, rule_state rs_in );
 
     public:
         std::string lastmon_whitelist;
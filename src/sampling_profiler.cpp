@@ -0,0 +1,245 @@
+#include "sampling_profiler.h"
+
+#if defined(BACKTRACE) && !defined(_WIN32) && !defined(__CYGWIN__)
+#   define CATA_SAMPLING_PROFILER
+#endif
+
+#if defined(CATA_SAMPLING_PROFILER)
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <pthread.h>
+
+#include "cata_utility.h"
+#include "debug.h"
+
+namespace
+{
+
+constexpr int max_depth = 48;
+// About five minutes of samples at the default interval
+constexpr size_t max_samples = 60000;
+// The signal handler and the signal delivery itself
+constexpr int skipped_frames = 2;
+
+struct sample {
+    std::array<void *, max_depth> frames;
+    int depth;
+};
+
+// Written by the signal handler, only allocated and read while no samples are taken
+std::vector<sample> samples;
+std::atomic<size_t> next_sample( 0 );
+
+struct profiler_state {
+    std::string path;
+    std::thread timer;
+    std::atomic<bool> stopping{ false };
+    struct sigaction previous_action;
+};
+std::unique_ptr<profiler_state> state;
+
+// backtrace is not async-signal-safe by POSIX. With glibc it is once libgcc is loaded, which
+// start does outside the handler, except that the unwinder takes locks of its own: a sample
+// taken while the main thread unwinds an exception or loads a library can deadlock. The game
+// does neither in its loops, so the risk is accepted to get whole stacks.
+extern "C" void take_sample( int )
+{
+    const int saved_errno = errno;
+    const size_t i = next_sample.fetch_add( 1 );
+    if( i < samples.size() ) {
+        samples[i].depth = backtrace( samples[i].frames.data(), max_depth );
+    }
+    errno = saved_errno;
+}
+
+// backtrace_symbols gives "binary(symbol+offset) [address]", with the symbol mangled
+std::string frame_name( const char *symbol )
+{
+    const char *const open = std::strchr( symbol, '(' );
+    const char *const plus = open ? std::strchr( open, '+' ) : nullptr;
+    const char *const close = open ? std::strchr( open, ')' ) : nullptr;
+    if( open == nullptr || plus == nullptr || close == nullptr || plus > close ) {
+        return symbol;
+    }
+    std::string result;
+    if( plus == open + 1 ) {
+        // No symbol, a static function: the binary and the offset into it
+        std::string binary( symbol, open );
+        const size_t slash = binary.rfind( '/' );
+        result = ( slash == std::string::npos ? binary : binary.substr( slash + 1 ) ) +
+                 std::string( plus, close );
+    } else {
+        const std::string mangled( open + 1, plus );
+        int status = 0;
+        char *const demangled = abi::__cxa_demangle( mangled.c_str(), nullptr, nullptr, &status );
+        result = status == 0 && demangled != nullptr ? demangled : mangled;
+        free( demangled );
+    }
+    // Semicolons separate the frames of the folded format
+    std::replace( result.begin(), result.end(), ';', ':' );
+    return result;
+}
+
+int write_samples( const std::string &path, const size_t count )
+{
+    std::map<std::vector<void *>, int> stacks;
+    std::map<void *, std::string> names;
+    for( size_t i = 0; i < count; ++i ) {
+        const sample &s = samples[i];
+        if( s.depth <= skipped_frames ) {
+            continue;
+        }
+        // Outermost frame first
+        std::vector<void *> stack( s.frames.rend() - s.depth, s.frames.rend() - skipped_frames );
+        for( void *frame : stack ) {
+            names[frame];
+        }
+        ++stacks[stack];
+    }
+
+    std::vector<void *> addresses;
+    for( const auto &e : names ) {
+        addresses.push_back( e.first );
+    }
+    char **const symbols = backtrace_symbols( addresses.data(), addresses.size() );
+    if( symbols == nullptr ) {
+        return 0;
+    }
+    for( size_t i = 0; i < addresses.size(); ++i ) {
+        names[addresses[i]] = frame_name( symbols[i] );
+    }
+    free( symbols );
+
+    int written = 0;
+    const bool ok = write_to_file( path, [&]( std::ostream & fout ) {
+        for( const auto &e : stacks ) {
+            for( size_t i = 0; i < e.first.size(); ++i ) {
+                fout << ( i == 0 ? "" : ";" ) << names[e.first[i]];
+            }
+            fout << " " << e.second << "\n";
+            written += e.second;
+        }
+    }, nullptr );
+    if( !ok ) {
+        DebugLog( D_WARNING, DC_ALL ) << "Could not write the stack samples to " << path;
+        return 0;
+    }
+    return written;
+}
+
+} // namespace
+
+namespace sampling_profiler
+{
+
+bool available()
+{
+    return true;
+}
+
+bool running()
+{
+    return state != nullptr;
+}
+
+bool start( const std::string &path, const int interval_ms )
+{
+    if( state ) {
+        return false;
+    }
+    samples.resize( max_samples );
+    next_sample = 0;
+    // The first call of backtrace loads libgcc, which must not happen in the signal handler
+    void *frame = nullptr;
+    backtrace( &frame, 1 );
+
+    state = std::make_unique<profiler_state>();
+    state->path = path;
+    struct sigaction action;
+    std::memset( &action, 0, sizeof( action ) );
+    action.sa_handler = take_sample;
+    action.sa_flags = SA_RESTART;
+    sigemptyset( &action.sa_mask );
+    sigaction( SIGPROF, &action, &state->previous_action );
+
+    const pthread_t main_thread = pthread_self();
+    const std::chrono::milliseconds interval( std::max( interval_ms, 1 ) );
+    state->timer = std::thread( [main_thread, interval]() {
+        while( !state->stopping ) {
+            std::this_thread::sleep_for( interval );
+            pthread_kill( main_thread, SIGPROF );
+        }
+    } );
+    return true;
+}
+
+int stop()
+{
+    if( !state ) {
+        return 0;
+    }
+    state->stopping = true;
+    state->timer.join();
+    // A signal sent just before the join may still be pending, the old handler must not get it
+    sigset_t pending;
+    sigpending( &pending );
+    if( !sigismember( &pending, SIGPROF ) ) {
+        sigaction( SIGPROF, &state->previous_action, nullptr );
+    }
+    const size_t count = std::min( next_sample.load(), samples.size() );
+    if( next_sample > samples.size() ) {
+        DebugLog( D_WARNING, DC_ALL ) << "The sampling profiler dropped " <<
+                                      next_sample - samples.size() << " samples, its buffer was full";
+    }
+    const int written = write_samples( state->path, count );
+    state.reset();
+    samples.clear();
+    samples.shrink_to_fit();
+    return written;
+}
+
+} // namespace sampling_profiler
+
+#else
+
+namespace sampling_profiler
+{
+
+bool available()
+{
+    return false;
+}
+
+bool running()
+{
+    return false;
+}
+
+bool start( const std::string &, int )
+{
+    return false;
+}
+
+int stop()
+{
+    return 0;
+}
+
+} // namespace sampling_profiler
+
+#endif
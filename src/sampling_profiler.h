@@ -0,0 +1,46 @@
+#pragma once
+#ifndef SAMPLING_PROFILER_H
+#define SAMPLING_PROFILER_H
+
+#include <string>
+
+/**
+ * A sampling profiler that works in release builds. While it runs, a timer thread interrupts
+ * the main thread every few milliseconds and its stack is recorded. When stopped, the stacks
+ * are written in the folded format of flamegraph.pl (and speedscope, inferno, ...): one line
+ * per distinct stack, outermost frame first, with the number of samples.
+ *
+ * Started with the --profile-samples command line flag (and then stopped when the game
+ * exits) or from the debug menu. It only exists in builds with BACKTRACE support on POSIX
+ * systems. Functions are named by the dynamic symbol table, static functions only show as
+ * an offset into the binary.
+ *
+ * The stacks are taken with backtrace in a signal handler, which POSIX does not promise to
+ * be safe. It is with glibc once libgcc is loaded (@ref start loads it), as long as the
+ * sampled thread isn't inside the unwinder itself: a sample taken while an exception unwinds
+ * or a library is loaded can deadlock. A debugging tool, not something to leave on for users.
+ */
+namespace sampling_profiler
+{
+
+/** Whether this build can sample stacks. */
+bool available();
+bool running();
+
+/**
+ * Starts sampling the calling thread, which must be the main thread, every interval_ms.
+ * The stacks will be written to path.
+ * @return false if it is not available or already running.
+ */
+bool start( const std::string &path, int interval_ms = 5 );
+
+/**
+ * Stops sampling and writes the stacks to the path given to @ref start.
+ * @return how many samples were written, 0 if it was not running or the file could not be
+ * written.
+ */
+int stop();
+
+} // namespace sampling_profiler
+
+#endif
@@ -0,0 +1,222 @@
+#include "save_benchmark.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <ostream>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+#include "avatar.h"
+#include "calendar.h"
+#include "cata_utility.h"
+#include "coordinate_conversions.h"
+#include "debug.h"
+#include "filesystem.h"
+#include "game.h"
+#include "item.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "overmapbuffer.h"
+#include "path_info.h"
+#include "point.h"
+#include "rng.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "worldfactory.h"
+
+namespace
+{
+
+using bench_clock = std::chrono::steady_clock;
+
+double seconds_since( const bench_clock::time_point &start )
+{
+    return std::chrono::duration<double>( bench_clock::now() - start ).count();
+}
+
+// Overmap coordinates, a row east of the avatar's overmap
+std::vector<point> overmap_positions( const save_benchmark::world_size &size )
+{
+    const point first = sm_to_om_copy( point( g->get_levx(), g->get_levy() ) ) + point_east;
+    std::vector<point> result;
+    for( int i = 0; i < size.overmaps; ++i ) {
+        result.push_back( first + point( i, 0 ) );
+    }
+    return result;
+}
+
+// Absolute submap coordinates, a square starting at the corner of the first synthetic overmap
+std::vector<tripoint> submap_positions( const save_benchmark::world_size &size )
+{
+    const point first = sm_to_om_copy( point( g->get_levx(), g->get_levy() ) ) + point_east;
+    const tripoint origin( om_to_sm_copy( first ), 0 );
+    const int side = std::ceil( std::sqrt( size.submaps ) );
+    std::vector<tripoint> result;
+    for( int i = 0; i < size.submaps; ++i ) {
+        result.push_back( origin + point( i % side, i / side ) );
+    }
+    return result;
+}
+
+save_benchmark::stage measure( const std::string &name, const std::function<void()> &work )
+{
+    save_benchmark::stage result;
+    result.name = name;
+    const written_totals before = total_written();
+    const bench_clock::time_point start = bench_clock::now();
+    work();
+    result.seconds = seconds_since( start );
+    const written_totals after = total_written();
+    result.files = after.files - before.files;
+    result.bytes = after.bytes - before.bytes;
+#if !defined(_WIN32)
+    const bench_clock::time_point sync_start = bench_clock::now();
+    sync();
+    result.sync_seconds = seconds_since( sync_start );
+#endif
+    return result;
+}
+
+// Copies the folder of one world to a new world of the given name, with everything in it
+bool copy_world( const std::string &world, const std::string &copy )
+{
+    world_generator->init();
+    if( world_generator->get_world( copy ) ) {
+        // Left over from a run that didn't finish
+        world_generator->delete_world( copy, true );
+    }
+    const WORLDPTR source = world_generator->get_world( world );
+    if( !source ) {
+        return false;
+    }
+    const std::string from = source->folder_path();
+    const std::string to = FILENAMES["savedir"] + utf8_to_native( copy );
+    if( !assure_dir_exist( to ) ) {
+        return false;
+    }
+    // Breadth first, so every directory comes before what is in it
+    for( const std::string &path : get_files_from_path( "", from, true ) ) {
+        const std::string target = to + path.substr( from.size() );
+        if( dir_exist( path ) ? !assure_dir_exist( target ) : !copy_file( path, target ) ) {
+            DebugLog( D_ERROR, DC_ALL ) << "The save benchmark could not copy " << path;
+            return false;
+        }
+    }
+    return true;
+}
+
+void save_game()
+{
+    if( !g->save() ) {
+        DebugLog( D_WARNING, DC_ALL ) << "The save benchmark could not save the game";
+    }
+    // The submap files are written in the background, the save is done when they are
+    MAPBUFFER.finish_writes();
+}
+
+} // namespace
+
+namespace save_benchmark
+{
+
+void generate( const world_size &size )
+{
+    for( const point &om : overmap_positions( size ) ) {
+        overmap_buffer.get( om );
+    }
+
+    const std::array<itype_id, 6> stock = {{
+            "2x4", "rock", "hammer", "tshirt", "jeans", "can_beans"
+        }
+    };
+    for( const tripoint &pos : submap_positions( size ) ) {
+        std::unique_ptr<submap> sm = std::make_unique<submap>();
+        for( int x = 0; x < SEEX; ++x ) {
+            for( int y = 0; y < SEEY; ++y ) {
+                // Uniform submaps are not saved at all
+                sm->set_ter( point( x, y ), ( x + y ) % 5 == 0 ? t_dirt : t_grass );
+            }
+        }
+        for( int i = 0; i < size.items_per_submap; ++i ) {
+            sm->itm[rng( 0, SEEX - 1 )][rng( 0, SEEY - 1 )].insert( item( random_entry( stock ),
+                    calendar::turn ) );
+        }
+        sm->last_touched = calendar::turn;
+        // Fails where the world already has a submap, the benchmark just uses that one then
+        MAPBUFFER.add_submap( pos, sm );
+    }
+}
+
+std::vector<stage> run_stages( const world_size &size )
+{
+    const std::vector<point> overmaps = overmap_positions( size );
+    const std::vector<tripoint> submaps = submap_positions( size );
+    std::vector<stage> result;
+
+    result.push_back( measure( "full_save", save_game ) );
+
+    // Like loading the world from the main menu, then reading everything the first save wrote
+    const std::string world = world_generator->active_world->world_name;
+    result.push_back( measure( "cold_load", [&world]() {
+        MAPBUFFER.reset();
+        overmap_buffer.clear();
+        g->load( world );
+    } ) );
+    result.push_back( measure( "load_synthetic", [&overmaps, &submaps]() {
+        for( const point &om : overmaps ) {
+            overmap_buffer.get( om );
+        }
+        for( const tripoint &pos : submaps ) {
+            MAPBUFFER.lookup_submap( pos );
+        }
+    } ) );
+
+    // Fresh from the disk nothing is modified, so only the changed quads have to be written
+    for( size_t i = 0; i < submaps.size(); i += 100 ) {
+        if( submap *const sm = MAPBUFFER.lookup_submap( submaps[i] ) ) {
+            sm->itm[0][0].insert( item( "rock", calendar::turn ) );
+            sm->modified = true;
+        }
+    }
+    result.push_back( measure( "incremental_save", save_game ) );
+    return result;
+}
+
+bool run( const std::string &world, const world_size &size, const std::string &path )
+{
+    // The content is saved into the world, so the original is left alone
+    const std::string copy = world + "-save-benchmark";
+    if( !copy_world( world, copy ) || !g->load( copy ) ) {
+        return false;
+    }
+    // A fixed seed, so every run writes the same content
+    rng_set_engine_seed( 1 );
+    generate( size );
+    const std::vector<stage> stages = run_stages( size );
+    world_generator->delete_world( copy, true );
+
+    const bool written = write_to_file( path, [&]( std::ostream & fout ) {
+        fout << string_format( "# world\t%s\n", world );
+        fout << string_format( "# overmaps\t%d\n", size.overmaps );
+        fout << string_format( "# submaps\t%d\n", size.submaps );
+        fout << string_format( "# items_per_submap\t%d\n", size.items_per_submap );
+        fout << "stage\tseconds\tfiles\tkib\tsync_seconds\n";
+        for( const stage &s : stages ) {
+            const std::string sync = s.sync_seconds < 0 ? "n/a" : string_format( "%.3f",
+                                     s.sync_seconds );
+            fout << string_format( "%s\t%.3f\t%d\t%.1f\t%s\n", s.name, s.seconds, s.files,
+                                   s.bytes / 1024.0, sync );
+        }
+    }, nullptr );
+    if( !written ) {
+        DebugLog( D_WARNING, DC_ALL ) << "Could not write the save benchmark to " << path;
+    }
+    return true;
+}
+
+} // namespace save_benchmark
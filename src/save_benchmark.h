@@ -0,0 +1,61 @@
+#pragma once
+#ifndef SAVE_BENCHMARK_H
+#define SAVE_BENCHMARK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Measures saving and loading of a world made bigger with synthetic content: extra generated
+ * overmaps and submaps full of items next to the avatar's overmap. The content is written
+ * into the world, so @ref run works on a copy of it.
+ * Used by the --benchmark-save command line flag.
+ */
+namespace save_benchmark
+{
+
+struct world_size {
+    /** Overmaps generated east of the avatar's one. */
+    int overmaps = 4;
+    /** Submaps of items added in a square, starting at the first of those overmaps. */
+    int submaps = 4096;
+    /** Items on each of these submaps. */
+    int items_per_submap = 50;
+};
+
+struct stage {
+    std::string name;
+    double seconds = 0;
+    /** Files and bytes written during the stage. */
+    uint64_t files = 0;
+    uint64_t bytes = 0;
+    /**
+     * Time taken to flush what the stage wrote to the disk afterwards, the game itself doesn't
+     * sync its files. Negative where that is not supported.
+     */
+    double sync_seconds = -1;
+};
+
+/** Adds the synthetic content around the avatar of the current game. */
+void generate( const world_size &size );
+
+/**
+ * With the current game enlarged by @ref generate: a full save, a cold load of the world
+ * followed by loading all of the synthetic content, and an incremental save after changing a
+ * hundredth of the synthetic submaps.
+ */
+std::vector<stage> run_stages( const world_size &size );
+
+/**
+ * Copies the given world to a new one named after it with a "-save-benchmark" suffix, loads
+ * the first save of the copy, generates the content, runs the stages and writes their results
+ * to path as tab separated values. The copy is deleted afterwards, the world itself is never
+ * written to.
+ * @return false if the world could not be copied or loaded.
+ */
+bool run( const std::string &world, const world_size &size, const std::string &path );
+
+} // namespace save_benchmark
+
+#endif
@@ -261,6 +261,7 @@ void scent_map::deserialize( const std::string &data )
             val = stmp;
         }
     }
+    peak_dirty = true;
 }
 
 ///// weather
@@ -960,15 +961,14 @@ void overmap::unserialize( std::istream &fin )
                 radios.push_back( new_radio );
             }
         } else if( name == "monster_map" ) {
-            jsin.start_array();
-            while( !jsin.end_array() ) {
-                tripoint monster_location;
-                monster new_monster;
-                monster_location.deserialize( jsin );
-                new_monster.deserialize( jsin );
-                monster_map.insert( std::make_pair( monster_location,
-                                                    std::move( new_monster ) ) );
-            }
+            // Kept as text until needed, see overmap::monsters.
+            const int start = jsin.tell();
+            jsin.skip_value();
+            unloaded_monster_map = jsin.substr( start, jsin.tell() - start );
+            // The skipped text may have whitespace and the next separator around it.
+            unloaded_monster_map.erase( 0, unloaded_monster_map.find( '[' ) );
+            unloaded_monster_map.erase( unloaded_monster_map.rfind( ']' ) + 1 );
+            monster_map.clear();
         } else if( name == "tracked_vehicles" ) {
             jsin.start_array();
             while( !jsin.end_array() ) {
@@ -1063,6 +1063,42 @@ void overmap::unserialize( std::istream &fin )
     }
 }
 
+std::unordered_multimap<tripoint, monster> &overmap::monsters()
+{
+    load_monster_map();
+    return monster_map;
+}
+
+const std::unordered_multimap<tripoint, monster> &overmap::monsters() const
+{
+    load_monster_map();
+    return monster_map;
+}
+
+void overmap::load_monster_map() const
+{
+    if( unloaded_monster_map.empty() ) {
+        return;
+    }
+    std::istringstream stream( unloaded_monster_map );
+    // Cleared first so a broken section is only reported once.
+    unloaded_monster_map.clear();
+    try {
+        JsonIn jsin( stream );
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            tripoint monster_location;
+            monster new_monster;
+            monster_location.deserialize( jsin );
+            new_monster.deserialize( jsin );
+            monster_map.insert( std::make_pair( monster_location,
+                                                std::move( new_monster ) ) );
+        }
+    } catch( const JsonError &err ) {
+        debugmsg( "Failed to load the monsters of overmap %d,%d: %s", loc.x, loc.y, err.what() );
+    }
+}
+
 static void unserialize_array_from_compacted_sequence( JsonIn &jsin, bool ( &array )[OMAPX][OMAPY] )
 {
     int count = 0;
@@ -1381,12 +1417,18 @@ void overmap::serialize( std::ostream &fout ) const
     fout << std::endl;
 
     json.member( "monster_map" );
-    json.start_array();
-    for( auto &i : monster_map ) {
-        i.first.serialize( json );
-        i.second.serialize( json );
+    if( !unloaded_monster_map.empty() ) {
+        // Nobody looked at them, so they are saved as they were loaded.
+        fout << unloaded_monster_map;
+        json.set_need_separator();
+    } else {
+        json.start_array();
+        for( auto &i : monster_map ) {
+            i.first.serialize( json );
+            i.second.serialize( json );
+        }
+        json.end_array();
     }
-    json.end_array();
     fout << std::endl;
 
     json.member( "tracked_vehicles" );
@@ -1638,6 +1680,7 @@ void Creature_tracker::deserialize( JsonIn &jsin )
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    monsters_by_submap.clear();
     jsin.start_array();
     while( !jsin.end_array() ) {
         monster montmp;
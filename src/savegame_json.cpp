@@ -2971,29 +2971,48 @@ void player_morale::load( JsonObject &jsin )
     jsin.read( "morale", points );
 }
 
+// The id index, subtile and rotation of a memorized tile in a single number
+static int64_t pack_memorized_tile( const uint32_t id, const int8_t subtile, const int8_t rotation )
+{
+    return static_cast<int64_t>( id ) << 16 | static_cast<uint8_t>( subtile ) << 8 |
+           static_cast<uint8_t>( rotation );
+}
+
 void map_memory::store( JsonOut &jsout ) const
 {
+    // The format version, the older format had an array of tiles here
     jsout.start_array();
+    jsout.write( 2 );
     jsout.start_array();
-    for( const auto &elem : tile_cache.list() ) {
-        jsout.start_array();
-        jsout.write( elem.first.x );
-        jsout.write( elem.first.y );
-        jsout.write( elem.first.z );
-        jsout.write( elem.second.tile );
-        jsout.write( elem.second.subtile );
-        jsout.write( elem.second.rotation );
-        jsout.end_array();
+    for( const std::string &id : tile_ids ) {
+        jsout.write( id );
     }
     jsout.end_array();
 
+    // In the order they were used, so the least recently used are still forgotten first,
+    // with the tiles and symbols of each block in a row. Either is left out if empty.
     jsout.start_array();
-    for( const auto &elem : symbol_cache.list() ) {
+    for( const tripoint &sm_pos : lru ) {
+        const memorized_submap &sm = *blocks.at( sm_pos ).data;
         jsout.start_array();
-        jsout.write( elem.first.x );
-        jsout.write( elem.first.y );
-        jsout.write( elem.first.z );
-        jsout.write( elem.second );
+        jsout.write( sm_pos.x );
+        jsout.write( sm_pos.y );
+        jsout.write( sm_pos.z );
+        jsout.start_array();
+        for( int x = 0; x < SEEX && sm.tile_count > 0; x++ ) {
+            for( int y = 0; y < SEEY; y++ ) {
+                const tile_entry &t = sm.tiles[x][y];
+                jsout.write( pack_memorized_tile( t.id, t.subtile, t.rotation ) );
+            }
+        }
+        jsout.end_array();
+        jsout.start_array();
+        for( int x = 0; x < SEEX && sm.symbol_count > 0; x++ ) {
+            for( int y = 0; y < SEEY; y++ ) {
+                jsout.write( sm.symbols[x][y] );
+            }
+        }
+        jsout.end_array();
         jsout.end_array();
     }
     jsout.end_array();
@@ -3006,12 +3025,15 @@ void map_memory::load( JsonIn &jsin )
     if( jsin.test_object() ) {
         JsonObject jsobj = jsin.get_object();
         load( jsobj );
-    } else {
-        // This file is large enough that it's more than called for to minimize the
-        // amount of data written and read and make it a bit less "friendly",
-        // and use the streaming interface.
-        jsin.start_array();
-        tile_cache.clear();
+        return;
+    }
+    // This file is large enough that it's more than called for to minimize the
+    // amount of data written and read and make it a bit less "friendly",
+    // and use the streaming interface.
+    clear();
+    jsin.start_array();
+    if( !jsin.test_int() ) {
+        // Legacy loading of a tile per entry.
         jsin.start_array();
         while( !jsin.end_array() ) {
             jsin.start_array();
@@ -3026,7 +3048,6 @@ void map_memory::load( JsonIn &jsin )
                            tile, subtile, rotation );
             jsin.end_array();
         }
-        symbol_cache.clear();
         jsin.start_array();
         while( !jsin.end_array() ) {
             jsin.start_array();
@@ -3039,14 +3060,58 @@ void map_memory::load( JsonIn &jsin )
             jsin.end_array();
         }
         jsin.end_array();
+        return;
     }
+
+    jsin.get_int();
+    // The indices in the file to the ones of this memory
+    std::vector<uint32_t> ids;
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        ids.push_back( tile_id_index( jsin.get_string() ) );
+    }
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        jsin.start_array();
+        tripoint sm_pos;
+        sm_pos.x = jsin.get_int();
+        sm_pos.y = jsin.get_int();
+        sm_pos.z = jsin.get_int();
+        memorized_submap &sm = touch_block( sm_pos );
+        jsin.start_array();
+        for( int i = 0; !jsin.end_array(); i++ ) {
+            const int64_t packed = jsin.get_int64();
+            const size_t id = packed >> 16;
+            if( i >= SEEX * SEEY || id == 0 || id >= ids.size() ) {
+                continue;
+            }
+            tile_entry &t = sm.tiles[i / SEEY][i % SEEY];
+            t.id = ids[id];
+            t.subtile = static_cast<int8_t>( packed >> 8 & 0xff );
+            t.rotation = static_cast<int8_t>( packed & 0xff );
+            sm.tile_count++;
+        }
+        jsin.start_array();
+        for( int i = 0; !jsin.end_array(); i++ ) {
+            const int symbol = jsin.get_int();
+            if( i >= SEEX * SEEY || symbol == 0 ) {
+                continue;
+            }
+            sm.symbols[i / SEEY][i % SEEY] = symbol;
+            sm.symbol_count++;
+        }
+        tile_count += sm.tile_count;
+        symbol_count += sm.symbol_count;
+        jsin.end_array();
+    }
+    jsin.end_array();
 }
 
 // Deserializer for legacy object-based memory map.
 void map_memory::load( JsonObject &jsin )
 {
     JsonArray map_memory_tiles = jsin.get_array( "map_memory_tiles" );
-    tile_cache.clear();
+    clear();
     while( map_memory_tiles.has_more() ) {
         JsonObject pmap = map_memory_tiles.next_object();
         const tripoint p( pmap.get_int( "x" ), pmap.get_int( "y" ), pmap.get_int( "z" ) );
@@ -3055,7 +3120,6 @@ void map_memory::load( JsonObject &jsin )
     }
 
     JsonArray map_memory_curses = jsin.get_array( "map_memory_curses" );
-    symbol_cache.clear();
     while( map_memory_curses.has_more() ) {
         JsonObject pmap = map_memory_curses.next_object();
         const tripoint p( pmap.get_int( "x" ), pmap.get_int( "y" ), pmap.get_int( "z" ) );
@@ -3309,9 +3373,12 @@ void cata_variant::deserialize( JsonIn &jsin )
 void event_tracker::serialize( JsonOut &jsout ) const
 {
     jsout.start_object();
-    using value_type = decltype( event_counts )::value_type;
-    std::vector<value_type> copy( event_counts.begin(), event_counts.end() );
-    jsout.member( "event_counts", copy );
+    jsout.member( "event_counts" );
+    jsout.start_array();
+    for( const auto &entry : event_counts ) {
+        jsout.write( entry );
+    }
+    jsout.end_array();
     jsout.end_object();
 }
 
@@ -3325,7 +3392,11 @@ void event_tracker::deserialize( JsonIn &jsin )
             if( !jsin.read( copy ) ) {
                 jsin.error( "Failed to read event_counts" );
             }
-            event_counts = { copy.begin(), copy.end() };
+            event_counts.clear();
+            event_counts.reserve( copy.size() );
+            for( std::pair<cata::event::data_type, int> &entry : copy ) {
+                event_counts[std::move( entry.first )] += entry.second;
+            }
         } else {
             jsin.skip_value();
         }
@@ -3345,52 +3416,131 @@ void stats_tracker::deserialize( JsonIn &jsin )
     jo.read( "data", data );
 }
 
+// Ids shared by the tile runs of one submap in the compact format, see MAP_COMPACT_SUBMAPS.
+class tile_palette
+{
+    public:
+        int index( const std::string &id ) {
+            const auto it = indices.emplace( id, static_cast<int>( ids.size() ) );
+            if( it.second ) {
+                ids.push_back( id );
+            }
+            return it.first->second;
+        }
+
+        std::vector<std::string> ids;
+
+    private:
+        std::unordered_map<std::string, int> indices;
+};
+
+// Encodes every tile in row order as flat ( palette index, run length ) pairs.
+template<typename T>
+static std::vector<int> tile_runs( const int_id<T>( &tiles )[SEEX][SEEY], tile_palette &palette )
+{
+    std::vector<int> runs;
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            const int index = palette.index( tiles[i][j].id().str() );
+            if( !runs.empty() && runs[runs.size() - 2] == index ) {
+                ++runs.back();
+            } else {
+                runs.push_back( index );
+                runs.push_back( 1 );
+            }
+        }
+    }
+    return runs;
+}
+
+template<typename T>
+static void load_tile_runs( JsonIn &jsin, const std::vector<std::string> &palette,
+                            int_id<T>( &tiles )[SEEX][SEEY] )
+{
+    int cell = 0;
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        const int index = jsin.get_int();
+        const int count = jsin.get_int();
+        if( index < 0 || index >= static_cast<int>( palette.size() ) ) {
+            jsin.error( "tile palette index out of range" );
+        }
+        if( count < 1 || cell + count > SEEX * SEEY ) {
+            jsin.error( "tile runs overflow the submap" );
+        }
+        const int_id<T> id = string_id<T>( palette[index] ).id();
+        for( const int end = cell + count; cell < end; ++cell ) {
+            tiles[cell % SEEX][cell / SEEX] = id;
+        }
+    }
+    if( cell != SEEX * SEEY ) {
+        debugmsg( "Mapbuffer tile data is corrupt, runs end early." );
+    }
+}
+
 void submap::store( JsonOut &jsout ) const
 {
     jsout.member( "turn_last_touched", last_touched );
     jsout.member( "temperature", temperature );
 
-    // Terrain is saved using a simple RLE scheme.  Legacy saves don't have
-    // this feature but the algorithm is backward compatible.
-    jsout.member( "terrain" );
-    jsout.start_array();
-    std::string last_id;
-    int num_same = 1;
-    for( int j = 0; j < SEEY; j++ ) {
-        // NOLINTNEXTLINE(modernize-loop-convert)
-        for( int i = 0; i < SEEX; i++ ) {
-            const std::string this_id = ter[i][j].obj().id.str();
-            if( !last_id.empty() ) {
-                if( this_id == last_id ) {
-                    num_same++;
-                } else {
-                    if( num_same == 1 ) {
-                        // if there's only one element don't write as an array
-                        jsout.write( last_id );
+    // The compact format replaces the terrain, furniture and traps members with runs of
+    // indices into one list of ids, written first so loading can resolve the runs as they are read.
+    const bool compact = get_option<bool>( "MAP_COMPACT_SUBMAPS" );
+    if( compact ) {
+        tile_palette palette;
+        const std::vector<int> ter_runs = tile_runs( ter, palette );
+        const std::vector<int> frn_runs = tile_runs( frn, palette );
+        const std::vector<int> trp_runs = tile_runs( trp, palette );
+        jsout.member( "tiles" );
+        jsout.start_object();
+        jsout.member( "palette", palette.ids );
+        jsout.member( "terrain", ter_runs );
+        jsout.member( "furniture", frn_runs );
+        jsout.member( "traps", trp_runs );
+        jsout.end_object();
+    } else {
+        // Terrain is saved using a simple RLE scheme.  Legacy saves don't have
+        // this feature but the algorithm is backward compatible.
+        jsout.member( "terrain" );
+        jsout.start_array();
+        std::string last_id;
+        int num_same = 1;
+        for( int j = 0; j < SEEY; j++ ) {
+            // NOLINTNEXTLINE(modernize-loop-convert)
+            for( int i = 0; i < SEEX; i++ ) {
+                const std::string this_id = ter[i][j].obj().id.str();
+                if( !last_id.empty() ) {
+                    if( this_id == last_id ) {
+                        num_same++;
                     } else {
-                        jsout.start_array();
-                        jsout.write( last_id );
-                        jsout.write( num_same );
-                        jsout.end_array();
-                        num_same = 1;
+                        if( num_same == 1 ) {
+                            // if there's only one element don't write as an array
+                            jsout.write( last_id );
+                        } else {
+                            jsout.start_array();
+                            jsout.write( last_id );
+                            jsout.write( num_same );
+                            jsout.end_array();
+                            num_same = 1;
+                        }
+                        last_id = this_id;
                     }
+                } else {
                     last_id = this_id;
                 }
-            } else {
-                last_id = this_id;
             }
         }
-    }
-    // Because of the RLE scheme we have to do one last pass
-    if( num_same == 1 ) {
-        jsout.write( last_id );
-    } else {
-        jsout.start_array();
-        jsout.write( last_id );
-        jsout.write( num_same );
+        // Because of the RLE scheme we have to do one last pass
+        if( num_same == 1 ) {
+            jsout.write( last_id );
+        } else {
+            jsout.start_array();
+            jsout.write( last_id );
+            jsout.write( num_same );
+            jsout.end_array();
+        }
         jsout.end_array();
     }
-    jsout.end_array();
 
     // Write out the radiation array in a simple RLE scheme.
     // written in intensity, count pairs
@@ -3398,7 +3548,12 @@ void submap::store( JsonOut &jsout ) const
     jsout.start_array();
     int lastrad = -1;
     int count = 0;
-    for( int j = 0; j < SEEY; j++ ) {
+    if( rad.empty() ) {
+        lastrad = 0;
+        count = SEEX * SEEY;
+        jsout.write( lastrad );
+    }
+    for( int j = 0; j < SEEY && !rad.empty(); j++ ) {
         for( int i = 0; i < SEEX; i++ ) {
             const point p( i, j );
             // Save radiation, re-examine this because it doesn't look like it works right
@@ -3418,22 +3573,24 @@ void submap::store( JsonOut &jsout ) const
     jsout.write( count );
     jsout.end_array();
 
-    jsout.member( "furniture" );
-    jsout.start_array();
-    for( int j = 0; j < SEEY; j++ ) {
-        for( int i = 0; i < SEEX; i++ ) {
-            const point p( i, j );
-            // Save furniture
-            if( get_furn( p ) ) {
-                jsout.start_array();
-                jsout.write( p.x );
-                jsout.write( p.y );
-                jsout.write( get_furn( p ).obj().id );
-                jsout.end_array();
+    if( !compact ) {
+        jsout.member( "furniture" );
+        jsout.start_array();
+        for( int j = 0; j < SEEY; j++ ) {
+            for( int i = 0; i < SEEX; i++ ) {
+                const point p( i, j );
+                // Save furniture
+                if( get_furn( p ) ) {
+                    jsout.start_array();
+                    jsout.write( p.x );
+                    jsout.write( p.y );
+                    jsout.write( get_furn( p ).obj().id );
+                    jsout.end_array();
+                }
             }
         }
+        jsout.end_array();
     }
-    jsout.end_array();
 
     jsout.member( "items" );
     jsout.start_array();
@@ -3449,23 +3606,25 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
-    jsout.member( "traps" );
-    jsout.start_array();
-    for( int j = 0; j < SEEY; j++ ) {
-        for( int i = 0; i < SEEX; i++ ) {
-            const point p( i, j );
-            // Save traps
-            if( get_trap( p ) ) {
-                jsout.start_array();
-                jsout.write( p.x );
-                jsout.write( p.y );
-                // TODO: jsout should support writing an id like jsout.write( trap_id )
-                jsout.write( get_trap( p ).id().str() );
-                jsout.end_array();
+    if( !compact ) {
+        jsout.member( "traps" );
+        jsout.start_array();
+        for( int j = 0; j < SEEY; j++ ) {
+            for( int i = 0; i < SEEX; i++ ) {
+                const point p( i, j );
+                // Save traps
+                if( get_trap( p ) ) {
+                    jsout.start_array();
+                    jsout.write( p.x );
+                    jsout.write( p.y );
+                    // TODO: jsout should support writing an id like jsout.write( trap_id )
+                    jsout.write( get_trap( p ).id().str() );
+                    jsout.end_array();
+                }
             }
         }
+        jsout.end_array();
     }
-    jsout.end_array();
 
     jsout.member( "fields" );
     jsout.start_array();
@@ -3633,6 +3792,23 @@ void submap::load( JsonIn &jsin, const std::string &member_name, bool rubpow_upd
             }
         }
         jsin.end_array();
+    } else if( member_name == "tiles" ) {
+        std::vector<std::string> palette;
+        jsin.start_object();
+        while( !jsin.end_object() ) {
+            const std::string tiles_member = jsin.get_member_name();
+            if( tiles_member == "palette" ) {
+                jsin.read( palette );
+            } else if( tiles_member == "terrain" ) {
+                load_tile_runs( jsin, palette, ter );
+            } else if( tiles_member == "furniture" ) {
+                load_tile_runs( jsin, palette, frn );
+            } else if( tiles_member == "traps" ) {
+                load_tile_runs( jsin, palette, trp );
+            } else {
+                jsin.skip_value();
+            }
+        }
     } else if( member_name == "radiation" ) {
         int rad_cell = 0;
         jsin.start_array();
@@ -3640,9 +3816,9 @@ void submap::load( JsonIn &jsin, const std::string &member_name, bool rubpow_upd
             int rad_strength = jsin.get_int();
             int rad_num = jsin.get_int();
             for( int i = 0; i < rad_num; ++i ) {
-                // A little array trick here, assign to it as a 1D array.
+                // Cells are stored in the same order as the old 2D array's memory.
                 // If it's not in bounds we're kinda hosed anyway.
-                set_radiation( { 0, rad_cell }, rad_strength );
+                set_radiation( { rad_cell / SEEY, rad_cell % SEEY }, rad_strength );
                 rad_cell++;
             }
         }
@@ -3726,6 +3902,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, bool rubpow_upd
                 }
                 if( fld[i][j].find_field( ft ) == nullptr ) {
                     field_count++;
+                    field_tiles.set( point( i, j ) );
                 }
                 fld[i][j].add_field( ft, intensity, time_duration::from_turns( age ) );
             }
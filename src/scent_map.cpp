@@ -3,6 +3,7 @@
 #include <cstdlib>
 #include <cassert>
 #include <algorithm>
+#include <climits>
 
 #include "calendar.h"
 #include "color.h"
@@ -50,6 +51,7 @@ void scent_map::reset()
             val = 0;
         }
     }
+    peak_dirty = true;
 }
 
 void scent_map::decay()
@@ -59,6 +61,7 @@ void scent_map::decay()
             val = std::max( 0, val - 1 );
         }
     }
+    peak_dirty = true;
 }
 
 void scent_map::draw( const catacurses::window &win, const int div, const tripoint &center ) const
@@ -84,6 +87,7 @@ void scent_map::shift( const int sm_shift_x, const int sm_shift_y )
         }
     }
     grscent = new_scent;
+    peak_dirty = true;
 }
 
 int scent_map::get( const tripoint &p ) const
@@ -104,12 +108,51 @@ void scent_map::set( const tripoint &p, int value )
 void scent_map::set_unsafe( const tripoint &p, int value )
 {
     grscent[p.x][p.y] = value;
+    peak_dirty = true;
 }
 int scent_map::get_unsafe( const tripoint &p ) const
 {
     return grscent[p.x][p.y] - std::abs( gm.get_levz() - p.z );
 }
 
+int scent_map::peak_near( const tripoint &p ) const
+{
+    if( p.x < 0 || p.x >= MAPSIZE_X || p.y < 0 || p.y >= MAPSIZE_Y ) {
+        return INT_MAX;
+    }
+    if( peak_dirty ) {
+        // Maximum over 3 tiles along y, then over 3 of those along x.
+        scent_array<int> peak_y;
+        for( int x = 0; x < MAPSIZE_X; ++x ) {
+            for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                int high = grscent[x][y];
+                if( y > 0 ) {
+                    high = std::max( high, grscent[x][y - 1] );
+                }
+                if( y + 1 < MAPSIZE_Y ) {
+                    high = std::max( high, grscent[x][y + 1] );
+                }
+                peak_y[x][y] = high;
+            }
+        }
+        for( int x = 0; x < MAPSIZE_X; ++x ) {
+            for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                int high = peak_y[x][y];
+                if( x > 0 ) {
+                    high = std::max( high, peak_y[x - 1][y] );
+                }
+                if( x + 1 < MAPSIZE_X ) {
+                    high = std::max( high, peak_y[x + 1][y] );
+                }
+                peak[x][y] = high;
+            }
+        }
+        peak_dirty = false;
+    }
+    // get() never returns more than the stored value, it only subtracts for other z-levels.
+    return std::max( 0, peak[p.x][p.y] );
+}
+
 bool scent_map::inbounds( const tripoint &p ) const
 {
     // This weird long check here is a hack around the fact that scentmap is 2D
@@ -142,13 +185,16 @@ void scent_map::update( const tripoint &center, map &m )
         return;
     }
 
-    // note: the next four intermediate matrices need to be at least
-    // [2*SCENT_RADIUS+3][2*SCENT_RADIUS+1] in size to hold enough data
+    // note: the next three intermediate matrices need to be at least
+    // [2*SCENT_RADIUS+3][2*SCENT_RADIUS+3] in size to hold enough data
     // The code I'm modifying used [MAPSIZE_X]. I'm staying with that to avoid new bugs.
 
-    // These two matrices are transposed so that x addresses are contiguous in memory
+    // These are laid out like grscent, so the inner loops below walk y through
+    // contiguous memory without branches and can be vectorized by the compiler.
     scent_array<int> sum_3_scent_y;
     scent_array<int> squares_used_y;
+    // How much each square takes part in diffusion: 0 for walls, 2 for REDUCE_SCENT, 10 otherwise
+    scent_array<int> weight;
 
     // these are for caching flag lookups
     scent_array<bool> blocks_scent; // currently only TFLAG_WALL blocks scent
@@ -167,6 +213,12 @@ void scent_map::update( const tripoint &center, map &m )
     // The new scent flag searching function. Should be wayyy faster than the old one.
     m.scent_blockers( blocks_scent, reduces_scent, point( scentmap_minx - 1, scentmap_miny - 1 ),
                       point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
+    for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
+        for( int y = scentmap_miny - 1; y <= scentmap_maxy + 1; ++y ) {
+            // only 20% of scent can diffuse on REDUCE_SCENT squares
+            weight[x][y] = blocks_scent[x][y] ? 0 : reduces_scent[x][y] ? 2 : 10;
+        }
+    }
     // Sum neighbors in the y direction.  This way, each square gets called 3 times instead of 9
     // times. This cost us an extra loop here, but it also eliminated a loop at the end, so there
     // is a net performance improvement over the old code. Could probably still be better.
@@ -174,59 +226,44 @@ void scent_map::update( const tripoint &center, map &m )
     // than the final scent matrix. I think this is fine since SCENT_RADIUS is less than
     // MAPSIZE_X, but if that changes, this may need tweaking.
     for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
+        const auto &w = weight[x];
+        const auto &scent = grscent[x];
         for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
             // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = y - 1; i <= y + 1; ++i ) {
-                if( !blocks_scent[x][i] ) {
-                    if( reduces_scent[x][i] ) {
-                        // only 20% of scent can diffuse on REDUCE_SCENT squares
-                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
-                        squares_used_y[y][x] += 2;
-                    } else {
-                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
-                        squares_used_y[y][x] += 10;
-                    }
-                }
-            }
+            sum_3_scent_y[x][y] = w[y - 1] * scent[y - 1] + w[y] * scent[y] + w[y + 1] * scent[y + 1];
+            squares_used_y[x][y] = w[y - 1] + w[y] + w[y + 1];
         }
     }
 
     // Rest of the scent map
     for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
+        auto &scent = grscent[x];
         for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
-            auto &scent_here = grscent[x][y];
-            if( !blocks_scent[x][y] ) {
-                // to how many neighboring squares do we diffuse out? (include our own square
-                // since we also include our own square when diffusing in)
-                const int squares_used = squares_used_y[y][x - 1]
-                                         + squares_used_y[y][x]
-                                         + squares_used_y[y][x + 1];
-
-                int this_diffusivity;
-                if( !reduces_scent[x][y] ) {
-                    this_diffusivity = diffusivity;
-                } else {
-                    this_diffusivity = diffusivity / 5; //less air movement for REDUCE_SCENT square
-                }
-                // take the old scent and subtract what diffuses out
-                int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
-                // neighboring walls and reduce_scent squares absorb some scent
-                temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
-                // we've already summed neighboring scent values in the y direction in the previous
-                // loop. Now we do it for the x direction, multiply by diffusion, and this is what
-                // diffuses into our current square.
-                scent_here =
-                    ( temp_scent
-                      + this_diffusivity * ( sum_3_scent_y[y][x - 1]
-                                             + sum_3_scent_y[y][x]
-                                             + sum_3_scent_y[y][x + 1] )
-                    ) / ( 1000 * 10 );
-            } else {
-                // this cell blocks scent
-                scent_here = 0;
-            }
+            // to how many neighboring squares do we diffuse out? (include our own square
+            // since we also include our own square when diffusing in)
+            const int squares_used = squares_used_y[x - 1][y]
+                                     + squares_used_y[x][y]
+                                     + squares_used_y[x + 1][y];
+
+            //less air movement for REDUCE_SCENT square
+            const int this_diffusivity = reduces_scent[x][y] ? diffusivity / 5 : diffusivity;
+            const int scent_here = scent[y];
+            // take the old scent and subtract what diffuses out
+            int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
+            // neighboring walls and reduce_scent squares absorb some scent
+            temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
+            // we've already summed neighboring scent values in the y direction in the previous
+            // loop. Now we do it for the x direction, multiply by diffusion, and this is what
+            // diffuses into our current square.
+            const int new_scent =
+                ( temp_scent
+                  + this_diffusivity * ( sum_3_scent_y[x - 1][y]
+                                         + sum_3_scent_y[x][y]
+                                         + sum_3_scent_y[x + 1][y] )
+                ) / ( 1000 * 10 );
+            // cells that block scent hold none
+            scent[y] = blocks_scent[x][y] ? 0 : new_scent;
         }
     }
+    peak_dirty = true;
 }
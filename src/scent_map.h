@@ -28,6 +28,10 @@ class scent_map
         using scent_array = std::array<std::array<T, MAPSIZE_Y>, MAPSIZE_X>;
 
         scent_array<int> grscent;
+        // Highest value of grscent on each tile and the tiles next to it, see @ref peak_near.
+        mutable scent_array<int> peak;
+        // Set whenever grscent changes, peak is then rebuilt on the next call to peak_near.
+        mutable bool peak_dirty = true;
         cata::optional<tripoint> player_last_position;
         time_point player_last_moved = calendar::before_time_starts;
 
@@ -58,6 +62,14 @@ class scent_map
         void set_unsafe( const tripoint &p, int value );
         int get_unsafe( const tripoint &p ) const;
 
+        /**
+         * Upper bound of @ref get on p and every tile next to it, including the tiles above
+         * and below. Lets scent trackers skip sampling their surroundings when nothing there
+         * could be strong enough to follow.
+         * Rebuilt at most once between changes of the scent map.
+         */
+        int peak_near( const tripoint &p ) const;
+
         bool inbounds( const tripoint &p ) const;
         bool inbounds( const point &p ) const {
             return inbounds( tripoint( p, 0 ) );
@@ -5,7 +5,10 @@
 #include <cstdlib>
 #include <algorithm>
 #include <chrono>
+#include <list>
 #include <map>
+#include <mutex>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -29,6 +32,7 @@
 #include "rng.h"
 #include "sdl_wrappers.h"
 #include "sounds.h"
+#include "thread_pool.h"
 
 #define dbg(x) DebugLog((x),D_SDL) << __FILE__ << ":" << __LINE__ << ": "
 
@@ -42,6 +46,10 @@ struct sound_effect_resource {
         }
     };
     std::unique_ptr<Mix_Chunk, deleter> chunk;
+    /** Preloaded chunks are kept, the others are freed again when the cache is full. */
+    bool pinned = false;
+    /** Where the chunk is in @ref sfx_lru, if it is loaded and not pinned. */
+    std::list<int>::iterator lru_pos;
 };
 struct sound_effect {
     int volume;
@@ -77,6 +85,13 @@ static std::string current_soundpack_path;
 static std::unordered_map<std::string, int> unique_paths;
 static sfx_resources_t sfx_resources;
 static std::vector<id_and_variant> sfx_preload;
+// Resource ids of the loaded chunks that aren't pinned, the least recently played first
+static std::list<int> sfx_lru;
+// Audio data of the chunks in sfx_lru
+static size_t sfx_lru_bytes = 0;
+// Sounds are also played from the thread pool (see sfx::generate_melee_sound), this guards
+// playing them and loading and freeing the chunks
+static std::mutex sfx_mutex;
 
 bool sounds::sound_enabled = false;
 
@@ -128,6 +143,8 @@ void shutdown_sound()
 {
     // De-allocate all loaded sound.
     sfx_resources.resource.clear();
+    sfx_lru.clear();
+    sfx_lru_bytes = 0;
     sfx_resources.sound_effects.clear();
 
     playlists.clear();
@@ -264,27 +281,81 @@ static Mix_Chunk *make_null_chunk()
     return nchunk;
 }
 
-static Mix_Chunk *load_chunk( const std::string &path )
+// Only decodes, so it can run on any thread. The error is reported by finish_chunk.
+static Mix_Chunk *decode_chunk( const std::string &path, std::string &error )
 {
     Mix_Chunk *result = Mix_LoadWAV( path.c_str() );
     if( result == nullptr ) {
-        // Failing to load a sound file is not a fatal error worthy of a backtrace
-        dbg( D_WARNING ) << "Failed to load sfx audio file " << path << ": " << Mix_GetError();
-        result = make_null_chunk();
+        error = Mix_GetError();
     }
     return result;
 }
 
+static Mix_Chunk *finish_chunk( Mix_Chunk *chunk, const std::string &path,
+                                const std::string &error )
+{
+    if( chunk == nullptr ) {
+        // Failing to load a sound file is not a fatal error worthy of a backtrace
+        dbg( D_WARNING ) << "Failed to load sfx audio file " << path << ": " << error;
+        return make_null_chunk();
+    }
+    return chunk;
+}
+
+static std::string resource_path( const sound_effect_resource &resource )
+{
+    return current_soundpack_path + "/" + resource.path;
+}
+
+static bool chunk_is_playing( const Mix_Chunk *const chunk )
+{
+    const int channels = Mix_AllocateChannels( -1 );
+    for( int ch = 0; ch < channels; ++ch ) {
+        if( Mix_Playing( ch ) && Mix_GetChunk( ch ) == chunk ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Frees the least recently played chunks until the cache fits its budget again, except
+// for the one about to be played and the ones still playing
+static void trim_sfx_cache( const int keep )
+{
+    const size_t budget = static_cast<size_t>( get_option<int>( "SOUND_EFFECT_CACHE" ) ) << 20;
+    for( auto it = sfx_lru.begin(); it != sfx_lru.end() && sfx_lru_bytes > budget; ) {
+        sound_effect_resource &resource = sfx_resources.resource[*it];
+        if( *it == keep || chunk_is_playing( resource.chunk.get() ) ) {
+            ++it;
+            continue;
+        }
+        sfx_lru_bytes -= resource.chunk->alen;
+        resource.chunk.reset();
+        it = sfx_lru.erase( it );
+    }
+}
+
 // Check to see if the resource has already been loaded
 // - Loaded: Return stored pointer
 // - Not Loaded: Load chunk from stored resource path
+// Must be called with sfx_mutex held, and the chunk is only valid while it stays held
+// (or while it plays).
 static inline Mix_Chunk *get_sfx_resource( int resource_id )
 {
     auto &resource = sfx_resources.resource[ resource_id ];
-    if( !resource.chunk ) {
-        std::string path = ( current_soundpack_path + "/" + resource.path );
-        resource.chunk.reset( load_chunk( path ) );
-    }
+    if( resource.pinned ) {
+        return resource.chunk.get();
+    }
+    if( resource.chunk ) {
+        sfx_lru.splice( sfx_lru.end(), sfx_lru, resource.lru_pos );
+        return resource.chunk.get();
+    }
+    const std::string path = resource_path( resource );
+    std::string error;
+    resource.chunk.reset( finish_chunk( decode_chunk( path, error ), path, error ) );
+    sfx_lru_bytes += resource.chunk->alen;
+    resource.lru_pos = sfx_lru.insert( sfx_lru.end(), resource_id );
+    trim_sfx_cache( resource_id );
     return resource.chunk.get();
 }
 
@@ -460,6 +531,7 @@ void sfx::play_variant_sound( const std::string &id, const std::string &variant,
     }
     const sound_effect &selected_sound_effect = *eff;
 
+    std::lock_guard<std::mutex> lock( sfx_mutex );
     Mix_Chunk *effect_to_play = get_sfx_resource( selected_sound_effect.resource_id );
     Mix_VolumeChunk( effect_to_play,
                      selected_sound_effect.volume * get_option<int>( "SOUND_EFFECT_VOLUME" ) * volume / ( 100 * 100 ) );
@@ -481,6 +553,7 @@ void sfx::play_variant_sound( const std::string &id, const std::string &variant,
     }
     const sound_effect &selected_sound_effect = *eff;
 
+    std::lock_guard<std::mutex> lock( sfx_mutex );
     Mix_Chunk *effect_to_play = get_sfx_resource( selected_sound_effect.resource_id );
     bool is_pitched = ( pitch_min > 0 ) && ( pitch_max > 0 );
     if( is_pitched ) {
@@ -521,6 +594,7 @@ void sfx::play_ambient_variant_sound( const std::string &id, const std::string &
     }
     const sound_effect &selected_sound_effect = *eff;
 
+    std::lock_guard<std::mutex> lock( sfx_mutex );
     Mix_Chunk *effect_to_play = get_sfx_resource( selected_sound_effect.resource_id );
     bool is_pitched = ( pitch > 0 );
     if( is_pitched ) {
@@ -580,15 +654,36 @@ void load_soundset()
         dbg( D_ERROR ) << "failed to load sounds: " << err.what();
     }
 
-    // Preload sound effects
+    // Preload sound effects, decoding them on the thread pool. They stay loaded, the other
+    // sounds are loaded when first played and freed again when the cache runs full.
+    std::set<int> preload_ids;
     for( const auto &preload : sfx_preload ) {
         const auto find_result = sfx_resources.sound_effects.find( preload );
         if( find_result != sfx_resources.sound_effects.end() ) {
             for( const auto &sfx : find_result->second ) {
-                get_sfx_resource( sfx.resource_id );
+                if( !sfx_resources.resource[sfx.resource_id].pinned ) {
+                    preload_ids.insert( sfx.resource_id );
+                }
             }
         }
     }
+    const std::vector<int> to_decode( preload_ids.begin(), preload_ids.end() );
+    std::vector<Mix_Chunk *> decoded( to_decode.size(), nullptr );
+    std::vector<std::string> errors( to_decode.size() );
+    thread_pool::parallel_for( 0, to_decode.size(), thread_pool::worker_count() + 1,
+    [&]( const int i ) {
+        decoded[i] = decode_chunk( resource_path( sfx_resources.resource[to_decode[i]] ),
+                                   errors[i] );
+    } );
+    for( size_t i = 0; i < to_decode.size(); ++i ) {
+        sound_effect_resource &resource = sfx_resources.resource[to_decode[i]];
+        if( resource.chunk ) {
+            sfx_lru_bytes -= resource.chunk->alen;
+            sfx_lru.erase( resource.lru_pos );
+        }
+        resource.chunk.reset( finish_chunk( decoded[i], resource_path( resource ), errors[i] ) );
+        resource.pinned = true;
+    }
 
     // Memory of unique_paths no longer required, swap with locally scoped unordered_map
     // to force deallocation of resources.
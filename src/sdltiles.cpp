@@ -20,6 +20,7 @@
 #include <map>
 #include <set>
 #include <type_traits>
+#include <unordered_map>
 #include <tuple>
 
 #if defined(_MSC_VER) && defined(USE_VCPKG)
@@ -153,18 +154,30 @@ class CachedTTFFont : public Font
             std::string   codepoints;
             unsigned char color;
 
-            // Operator overload required to use in std::map.
-            bool operator<( const key_t &rhs ) const noexcept {
-                return ( color == rhs.color ) ? codepoints < rhs.codepoints : color < rhs.color;
+            bool operator==( const key_t &rhs ) const noexcept {
+                return color == rhs.color && codepoints == rhs.codepoints;
+            }
+        };
+
+        struct key_hash {
+            size_t operator()( const key_t &k ) const noexcept {
+                return std::hash<std::string>()( k.codepoints ) * 16 + k.color;
             }
         };
 
         struct cached_t {
             SDL_Texture_Ptr texture;
             int          width;
+            bool         created = false;
         };
 
-        std::map<key_t, cached_t> glyph_cache_map;
+        const cached_t &get_glyph( const std::string &ch, unsigned char color );
+
+        // Nearly all cells hold a single ASCII character, those are looked up by
+        // (character, color) without hashing the string.
+        static constexpr int ascii_glyph_count = 128;
+        std::array<cached_t, ascii_glyph_count * 16> ascii_glyphs;
+        std::unordered_map<key_t, cached_t, key_hash> glyph_cache_map;
 
         const bool fontblending;
 };
@@ -447,6 +460,13 @@ static void WinCreate()
     bool software_renderer = get_option<bool>( "SOFTWARE_RENDERING" );
 #endif
 
+#if defined(SDL_HINT_RENDER_BATCHING)
+    // SDL (2.0.10 and later) can queue the thousands of sprite copies per frame and submit
+    // them to the GPU in a few batches, but it turns that off when a specific render driver is
+    // requested, as we do above. All drawing goes through the SDL render API, so it is safe.
+    SDL_SetHint( SDL_HINT_RENDER_BATCHING, "1" );
+#endif
+
     if( !software_renderer ) {
         dbg( D_INFO ) << "Attempting to initialize accelerated SDL renderer.";
 
@@ -654,20 +674,28 @@ SDL_Texture_Ptr CachedTTFFont::create_glyph( const std::string &ch, const int co
     return CreateTextureFromSurface( renderer, sglyph );
 }
 
+const CachedTTFFont::cached_t &CachedTTFFont::get_glyph( const std::string &ch,
+        const unsigned char color )
+{
+    cached_t *entry = nullptr;
+    if( ch.size() == 1 && static_cast<unsigned char>( ch[0] ) < ascii_glyph_count ) {
+        entry = &ascii_glyphs[color * ascii_glyph_count + static_cast<unsigned char>( ch[0] )];
+    } else {
+        key_t key {ch, color};
+        entry = &glyph_cache_map[std::move( key )];
+    }
+    if( !entry->created ) {
+        entry->texture = create_glyph( ch, color );
+        entry->width = static_cast<int>( fontwidth * utf8_wrapper( ch ).display_width() );
+        entry->created = true;
+    }
+    return *entry;
+}
+
 void CachedTTFFont::OutputChar( const std::string &ch, const int x, const int y,
                                 const unsigned char color )
 {
-    key_t    key {ch, static_cast<unsigned char>( color & 0xf )};
-
-    auto it = glyph_cache_map.find( key );
-    if( it == std::end( glyph_cache_map ) ) {
-        cached_t new_entry {
-            create_glyph( key.codepoints, key.color ),
-            static_cast<int>( fontwidth * utf8_wrapper( key.codepoints ).display_width() )
-        };
-        it = glyph_cache_map.insert( std::make_pair( std::move( key ), std::move( new_entry ) ) ).first;
-    }
-    const cached_t &value = it->second;
+    const cached_t &value = get_glyph( ch, static_cast<unsigned char>( color & 0xf ) );
 
     if( !value.texture ) {
         // Nothing we can do here )-:
@@ -1244,6 +1272,11 @@ bool Font::draw_window( const catacurses::window &w, const int offsetx, const in
     // TODO: Get this from UTF system to make sure it is exactly the kind of space we need
     static const std::string space_string = " ";
 
+    const bool ascii_lines_option = get_option<bool>( "USE_DRAW_ASCII_LINES_ROUTINE" );
+
+    // Only true if a cell differed from the framebuffer. Windows are usually erased and
+    // rewritten completely, which touches every line, but a redraw that reproduces the
+    // same text must not cause the whole screen to be presented again.
     bool update = false;
     for( int j = 0; j < win->height; j++ ) {
         if( !win->line[j].touched ) {
@@ -1256,7 +1289,6 @@ bool Font::draw_window( const catacurses::window &w, const int offsetx, const in
             break;
         }
 
-        update = true;
         win->line[j].touched = false;
         for( int i = 0; i < win->width; i++ ) {
             const int fbx = win->pos.x + i;
@@ -1282,6 +1314,7 @@ bool Font::draw_window( const catacurses::window &w, const int offsetx, const in
                 continue;
             }
             oldcell = cell;
+            update = true;
 
             if( cell.ch.empty() ) {
                 continue; // second cell of a multi-cell character
@@ -1292,15 +1325,21 @@ bool Font::draw_window( const catacurses::window &w, const int offsetx, const in
                 FillRectDIB( drawx, drawy, fontwidth, fontheight, cell.BG );
                 continue;
             }
-            const int codepoint = UTF8_getch( cell.ch );
             const catacurses::base_color FG = cell.FG;
             const catacurses::base_color BG = cell.BG;
+            if( cell.ch.size() == 1 && cell.ch[0] >= ' ' && cell.ch[0] <= '~' ) {
+                // Printable ASCII needs neither decoding nor a width lookup
+                FillRectDIB( drawx, drawy, fontwidth, fontheight, BG );
+                OutputChar( cell.ch, drawx, drawy, FG );
+                continue;
+            }
+            const int codepoint = UTF8_getch( cell.ch );
             int cw = ( codepoint == UNKNOWN_UNICODE ) ? 1 : utf8_width( cell.ch );
             if( cw < 1 ) {
                 // utf8_width() may return a negative width
                 continue;
             }
-            bool use_draw_ascii_lines_routine = get_option<bool>( "USE_DRAW_ASCII_LINES_ROUTINE" );
+            bool use_draw_ascii_lines_routine = ascii_lines_option;
             unsigned char uc = static_cast<unsigned char>( cell.ch[0] );
             switch( codepoint ) {
                 case LINE_XOXO_UNICODE:
@@ -2797,6 +2836,16 @@ static void CheckMessages()
                         break;
                 }
                 break;
+            case SDL_RENDER_TARGETS_RESET:
+#if SDL_VERSION_ATLEAST( 2, 0, 4 )
+            case SDL_RENDER_DEVICE_RESET:
+#endif
+                // What was drawn to textures is lost, the cached frames as well
+                if( tilecontext ) {
+                    tilecontext->on_render_targets_reset();
+                }
+                needupdate = true;
+                break;
             case SDL_KEYDOWN: {
 #if defined(__ANDROID__)
                 // Toggle virtual keyboard with Android back button. For some reason I get double inputs, so ignore everything once it's already down.
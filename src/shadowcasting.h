@@ -100,6 +100,17 @@ inline float accumulate_transparency( const float &cumulative_transparency,
     return ( ( distance - 1 ) * cumulative_transparency + current_transparency ) / distance;
 }
 
+// Overmap sight, see game::update_overmap_seen. The input is the see cost of each overmap
+// terrain, the result the sight points left on reaching a tile, before paying for that tile.
+inline float overmap_sight_calc( const float &numerator, const float &cost, const int &distance )
+{
+    return numerator - cost * ( distance - 1 );
+}
+inline bool overmap_sight_check( const float &/*cost*/, const float &sight_points )
+{
+    return sight_points >= 0;
+}
+
 template<typename T, typename Out, T( *calc )( const T &, const T &, const int & ),
          bool( *check )( const T &, const T & ),
          void( *update_output )( Out &, const T &, quadrant ),
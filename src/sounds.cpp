@@ -9,6 +9,7 @@
 #include <set>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 
 #include "avatar.h"
 #include "coordinate_conversions.h"
@@ -28,6 +29,7 @@
 #include "player.h"
 #include "string_formatter.h"
 #include "translations.h"
+#include "turn_profile.h"
 #include "weather.h"
 #include "bodypart.h"
 #include "calendar.h"
@@ -54,6 +56,7 @@
 #   if defined(_WIN32) && !defined(_MSC_VER)
 #       include "mingw.thread.h"
 #   endif
+#   include "thread_pool.h"
 #endif
 
 #define dbg(x) DebugLog((x),D_SDL) << __FILE__ << ":" << __LINE__ << ": "
@@ -166,6 +169,7 @@ static std::vector<centroid> cluster_sounds( std::vector<std::pair<tripoint, int
     std::vector<centroid> sound_clusters;
     const int num_seed_clusters = std::max( std::min( recent_sounds.size(), static_cast<size_t>( 10 ) ),
                                             static_cast<size_t>( log( recent_sounds.size() ) ) );
+    sound_clusters.reserve( num_seed_clusters );
     const size_t stopping_point = recent_sounds.size() - num_seed_clusters;
     const size_t max_map_distance = rl_dist( point_zero, point( MAPSIZE_X, MAPSIZE_Y ) );
     // Randomly choose cluster seeds.
@@ -239,8 +243,36 @@ static int get_signal_for_hordes( const centroid &centr )
 
 void sounds::process_sounds()
 {
-    std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
+    turn_profile::phase timer( "sounds" );
+    // The sounds are dropped at the end anyway, so hand them over instead of copying.
+    std::vector<centroid> sound_clusters = cluster_sounds( std::move( recent_sounds ) );
     const int weather_vol = weather::sound_attn( g->weather.weather );
+
+    // Bucket the monsters by submap once, so each sound only looks at the monsters
+    // in submaps it can reach instead of at every monster in the reality bubble.
+    // This runs every turn; the buffers are kept so their storage is reused.
+    static std::vector<monster *> monsters;
+    static std::vector<std::vector<size_t>> monster_buckets( MAPSIZE * MAPSIZE );
+    // Monsters outside the map bounds are checked for every sound, like before.
+    static std::vector<size_t> unbucketed_monsters;
+    static std::vector<size_t> listeners;
+    monsters.clear();
+    for( std::vector<size_t> &bucket : monster_buckets ) {
+        bucket.clear();
+    }
+    unbucketed_monsters.clear();
+    if( !sound_clusters.empty() ) {
+        for( monster &critter : g->all_monsters() ) {
+            const point sm = ms_to_sm_copy( critter.pos().xy() );
+            if( sm.x >= 0 && sm.x < MAPSIZE && sm.y >= 0 && sm.y < MAPSIZE ) {
+                monster_buckets[sm.x + sm.y * MAPSIZE].push_back( monsters.size() );
+            } else {
+                unbucketed_monsters.push_back( monsters.size() );
+            }
+            monsters.push_back( &critter );
+        }
+    }
+
     for( const auto &this_centroid : sound_clusters ) {
         // Since monsters don't go deaf ATM we can just use the weather modified volume
         // If they later get physical effects from loud noises we'll have to change this
@@ -258,11 +290,26 @@ void sounds::process_sounds()
             overmap_buffer.signal_hordes( target, sig_power );
         }
         // Alert all monsters (that can hear) to the sound.
-        for( monster &critter : g->all_monsters() ) {
+        // Exclude monsters that certainly won't hear the sound
+        if( vol * 2 <= 0 ) {
+            continue;
+        }
+        const point sm_min = ms_to_sm_copy( source.xy() - point( vol * 2, vol * 2 ) );
+        const point sm_max = ms_to_sm_copy( source.xy() + point( vol * 2, vol * 2 ) );
+        listeners = unbucketed_monsters;
+        for( int y = std::max( sm_min.y, 0 ); y <= std::min( sm_max.y, MAPSIZE - 1 ); ++y ) {
+            for( int x = std::max( sm_min.x, 0 ); x <= std::min( sm_max.x, MAPSIZE - 1 ); ++x ) {
+                const std::vector<size_t> &bucket = monster_buckets[x + y * MAPSIZE];
+                listeners.insert( listeners.end(), bucket.begin(), bucket.end() );
+            }
+        }
+        // Keep the monster list order, they may react to what they hear in turn
+        std::sort( listeners.begin(), listeners.end() );
+        for( const size_t index : listeners ) {
+            monster &critter = *monsters[index];
             // TODO: Generalize this to Creature::hear_sound
             const int dist = rl_dist( source, critter.pos() );
             if( vol * 2 > dist ) {
-                // Exclude monsters that certainly won't hear the sound
                 critter.hear_sound( source, vol, dist );
             }
         }
@@ -959,11 +1006,7 @@ void sfx::generate_melee_sound( const tripoint &source, const tripoint &target,
                                 bool targ_mon,
                                 const std::string &material )
 {
-    // If creating a new thread for each invocation is to much, we have to consider a thread
-    // pool or maybe a single thread that works continuously, but that requires a queue or similar
-    // to coordinate its work.
-    std::thread the_thread( sound_thread( source, target, hit, targ_mon, material ) );
-    the_thread.detach();
+    thread_pool::run_detached( sound_thread( source, target, hit, targ_mon, material ) );
 }
 
 sfx::sound_thread::sound_thread( const tripoint &source, const tripoint &target, const bool hit,
@@ -0,0 +1,164 @@
+#include "startup_trace.h"
+
+#include <fstream>
+#include <map>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+#include "cata_utility.h"
+#include "debug.h"
+#include "json.h"
+#include "string_formatter.h"
+
+namespace
+{
+
+using trace_clock = std::chrono::steady_clock;
+
+struct trace_event {
+    std::string name;
+    std::string category;
+    trace_clock::time_point start;
+    trace_clock::duration duration = trace_clock::duration::zero();
+    size_t bytes = 0;
+    long peak_memory_kb = 0;
+    // type -> total time and number of objects
+    std::map<std::string, std::pair<trace_clock::duration, int>> types;
+};
+
+struct trace_state {
+    std::string path;
+    trace_clock::time_point epoch;
+    std::vector<trace_event> events;
+    // Indices into events of the scopes that are still open, innermost last
+    std::vector<size_t> open;
+};
+
+trace_state *state = nullptr;
+
+long peak_memory_kb()
+{
+#if defined(_WIN32)
+    return 0;
+#else
+    rusage usage;
+    if( getrusage( RUSAGE_SELF, &usage ) != 0 ) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    // Reported in bytes instead of kilobytes there
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+long long to_microseconds( const trace_clock::duration &d )
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>( d ).count();
+}
+
+} // namespace
+
+namespace startup_trace
+{
+
+void enable( const std::string &path )
+{
+    static trace_state the_state;
+    the_state.path = path;
+    the_state.epoch = trace_clock::now();
+    state = &the_state;
+}
+
+bool enabled()
+{
+    return state != nullptr;
+}
+
+void write()
+{
+    if( !state ) {
+        return;
+    }
+    const bool written = write_to_file( state->path, []( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        jsout.start_object();
+        jsout.member( "traceEvents" );
+        jsout.start_array();
+        for( const trace_event &ev : state->events ) {
+            jsout.start_object();
+            jsout.member( "name", ev.name );
+            jsout.member( "cat", ev.category );
+            jsout.member( "ph", "X" );
+            jsout.member( "pid", 1 );
+            jsout.member( "tid", 1 );
+            jsout.member( "ts", to_microseconds( ev.start - state->epoch ) );
+            jsout.member( "dur", to_microseconds( ev.duration ) );
+            jsout.member( "args" );
+            jsout.start_object();
+            if( ev.bytes ) {
+                jsout.member( "json_bytes", ev.bytes );
+            }
+            jsout.member( "peak_memory_kb", ev.peak_memory_kb );
+            for( const auto &type : ev.types ) {
+                jsout.member( type.first, string_format( "%d objects, %.3f ms", type.second.second,
+                              to_microseconds( type.second.first ) / 1000.0 ) );
+            }
+            jsout.end_object();
+            jsout.end_object();
+        }
+        jsout.end_array();
+        jsout.end_object();
+    }, nullptr );
+    if( !written ) {
+        DebugLog( D_WARNING, DC_ALL ) << "Could not write the startup trace to " << state->path;
+    }
+}
+
+void add_bytes( const size_t bytes )
+{
+    if( state && !state->open.empty() ) {
+        state->events[state->open.back()].bytes += bytes;
+    }
+}
+
+void add_type_time( const std::string &type, const std::chrono::steady_clock::duration time )
+{
+    if( state && !state->open.empty() ) {
+        auto &entry = state->events[state->open.back()].types[type];
+        entry.first += time;
+        ++entry.second;
+    }
+}
+
+scope::scope( const std::string &name, const char *category ) : recording( state != nullptr )
+{
+    if( !recording ) {
+        return;
+    }
+    trace_event ev;
+    ev.name = name;
+    ev.category = category;
+    ev.start = trace_clock::now();
+    state->open.push_back( state->events.size() );
+    state->events.push_back( std::move( ev ) );
+}
+
+scope::~scope()
+{
+    if( !recording || !state || state->open.empty() ) {
+        return;
+    }
+    trace_event &ev = state->events[state->open.back()];
+    state->open.pop_back();
+    ev.duration = trace_clock::now() - ev.start;
+    ev.peak_memory_kb = peak_memory_kb();
+}
+
+} // namespace startup_trace
@@ -0,0 +1,45 @@
+#pragma once
+#ifndef STARTUP_TRACE_H
+#define STARTUP_TRACE_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/**
+ * Optional record of where the time goes while the game data loads, enabled with
+ * the --startup-trace command line flag. It is written in the Chrome trace event
+ * format, which chrome://tracing and Perfetto can display.
+ *
+ * Nothing is recorded (and everything here is cheap) unless it is enabled.
+ */
+namespace startup_trace
+{
+
+void enable( const std::string &path );
+bool enabled();
+/** Writes everything recorded so far to the file given to @ref enable. */
+void write();
+
+/** Adds JSON bytes read to the innermost open scope. */
+void add_bytes( size_t bytes );
+/** Adds the time spent loading one object of the given type to the innermost open scope. */
+void add_type_time( const std::string &type, std::chrono::steady_clock::duration time );
+
+/** Records the time from construction to destruction as one event. */
+class scope
+{
+    public:
+        scope( const std::string &name, const char *category );
+        ~scope();
+
+        scope( const scope & ) = delete;
+        scope &operator=( const scope & ) = delete;
+
+    private:
+        bool recording;
+};
+
+} // namespace startup_trace
+
+#endif
@@ -0,0 +1,204 @@
+#include "stress_scenario.h"
+
+#include <array>
+#include <memory>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "field.h"
+#include "game.h"
+#include "item.h"
+#include "line.h"
+#include "map.h"
+#include "mapdata.h"
+#include "monster.h"
+#include "npc.h"
+#include "overmapbuffer.h"
+#include "point.h"
+#include "rng.h"
+#include "type_id.h"
+#include "vehicle.h"
+
+static const mtype_id mon_zombie( "mon_zombie" );
+static const vproto_id vehicle_car( "car" );
+
+namespace stress_scenario
+{
+
+std::vector<std::string> names()
+{
+    return { "horde_night", "burning_city", "convoy", "mega_base" };
+}
+
+bool setup( const std::string &name, const unsigned int seed )
+{
+    rng_set_engine_seed( seed );
+    const tripoint center = g->u.pos();
+    if( name == "horde_night" ) {
+        horde_night( center );
+    } else if( name == "burning_city" ) {
+        burning_city( center );
+    } else if( name == "convoy" ) {
+        convoy( center );
+    } else if( name == "mega_base" ) {
+        mega_base( center );
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void horde_night( const tripoint &center )
+{
+    calendar::turn += 1_days - time_past_midnight( calendar::turn );
+
+    constexpr int horde_size = 300;
+    int placed = 0;
+    for( int attempt = 0; placed < horde_size && attempt < horde_size * 20; ++attempt ) {
+        const tripoint p = center + point( rng( -55, 55 ), rng( -55, 55 ) );
+        if( rl_dist( center, p ) < 20 || !g->m.inbounds( p ) || !g->m.passable( p ) ||
+            g->critter_at( p ) != nullptr ) {
+            continue;
+        }
+        if( monster *const zed = g->summon_mon( mon_zombie, p ) ) {
+            zed->wander_to( center, 100 );
+            ++placed;
+        }
+    }
+}
+
+void burning_city( const tripoint &center )
+{
+    // Three by three houses of 10x10 tiles, with a street of two tiles between them
+    constexpr int house_size = 10;
+    constexpr int street = 2;
+    const tripoint block_origin = center + point( 6, -( 3 * ( house_size + street ) ) / 2 );
+    const std::array<furn_id, 5> furniture = {{ f_bookcase, f_table, f_chair, f_bed, f_dresser }};
+
+    for( int hx = 0; hx < 3; ++hx ) {
+        for( int hy = 0; hy < 3; ++hy ) {
+            const tripoint house = block_origin + point( hx * ( house_size + street ),
+                                   hy * ( house_size + street ) );
+            for( int dx = -street; dx < house_size; ++dx ) {
+                for( int dy = -street; dy < house_size; ++dy ) {
+                    const tripoint p = house + point( dx, dy );
+                    if( !g->m.inbounds( p ) ) {
+                        continue;
+                    }
+                    g->m.furn_set( p, f_null );
+                    g->m.i_clear( p );
+                    if( dx < 0 || dy < 0 ) {
+                        g->m.ter_set( p, t_pavement );
+                    } else if( dx == 0 || dy == 0 || dx == house_size - 1 || dy == house_size - 1 ) {
+                        const bool middle_x = dx == house_size / 2;
+                        const bool middle_y = dy == house_size / 2;
+                        if( middle_x && dy == house_size - 1 ) {
+                            g->m.ter_set( p, t_door_c );
+                        } else if( middle_x || middle_y ) {
+                            g->m.ter_set( p, t_window );
+                        } else {
+                            g->m.ter_set( p, t_wall_wood );
+                        }
+                    } else {
+                        g->m.ter_set( p, t_floor );
+                        if( ( dx + dy ) % 3 == 0 ) {
+                            g->m.furn_set( p, furniture[( dx * 7 + dy ) % furniture.size()] );
+                        }
+                    }
+                }
+            }
+            // Most houses are burning, some are only filling with smoke from the others
+            if( !one_in( 4 ) ) {
+                for( int i = 0; i < 2; ++i ) {
+                    const tripoint p = house + point( rng( 1, house_size - 2 ), rng( 1, house_size - 2 ) );
+                    g->m.add_field( p, fd_fire, 3 );
+                }
+            }
+            for( int i = 0; i < 5; ++i ) {
+                const tripoint p = house + point( rng( -street, house_size - 1 ),
+                                                  rng( -street, house_size - 1 ) );
+                g->m.add_field( p, fd_smoke, rng( 1, 3 ) );
+            }
+        }
+    }
+}
+
+void convoy( const tripoint &center )
+{
+    constexpr int lanes = 10;
+    constexpr int lane_width = 5;
+    // About 20 mph
+    constexpr int speed = 2000;
+    const int start_x = center.x - 45;
+    for( int lane = 0; lane < lanes; ++lane ) {
+        const int y = center.y + 6 + lane * lane_width;
+        for( int x = start_x - 5; x < MAPSIZE_X; ++x ) {
+            for( int dy = -lane_width / 2; dy <= lane_width / 2; ++dy ) {
+                const tripoint p( x, y + dy, center.z );
+                if( g->m.inbounds( p ) ) {
+                    g->m.furn_set( p, f_null );
+                    g->m.ter_set( p, t_pavement );
+                }
+            }
+        }
+    }
+    for( int lane = 0; lane < lanes; ++lane ) {
+        const tripoint p( start_x, center.y + 6 + lane * lane_width, center.z );
+        vehicle *const veh = g->m.add_vehicle( vehicle_car, p, 0, 100, 0 );
+        if( veh == nullptr ) {
+            continue;
+        }
+        veh->engine_on = true;
+        veh->cruise_velocity = speed;
+        veh->velocity = speed;
+    }
+}
+
+void mega_base( const tripoint &center )
+{
+    constexpr int room_size = 25;
+    constexpr int item_count = 50000;
+    const tripoint room = center + point( -12 - room_size, -room_size / 2 );
+    const std::array<itype_id, 6> stock = {{ "2x4", "rock", "hammer", "tshirt", "jeans", "can_beans" }};
+
+    std::vector<tripoint> floor;
+    for( int dx = -1; dx <= room_size; ++dx ) {
+        for( int dy = -1; dy <= room_size; ++dy ) {
+            const tripoint p = room + point( dx, dy );
+            if( !g->m.inbounds( p ) ) {
+                continue;
+            }
+            g->m.furn_set( p, f_null );
+            g->m.i_clear( p );
+            if( dx < 0 || dy < 0 || dx == room_size || dy == room_size ) {
+                g->m.ter_set( p, dx == room_size && dy == room_size / 2 ? t_door_c : t_concrete_wall );
+            } else {
+                g->m.ter_set( p, t_floor );
+                floor.push_back( p );
+            }
+        }
+    }
+    if( floor.empty() ) {
+        return;
+    }
+    for( int i = 0; i < item_count; ++i ) {
+        g->m.add_item( floor[i % floor.size()], item( random_entry( stock ), calendar::turn ) );
+    }
+
+    constexpr int npc_count = 20;
+    for( int i = 0; i < npc_count; ++i ) {
+        // Half of them inside the storeroom, half outside its door
+        const tripoint p = i % 2 == 0 ? random_entry( floor ) :
+                           room + point( room_size + rng( 1, 6 ), rng( 0, room_size - 1 ) );
+        std::shared_ptr<npc> guy = std::make_shared<npc>();
+        guy->normalize();
+        guy->randomize();
+        guy->spawn_at_precise( { g->get_levx(), g->get_levy() }, p );
+        guy->mission = NPC_MISSION_NULL;
+        guy->set_fac( faction_id( "no_faction" ) );
+        overmap_buffer.insert_npc( guy );
+    }
+    g->load_npcs();
+}
+
+} // namespace stress_scenario
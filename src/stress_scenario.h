@@ -0,0 +1,41 @@
+#pragma once
+#ifndef STRESS_SCENARIO_H
+#define STRESS_SCENARIO_H
+
+#include <string>
+#include <vector>
+
+struct tripoint;
+
+/**
+ * Canned worst case loads for measuring the simulation: a horde converging at night, a burning
+ * city block, a moving convoy and a crowded base. They are set up in the reality bubble around
+ * a point, usually the avatar, replacing whatever terrain was there.
+ *
+ * With the same seed a scenario places exactly the same things, so timings of two builds can be
+ * compared. The tests and the --benchmark-scenario command line flag use them.
+ */
+namespace stress_scenario
+{
+
+/** Names of all scenarios, in the order they are documented here. */
+std::vector<std::string> names();
+
+/**
+ * Seeds the random number generator and sets up the named scenario around the avatar.
+ * @return false if there is no scenario of that name.
+ */
+bool setup( const std::string &name, unsigned int seed );
+
+/** 300 zombies spread over a ring around center, at midnight, all heading for center. */
+void horde_night( const tripoint &center );
+/** A block of wooden houses full of furniture east of center, several of them on fire. */
+void burning_city( const tripoint &center );
+/** Ten cars rolling east at speed in parallel lanes south of center. */
+void convoy( const tripoint &center );
+/** A storeroom of 50000 items west of center and 20 NPCs around it. */
+void mega_base( const tripoint &center );
+
+} // namespace stress_scenario
+
+#endif
@@ -2,6 +2,8 @@
 #ifndef STRING_ID_H
 #define STRING_ID_H
 
+#include <cstddef>
+#include <functional>
 #include <string>
 #include <type_traits>
 
@@ -55,14 +57,15 @@ class string_id
         // a std::string, otherwise a "no matching function to call..." error is generated.
         template<typename S, class = typename
                  std::enable_if< std::is_convertible<S, std::string >::value>::type >
-        explicit string_id( S && id, int cid = -1 ) : _id( std::forward<S>( id ) ), _cid( cid ) {
+        explicit string_id( S && id, int cid = -1 ) : _id( std::forward<S>( id ) ), _cid( cid ),
+            _hash( std::hash<std::string>()( _id ) ) {
         }
         /**
          * Default constructor constructs an empty id string.
          * Note that this id class does not enforce empty id strings (or any specific string at all)
          * to be special. Every string (including the empty one) may be a valid id.
          */
-        string_id() : _cid( -1 ) {}
+        string_id() : _cid( -1 ), _hash( std::hash<std::string>()( _id ) ) {}
         /**
          * Comparison, only useful when the id is used in std::map or std::set as key. Compares
          * the string id as with the strings comparison.
@@ -71,16 +74,17 @@ class string_id
             return _id < rhs._id;
         }
         /**
-         * The usual comparator, compares the string id as usual.
+         * The usual comparator, compares the string id as usual. Ids whose hashes differ are
+         * told apart without looking at the strings.
          */
         bool operator==( const This &rhs ) const {
-            return _id == rhs._id;
+            return _hash == rhs._hash && _id == rhs._id;
         }
         /**
          * The usual comparator, compares the string id as usual.
          */
         bool operator!=( const This &rhs ) const {
-            return _id != rhs._id;
+            return !operator==( rhs );
         }
         /**
          * The unusual comparator, compares the string id to char *
@@ -191,19 +195,28 @@ class string_id
         int_id<T> get_cid() const {
             return int_id<T>( _cid );
         }
+        /**
+         * Returns the hash of the id string. It is computed on construction and kept, so ids
+         * that are looked up repeatedly (static ids, map keys being copied) hash only once.
+         * Not filled in lazily, so ids shared between threads are never written to by a lookup.
+         */
+        std::size_t hash() const {
+            return _hash;
+        }
 
     private:
         std::string _id;
         mutable int _cid;
+        std::size_t _hash;
 };
 
-// Support hashing of string based ids by forwarding the hash of the string.
+// Support hashing of string based ids by forwarding the (cached) hash of the string.
 namespace std
 {
 template<typename T>
 struct hash< string_id<T> > {
     std::size_t operator()( const string_id<T> &v ) const {
-        return hash<std::string>()( v.str() );
+        return v.hash();
     }
 };
 } // namespace std
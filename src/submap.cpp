@@ -15,10 +15,12 @@ void maptile_soa<sx, sy>::swap_soa_tile( const point &p1, const point &p2 )
     std::swap( ter[p1.x][p1.y], ter[p2.x][p2.y] );
     std::swap( frn[p1.x][p1.y], frn[p2.x][p2.y] );
     std::swap( lum[p1.x][p1.y], lum[p2.x][p2.y] );
-    std::swap( itm[p1.x][p1.y], itm[p2.x][p2.y] );
-    std::swap( fld[p1.x][p1.y], fld[p2.x][p2.y] );
+    itm.swap_tile( p1, itm, p2 );
+    fld.swap_tile( p1, fld, p2 );
     std::swap( trp[p1.x][p1.y], trp[p2.x][p2.y] );
-    std::swap( rad[p1.x][p1.y], rad[p2.x][p2.y] );
+    const int rad1 = rad.get( p1 );
+    rad.set( p1, rad.get( p2 ) );
+    rad.set( p2, rad1 );
 }
 
 template<int sx, int sy>
@@ -27,10 +29,12 @@ void maptile_soa<sx, sy>::swap_soa_tile( const point &p, maptile_soa<1, 1> &othe
     std::swap( ter[p.x][p.y], **other.ter );
     std::swap( frn[p.x][p.y], **other.frn );
     std::swap( lum[p.x][p.y], **other.lum );
-    std::swap( itm[p.x][p.y], **other.itm );
-    std::swap( fld[p.x][p.y], **other.fld );
+    itm.swap_tile( p, other.itm, point_zero );
+    fld.swap_tile( p, other.fld, point_zero );
     std::swap( trp[p.x][p.y], **other.trp );
-    std::swap( rad[p.x][p.y], **other.rad );
+    const int rad1 = rad.get( p );
+    rad.set( p, other.rad.get( point_zero ) );
+    other.rad.set( point_zero, rad1 );
 }
 
 submap::submap()
@@ -41,9 +45,10 @@ submap::submap()
     std::uninitialized_fill_n( &frn[0][0], elements, f_null );
     std::uninitialized_fill_n( &lum[0][0], elements, 0 );
     std::uninitialized_fill_n( &trp[0][0], elements, tr_null );
-    std::uninitialized_fill_n( &rad[0][0], elements, 0 );
 
     is_uniform = false;
+
+    modified = true;
 }
 
 static const std::string COSMETICS_GRAFFITI( "GRAFFITI" );
@@ -90,6 +95,7 @@ const std::string &submap::get_graffiti( const point &p ) const
 void submap::set_graffiti( const point &p, const std::string &new_graffiti )
 {
     is_uniform = false;
+    modified = true;
     // Find signage at p if available
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
     if( fresult.result ) {
@@ -102,6 +108,7 @@ void submap::set_graffiti( const point &p, const std::string &new_graffiti )
 void submap::delete_graffiti( const point &p )
 {
     is_uniform = false;
+    modified = true;
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
     if( fresult.result ) {
         cosmetics[ fresult.ndx ] = cosmetics.back();
@@ -130,6 +137,7 @@ std::string submap::get_signage( const point &p ) const
 void submap::set_signage( const point &p, const std::string &s )
 {
     is_uniform = false;
+    modified = true;
     // Find signage at p if available
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
     if( fresult.result ) {
@@ -141,6 +149,7 @@ void submap::set_signage( const point &p, const std::string &s )
 void submap::delete_signage( const point &p )
 {
     is_uniform = false;
+    modified = true;
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
     if( fresult.result ) {
         cosmetics[ fresult.ndx ] = cosmetics.back();
@@ -195,6 +204,7 @@ computer *submap::get_computer( const point &p )
 
 void submap::set_computer( const point &p, const computer &c )
 {
+    modified = true;
     update_legacy_computer();
     const auto it = computers.find( p );
     if( it != computers.end() ) {
@@ -206,6 +216,7 @@ void submap::set_computer( const point &p, const computer &c )
 
 void submap::delete_computer( const point &p )
 {
+    modified = true;
     update_legacy_computer();
     computers.erase( p );
 }
@@ -220,9 +231,21 @@ bool submap::contains_vehicle( vehicle *veh )
     return match != vehicles.end();
 }
 
+void submap::update_field_tiles()
+{
+    // Reading must not allocate the fields
+    const auto &fields = fld;
+    for( int x = 0; x < SEEX; ++x ) {
+        for( int y = 0; y < SEEY; ++y ) {
+            field_tiles.set( { x, y }, fields[x][y].field_count() > 0 );
+        }
+    }
+}
+
 void submap::rotate( int turns )
 {
     turns = turns % 4;
+    modified = true;
 
     if( turns == 0 ) {
         return;
@@ -247,23 +270,24 @@ void submap::rotate( int turns )
             }
         }
     } else {
-        maptile_soa<1, 1> tmp;
-
+        // Each tile takes part in a 4-cycle p -> r(p) -> r(r(p)) -> r(r(r(p))) -> p.
+        // Swapping the first tile with each of the others in turn moves every tile one step
+        // along the cycle, with three swaps and no temporary tile.
         for( int j = 0, je = SEEY / 2; j < je; ++j ) {
             for( int i = j, ie = SEEX - j - 1; i < ie; ++i ) {
-                auto p = point{ i, j };
-
-                swap_soa_tile( p, tmp );
+                const point first( i, j );
+                point p = first;
 
-                for( int k = 0; k < 4; ++k ) {
+                for( int k = 0; k < 3; ++k ) {
                     p = rotate_point( p );
-                    swap_soa_tile( p, tmp );
+                    swap_soa_tile( first, p );
                 }
             }
         }
     }
 
     active_items.rotate_locations( turns, { SEEX, SEEY } );
+    update_field_tiles();
 
     for( auto &elem : cosmetics ) {
         elem.pos = rotate_point( elem.pos );
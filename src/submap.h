@@ -2,6 +2,7 @@
 #ifndef SUBMAP_H
 #define SUBMAP_H
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -12,6 +13,7 @@
 
 #include "active_item_cache.h"
 #include "basecamp.h"
+#include "bit_grid.h"
 #include "calendar.h"
 #include "colony.h"
 #include "computer.h"
@@ -45,15 +47,88 @@ struct spawn_point {
         mission_id( MIS ), friendly( F ), name( N ) {}
 };
 
+/**
+ * Irradiation of each square of a sx by sy grid. Most grids never see any
+ * radiation, so the levels are only allocated once a square becomes non-zero.
+ */
+template<int sx, int sy>
+class radiation_grid
+{
+    public:
+        int get( const point &p ) const {
+            return levels ? ( *levels )[index( p )] : 0;
+        }
+        /** Returns false if nothing changed. */
+        bool set( const point &p, const int value ) {
+            if( !levels ) {
+                if( value == 0 ) {
+                    return false;
+                }
+                levels.reset( new std::array<int, sx * sy> );
+                levels->fill( 0 );
+            }
+            ( *levels )[index( p )] = value;
+            return true;
+        }
+        /** True if no square has ever been irradiated. */
+        bool empty() const {
+            return !levels;
+        }
+
+    private:
+        static size_t index( const point &p ) {
+            return static_cast<size_t>( p.x ) * sy + static_cast<size_t>( p.y );
+        }
+
+        std::unique_ptr<std::array<int, sx * sy>> levels;
+};
+
+/**
+ * Per square objects of a sx by sy grid that are large even when empty, like item stacks.
+ * Many grids (open air, solid rock, most of the wilderness) never hold any, so the squares
+ * are only allocated on first non-const access. Until then const access sees empty objects.
+ */
+template<typename T, int sx, int sy>
+class lazy_tile_grid
+{
+    public:
+        using column = std::array<T, sy>;
+
+        column &operator[]( const size_t x ) {
+            if( !tiles ) {
+                tiles.reset( new std::array<column, sx> );
+            }
+            return ( *tiles )[x];
+        }
+        const column &operator[]( const size_t x ) const {
+            static const column empty_column{};
+            return tiles ? ( *tiles )[x] : empty_column;
+        }
+        /** False while every square is still the default object. */
+        bool allocated() const {
+            return !!tiles;
+        }
+        /** Swaps the objects on two squares, without allocating if there are none. */
+        template<int ox, int oy>
+        void swap_tile( const point &p, lazy_tile_grid<T, ox, oy> &other, const point &op ) {
+            if( allocated() || other.allocated() ) {
+                std::swap( ( *this )[p.x][p.y], other[op.x][op.y] );
+            }
+        }
+
+    private:
+        std::unique_ptr<std::array<column, sx>> tiles;
+};
+
 template<int sx, int sy>
 struct maptile_soa {
     ter_id             ter[sx][sy];  // Terrain on each square
     furn_id            frn[sx][sy];  // Furniture on each square
     std::uint8_t       lum[sx][sy];  // Number of items emitting light on each square
-    cata::colony<item> itm[sx][sy];  // Items on each square
-    field              fld[sx][sy];  // Field on each square
+    lazy_tile_grid<cata::colony<item>, sx, sy> itm; // Items on each square
+    lazy_tile_grid<field, sx, sy> fld;              // Field on each square
     trap_id            trp[sx][sy];  // Trap on each square
-    int                rad[sx][sy];  // Irradiation of each square
+    radiation_grid<sx, sy> rad;      // Irradiation of each square
 
     void swap_soa_tile( const point &p1, const point &p2 );
     void swap_soa_tile( const point &p, maptile_soa<1, 1> &other );
@@ -70,6 +145,7 @@ class submap : public maptile_soa<SEEX, SEEY>    // TODO: Use private inheritanc
 
         void set_trap( const point &p, trap_id trap ) {
             is_uniform = false;
+            modified = true;
             trp[p.x][p.y] = trap;
         }
 
@@ -79,6 +155,7 @@ class submap : public maptile_soa<SEEX, SEEY>    // TODO: Use private inheritanc
 
         void set_furn( const point &p, furn_id furn ) {
             is_uniform = false;
+            modified = true;
             frn[p.x][p.y] = furn;
         }
 
@@ -88,20 +165,24 @@ class submap : public maptile_soa<SEEX, SEEY>    // TODO: Use private inheritanc
 
         void set_ter( const point &p, ter_id terr ) {
             is_uniform = false;
+            modified = true;
             ter[p.x][p.y] = terr;
         }
 
         int get_radiation( const point &p ) const {
-            return rad[p.x][p.y];
+            return rad.get( p );
         }
 
         void set_radiation( const point &p, const int radiation ) {
-            is_uniform = false;
-            rad[p.x][p.y] = radiation;
+            if( rad.set( p, radiation ) ) {
+                is_uniform = false;
+                modified = true;
+            }
         }
 
         void update_lum_add( const point &p, const item &i ) {
             is_uniform = false;
+            modified = true;
             if( i.is_emissive() && lum[p.x][p.y] < 255 ) {
                 lum[p.x][p.y]++;
             }
@@ -109,6 +190,7 @@ class submap : public maptile_soa<SEEX, SEEY>    // TODO: Use private inheritanc
 
         void update_lum_rem( const point &p, const item &i ) {
             is_uniform = false;
+            modified = true;
             if( !i.is_emissive() ) {
                 return;
             } else if( lum[p.x][p.y] && lum[p.x][p.y] < 255 ) {
@@ -138,6 +220,7 @@ class submap : public maptile_soa<SEEX, SEEY>    // TODO: Use private inheritanc
 
         void insert_cosmetic( const point &p, const std::string &type, const std::string &str ) {
             cosmetic_t ins;
+            modified = true;
 
             ins.pos = p;
             ins.type = type;
@@ -151,6 +234,7 @@ class submap : public maptile_soa<SEEX, SEEY>    // TODO: Use private inheritanc
         }
 
         void set_temperature( int new_temperature ) {
+            modified = true;
             temperature = new_temperature;
         }
 
@@ -186,12 +270,26 @@ class submap : public maptile_soa<SEEX, SEEY>    // TODO: Use private inheritanc
         // If is_uniform is true, this submap is a solid block of terrain
         // Uniform submaps aren't saved/loaded, because regenerating them is faster
         bool is_uniform;
+        /**
+         * False while the submap is known to match what was last loaded from disk, so
+         * mapbuffer::save can skip it. Set by the setters here, and for good by map::setsubmap,
+         * because map code also changes the tile arrays directly.
+         */
+        bool modified = true;
 
         std::vector<cosmetic_t> cosmetics; // Textual "visuals" for squares
 
         active_item_cache active_items;
 
         int field_count = 0;
+        /**
+         * Tiles that may hold fields, so field processing can skip the rest.
+         * Set wherever @ref field_count is increased, cleared by field processing
+         * once a tile is found empty.
+         */
+        bit_grid<SEEX, SEEY> field_tiles;
+        /** Sets @ref field_tiles from the fields actually present. */
+        void update_field_tiles();
         time_point last_touched = calendar::turn_zero;
         std::vector<spawn_point> spawns;
         /**
@@ -256,7 +354,7 @@ struct maptile {
         }
 
         const field &get_field() const {
-            return sm->fld[x][y];
+            return static_cast<const submap *>( sm )->fld[x][y];
         }
 
         field_entry *find_field( const field_type_id field_to_find ) {
@@ -268,6 +366,7 @@ struct maptile {
             const bool ret = sm->fld[x][y].add_field( field_to_add, new_intensity, new_age );
             if( ret ) {
                 sm->field_count++;
+                sm->field_tiles.set( point( x, y ) );
             }
 
             return ret;
@@ -295,12 +394,12 @@ struct maptile {
 
         // For map::draw_maptile
         size_t get_item_count() const {
-            return sm->itm[x][y].size();
+            return static_cast<const submap *>( sm )->itm[x][y].size();
         }
 
         // Assumes there is at least one item
         const item &get_uppermost_item() const {
-            return *std::prev( sm->itm[x][y].cend() );
+            return *std::prev( static_cast<const submap *>( sm )->itm[x][y].cend() );
         }
 };
 
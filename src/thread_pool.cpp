@@ -0,0 +1,292 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+#include "debug.h"
+#include "point.h"
+
+namespace
+{
+
+struct task {
+    std::function<void()> work;
+    // nullptr for detached tasks
+    thread_pool::task_group *group = nullptr;
+    size_t index = 0;
+};
+
+struct task_queue {
+    std::mutex mutex;
+    std::deque<task> tasks;
+};
+
+// Index of the pool thread this is, -1 on any other thread
+thread_local int current_worker = -1;
+
+void run_task( task &t )
+{
+    std::exception_ptr error;
+    try {
+        t.work();
+    } catch( ... ) {
+        error = std::current_exception();
+    }
+    if( t.group != nullptr ) {
+        t.group->finish( t.index, error );
+    } else if( error ) {
+        try {
+            std::rethrow_exception( error );
+        } catch( const std::exception &err ) {
+            DebugLog( D_ERROR, DC_ALL ) << "A background task failed: " << err.what();
+        } catch( ... ) {
+            DebugLog( D_ERROR, DC_ALL ) << "A background task failed";
+        }
+    }
+}
+
+class pool
+{
+    public:
+        explicit pool( const size_t count ) : queues( count ) {
+            for( std::unique_ptr<task_queue> &q : queues ) {
+                q = std::make_unique<task_queue>();
+            }
+            for( size_t i = 0; i < count; ++i ) {
+                threads.emplace_back( [this, i]() {
+                    work( i );
+                } );
+            }
+        }
+
+        ~pool() {
+            {
+                std::lock_guard<std::mutex> lock( sleep_mutex );
+                stopping = true;
+            }
+            wake.notify_all();
+            for( std::thread &t : threads ) {
+                t.join();
+            }
+        }
+
+        size_t size() const {
+            return threads.size();
+        }
+
+        void push( task t ) {
+            // Tasks added by a pool thread are likely to be related to what it is doing
+            const size_t target = current_worker >= 0 ? current_worker :
+                                  next_queue++ % queues.size();
+            {
+                std::lock_guard<std::mutex> lock( queues[target]->mutex );
+                queues[target]->tasks.push_back( std::move( t ) );
+            }
+            {
+                std::lock_guard<std::mutex> lock( sleep_mutex );
+                ++queued;
+            }
+            wake.notify_one();
+        }
+
+        /**
+         * Takes a task that hasn't started, from the own queue first (newest first) and then
+         * from the others (oldest first). If group is set, only one of that group.
+         */
+        bool take( const int self, const thread_pool::task_group *const group, task &out ) {
+            const size_t count = queues.size();
+            const size_t first = self >= 0 ? self : 0;
+            for( size_t n = 0; n < count; ++n ) {
+                task_queue &q = *queues[( first + n ) % count];
+                std::lock_guard<std::mutex> lock( q.mutex );
+                if( q.tasks.empty() ) {
+                    continue;
+                }
+                const bool own = self >= 0 && n == 0;
+                if( group == nullptr ) {
+                    if( own ) {
+                        out = std::move( q.tasks.back() );
+                        q.tasks.pop_back();
+                    } else {
+                        out = std::move( q.tasks.front() );
+                        q.tasks.pop_front();
+                    }
+                } else {
+                    const auto found = std::find_if( q.tasks.begin(), q.tasks.end(),
+                    [group]( const task & t ) {
+                        return t.group == group;
+                    } );
+                    if( found == q.tasks.end() ) {
+                        continue;
+                    }
+                    out = std::move( *found );
+                    q.tasks.erase( found );
+                }
+                --queued;
+                return true;
+            }
+            return false;
+        }
+
+    private:
+        void work( const size_t self ) {
+            current_worker = self;
+            while( true ) {
+                task t;
+                if( take( self, nullptr, t ) ) {
+                    run_task( t );
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock( sleep_mutex );
+                wake.wait( lock, [this]() {
+                    return stopping || queued > 0;
+                } );
+                // Whatever was still queued is run before the pool goes away
+                if( stopping && queued == 0 ) {
+                    return;
+                }
+            }
+        }
+
+        std::vector<std::unique_ptr<task_queue>> queues;
+        std::vector<std::thread> threads;
+        std::atomic<size_t> next_queue{ 0 };
+        // Only increased while sleep_mutex is held, so a thread can't miss a new task
+        std::atomic<int> queued{ 0 };
+        std::mutex sleep_mutex;
+        std::condition_variable wake;
+        bool stopping = false;
+};
+
+pool &get_pool()
+{
+    static pool instance( std::max( std::thread::hardware_concurrency(), 2u ) - 1 );
+    return instance;
+}
+
+} // namespace
+
+namespace thread_pool
+{
+
+size_t worker_count()
+{
+    return get_pool().size();
+}
+
+task_group::~task_group()
+{
+    try {
+        wait();
+    } catch( ... ) {
+        // Whoever wanted the error should have waited
+    }
+}
+
+void task_group::run( std::function<void()> work )
+{
+    task t;
+    t.work = std::move( work );
+    t.group = this;
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        t.index = added++;
+        ++pending;
+    }
+    get_pool().push( std::move( t ) );
+}
+
+void task_group::finish( const size_t index, std::exception_ptr error )
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    if( error && ( !first_error || index < first_error_index ) ) {
+        first_error = error;
+        first_error_index = index;
+    }
+    // Notified while locked, the group may be destroyed as soon as the waiter sees pending at 0
+    if( --pending == 0 ) {
+        finished.notify_all();
+    }
+}
+
+void task_group::wait()
+{
+    task t;
+    while( get_pool().take( current_worker, this, t ) ) {
+        run_task( t );
+    }
+    // Nothing of this group is queued any more, the rest is already running elsewhere
+    std::unique_lock<std::mutex> lock( mutex );
+    finished.wait( lock, [this]() {
+        return pending == 0;
+    } );
+    if( first_error ) {
+        std::exception_ptr error;
+        std::swap( error, first_error );
+        std::rethrow_exception( error );
+    }
+}
+
+void parallel_for( const int begin, const int end, const int max_threads,
+                   const std::function<void( int )> &fn )
+{
+    const int runners = std::min<int>( { end - begin, max_threads,
+                                         static_cast<int>( worker_count() ) + 1
+                                       } );
+    if( runners <= 1 ) {
+        for( int i = begin; i < end; ++i ) {
+            fn( i );
+        }
+        return;
+    }
+    std::atomic<int> next( begin );
+    const auto claim = [&next, end, &fn]() {
+        for( int i = next++; i < end; i = next++ ) {
+            fn( i );
+        }
+    };
+    task_group group;
+    for( int i = 1; i < runners; ++i ) {
+        group.run( claim );
+    }
+    std::exception_ptr error;
+    try {
+        claim();
+    } catch( ... ) {
+        // Stop the other runners from taking more indices
+        error = std::current_exception();
+        next = end;
+    }
+    group.wait();
+    if( error ) {
+        std::rethrow_exception( error );
+    }
+}
+
+void parallel_for( const rectangle &area, const int max_threads,
+                   const std::function<void( const point & )> &fn )
+{
+    parallel_for( area.p_min.y, area.p_max.y, max_threads, [&area, &fn]( const int y ) {
+        for( int x = area.p_min.x; x < area.p_max.x; ++x ) {
+            fn( point( x, y ) );
+        }
+    } );
+}
+
+void run_detached( std::function<void()> work )
+{
+    task t;
+    t.work = std::move( work );
+    get_pool().push( std::move( t ) );
+}
+
+} // namespace thread_pool
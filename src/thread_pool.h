@@ -0,0 +1,81 @@
+#pragma once
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+struct rectangle;
+struct point;
+
+/**
+ * The threads shared by everything that wants to do work in parallel, instead of each caller
+ * starting its own. The pool has one thread less than the hardware has (at least one) and is
+ * started on first use.
+ *
+ * Each thread keeps its own queue of tasks, the tasks a thread adds go to its own queue and an
+ * idle thread takes from the queues of the others. A thread waiting for a @ref task_group
+ * runs the tasks of that group that haven't started yet itself, so groups can be nested and
+ * waiting never needs a free thread. Tasks run in no particular order; anything whose result
+ * has to be the same for every run must write per task results and combine them after the
+ * join, in the order they were added.
+ */
+namespace thread_pool
+{
+
+/** The number of threads in the pool, at least 1. The thread using it comes on top. */
+size_t worker_count();
+
+/**
+ * Tasks that are waited for together. Tasks may only be added by the thread that owns the
+ * group, but they may add tasks to groups of their own.
+ */
+class task_group
+{
+    public:
+        task_group() = default;
+        task_group( const task_group & ) = delete;
+        task_group &operator=( const task_group & ) = delete;
+        /** Waits for the tasks that are still running, their exceptions are dropped. */
+        ~task_group();
+
+        void run( std::function<void()> work );
+        /**
+         * Returns once every task added so far has finished. If any of them threw, the
+         * exception of the one that was added first is rethrown.
+         */
+        void wait();
+
+        /** For the pool: the task with the given index finished, error is set if it threw. */
+        void finish( size_t index, std::exception_ptr error );
+    private:
+        std::mutex mutex;
+        std::condition_variable finished;
+        size_t added = 0;
+        size_t pending = 0;
+        std::exception_ptr first_error;
+        size_t first_error_index = 0;
+};
+
+/**
+ * Calls fn for every index in [begin, end) on up to max_threads threads, the calling thread
+ * being one of them, and returns once all calls are done. Indices are handed out one at a
+ * time, so uneven work balances out. Exceptions are rethrown as with @ref task_group::wait.
+ */
+void parallel_for( int begin, int end, int max_threads, const std::function<void( int )> &fn );
+/** The same for every point of the (half-open) area, the threads take a row at a time. */
+void parallel_for( const rectangle &area, int max_threads,
+                   const std::function<void( const point & )> &fn );
+
+/**
+ * Runs work on the pool without anyone waiting for it, for things like sounds that play out
+ * over time. It must not touch game state that can change meanwhile, exceptions are logged.
+ */
+void run_detached( std::function<void()> work );
+
+} // namespace thread_pool
+
+#endif
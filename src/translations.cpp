@@ -36,6 +36,9 @@ static void reload_names()
 }
 
 static bool sanity_checked_genders = false;
+// Bumped whenever the language changes, so translation objects know their cached
+// lookups are stale. 0 is never current, it marks an empty cache.
+static int language_version = 1;
 
 #if defined(LOCALIZE)
 #include "options.h"
@@ -225,6 +228,7 @@ void set_language()
     reload_names();
 
     sanity_checked_genders = false;
+    ++language_version;
 }
 
 #if defined(MACOSX)
@@ -286,6 +290,7 @@ void select_language()
 void set_language()
 {
     reload_names();
+    ++language_version;
     return;
 }
 
@@ -383,6 +388,7 @@ translation translation::no_translation( const std::string &str )
 
 void translation::deserialize( JsonIn &jsin )
 {
+    cached_language_version = 0;
     if( jsin.test_string() ) {
         ctxt = cata::nullopt;
         raw = jsin.get_string();
@@ -399,15 +405,21 @@ void translation::deserialize( JsonIn &jsin )
     }
 }
 
-std::string translation::translated() const
+const std::string &translation::translated() const
 {
     if( !needs_translation || raw.empty() ) {
         return raw;
-    } else if( !ctxt ) {
-        return _( raw.c_str() );
-    } else {
-        return pgettext( ctxt->c_str(), raw.c_str() );
     }
+    // UI code translates the same names every frame, only look them up once per language
+    if( cached_language_version != language_version ) {
+        if( !ctxt ) {
+            cached_translation = _( raw.c_str() );
+        } else {
+            cached_translation = pgettext( ctxt->c_str(), raw.c_str() );
+        }
+        cached_language_version = language_version;
+    }
+    return cached_translation;
 }
 
 std::string translation::untranslated() const
@@ -139,9 +139,10 @@ class translation
 
         /**
          * Returns raw string if no translation is needed, otherwise returns
-         * the translated string.
+         * the translated string. The reference stays valid until this object
+         * changes or the language does.
          **/
-        std::string translated() const;
+        const std::string &translated() const;
 
         /**
          * Returns the raw string, untranslated.
@@ -178,6 +179,9 @@ class translation
         cata::optional<std::string> ctxt;
         std::string raw;
         bool needs_translation = false;
+        // Result of the last lookup, valid while the language version matches
+        mutable std::string cached_translation;
+        mutable int cached_language_version = 0;
 };
 
 /**
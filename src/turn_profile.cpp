@@ -0,0 +1,484 @@
+#include "turn_profile.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <deque>
+#include <ostream>
+#include <vector>
+
+#include "alloc_profile.h"
+#include "avatar.h"
+#include "calendar.h"
+#include "cata_utility.h"
+#include "debug.h"
+#include "field.h"
+#include "game.h"
+#include "game_constants.h"
+#include "json.h"
+#include "map.h"
+#include "npc.h"
+#include "options.h"
+#include "path_info.h"
+#include "stress_scenario.h"
+#include "string_formatter.h"
+#include "translations.h"
+#include "vehicle.h"
+
+namespace
+{
+
+using profile_clock = std::chrono::steady_clock;
+
+struct phase_entry {
+    const char *name;
+    profile_clock::duration time;
+    int calls;
+    // Only counted in ALLOC_PROFILE builds
+    uint64_t allocations;
+    uint64_t allocated_bytes;
+};
+
+struct phase_event {
+    const char *name;
+    profile_clock::time_point start;
+    profile_clock::duration duration;
+    uint64_t allocations;
+};
+
+struct turn_record {
+    profile_clock::time_point start;
+    profile_clock::duration duration = profile_clock::duration::zero();
+    std::vector<phase_event> events;
+};
+
+// How many of the last turns are kept for the summary and the trace
+constexpr size_t recent_turns = 100;
+
+// The last durations of something that happens over and over, in milliseconds
+class rolling_times
+{
+    public:
+        void add( const double ms ) {
+            if( times.size() < capacity ) {
+                times.push_back( ms );
+            } else {
+                times[next] = ms;
+            }
+            next = ( next + 1 ) % capacity;
+        }
+        const std::vector<double> &values() const {
+            return times;
+        }
+    private:
+        static constexpr size_t capacity = 1000;
+        std::vector<double> times;
+        size_t next = 0;
+};
+
+// Whole turns and frames are always timed, it's two clock reads each
+rolling_times turn_times;
+rolling_times frame_times;
+profile_clock::time_point turn_start;
+// Time of the current turn spent waiting for input, and how many waits are open
+profile_clock::duration turn_waiting = profile_clock::duration::zero();
+int open_waits = 0;
+// Slow turns written this session, to not fill the disk when everything is slow
+int slow_turns_captured = 0;
+constexpr int max_slow_turn_captures = 10;
+
+struct profile_state {
+    // There are only a handful of phases, a linear search beats a map here
+    std::vector<phase_entry> phases;
+    turn_record current;
+    bool in_turn = false;
+    std::deque<turn_record> recent;
+
+    phase_entry &entry( const char *name ) {
+        for( phase_entry &e : phases ) {
+            if( e.name == name || strcmp( e.name, name ) == 0 ) {
+                return e;
+            }
+        }
+        phases.push_back( { name, profile_clock::duration::zero(), 0, 0, 0 } );
+        return phases.back();
+    }
+};
+
+profile_state *state = nullptr;
+
+double to_milliseconds( const profile_clock::duration &d )
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>( d ).count() / 1000.0;
+}
+
+// Writes the turns as the traceEvents member of the Chrome trace format, in an open object
+template<typename Iter>
+void write_trace_events( JsonOut &jsout, const Iter first, const Iter last )
+{
+    const profile_clock::time_point epoch = first->start;
+    const auto microseconds = []( const profile_clock::duration & d ) {
+        return std::chrono::duration_cast<std::chrono::microseconds>( d ).count();
+    };
+    const auto write_event = [&]( const std::string & name, const char *category,
+    const profile_clock::time_point & start, const profile_clock::duration & duration ) {
+        jsout.start_object();
+        jsout.member( "name", name );
+        jsout.member( "cat", category );
+        jsout.member( "ph", "X" );
+        jsout.member( "pid", 1 );
+        jsout.member( "tid", 1 );
+        jsout.member( "ts", microseconds( start - epoch ) );
+        jsout.member( "dur", microseconds( duration ) );
+        jsout.end_object();
+    };
+    jsout.member( "traceEvents" );
+    jsout.start_array();
+    int turn_number = 0;
+    for( Iter turn = first; turn != last; ++turn ) {
+        write_event( string_format( "turn %d", ++turn_number ), "turn", turn->start, turn->duration );
+        for( const phase_event &e : turn->events ) {
+            write_event( e.name, "phase", e.start, e.duration );
+        }
+    }
+    jsout.end_array();
+    jsout.member( "displayTimeUnit", "ms" );
+}
+
+// The trace of one turn and what was going on in the reality bubble
+bool write_slow_turn( const std::string &path, const turn_record &turn, const int threshold )
+{
+    int field_tiles = 0;
+    const int z = g->get_levz();
+    const int mapsize = g->m.getmapsize() * SEEX;
+    for( int x = 0; x < mapsize; ++x ) {
+        for( int y = 0; y < mapsize; ++y ) {
+            field_tiles += g->m.field_at( tripoint( x, y, z ) ).field_count() != 0;
+        }
+    }
+    int vehicles = 0;
+    int moving_vehicles = 0;
+    for( const wrapped_vehicle &veh : g->m.get_vehicles() ) {
+        ++vehicles;
+        moving_vehicles += veh.v->velocity != 0;
+    }
+    const size_t npcs = g->get_npcs_if( []( const npc & ) {
+        return true;
+    } ).size();
+
+    return write_to_file( path, [&]( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        jsout.start_object();
+        jsout.member( "turn", to_turn<int>( calendar::turn ) );
+        jsout.member( "duration_ms", to_milliseconds( turn.duration ) );
+        jsout.member( "threshold_ms", threshold );
+        jsout.member( "world" );
+        jsout.start_object();
+        jsout.member( "monsters", g->num_creatures() );
+        jsout.member( "npcs", npcs );
+        jsout.member( "field_tiles", field_tiles );
+        jsout.member( "vehicles", vehicles );
+        jsout.member( "moving_vehicles", moving_vehicles );
+        jsout.end_object();
+        const turn_record *first = &turn;
+        write_trace_events( jsout, first, first + 1 );
+        jsout.end_object();
+    }, nullptr );
+}
+
+} // namespace
+
+namespace turn_profile
+{
+
+void enable()
+{
+    static profile_state the_state;
+    state = &the_state;
+}
+
+void disable()
+{
+    if( state ) {
+        state->phases.clear();
+        state->recent.clear();
+        state->in_turn = false;
+    }
+    state = nullptr;
+}
+
+bool enabled()
+{
+    return state != nullptr;
+}
+
+void begin_turn()
+{
+    turn_start = profile_clock::now();
+    turn_waiting = profile_clock::duration::zero();
+    // Capturing slow turns needs the phases of every turn, a slow one isn't known in advance
+    if( !state && slow_turns_captured < max_slow_turn_captures &&
+        get_option<int>( "SLOW_TURN_THRESHOLD" ) > 0 ) {
+        enable();
+    }
+    if( !state ) {
+        return;
+    }
+    state->current.events.clear();
+    state->current.start = turn_start;
+    state->in_turn = true;
+}
+
+void end_turn()
+{
+    const profile_clock::duration duration = profile_clock::now() - turn_start - turn_waiting;
+    turn_times.add( to_milliseconds( duration ) );
+    if( !state || !state->in_turn ) {
+        return;
+    }
+    state->current.duration = duration;
+    state->in_turn = false;
+    if( state->recent.size() >= recent_turns ) {
+        // Reuse the storage of the oldest turn
+        state->recent.push_back( std::move( state->recent.front() ) );
+        state->recent.pop_front();
+        std::swap( state->recent.back(), state->current );
+    } else {
+        state->recent.push_back( state->current );
+    }
+
+    const int threshold = get_option<int>( "SLOW_TURN_THRESHOLD" );
+    if( threshold > 0 && slow_turns_captured < max_slow_turn_captures &&
+        to_milliseconds( duration ) > threshold ) {
+        ++slow_turns_captured;
+        const std::string path = string_format( "%sslow_turn_%d.json", FILENAMES["config_dir"],
+                                                to_turn<int>( calendar::turn ) );
+        if( !write_slow_turn( path, state->recent.back(), threshold ) ) {
+            DebugLog( D_WARNING, DC_ALL ) << "Could not write the slow turn capture to " << path;
+        }
+    }
+}
+
+std::string histogram()
+{
+    // Upper bounds of the buckets in milliseconds, the last one takes everything longer
+    static const std::array<double, 9> bounds = {{ 1, 2, 5, 10, 20, 50, 100, 200, 500 }};
+    const auto bucket_counts = []( const std::vector<double> &times ) {
+        std::array<int, bounds.size() + 1> counts;
+        counts.fill( 0 );
+        for( const double ms : times ) {
+            const size_t bucket = std::upper_bound( bounds.begin(), bounds.end(), ms ) - bounds.begin();
+            ++counts[bucket];
+        }
+        return counts;
+    };
+    const auto turns = bucket_counts( turn_times.values() );
+    const auto frames = bucket_counts( frame_times.values() );
+
+    std::string result = string_format( "%-10s %8s %8s\n", _( "ms" ), _( "turns" ), _( "frames" ) );
+    for( size_t i = 0; i < turns.size(); ++i ) {
+        const std::string range = i < bounds.size() ? string_format( "< %g", bounds[i] ) :
+                                  string_format( ">= %g", bounds.back() );
+        result += string_format( "%-10s %8d %8d\n", range, turns[i], frames[i] );
+    }
+    return result;
+}
+
+std::string recent_summary()
+{
+    if( !state || state->recent.empty() ) {
+        return _( "No turns recorded yet." );
+    }
+    const std::deque<turn_record> &recent = state->recent;
+    struct totals {
+        const char *name;
+        profile_clock::duration sum;
+        profile_clock::duration worst;
+        uint64_t allocations;
+    };
+    std::vector<totals> phases;
+    profile_clock::duration turn_sum = profile_clock::duration::zero();
+    profile_clock::duration turn_worst = profile_clock::duration::zero();
+    for( const turn_record &turn : recent ) {
+        turn_sum += turn.duration;
+        turn_worst = std::max( turn_worst, turn.duration );
+        // A phase can run several times in one turn, the worst case is per turn
+        std::vector<totals> this_turn;
+        for( const phase_event &e : turn.events ) {
+            auto iter = std::find_if( this_turn.begin(), this_turn.end(), [&e]( const totals & t ) {
+                return strcmp( t.name, e.name ) == 0;
+            } );
+            if( iter == this_turn.end() ) {
+                this_turn.push_back( { e.name, e.duration, e.duration, e.allocations } );
+            } else {
+                iter->sum += e.duration;
+                iter->allocations += e.allocations;
+            }
+        }
+        for( const totals &t : this_turn ) {
+            auto iter = std::find_if( phases.begin(), phases.end(), [&t]( const totals & p ) {
+                return strcmp( p.name, t.name ) == 0;
+            } );
+            if( iter == phases.end() ) {
+                phases.push_back( t );
+            } else {
+                iter->sum += t.sum;
+                iter->worst = std::max( iter->worst, t.sum );
+                iter->allocations += t.allocations;
+            }
+        }
+    }
+    std::sort( phases.begin(), phases.end(), []( const totals & lhs, const totals & rhs ) {
+        return lhs.sum > rhs.sum;
+    } );
+
+    const double count = recent.size();
+    std::string result = string_format( _( "Last %d turns, mean %.2f ms, worst %.2f ms" ),
+                                        recent.size(), to_milliseconds( turn_sum ) / count,
+                                        to_milliseconds( turn_worst ) );
+    result += "\n\n";
+    const bool allocations = alloc_profile::available();
+    result += string_format( "%-14s %9s %9s", _( "phase" ), _( "mean ms" ), _( "worst ms" ) );
+    result += allocations ? string_format( " %9s\n", _( "allocs" ) ) : "\n";
+    for( const totals &t : phases ) {
+        result += string_format( "%-14s %9.2f %9.2f", t.name, to_milliseconds( t.sum ) / count,
+                                 to_milliseconds( t.worst ) );
+        result += allocations ? string_format( " %9.1f\n", t.allocations / count ) : "\n";
+    }
+    return result;
+}
+
+bool write_trace( const std::string &path )
+{
+    if( !state || state->recent.empty() ) {
+        return false;
+    }
+    return write_to_file( path, []( std::ostream & fout ) {
+        JsonOut jsout( fout );
+        jsout.start_object();
+        write_trace_events( jsout, state->recent.begin(), state->recent.end() );
+        jsout.end_object();
+    }, nullptr );
+}
+
+bool run_benchmark( const std::string &world, const int turns, const std::string &path,
+                    const std::string &scenario )
+{
+    if( !g->load( world ) ) {
+        return false;
+    }
+    // A fixed seed, so every run of the scenario gets the same load
+    if( !scenario.empty() && !stress_scenario::setup( scenario, 1 ) ) {
+        return false;
+    }
+    enable();
+    state->phases.clear();
+
+    const profile_clock::time_point start = profile_clock::now();
+    int done = 0;
+    while( done < turns && !g->u.is_dead_state() ) {
+        // Without moves the avatar never asks for input, the rest of the world goes on.
+        g->u.moves = 0;
+        if( g->do_turn() ) {
+            break;
+        }
+        ++done;
+    }
+    const profile_clock::duration elapsed = profile_clock::now() - start;
+
+    std::vector<phase_entry> sorted = state->phases;
+    std::sort( sorted.begin(), sorted.end(), []( const phase_entry & lhs, const phase_entry & rhs ) {
+        return lhs.time > rhs.time;
+    } );
+    const double total_ms = to_milliseconds( elapsed );
+    const bool written = write_to_file( path, [&]( std::ostream & fout ) {
+        fout << string_format( "# world\t%s\n", world );
+        if( !scenario.empty() ) {
+            fout << string_format( "# scenario\t%s\n", scenario );
+        }
+        fout << string_format( "# turns\t%d\n", done );
+        fout << string_format( "# seconds\t%.3f\n", total_ms / 1000.0 );
+        fout << string_format( "# turns_per_second\t%.1f\n",
+                               total_ms > 0 ? done * 1000.0 / total_ms : 0.0 );
+        // Allocation columns only when they are counted, so files of normal builds can be compared
+        const bool allocations = alloc_profile::available();
+        fout << "phase\tcalls\ttotal_ms\tms_per_turn\tshare";
+        fout << ( allocations ? "\tallocs_per_turn\talloc_kib_per_turn\n" : "\n" );
+        for( const phase_entry &e : sorted ) {
+            const double ms = to_milliseconds( e.time );
+            fout << string_format( "%s\t%d\t%.3f\t%.4f\t%.3f", e.name, e.calls, ms,
+                                   done ? ms / done : 0.0, total_ms > 0 ? ms / total_ms : 0.0 );
+            if( allocations ) {
+                const double divisor = done ? done : 1;
+                fout << string_format( "\t%.1f\t%.2f", e.allocations / divisor,
+                                       e.allocated_bytes / 1024.0 / divisor );
+            }
+            fout << "\n";
+        }
+    }, nullptr );
+    if( !written ) {
+        DebugLog( D_WARNING, DC_ALL ) << "Could not write the turn benchmark to " << path;
+    }
+    return true;
+}
+
+void record( const char *name, const profile_clock::duration time )
+{
+    if( state == nullptr ) {
+        return;
+    }
+    phase_entry &e = state->entry( name );
+    e.time += time;
+    ++e.calls;
+}
+
+frame::frame() : start( profile_clock::now() )
+{
+}
+
+frame::~frame()
+{
+    frame_times.add( to_milliseconds( profile_clock::now() - start ) );
+}
+
+input_wait::input_wait() : start( profile_clock::now() )
+{
+    ++open_waits;
+}
+
+input_wait::~input_wait()
+{
+    if( --open_waits == 0 ) {
+        turn_waiting += profile_clock::now() - start;
+    }
+}
+
+phase::phase( const char *name ) : name( name ), recording( state != nullptr )
+{
+    if( recording ) {
+        const alloc_profile::counts allocated = alloc_profile::current();
+        allocations = allocated.allocations;
+        allocated_bytes = allocated.bytes;
+        start = profile_clock::now();
+    }
+}
+
+phase::~phase()
+{
+    if( !recording || !state ) {
+        return;
+    }
+    const profile_clock::duration duration = profile_clock::now() - start;
+    const alloc_profile::counts allocated = alloc_profile::current();
+    const uint64_t new_allocations = allocated.allocations - allocations;
+    phase_entry &e = state->entry( name );
+    e.time += duration;
+    ++e.calls;
+    e.allocations += new_allocations;
+    e.allocated_bytes += allocated.bytes - allocated_bytes;
+    if( state->in_turn ) {
+        state->current.events.push_back( { name, start, duration, new_allocations } );
+    }
+}
+
+} // namespace turn_profile
@@ -0,0 +1,120 @@
+#pragma once
+#ifndef TURN_PROFILE_H
+#define TURN_PROFILE_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * Optional timing of the phases of a game turn (monsters, NPCs, fields, items, vehicles,
+ * caches, ...). The --benchmark-turns command line flag uses it to report how fast a saved
+ * game simulates, without anyone at the keyboard. It can also be switched on from the debug
+ * menu, which then shows where the time of the last turns went.
+ *
+ * Nothing is recorded (and everything here is cheap) unless it is enabled. Only the durations
+ * of the last whole turns and frames are always kept, for @ref histogram.
+ * Phases are only timed on the main thread.
+ *
+ * With the SLOW_TURN_THRESHOLD option set, phases are recorded all the time and each turn
+ * slower than that is written to the config directory, with a short description of the world.
+ */
+namespace turn_profile
+{
+
+void enable();
+void disable();
+bool enabled();
+
+/**
+ * Marks the boundaries of a game turn, the phases in between are recorded as that turn.
+ * The time spent in @ref input_wait is not part of the turn.
+ */
+void begin_turn();
+void end_turn();
+
+/** Mean and worst time of each phase over the recently recorded turns, as display text. */
+std::string recent_summary();
+/** How many of the last turns and frames took how long, as display text. */
+std::string histogram();
+/**
+ * Writes the recently recorded turns in the Chrome trace event format, which
+ * chrome://tracing and Perfetto can display.
+ * @return false if the file could not be written.
+ */
+bool write_trace( const std::string &path );
+
+/**
+ * Loads the first save of the given world and simulates the given number of turns. The avatar
+ * stays idle, it never gets a move, so no input is needed. Stops early if the avatar dies.
+ * If a scenario is named, that @ref stress_scenario is set up around the avatar first.
+ * The turns per second and the time of each phase are written to the file at path.
+ * @return false if the world could not be loaded or there is no such scenario.
+ */
+bool run_benchmark( const std::string &world, int turns, const std::string &path,
+                    const std::string &scenario = std::string() );
+
+/**
+ * Adds time measured elsewhere to the phase of the given name, as one call. Not part of the
+ * trace of a turn. The name must be a string literal (or outlive the profile).
+ */
+void record( const char *name, std::chrono::steady_clock::duration time );
+
+/** Adds the time from construction to destruction to the frame times of @ref histogram. */
+class frame
+{
+    public:
+        frame();
+        ~frame();
+
+        frame( const frame & ) = delete;
+        frame &operator=( const frame & ) = delete;
+
+    private:
+        std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * Leaves the time from construction to destruction out of the current turn, it is spent
+ * waiting for the player. Used around the key wait of input_context::handle_input and the
+ * input loop of the game, so the turn times say how long the game took and not how long the
+ * player thought. Nested waits only count once.
+ */
+class input_wait
+{
+    public:
+        input_wait();
+        ~input_wait();
+
+        input_wait( const input_wait & ) = delete;
+        input_wait &operator=( const input_wait & ) = delete;
+
+    private:
+        std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * Adds the time from construction to destruction to the phase of the given name. In
+ * ALLOC_PROFILE builds the allocations made meanwhile are added too, see @ref alloc_profile.
+ * The name must be a string literal (or outlive the profile).
+ */
+class phase
+{
+    public:
+        explicit phase( const char *name );
+        ~phase();
+
+        phase( const phase & ) = delete;
+        phase &operator=( const phase & ) = delete;
+
+    private:
+        const char *name;
+        bool recording;
+        uint64_t allocations = 0;
+        uint64_t allocated_bytes = 0;
+        std::chrono::steady_clock::time_point start;
+};
+
+} // namespace turn_profile
+
+#endif
@@ -514,7 +514,7 @@ npc vehicle::get_targeting_npc( const vehicle_part &pt )
     return cpu;
 }
 
-int vehicle::automatic_fire_turret( vehicle_part &pt )
+int vehicle::automatic_fire_turret( vehicle_part &pt, const std::vector<Creature *> &hostiles )
 {
     turret_data gun = turret_query( pt );
 
@@ -549,7 +549,7 @@ int vehicle::automatic_fire_turret( vehicle_part &pt )
         // TODO: calculate chance to hit and cap range based upon this
         int max_range = 20;
         int range = std::min( gun.range(), max_range );
-        Creature *auto_target = cpu.auto_find_hostile_target( range, boo_hoo, area );
+        Creature *auto_target = cpu.auto_find_hostile_target( hostiles, range, boo_hoo, area );
         if( auto_target == nullptr ) {
             if( boo_hoo ) {
                 cpu.name = string_format( pgettext( "vehicle turret", "The %s" ), pt.name() );
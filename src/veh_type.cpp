@@ -103,6 +103,7 @@ static const std::unordered_map<std::string, vpart_bitflags> vpart_bitflag_map =
     { "FLUIDTANK", VPFLAG_FLUIDTANK },
     { "REACTOR", VPFLAG_REACTOR },
     { "RAIL", VPFLAG_RAIL },
+    { "ROOF", VPFLAG_ROOF },
 };
 
 static const std::vector<std::pair<std::string, veh_ter_mod>> standard_terrain_mod = {{
@@ -441,6 +442,76 @@ void vpart_info::finalize()
     DynamicDataLoader::get_instance().load_deferred( deferred );
 
     for( auto &e : vpart_info_all ) {
+        vpart_info &part = e.second;
+
+        // handle legacy parts without requirement data
+        // TODO: deprecate once requirements are entirely loaded from JSON
+        if( part.legacy ) {
+
+            part.install_skills.emplace( skill_mechanics, part.difficulty );
+            part.removal_skills.emplace( skill_mechanics, std::max( part.difficulty - 2, 2 ) );
+            part.repair_skills.emplace( skill_mechanics, std::min( part.difficulty + 1, MAX_SKILL ) );
+
+            if( part.has_flag( "TOOL_WRENCH" ) || part.has_flag( "WHEEL" ) ) {
+                part.install_reqs = { { requirement_id( "vehicle_bolt" ), 1 } };
+                part.removal_reqs = { { requirement_id( "vehicle_bolt" ), 1 } };
+                part.repair_reqs  = { { requirement_id( "welding_standard" ), 5 } };
+
+            } else if( part.has_flag( "TOOL_SCREWDRIVER" ) ) {
+                part.install_reqs = { { requirement_id( "vehicle_screw" ), 1 } };
+                part.removal_reqs = { { requirement_id( "vehicle_screw" ), 1 } };
+                part.repair_reqs  = { { requirement_id( "adhesive" ), 1 } };
+
+            } else if( part.has_flag( "NAILABLE" ) ) {
+                part.install_reqs = { { requirement_id( "vehicle_nail_install" ), 1 } };
+                part.removal_reqs = { { requirement_id( "vehicle_nail_removal" ), 1 } };
+                part.repair_reqs  = { { requirement_id( "adhesive" ), 2 } };
+
+            } else if( part.has_flag( "TOOL_NONE" ) ) {
+                // no-op
+
+            } else {
+                part.install_reqs = { { requirement_id( "welding_standard" ), 5 } };
+                part.removal_reqs = { { requirement_id( "vehicle_weld_removal" ), 1 } };
+                part.repair_reqs  = { { requirement_id( "welding_standard" ), 5 } };
+            }
+
+        } else {
+            if( part.has_flag( "REVERSIBLE" ) ) {
+                if( !part.removal_reqs.empty() ) {
+                    debugmsg( "vehicle part %s specifies both REVERSIBLE and removal", part.id.c_str() );
+                }
+                part.removal_reqs = part.install_reqs;
+            }
+        }
+
+        // add the base item to the installation requirements
+        // TODO: support multiple/alternative base items
+        requirement_data ins;
+        ins.components.push_back( { { { part.item, 1 } } } );
+
+        const requirement_id ins_id( std::string( "inline_vehins_base_" ) + part.id.str() );
+        requirement_data::save_requirement( ins, ins_id );
+        part.install_reqs.emplace_back( ins_id, 1 );
+
+        if( part.removal_moves < 0 ) {
+            part.removal_moves = part.install_moves / 2;
+        }
+
+        // Fuel type errors are serious and need fixing now, not when the checks run
+        if( !item::type_is_defined( part.fuel_type ) ) {
+            debugmsg( "vehicle part %s uses undefined fuel %s", part.id.c_str(), part.item.c_str() );
+            part.fuel_type = "null";
+        } else if( part.fuel_type != "null" && !item::find_type( part.fuel_type )->fuel &&
+                   ( !item::type_is_defined( part.item ) || !item::find_type( part.item )->container ||
+                     !item::find_type( part.item )->container->watertight ) ) {
+            // Tanks are allowed to specify non-fuel "fuel",
+            // because currently legacy blazemod uses it as a hack to restrict content types
+            debugmsg( "non-tank vehicle part %s uses non-fuel item %s as fuel, setting to null",
+                      part.id.c_str(), part.fuel_type.c_str() );
+            part.fuel_type = "null";
+        }
+
         if( e.second.folded_volume > 0_ml ) {
             e.second.set_flag( "FOLDABLE" );
         }
@@ -503,60 +574,6 @@ void vpart_info::check()
     for( auto &vp : vpart_info_all ) {
         auto &part = vp.second;
 
-        // handle legacy parts without requirement data
-        // TODO: deprecate once requirements are entirely loaded from JSON
-        if( part.legacy ) {
-
-            part.install_skills.emplace( skill_mechanics, part.difficulty );
-            part.removal_skills.emplace( skill_mechanics, std::max( part.difficulty - 2, 2 ) );
-            part.repair_skills.emplace( skill_mechanics, std::min( part.difficulty + 1, MAX_SKILL ) );
-
-            if( part.has_flag( "TOOL_WRENCH" ) || part.has_flag( "WHEEL" ) ) {
-                part.install_reqs = { { requirement_id( "vehicle_bolt" ), 1 } };
-                part.removal_reqs = { { requirement_id( "vehicle_bolt" ), 1 } };
-                part.repair_reqs  = { { requirement_id( "welding_standard" ), 5 } };
-
-            } else if( part.has_flag( "TOOL_SCREWDRIVER" ) ) {
-                part.install_reqs = { { requirement_id( "vehicle_screw" ), 1 } };
-                part.removal_reqs = { { requirement_id( "vehicle_screw" ), 1 } };
-                part.repair_reqs  = { { requirement_id( "adhesive" ), 1 } };
-
-            } else if( part.has_flag( "NAILABLE" ) ) {
-                part.install_reqs = { { requirement_id( "vehicle_nail_install" ), 1 } };
-                part.removal_reqs = { { requirement_id( "vehicle_nail_removal" ), 1 } };
-                part.repair_reqs  = { { requirement_id( "adhesive" ), 2 } };
-
-            } else if( part.has_flag( "TOOL_NONE" ) ) {
-                // no-op
-
-            } else {
-                part.install_reqs = { { requirement_id( "welding_standard" ), 5 } };
-                part.removal_reqs = { { requirement_id( "vehicle_weld_removal" ), 1 } };
-                part.repair_reqs  = { { requirement_id( "welding_standard" ), 5 } };
-            }
-
-        } else {
-            if( part.has_flag( "REVERSIBLE" ) ) {
-                if( !part.removal_reqs.empty() ) {
-                    debugmsg( "vehicle part %s specifies both REVERSIBLE and removal", part.id.c_str() );
-                }
-                part.removal_reqs = part.install_reqs;
-            }
-        }
-
-        // add the base item to the installation requirements
-        // TODO: support multiple/alternative base items
-        requirement_data ins;
-        ins.components.push_back( { { { part.item, 1 } } } );
-
-        const requirement_id ins_id( std::string( "inline_vehins_base_" ) + part.id.str() );
-        requirement_data::save_requirement( ins, ins_id );
-        part.install_reqs.emplace_back( ins_id, 1 );
-
-        if( part.removal_moves < 0 ) {
-            part.removal_moves = part.install_moves / 2;
-        }
-
         for( auto &e : part.install_skills ) {
             if( !e.first.is_valid() ) {
                 debugmsg( "vehicle part %s has unknown install skill %s", part.id.c_str(), e.first.c_str() );
@@ -636,18 +653,6 @@ void vpart_info::check()
             debugmsg( "vehicle part %s uses undefined item %s", part.id.c_str(), part.item.c_str() );
         }
         const itype &base_item_type = *item::find_type( part.item );
-        // Fuel type errors are serious and need fixing now
-        if( !item::type_is_defined( part.fuel_type ) ) {
-            debugmsg( "vehicle part %s uses undefined fuel %s", part.id.c_str(), part.item.c_str() );
-            part.fuel_type = "null";
-        } else if( part.fuel_type != "null" && !item::find_type( part.fuel_type )->fuel &&
-                   ( !base_item_type.container || !base_item_type.container->watertight ) ) {
-            // Tanks are allowed to specify non-fuel "fuel",
-            // because currently legacy blazemod uses it as a hack to restrict content types
-            debugmsg( "non-tank vehicle part %s uses non-fuel item %s as fuel, setting to null",
-                      part.id.c_str(), part.fuel_type.c_str() );
-            part.fuel_type = "null";
-        }
         if( part.has_flag( "TURRET" ) && !base_item_type.gun ) {
             debugmsg( "vehicle part %s has the TURRET flag, but is not made from a gun item", part.id.c_str() );
         }
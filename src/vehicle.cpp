@@ -25,6 +25,7 @@
 #include "event_bus.h"
 #include "explosion.h"
 #include "game.h"
+#include "hash_utils.h"
 #include "item.h"
 #include "item_group.h"
 #include "itype.h"
@@ -1861,6 +1862,7 @@ void vehicle::part_removal_cleanup()
     }
     removed_part_count = 0;
     if( changed || parts.empty() ) {
+        // Rebuild cached indices
         refresh();
         if( parts.empty() ) {
             g->m.destroy_vehicle( this );
@@ -1869,8 +1871,9 @@ void vehicle::part_removal_cleanup()
             g->m.update_vehicle_cache( this, sm_pos.z );
         }
     }
+    // Refreshes on its own if it has to move the parts; if nothing was erased the
+    // indices are still current from the refresh done when the parts were removed.
     shift_if_needed();
-    refresh(); // Rebuild cached indices
     coeff_air_dirty = coeff_air_changed;
     coeff_air_changed = false;
 }
@@ -2285,13 +2288,8 @@ std::vector<int> vehicle::parts_at_relative( const point &dp,
         }
         return res;
     } else {
-        const auto &iter = relative_parts.find( dp );
-        if( iter != relative_parts.end() ) {
-            return iter->second;
-        } else {
-            std::vector<int> res;
-            return res;
-        }
+        const vehicle_mount_index::range here = relative_parts.at( dp );
+        return std::vector<int>( here.begin(), here.end() );
     }
 }
 
@@ -2365,13 +2363,9 @@ int vehicle::part_with_feature( int part, vpart_bitflags const flag, bool unbrok
     if( part_flag( part, flag ) && ( !unbroken || !parts[part].is_broken() ) ) {
         return part;
     }
-    const auto it = relative_parts.find( parts[part].mount );
-    if( it != relative_parts.end() ) {
-        const std::vector<int> &parts_here = it->second;
-        for( auto &i : parts_here ) {
-            if( part_flag( i, flag ) && ( !unbroken || !parts[i].is_broken() ) ) {
-                return i;
-            }
+    for( const int i : relative_parts.at( parts[part].mount ) ) {
+        if( part_flag( i, flag ) && ( !unbroken || !parts[i].is_broken() ) ) {
+            return i;
         }
     }
     return -1;
@@ -2894,18 +2888,38 @@ void vehicle::precalc_mounts( int idir, int dir, const point &pivot )
     if( idir < 0 || idir > 1 ) {
         idir = 0;
     }
-    tileray tdir( dir );
-    std::unordered_map<point, point> mount_to_precalc;
-    for( auto &p : parts ) {
-        if( p.removed ) {
-            continue;
+    // Turning back and forth revisits the same few headings, so keep their results.
+    // 24 headings of 15 degrees, for a couple of pivots.
+    constexpr size_t max_cached_rotations = 48;
+    const std::pair<int, point> key( dir, pivot );
+    auto cached = precalc_cache.find( key );
+    if( cached == precalc_cache.end() || cached->second.size() != parts.size() ) {
+        if( precalc_cache.size() >= max_cached_rotations ) {
+            precalc_cache.clear();
+        }
+        tileray tdir( dir );
+        std::unordered_map<point, point> mount_to_precalc;
+        std::vector<point> precalc( parts.size() );
+        for( size_t i = 0; i < parts.size(); i++ ) {
+            const vehicle_part &p = parts[i];
+            if( p.removed ) {
+                continue;
+            }
+            auto q = mount_to_precalc.find( p.mount );
+            if( q == mount_to_precalc.end() ) {
+                coord_translate( tdir, pivot, p.mount, precalc[i] );
+                mount_to_precalc.insert( { p.mount, precalc[i] } );
+            } else {
+                precalc[i] = q->second;
+            }
         }
-        auto q = mount_to_precalc.find( p.mount );
-        if( q == mount_to_precalc.end() ) {
-            coord_translate( tdir, pivot, p.mount, p.precalc[idir] );
-            mount_to_precalc.insert( { p.mount, p.precalc[idir] } );
-        } else {
-            p.precalc[idir] = q->second;
+        cached = precalc_cache.emplace( key, std::vector<point>() ).first;
+        cached->second = std::move( precalc );
+    }
+    const std::vector<point> &precalc = cached->second;
+    for( size_t i = 0; i < parts.size(); i++ ) {
+        if( !parts[i].removed ) {
+            parts[i].precalc[idir] = precalc[i];
         }
     }
     pivot_anchor[idir] = pivot;
@@ -3467,7 +3481,7 @@ void vehicle::spew_field( double joules, int part, field_type_id type, int inten
     point p = parts[part].mount;
     intensity = std::max( joules / 10000, static_cast<double>( intensity ) );
     // Move back from engine/muffler until we find an open space
-    while( relative_parts.find( p ) != relative_parts.end() ) {
+    while( relative_parts.has( p ) ) {
         p.x += ( velocity < 0 ? 1 : -1 );
     }
     point q = coord_translate( p );
@@ -3756,31 +3770,37 @@ double vehicle::coeff_rolling_drag() const
     if( !coeff_rolling_dirty ) {
         return coefficient_rolling_resistance;
     }
-    constexpr double wheel_ratio = 1.25;
-    constexpr double base_wheels = 4.0;
     // SAE J2452 measurements are in F_rr = N * C_rr * 0.000225 * ( v + 33.33 )
     // Don't ask me why, but it's the numbers we have. We want N * C_rr * 0.000225 here,
     // and N is mass * accel from gravity (aka weight)
     constexpr double sae_ratio = 0.000225;
     constexpr double newton_ratio = accel_g * sae_ratio;
-    double wheel_factor = 0;
-    if( wheelcache.empty() ) {
-        wheel_factor = 50;
-    } else {
-        // should really sum the each wheel's c_rolling_resistance * it's share of vehicle mass
-        for( auto wheel : wheelcache ) {
-            wheel_factor += parts[ wheel ].info().wheel_rolling_resistance();
-        }
-        // mildly increasing rolling resistance for vehicles with more than 4 wheels and mildly
-        // decrease it for vehicles with less
-        wheel_factor *= wheel_ratio /
-                        ( base_wheels * wheel_ratio - base_wheels + wheelcache.size() );
-    }
-    coefficient_rolling_resistance = newton_ratio * wheel_factor * to_kilogram( total_mass() );
+    // Mass changes with every drop of fuel burned, the wheels only when refreshed.
+    coefficient_rolling_resistance = newton_ratio * wheel_rolling_factor * to_kilogram( total_mass() );
     coeff_rolling_dirty = false;
     return coefficient_rolling_resistance;
 }
 
+void vehicle::refresh_wheel_rolling_factor()
+{
+    constexpr double wheel_ratio = 1.25;
+    constexpr double base_wheels = 4.0;
+    if( wheelcache.empty() ) {
+        wheel_rolling_factor = 50;
+        return;
+    }
+    double wheel_factor = 0;
+    // should really sum the each wheel's c_rolling_resistance * it's share of vehicle mass
+    for( auto wheel : wheelcache ) {
+        wheel_factor += parts[ wheel ].info().wheel_rolling_resistance();
+    }
+    // mildly increasing rolling resistance for vehicles with more than 4 wheels and mildly
+    // decrease it for vehicles with less
+    wheel_factor *= wheel_ratio /
+                    ( base_wheels * wheel_ratio - base_wheels + wheelcache.size() );
+    wheel_rolling_factor = wheel_factor;
+}
+
 double vehicle::water_draft() const
 {
     if( coeff_water_dirty ) {
@@ -3813,7 +3833,7 @@ double vehicle::coeff_water_drag() const
     if( !coeff_water_dirty ) {
         return coefficient_water_resistance;
     }
-    std::vector<int> structure_indices = all_parts_at_location( part_location_structure );
+    const std::vector<int> &structure_indices = structure_parts;
     if( structure_indices.empty() ) {
         // huh?
         coeff_water_dirty = false;
@@ -4401,11 +4421,8 @@ int vehicle::traverse_vehicle_graph( Vehicle *start_veh, int amount, Func action
 
         g->u.add_msg_if_player( m_debug, "Traversing graph with %d power", amount );
 
-        for( auto &p : current_veh->loose_parts ) {
-            if( !current_veh->part_info( p ).has_flag( "POWER_TRANSFER" ) ) {
-                continue; // ignore loose parts that aren't power transfer cables
-            }
-
+        // Only loose parts that are power transfer cables lead anywhere
+        for( auto &p : current_veh->power_cables ) {
             auto target_veh = vehicle::find_vehicle( current_veh->parts[p].target.second );
             if( target_veh == nullptr || visited_vehs.count( target_veh ) > 0 ) {
                 // Either no destination here (that vehicle's rolled away or off-map) or
@@ -4440,8 +4457,9 @@ int vehicle::charge_battery( int amount, bool include_other_vehicles )
 {
     // Key parts by percentage charge level.
     std::multimap<int, vehicle_part *> chargeable_parts;
-    for( vehicle_part &p : parts ) {
-        if( p.is_available() && p.is_battery() && p.ammo_capacity() > p.ammo_remaining() ) {
+    for( const int b : batteries ) {
+        vehicle_part &p = parts[b];
+        if( p.is_available() && p.ammo_capacity() > p.ammo_remaining() ) {
             chargeable_parts.insert( { ( p.ammo_remaining() * 100 ) / p.ammo_capacity(), &p } );
         }
     }
@@ -4479,8 +4497,9 @@ int vehicle::discharge_battery( int amount, bool recurse )
 {
     // Key parts by percentage charge level.
     std::multimap<int, vehicle_part *> dischargeable_parts;
-    for( vehicle_part &p : parts ) {
-        if( p.is_available() && p.is_battery() && p.ammo_remaining() > 0 ) {
+    for( const int b : batteries ) {
+        vehicle_part &p = parts[b];
+        if( p.is_available() && p.ammo_remaining() > 0 ) {
             dischargeable_parts.insert( { ( p.ammo_remaining() * 100 ) / p.ammo_capacity(), &p } );
         }
     }
@@ -4886,9 +4905,16 @@ void vehicle::gain_moves()
 
     // turrets which are enabled will try to reload and then automatically fire
     // Turrets which are disabled but have targets set are a special case
+    // They all choose from the same candidates, only gathered if any turret needs them
+    std::vector<Creature *> hostiles;
+    bool hostiles_found = false;
     for( auto e : turrets() ) {
         if( e->enabled || e->target.second != e->target.first ) {
-            automatic_fire_turret( *e );
+            if( !hostiles_found ) {
+                hostiles = Creature::hostile_target_candidates();
+                hostiles_found = true;
+            }
+            automatic_fire_turret( *e, hostiles );
         }
     }
 
@@ -4930,6 +4956,8 @@ void vehicle::enable_refresh()
  */
 void vehicle::refresh()
 {
+    // Parts may have moved even if the rest has to wait for enable_refresh().
+    precalc_cache.clear();
     if( no_refresh ) {
         return;
     }
@@ -4945,6 +4973,9 @@ void vehicle::refresh()
     emitters.clear();
     relative_parts.clear();
     loose_parts.clear();
+    power_cables.clear();
+    batteries.clear();
+    structure_parts.clear();
     wheelcache.clear();
     rail_wheelcache.clear();
     steering.clear();
@@ -4955,14 +4986,6 @@ void vehicle::refresh()
     all_wheels_on_one_axis = true;
     int first_wheel_y_mount = INT_MAX;
 
-    // Used to sort part list so it displays properly when examining
-    struct sort_veh_part_vector {
-        vehicle *veh;
-        inline bool operator()( const int p1, const int p2 ) {
-            return veh->part_info( p1 ).list_order < veh->part_info( p2 ).list_order;
-        }
-    } svpv = { this };
-
     mount_min.x = 123;
     mount_min.y = 123;
     mount_max.x = -123;
@@ -4973,6 +4996,13 @@ void vehicle::refresh()
     int railwheel_xmax = INT_MIN;
     int railwheel_ymax = INT_MIN;
 
+    // Everything refresh_insides looks at; the flags only need rederiving if this changes.
+    size_t layout = 0;
+
+    // Mount point of every part, used to build relative_parts after the loop.
+    std::vector<std::pair<point, int>> mounted_parts;
+    mounted_parts.reserve( parts.size() );
+
     // Main loop over all vehicle parts.
     for( const vpart_reference &vp : get_all_parts() ) {
         const size_t p = vp.part_index();
@@ -4981,22 +5011,31 @@ void vehicle::refresh()
             continue;
         }
 
-        // Build map of point -> all parts in that point
+        // Collect point -> all parts in that point
         const point pt = vp.mount();
         mount_min.x = std::min( mount_min.x, pt.x );
         mount_min.y = std::min( mount_min.y, pt.y );
         mount_max.x = std::max( mount_max.x, pt.x );
         mount_max.y = std::max( mount_max.y, pt.y );
 
-        // This will keep the parts at point pt sorted
-        std::vector<int>::iterator vii = std::lower_bound( relative_parts[pt].begin(),
-                                         relative_parts[pt].end(),
-                                         static_cast<int>( p ), svpv );
-        relative_parts[pt].insert( vii, p );
+        mounted_parts.emplace_back( pt, static_cast<int>( p ) );
+
+        cata::hash_combine( layout, p );
+        cata::hash_combine( layout, pt );
+        if( vpi.has_flag( VPFLAG_ROOF ) || vpi.has_flag( VPFLAG_OBSTACLE ) ) {
+            cata::hash_combine( layout, vp.part().is_available() );
+            cata::hash_combine( layout, vp.part().open );
+        }
 
         if( vpi.has_flag( VPFLAG_FLOATS ) ) {
             floating.push_back( p );
         }
+        if( vp.part().is_battery() ) {
+            batteries.push_back( p );
+        }
+        if( vpi.location == part_location_structure ) {
+            structure_parts.push_back( p );
+        }
 
         if( vp.part().is_unavailable() ) {
             continue;
@@ -5027,6 +5066,9 @@ void vehicle::refresh()
         }
         if( vpi.has_flag( "UNMOUNT_ON_MOVE" ) ) {
             loose_parts.push_back( p );
+            if( vpi.has_flag( "POWER_TRANSFER" ) ) {
+                power_cables.push_back( p );
+            }
         }
         if( vpi.has_flag( "EMITTER" ) ) {
             emitters.push_back( p );
@@ -5073,17 +5115,79 @@ void vehicle::refresh()
         }
     }
 
+    // Sort the parts at each point so they display properly when examining.
+    // Parts with the same list order end up newest first.
+    std::reverse( mounted_parts.begin(), mounted_parts.end() );
+    std::stable_sort( mounted_parts.begin(), mounted_parts.end(),
+    [this]( const std::pair<point, int> &lhs, const std::pair<point, int> &rhs ) {
+        return part_info( lhs.second ).list_order < part_info( rhs.second ).list_order;
+    } );
+    relative_parts.build( mount_min, mount_max, mounted_parts );
+
+    refresh_wheel_rolling_factor();
+
     rail_wheel_bounding_box.p1 = point( railwheel_xmin, railwheel_ymin );
     rail_wheel_bounding_box.p2 = point( railwheel_xmax, railwheel_ymax );
 
     // NB: using the _old_ pivot point, don't recalc here, we only do that when moving!
     precalc_mounts( 0, pivot_rotation[0], pivot_anchor[0] );
     check_environmental_effects = true;
-    insides_dirty = true;
+    if( layout != insides_layout ) {
+        insides_layout = layout;
+        insides_dirty = true;
+    }
     zones_dirty = true;
     invalidate_mass();
 }
 
+void vehicle_mount_index::clear()
+{
+    width = 0;
+    height = 0;
+    offsets.clear();
+    pool.clear();
+}
+
+void vehicle_mount_index::build( const point &min, const point &max,
+                                 const std::vector<std::pair<point, int>> &entries )
+{
+    clear();
+    if( entries.empty() ) {
+        return;
+    }
+    origin = min;
+    width = max.x - min.x + 1;
+    height = max.y - min.y + 1;
+    const auto cell = [this]( const point & mount ) {
+        return ( mount.x - origin.x ) * height + ( mount.y - origin.y );
+    };
+
+    // Count the parts in each cell, then turn the counts into start offsets.
+    offsets.assign( width * height + 1, 0 );
+    for( const std::pair<point, int> &e : entries ) {
+        offsets[cell( e.first ) + 1]++;
+    }
+    for( size_t i = 1; i < offsets.size(); i++ ) {
+        offsets[i] += offsets[i - 1];
+    }
+    pool.resize( entries.size() );
+    std::vector<int> next( offsets.begin(), offsets.end() - 1 );
+    for( const std::pair<point, int> &e : entries ) {
+        pool[next[cell( e.first )]++] = e.second;
+    }
+}
+
+vehicle_mount_index::range vehicle_mount_index::at( const point &mount ) const
+{
+    const int x = mount.x - origin.x;
+    const int y = mount.y - origin.y;
+    if( x < 0 || x >= width || y < 0 || y >= height ) {
+        return range();
+    }
+    const int i = x * height + y;
+    return range{ pool.data() + offsets[i], pool.data() + offsets[i + 1] };
+}
+
 const point &vehicle::pivot_point() const
 {
     if( pivot_dirty ) {
@@ -5255,7 +5359,7 @@ void vehicle::refresh_insides()
         }
         /* If there's no roof, or there is a roof but it's broken, it's outside.
          * (Use short-circuiting && so broken frames don't screw this up) */
-        if( !( part_with_feature( p, "ROOF", true ) >= 0 && vp.part().is_available() ) ) {
+        if( !( part_with_feature( p, VPFLAG_ROOF, true ) >= 0 && vp.part().is_available() ) ) {
             vp.part().inside = false;
             continue;
         }
@@ -5263,16 +5367,15 @@ void vehicle::refresh_insides()
         parts[p].inside = true; // inside if not otherwise
         for( int i = 0; i < 4; i++ ) { // let's check four neighbor parts
             point near_mount = parts[ p ].mount + vehicles::cardinal_d[ i ];
-            std::vector<int> parts_n3ar = parts_at_relative( near_mount, true );
             bool cover = false; // if we aren't covered from sides, the roof at p won't save us
-            for( auto &j : parts_n3ar ) {
+            for( const int j : relative_parts.at( near_mount ) ) {
                 // another roof -- cover
-                if( part_flag( j, "ROOF" ) && parts[ j ].is_available() ) {
+                if( part_flag( j, VPFLAG_ROOF ) && parts[ j ].is_available() ) {
                     cover = true;
                     break;
-                } else if( part_flag( j, "OBSTACLE" ) && parts[ j ].is_available() ) {
+                } else if( part_flag( j, VPFLAG_OBSTACLE ) && parts[ j ].is_available() ) {
                     // found an obstacle, like board or windshield or door
-                    if( parts[j].inside || ( part_flag( j, "OPENABLE" ) && parts[j].open ) ) {
+                    if( parts[j].inside || ( part_flag( j, VPFLAG_OPENABLE ) && parts[j].open ) ) {
                         continue; // door and it's open -- can't cover
                     }
                     cover = true;
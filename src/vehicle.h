@@ -512,6 +512,51 @@ class turret_data
         vehicle_part *part = nullptr;
 };
 
+/**
+ * Part indices at each mount point of a vehicle. The mount bounding box is laid
+ * out as a dense grid of offsets into one flat pool of indices, so lookups are
+ * two array reads and no mount point needs its own allocation.
+ */
+class vehicle_mount_index
+{
+    public:
+        /** The parts at one mount point, in list order. */
+        struct range {
+            const int *first = nullptr;
+            const int *last = nullptr;
+
+            const int *begin() const {
+                return first;
+            }
+            const int *end() const {
+                return last;
+            }
+            bool empty() const {
+                return first == last;
+            }
+        };
+
+        void clear();
+        /**
+         * Rebuilds the index from (mount, part index) pairs, which must all lie
+         * within [min, max]. Parts at a mount point keep the order they are given in.
+         */
+        void build( const point &min, const point &max,
+                    const std::vector<std::pair<point, int>> &entries );
+        range at( const point &mount ) const;
+        bool has( const point &mount ) const {
+            return !at( mount ).empty();
+        }
+
+    private:
+        point origin;
+        int width = 0;
+        int height = 0;
+        // Parts at grid cell i are pool[offsets[i]] up to pool[offsets[i + 1]].
+        std::vector<int> offsets;
+        std::vector<int> pool;
+};
+
 /**
  * Struct used for storing labels
  * (easier to json opposed to a std::map<point, std::string>)
@@ -654,6 +699,9 @@ class vehicle
         // refresh pivot_cache, clear pivot_dirty
         void refresh_pivot() const;
 
+        // recompute wheel_rolling_factor from wheelcache
+        void refresh_wheel_rolling_factor();
+
         void refresh_mass() const;
         void calc_mass_center( bool precalc ) const;
 
@@ -662,9 +710,10 @@ class vehicle
 
         /*
          * Fire turret at automatically acquired targets
+         * @param hostiles the targets to choose from, see @ref Creature::hostile_target_candidates
          * @return number of shots actually fired (which may be zero)
          */
-        int automatic_fire_turret( vehicle_part &pt );
+        int automatic_fire_turret( vehicle_part &pt, const std::vector<Creature *> &hostiles );
         /**
          * Find a possibly off-map vehicle. If necessary, loads up its submap through
          * the global MAPBUFFER and pulls it from there. For this reason, you should only
@@ -1559,6 +1608,8 @@ class vehicle
     private:
         mutable double coefficient_air_resistance = 1;
         mutable double coefficient_rolling_resistance = 1;
+        // Mass independent part of the rolling resistance, set in refresh()
+        double wheel_rolling_factor = 50;
         mutable double coefficient_water_resistance = 1;
         mutable double draft_m = 1;
         mutable double hull_height = 0.3;
@@ -1579,6 +1630,9 @@ class vehicle
         std::vector<int> funnels;          // List of funnel indices
         std::vector<int> emitters;         // List of emitter parts
         std::vector<int> loose_parts;      // List of UNMOUNT_ON_MOVE parts
+        std::vector<int> power_cables;     // List of UNMOUNT_ON_MOVE parts with POWER_TRANSFER
+        std::vector<int> batteries;        // List of battery parts, working or not
+        std::vector<int> structure_parts;  // List of parts in the structure location
         std::vector<int> wheelcache;       // List of wheels
         std::vector<int> rail_wheelcache;  // List of rail wheels
         std::vector<int> steering;         // List of STEERABLE parts
@@ -1595,7 +1649,7 @@ class vehicle
          */
         vproto_id type;
         // parts_at_relative(dp) is used a lot (to put it mildly)
-        std::map<point, std::vector<int>> relative_parts;
+        vehicle_mount_index relative_parts;
         std::set<label> labels;            // stores labels
         std::set<std::string> tags;        // Properties of the vehicle
         // After fuel consumption, this tracks the remainder of fuel < 1, and applies it the next time.
@@ -1676,6 +1730,8 @@ class vehicle
         bounding_box rail_wheel_bounding_box;
         // points used for rotation of mount precalc values
         std::array<point, 2> pivot_anchor;
+        // precalc values of every part, per rotation and pivot already seen; reset by refresh()
+        std::map<std::pair<int, point>, std::vector<point>> precalc_cache;
         // frame direction
         tileray face;
         // direction we are moving
@@ -1725,6 +1781,8 @@ class vehicle
         bool check_environmental_effects = false;
         // "inside" flags are outdated and need refreshing
         bool insides_dirty = true;
+        // Hash of the part layout the "inside" flags were last derived from, see refresh()
+        size_t insides_layout = 0;
         // Is the vehicle hanging in the air and expected to fall down in the next turn?
         bool is_falling = false;
         // zone_data positions are outdated and need refreshing
@@ -35,7 +35,6 @@
 #include "int_id.h"
 #include "monster.h"
 
-static const std::string part_location_structure( "structure" );
 static const itype_id fuel_type_muscle( "muscle" );
 static const itype_id fuel_type_animal( "animal" );
 
@@ -362,8 +361,10 @@ bool vehicle::collision( std::vector<veh_collision> &colls,
     const int velocity_before = coll_velocity;
     const int sign_before = sgn( velocity_before );
     bool empty = true;
-    for( int p = 0; static_cast<size_t>( p ) < parts.size(); p++ ) {
-        if( part_info( p ).location != part_location_structure || parts[ p ].removed ) {
+    // A copy, as damage dealt below can refresh the vehicle.
+    const std::vector<int> structure = structure_parts;
+    for( const int p : structure ) {
+        if( parts[ p ].removed ) {
             continue;
         }
         empty = false;
@@ -425,12 +426,9 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
     // Vertical collisions need to be handled differently
     // All collisions have to be either fully vertical or fully horizontal for now
     const bool vert_coll = bash_floor || p.z != sm_pos.z;
-    const bool pl_ctrl = player_in_control( g->u );
     Creature *critter = g->critter_at( p, true );
     player *ph = dynamic_cast<player *>( critter );
 
-    Creature *driver = pl_ctrl ? &g->u : nullptr;
-
     // If in a vehicle assume it's this one
     if( ph != nullptr && ph->in_vehicle ) {
         critter = nullptr;
@@ -540,6 +538,10 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
         return ret;
     }
 
+    // Only needed once something is actually hit, and most parts hit nothing.
+    const bool pl_ctrl = player_in_control( g->u );
+    Creature *driver = pl_ctrl ? &g->u : nullptr;
+
     // Calculate mass AFTER checking for collision
     //  because it involves iterating over all cargo
     const float mass = to_kilogram( total_mass() );
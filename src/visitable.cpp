@@ -158,9 +158,10 @@ bool visitable<T>::has_quality( const quality_id &qual, int level, int qty ) con
 template <>
 bool visitable<inventory>::has_quality( const quality_id &qual, int level, int qty ) const
 {
+    const auto &levels = static_cast<const inventory *>( this )->get_quality_levels( qual );
     int res = 0;
-    for( const auto &stack : static_cast<const inventory *>( this )->items ) {
-        res += stack.size() * has_quality_internal( stack.front(), qual, level, qty );
+    for( auto iter = levels.lower_bound( level ); iter != levels.end(); ++iter ) {
+        res = sum_no_wrap( res, iter->second );
         if( res >= qty ) {
             return true;
         }
@@ -248,6 +249,14 @@ int visitable<T>::max_quality( const quality_id &qual ) const
     return max_quality_internal( *this, qual );
 }
 
+/** @relates visitable */
+template<>
+int visitable<inventory>::max_quality( const quality_id &qual ) const
+{
+    const auto &levels = static_cast<const inventory *>( this )->get_quality_levels( qual );
+    return levels.empty() ? INT_MIN : levels.rbegin()->first;
+}
+
 /** @relates visitable */
 template<>
 int visitable<Character>::max_quality( const quality_id &qual ) const
@@ -17,6 +17,8 @@
 namespace
 {
 constexpr double tau = 2 * M_PI;
+// Enough for a few weeks of hourly samples over a large stockpile's worth of tiles.
+constexpr size_t max_cached_temperatures = 16384;
 } //namespace
 
 weather_generator::weather_generator() = default;
@@ -94,7 +96,18 @@ static double weather_temperature_from_common_data( const weather_generator &wg,
 double weather_generator::get_weather_temperature( const tripoint &location, const time_point &t,
         unsigned seed ) const
 {
-    return weather_temperature_from_common_data( *this, get_common_data( location, t, seed ), t );
+    const temperature_key key( location, to_turn<int>( t ), seed );
+    const auto iter = temperature_cache.find( key );
+    if( iter != temperature_cache.end() ) {
+        return iter->second;
+    }
+    if( temperature_cache.size() >= max_cached_temperatures ) {
+        temperature_cache.clear();
+    }
+    const double result = weather_temperature_from_common_data( *this, get_common_data( location, t,
+                          seed ), t );
+    temperature_cache.emplace( key, result );
+    return result;
 }
 w_point weather_generator::get_weather( const tripoint &location, const time_point &t,
                                         unsigned seed ) const
@@ -3,10 +3,13 @@
 #define WEATHER_GEN_H
 
 #include <string>
+#include <tuple>
+#include <unordered_map>
 
 #include "calendar.h"
+#include "hash_utils.h"
+#include "point.h"
 
-struct tripoint;
 class JsonObject;
 
 enum weather_type : int;
@@ -66,6 +69,15 @@ class weather_generator
         double get_weather_temperature( const tripoint &, const time_point &, unsigned ) const;
 
         static weather_generator load( JsonObject &jo );
+
+    private:
+        using temperature_key = std::tuple<tripoint, int, unsigned>;
+        /**
+         * Results of @ref get_weather_temperature, which is pure noise and gets asked
+         * the same questions over and over when catching up items left out of the
+         * reality bubble. Dropped wholesale once it grows too large.
+         */
+        mutable std::unordered_map<temperature_key, double, cata::tuple_hash> temperature_cache;
 };
 
 #endif
@@ -117,11 +117,25 @@ worldfactory::worldfactory()
 
 worldfactory::~worldfactory() = default;
 
+// The saves are the entries of the directory, so its own stamp changes with them. Where the
+// times only have whole seconds that can miss a save added right after the last scan, which
+// the count of saves still catches.
+static std::string world_stamp( const std::string &world_dir, const size_t save_count )
+{
+    return std::to_string( save_count ) + " " + file_stamp( world_dir ) + " " +
+           file_stamp( world_dir + "/" + FILENAMES["worldoptions"] ) + " " +
+           file_stamp( world_dir + "/" + FILENAMES["legacy_worldoptions"] ) + " " +
+           file_stamp( world_dir + "/mods.json" );
+}
+
 WORLDPTR worldfactory::add_world( std::unique_ptr<WORLD> retworld )
 {
     if( !retworld->save() ) {
         return nullptr;
     }
+    // So the next init keeps it, unless something changes it on disk
+    world_stamps[retworld->world_name] = world_stamp( retworld->folder_path(),
+                                         retworld->world_saves.size() );
     return ( all_worlds[ retworld->world_name ] = std::move( retworld ) ).get();
 }
 
@@ -198,16 +212,13 @@ WORLDPTR worldfactory::make_new_world( special_game_id special_type )
 
     special_world->WORLD_OPTIONS["WORLD_END"].setValue( "delete" );
 
-    if( !special_world->save() ) {
-        return nullptr;
-    }
-
-    return ( all_worlds[worldname] = std::move( special_world ) ).get();
+    return add_world( std::move( special_world ) );
 }
 
 void worldfactory::set_active_world( WORLDPTR world )
 {
     world_generator->active_world = world;
+    invalidate_cached_options();
 }
 
 bool WORLD::save( const bool is_conversion ) const
@@ -259,24 +270,38 @@ void worldfactory::init()
     qualifiers.push_back( FILENAMES["legacy_worldoptions"] );
     qualifiers.push_back( SAVE_MASTER );
 
-    all_worlds.clear();
+    // Worlds that haven't changed on disk since they were read are kept as they are
+    std::map<std::string, std::unique_ptr<WORLD>> previous_worlds;
+    std::map<std::string, std::string> previous_stamps;
+    previous_worlds.swap( all_worlds );
+    previous_stamps.swap( world_stamps );
 
     // get the master files. These determine the validity of a world
     // worlds exist by having an option file
     // create worlds
     for( const auto &world_dir : get_directories_with( qualifiers, FILENAMES["savedir"], true ) ) {
+        // the directory name is the name of the world
+        std::string worldname;
+        size_t name_index = world_dir.find_last_of( "/\\" );
+        worldname = native_to_utf8( world_dir.substr( name_index + 1 ) );
+
         // get the save files
         auto world_sav_files = get_files_from_path( SAVE_EXTENSION, world_dir, false );
+
+        const auto previous = previous_worlds.find( worldname );
+        if( previous != previous_worlds.end() &&
+            previous_stamps[worldname] == world_stamp( world_dir, world_sav_files.size() ) ) {
+            all_worlds[worldname] = std::move( previous->second );
+            world_stamps[worldname] = previous_stamps[worldname];
+            continue;
+        }
+
         // split the save file names between the directory and the extension
         for( auto &world_sav_file : world_sav_files ) {
             size_t save_index = world_sav_file.find( SAVE_EXTENSION );
             world_sav_file = world_sav_file.substr( world_dir.size() + 1,
                                                     save_index - ( world_dir.size() + 1 ) );
         }
-        // the directory name is the name of the world
-        std::string worldname;
-        size_t name_index = world_dir.find_last_of( "/\\" );
-        worldname = native_to_utf8( world_dir.substr( name_index + 1 ) );
 
         // create and store the world
         all_worlds[worldname] = std::make_unique<WORLD>();
@@ -294,6 +319,8 @@ void worldfactory::init()
             all_worlds[worldname]->WORLD_OPTIONS["WORLD_END"].setValue( "delete" );
             all_worlds[worldname]->save();
         }
+        // Taken after the loading, which may have rewritten the files
+        world_stamps[worldname] = world_stamp( world_dir, world_sav_files.size() );
     }
 
     // check to see if there exists a worldname "save" which denotes that a world exists in the save
@@ -539,6 +566,7 @@ void worldfactory::remove_world( const std::string &worldname )
         WORLDPTR wptr = it->second.get();
         if( active_world == wptr ) {
             active_world = nullptr;
+            invalidate_cached_options();
         }
         all_worlds.erase( it );
     }
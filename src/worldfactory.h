@@ -130,6 +130,11 @@ class worldfactory
 
     private:
         std::map<std::string, std::unique_ptr<WORLD>> all_worlds;
+        /**
+         * The stamps of the files each world in all_worlds was read from, init only reads
+         * the worlds whose files changed since.
+         */
+        std::map<std::string, std::string> world_stamps;
 
         void load_last_world_info();
 
@@ -0,0 +1,24 @@
+#include "catch/catch.hpp"
+#include "active_item_cache.h"
+#include "item.h"
+#include "point.h"
+
+TEST_CASE( "active_item_cache_empties_after_removal", "[item]" )
+{
+    active_item_cache cache;
+    item torch( "torch_lit" );
+    item rock( "rock" );
+
+    // Removing an item that was never added must not leave anything behind.
+    cache.remove( &rock );
+    CHECK( cache.empty() );
+
+    cache.add( torch, point_zero );
+    CHECK_FALSE( cache.empty() );
+    CHECK( cache.get().size() == 1 );
+    CHECK( cache.get_for_processing().size() == 1 );
+
+    cache.remove( &torch );
+    CHECK( cache.empty() );
+    CHECK( cache.get().empty() );
+}
@@ -0,0 +1,67 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "calendar.h"
+#include "item.h"
+#include "json.h"
+
+static std::vector<item> sample_items()
+{
+    std::vector<item> items;
+    items.emplace_back( "rock" );
+    items.emplace_back( "hammer" );
+    items.emplace_back( "backpack" );
+    items.emplace_back( "glock_19" );
+    item bottle( "bottle_plastic" );
+    bottle.put_in( item( "water", calendar::turn_zero, 2 ) );
+    items.push_back( bottle );
+    return items;
+}
+
+TEST_CASE( "item_tname_benchmark", "[benchmark]" )
+{
+    const std::vector<item> items = sample_items();
+
+    BENCHMARK( "tname" ) {
+        std::string names;
+        for( const item &it : items ) {
+            names += it.tname();
+        }
+        return names;
+    };
+}
+
+TEST_CASE( "json_parse_benchmark", "[benchmark]" )
+{
+    const std::vector<item> items = sample_items();
+    std::ostringstream os;
+    JsonOut jsout( os );
+    jsout.start_array();
+    for( int i = 0; i < 200; ++i ) {
+        for( const item &it : items ) {
+            it.serialize( jsout );
+        }
+    }
+    jsout.end_array();
+    const std::string json = os.str();
+
+    BENCHMARK( "skip values" ) {
+        std::istringstream is( json );
+        JsonIn jsin( is );
+        jsin.skip_value();
+    };
+
+    BENCHMARK( "deserialize items" ) {
+        std::istringstream is( json );
+        JsonIn jsin( is );
+        std::vector<item> read;
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            read.emplace_back();
+            read.back().deserialize( jsin );
+        }
+        return read.size();
+    };
+}
@@ -0,0 +1,115 @@
+#include <vector>
+
+#include "avatar.h"
+#include "catch/catch.hpp"
+#include "field.h"
+#include "game.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapdata.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "scent_map.h"
+#include "type_id.h"
+#include "vehicle.h"
+
+// Every benchmark here starts from a cleared map with the same layout, so runs can be compared.
+
+// Rows of wall with a gap at alternating ends, so routes have to snake through the whole map.
+static void build_wall_maze()
+{
+    clear_map();
+    for( int y = 6; y < MAPSIZE_Y - 6; y += 6 ) {
+        const bool gap_left = y % 12 == 0;
+        for( int x = 0; x < MAPSIZE_X; ++x ) {
+            if( gap_left ? x > 3 : x < MAPSIZE_X - 4 ) {
+                g->m.ter_set( tripoint( x, y, 0 ), t_wall );
+            }
+        }
+    }
+    g->m.invalidate_map_cache( 0 );
+    g->m.build_map_cache( 0, true );
+}
+
+TEST_CASE( "map_route_benchmark", "[benchmark]" )
+{
+    build_wall_maze();
+    const pathfinding_settings settings( 0, 1000, 10000, 0, false, false, false, false );
+    const tripoint from( 1, 1, 0 );
+    const tripoint to( MAPSIZE_X - 2, MAPSIZE_Y - 2, 0 );
+    REQUIRE_FALSE( g->m.route( from, to, settings ).empty() );
+
+    BENCHMARK( "route through a maze" ) {
+        return g->m.route( from, to, settings );
+    };
+}
+
+TEST_CASE( "map_cache_benchmark", "[benchmark]" )
+{
+    build_wall_maze();
+    const int z = g->u.posz();
+
+    BENCHMARK( "transparency cache" ) {
+        g->m.set_transparency_cache_dirty( z );
+        g->m.build_map_cache( z, true );
+    };
+
+    // A handful of fires, so the lightmap has light sources besides the sun
+    for( int i = 0; i < 10; ++i ) {
+        g->m.add_field( tripoint( 10 + i * 10, 20 + i * 8, z ), fd_fire, 2 );
+    }
+    BENCHMARK( "lightmap" ) {
+        g->m.build_map_cache( z );
+    };
+    clear_fields( z );
+}
+
+TEST_CASE( "map_process_fields_benchmark", "[benchmark]" )
+{
+    build_wall_maze();
+    const int z = g->u.posz();
+    std::vector<tripoint> sources;
+    for( int x = 10; x < MAPSIZE_X - 10; x += 12 ) {
+        for( int y = 8; y < MAPSIZE_Y - 8; y += 12 ) {
+            sources.emplace_back( x, y, z );
+        }
+    }
+
+    BENCHMARK( "smoke fields" ) {
+        // Fields spread and decay, keep topping them up so every run sees a similar load
+        for( const tripoint &p : sources ) {
+            g->m.add_field( p, fd_smoke, 3 );
+        }
+        return g->m.process_fields();
+    };
+    clear_fields( z );
+}
+
+TEST_CASE( "scent_map_update_benchmark", "[benchmark]" )
+{
+    build_wall_maze();
+    scent_map &scent = g->scent;
+    scent.reset();
+    const tripoint center = g->u.pos();
+
+    BENCHMARK( "scent diffusion" ) {
+        scent.set( center, 1000 );
+        scent.update( center, g->m );
+    };
+    scent.reset();
+}
+
+TEST_CASE( "vehicle_refresh_benchmark", "[benchmark]" )
+{
+    clear_map();
+    vehicle *veh = g->m.add_vehicle( vproto_id( "car" ), g->u.pos() + point( 10, 0 ), 0, 0, 0 );
+    REQUIRE( veh != nullptr );
+
+    // The way mapgen and part installation refresh a vehicle, with all cached values dirty
+    BENCHMARK( "car refresh" ) {
+        veh->suspend_refresh();
+        veh->enable_refresh();
+    };
+    g->m.destroy_vehicle( veh );
+}
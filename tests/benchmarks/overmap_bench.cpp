@@ -0,0 +1,21 @@
+#include <memory>
+
+#include "catch/catch.hpp"
+#include "overmap.h"
+#include "point.h"
+#include "rng.h"
+
+TEST_CASE( "overmap_generation_benchmark", "[benchmark]" )
+{
+    // Kept out of the overmap buffer, so it doesn't grow with every run
+    const point pos( 5, 5 );
+
+    BENCHMARK( "generate overmap" ) {
+        // The same seed for every run, so each one generates the same overmap
+        rng_set_engine_seed( 1 );
+        std::unique_ptr<overmap> om = std::make_unique<overmap>( pos );
+        overmap_special_batch specials = overmap_specials::get_default_batch( pos );
+        om->populate( specials );
+        return om;
+    };
+}
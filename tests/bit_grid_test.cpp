@@ -0,0 +1,27 @@
+#include "catch/catch.hpp"
+#include "bit_grid.h"
+#include "point.h"
+
+TEST_CASE( "bit_grid", "[bit_grid]" )
+{
+    bit_grid<5, 3> grid;
+    grid.fill( false );
+    CHECK( grid.none() );
+
+    grid.set( point( 4, 2 ) );
+    grid.set( point( 0, 1 ) );
+    CHECK( grid.count() == 2 );
+    CHECK( grid.get( point( 4, 2 ) ) );
+    CHECK( grid.get( point( 0, 1 ) ) );
+    // Neighbours in both directions are separate cells
+    CHECK_FALSE( grid.get( point( 1, 0 ) ) );
+    CHECK_FALSE( grid.get( point( 0, 2 ) ) );
+
+    grid.set( point( 4, 2 ), false );
+    CHECK_FALSE( grid.get( point( 4, 2 ) ) );
+    grid.reset( point( 0, 1 ) );
+    CHECK( grid.none() );
+
+    grid.fill( true );
+    CHECK( grid.count() == 15 );
+}
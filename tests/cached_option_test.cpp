@@ -0,0 +1,15 @@
+#include "catch/catch.hpp"
+#include "options.h"
+
+TEST_CASE( "cached_options_follow_changed_options", "[options]" )
+{
+    options_manager::cOpt &opt = get_options().get_option( "PLAYER_THIRST_RATE" );
+    const float original = opt.value_as<float>();
+    const cached_option<float> cached( "PLAYER_THIRST_RATE" );
+    CHECK( cached.get() == original );
+
+    opt.setValue( 2.0f );
+    CHECK( cached.get() == 2.0f );
+    opt.setValue( original );
+    CHECK( cached.get() == original );
+}
@@ -1,5 +1,9 @@
+#include <ostream>
+
 #include "catch/catch.hpp"
 #include "cata_utility.h"
+#include "filesystem.h"
+#include "path_info.h"
 #include "units.h"
 
 TEST_CASE( "string_starts_with", "[utility]" )
@@ -39,3 +43,17 @@ TEST_CASE( "divide_round_up_units", "[utility]" )
     CHECK( divide_round_up( 5_ml, 5_ml ) == 1 );
     CHECK( divide_round_up( 6_ml, 5_ml ) == 2 );
 }
+
+TEST_CASE( "written_files_are_counted", "[utility]" )
+{
+    const std::string path = FILENAMES["config_dir"] + "written_totals_test.txt";
+    // The map buffer may still be writing on its own thread, only this one is known
+    const written_totals before = written_on_this_thread();
+    REQUIRE( write_to_file( path, []( std::ostream & fout ) {
+        fout << "0123456789";
+    }, nullptr ) );
+    const written_totals after = written_on_this_thread();
+    CHECK( after.files == before.files + 1 );
+    CHECK( after.bytes == before.bytes + 10 );
+    remove_file( path );
+}
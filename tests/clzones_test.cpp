@@ -0,0 +1,41 @@
+#include "catch/catch.hpp"
+#include "clzones.h"
+#include "faction.h"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "optional.h"
+#include "point.h"
+
+TEST_CASE( "zone_queries_use_the_zone_boxes", "[zones]" )
+{
+    clear_map();
+    zone_manager mgr;
+    const zone_type_id wood( "LOOT_WOOD" );
+    const zone_type_id food( "LOOT_FOOD" );
+    const tripoint origin = g->m.getabs( tripoint( 30, 30, 0 ) );
+    mgr.add( "wood", wood, your_fac, false, true, origin, origin + point( 4, 2 ) );
+    mgr.add( "more wood", wood, your_fac, false, true, origin + point( 20, 0 ),
+             origin + point( 20, 0 ) );
+    mgr.add( "disabled", food, your_fac, false, false, origin, origin );
+
+    CHECK( mgr.has_defined( wood ) );
+    CHECK_FALSE( mgr.has_defined( food ) );
+    CHECK( mgr.has( wood, origin + point( 4, 2 ) ) );
+    CHECK_FALSE( mgr.has( wood, origin + point( 5, 2 ) ) );
+    CHECK_FALSE( mgr.has( food, origin ) );
+
+    // Distance to the nearest corner, on the same level only
+    CHECK( mgr.has_near( wood, origin + point( 7, -3 ), 3 ) );
+    CHECK_FALSE( mgr.has_near( wood, origin + point( 8, -3 ), 3 ) );
+    CHECK_FALSE( mgr.has_near( wood, origin + tripoint( 0, 0, 1 ), 3 ) );
+
+    const cata::optional<tripoint> nearest = mgr.get_nearest( wood, origin + point( 11, 1 ), 10 );
+    REQUIRE( nearest );
+    CHECK( *nearest == origin + point( 4, 1 ) );
+    CHECK_FALSE( mgr.get_nearest( wood, origin + point( 12, 10 ), 5 ) );
+
+    // Only the parts of the zones that are in range
+    CHECK( mgr.get_near( wood, origin + point( 5, 1 ), 2 ).size() == 6 );
+    CHECK( mgr.get_near( wood, origin + point( 12, 1 ), 8 ).size() == 4 );
+}
@@ -52,3 +52,27 @@ TEST_CASE( "destroy_bus_before_subscriber", "[event]" )
                   character_id( 5 ), mtype_id( "zombie" ) ) );
     CHECK( sub.events.size() == 1 );
 }
+
+struct kills_only_subscriber : public test_subscriber {
+    bool wants_event( event_type type ) const override {
+        return type == event_type::character_kills_monster;
+    }
+};
+
+TEST_CASE( "bus_only_delivers_wanted_events", "[event]" )
+{
+    event_bus bus;
+    kills_only_subscriber sub;
+    bus.subscribe( &sub );
+
+    bus.send( cata::event::make<event_type::character_kills_monster>(
+                  character_id( 5 ), mtype_id( "zombie" ) ) );
+    bus.send( cata::event::make<event_type::avatar_moves>( mtype_id( "mon_horse" ) ) );
+    REQUIRE( sub.events.size() == 1 );
+    CHECK( sub.events[0].type() == event_type::character_kills_monster );
+
+    bus.unsubscribe( &sub );
+    bus.send( cata::event::make<event_type::character_kills_monster>(
+                  character_id( 5 ), mtype_id( "zombie" ) ) );
+    CHECK( sub.events.size() == 1 );
+}
@@ -104,4 +104,20 @@ TEST_CASE( "fold-string" )
         };
         check_equal( folded.begin(), folded.end(), expected.begin(), expected.end() );
     }
+
+    SECTION( "Case 6 - test repeated folding of the same text" ) {
+        // Results are cached, they must still depend on the width and the split character
+        const std::string text = "one,two three,four";
+        const std::vector<std::string> wide = foldstring( text, 18 );
+        const std::vector<std::string> narrow = foldstring( text, 9 );
+        const std::vector<std::string> by_comma = foldstring( text, 9, ',' );
+        CHECK( wide == std::vector<std::string>( { text } ) );
+        REQUIRE( narrow.size() > 1 );
+        CHECK( narrow.front() == "one,two " );
+        CHECK( by_comma.front() == "one," );
+        CHECK( foldstring( text, 9, ',' ) == by_comma );
+        CHECK( foldstring( text, 9 ) == narrow );
+        CHECK( foldstring( text, 18 ) == wide );
+        CHECK( foldstring( "", 10 ).empty() );
+    }
 }
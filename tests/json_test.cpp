@@ -1,5 +1,7 @@
 #include "json.h"
 
+#include <cstdint>
+#include <limits>
 #include <list>
 #include <sstream>
 
@@ -69,3 +71,74 @@ TEST_CASE( "serialize_set", "[json]" )
     std::set<body_part> enum_set = { bp_foot_l };
     test_serialization( enum_set, string_format( R"([%d])", static_cast<int>( bp_foot_l ) ) );
 }
+
+TEST_CASE( "serialize_numbers", "[json]" )
+{
+    test_serialization( 0, "0" );
+    test_serialization( -42, "-42" );
+    test_serialization( std::numeric_limits<int>::min(), "-2147483648" );
+    test_serialization( true, "true" );
+
+    // JsonIn can't read these back, only check the writing.
+    std::ostringstream os;
+    JsonOut jsout( os );
+    jsout.write( std::numeric_limits<int64_t>::min() );
+    jsout.write( std::numeric_limits<uint64_t>::max() );
+    CHECK( os.str() == "-9223372036854775808,18446744073709551615" );
+}
+
+TEST_CASE( "serialize_escaped_strings", "[json]" )
+{
+    test_serialization( std::string(), R"("")" );
+    test_serialization( std::string( "a \"quoted\" \\path/" ), R"("a \"quoted\" \\path/")" );
+    test_serialization( std::string( "line\nbreak\ttab\x01" ), R"("line\nbreak\ttab\u0001")" );
+}
+
+TEST_CASE( "deserialize_numbers_and_long_strings", "[json]" )
+{
+    const std::string long_string( 1000, 'x' );
+    std::istringstream is( "[ 1.5, -2.25e2, 3E+1, 0.125, \"" + long_string + "\\n\" ]" );
+    JsonIn jsin( is );
+    jsin.start_array();
+    CHECK( jsin.get_float() == Approx( 1.5 ) );
+    CHECK( jsin.get_float() == Approx( -225 ) );
+    CHECK( jsin.get_int() == 30 );
+    CHECK( jsin.get_float() == Approx( 0.125 ) );
+    CHECK( jsin.get_string() == long_string + "\n" );
+    CHECK( jsin.end_array() );
+    // A number can end the stream
+    std::istringstream last( "17" );
+    JsonIn last_jsin( last );
+    CHECK( last_jsin.get_int() == 17 );
+
+    std::istringstream bad( "[ 01 ]" );
+    JsonIn bad_jsin( bad );
+    bad_jsin.start_array();
+    CHECK_THROWS_AS( bad_jsin.get_float(), JsonError );
+}
+
+TEST_CASE( "unterminated_strings_are_errors", "[json]" )
+{
+    std::istringstream is( R"(  "no end)" );
+    JsonIn jsin( is );
+    CHECK_THROWS_AS( jsin.get_string(), JsonError );
+}
+
+TEST_CASE( "json_object_member_lookup", "[json]" )
+{
+    std::istringstream is( R"({"a":1,"b":"two","//":"x","//":"y"})" );
+    JsonIn jsin( is );
+    JsonObject jo = jsin.get_object();
+    CHECK( jo.get_int( "a" ) == 1 );
+    CHECK( jo.get_string( "b" ) == "two" );
+    CHECK( jo.get_string( "//" ) == "y" );
+    CHECK( jo.get_int( "missing", 7 ) == 7 );
+    CHECK_FALSE( jo.has_member( "missing" ) );
+    // Looking up missing members doesn't add them.
+    CHECK( jo.size() == 3 );
+    CHECK( jo.get_member_names() == std::set<std::string> { "a", "b", "//" } );
+
+    std::istringstream dup( R"({"a":1,"a":2})" );
+    JsonIn dup_jsin( dup );
+    CHECK_THROWS_AS( dup_jsin.get_object(), JsonError );
+}
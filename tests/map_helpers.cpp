@@ -55,11 +55,13 @@ void clear_npcs()
 void clear_fields( const int zlevel )
 {
     const int mapsize = g->m.getmapsize() * SEEX;
+    // Reading through const access leaves the fields of empty submaps unallocated
+    const map &here = g->m;
     for( int x = 0; x < mapsize; ++x ) {
         for( int y = 0; y < mapsize; ++y ) {
             const tripoint p( x, y, zlevel );
             std::vector<field_type_id> fields;
-            for( auto &pr : g->m.field_at( p ) ) {
+            for( auto &pr : here.field_at( p ) ) {
                 fields.push_back( pr.second.get_field_type() );
             }
             for( field_type_id f : fields ) {
@@ -0,0 +1,40 @@
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "item.h"
+#include "map_item_stack.h"
+#include "point.h"
+
+static std::vector<std::string> names( const std::vector<map_item_stack> &stacks )
+{
+    std::vector<std::string> ret;
+    for( const map_item_stack &s : stacks ) {
+        ret.push_back( s.example->typeId() );
+    }
+    return ret;
+}
+
+TEST_CASE( "item_list_priorities_keep_the_order_within_each_part", "[item_list]" )
+{
+    std::vector<item> items = { item( "rock" ), item( "stick" ), item( "rag" ), item( "rock" ),
+                                item( "pebble" ), item( "stick" )
+                              };
+    std::vector<map_item_stack> stacks;
+    for( item &it : items ) {
+        stacks.emplace_back( &it, tripoint_zero );
+    }
+
+    const int high_end = list_filter_high_priority( stacks, "stick" );
+    CHECK( high_end == 2 );
+    const int low_start = list_filter_low_priority( stacks, high_end, "rock" );
+    CHECK( low_start == 4 );
+    CHECK( names( stacks ) == std::vector<std::string>( {
+        "stick", "stick", "rag", "pebble", "rock", "rock"
+    } ) );
+
+    // No priorities leave everything where it is
+    CHECK( list_filter_high_priority( stacks, "" ) == 0 );
+    CHECK( list_filter_low_priority( stacks, 0, "" ) == 6 );
+    CHECK( names( stacks ).front() == "stick" );
+}
@@ -90,6 +90,66 @@ TEST_CASE( "map_memory_survives_save_lod", "[map_memory]" )
     CHECK( memory.get_symbol( p3 ) == memory2.get_symbol( p3 ) );
 }
 
+TEST_CASE( "map_memory_forgets_whole_submaps", "[map_memory]" )
+{
+    map_memory memory;
+    const tripoint first_sm_tile( 1, 1, 0 );
+    const tripoint second_sm_tile( SEEX + 1, 1, 0 );
+    memory.memorize_tile( 3, first_sm_tile, "t_dirt", 1, 2 );
+    memory.memorize_tile( 3, first_sm_tile + point_east, "t_grass", 0, 0 );
+    memory.memorize_tile( 3, second_sm_tile, "t_wall", 0, 3 );
+    CHECK( memory.get_tile( first_sm_tile ).tile == "t_dirt" );
+    CHECK( memory.get_tile( second_sm_tile ).tile == "t_wall" );
+    // Over the limit, the submap used longest ago goes
+    memory.memorize_tile( 3, second_sm_tile + point_east, "t_wall", 0, 3 );
+    CHECK( memory.get_tile( first_sm_tile ).tile.empty() );
+    CHECK( memory.get_tile( first_sm_tile + point_east ).tile.empty() );
+    CHECK( memory.get_tile( second_sm_tile ).tile == "t_wall" );
+    CHECK( memory.get_tile( second_sm_tile + point_east ).tile == "t_wall" );
+}
+
+TEST_CASE( "map_memory_tiles_survive_save_load", "[map_memory]" )
+{
+    map_memory memory;
+    const tripoint p( -3, 5, -1 );
+    memory.memorize_tile( 100, p, "t_dirt", 4, 3 );
+    memory.memorize_tile( 100, p + point_south, "t_door_c", 0, 1 );
+    memory.memorize_symbol( 100, p, 'x' );
+    memory.memorize_tile( 100, p + point_east, "t_dirt", 1, 2 );
+    memory.clear_memorized_tile( p + point_east );
+
+    std::ostringstream jsout_s;
+    JsonOut jsout( jsout_s );
+    memory.store( jsout );
+    INFO( "Json was: " << jsout_s.str() );
+    std::istringstream jsin_s( jsout_s.str() );
+    JsonIn jsin( jsin_s );
+    map_memory memory2;
+    memory2.load( jsin );
+
+    const memorized_terrain_tile t = memory2.get_tile( p );
+    CHECK( t.tile == "t_dirt" );
+    CHECK( t.subtile == 4 );
+    CHECK( t.rotation == 3 );
+    CHECK( memory2.get_tile( p + point_south ).tile == "t_door_c" );
+    CHECK( memory2.get_tile( p + point_south ).rotation == 1 );
+    CHECK( memory2.get_tile( p + point_east ).tile.empty() );
+    CHECK( memory2.get_symbol( p ) == 'x' );
+    CHECK( memory2.get_symbol( p + point_south ) == 0 );
+}
+
+TEST_CASE( "map_memory_loads_the_tile_per_entry_format", "[map_memory]" )
+{
+    std::istringstream jsin_s( R"([[[1,2,0,"t_dirt",1,2],[-1,-2,0,"t_wall",0,1]],[[1,2,0,120]]])" );
+    JsonIn jsin( jsin_s );
+    map_memory memory;
+    memory.load( jsin );
+    CHECK( memory.get_tile( { 1, 2, 0 } ).tile == "t_dirt" );
+    CHECK( memory.get_tile( { 1, 2, 0 } ).rotation == 2 );
+    CHECK( memory.get_tile( { -1, -2, 0 } ).tile == "t_wall" );
+    CHECK( memory.get_symbol( { 1, 2, 0 } ) == 120 );
+}
+
 #include <chrono>
 
 TEST_CASE( "lru_cache_perf", "[.]" )
@@ -1,14 +1,23 @@
+#include <algorithm>
 #include <memory>
 
 #include "avatar.h"
 #include "catch/catch.hpp"
+#include "coordinate_conversions.h"
+#include "field.h"
 #include "game.h"
+#include "item.h"
 #include "map.h"
+#include "mapbuffer.h"
 #include "map_helpers.h"
+#include "submap.h"
 #include "enums.h"
+#include "lightmap.h"
 #include "game_constants.h"
 #include "type_id.h"
 #include "point.h"
+#include "pathfinding.h"
+#include "line.h"
 
 TEST_CASE( "destroy_grabbed_furniture" )
 {
@@ -78,3 +87,260 @@ TEST_CASE( "tinymap_bounds_checking" )
         }
     }
 }
+
+TEST_CASE( "transparency_cache_rebuilds_only_dirty_submaps" )
+{
+    clear_map();
+    map &here = g->m;
+    const tripoint test_origin( 60, 60, 0 );
+    const tripoint wall_pos( 40, 40, 0 );
+    const int z = test_origin.z;
+    g->u.setpos( test_origin );
+    here.build_map_cache( z );
+    const level_cache &cache = here.get_cache_ref( z );
+    REQUIRE( cache.transparency_cache_dirty.none() );
+    REQUIRE( cache.transparency_cache[wall_pos.x][wall_pos.y] > LIGHT_TRANSPARENCY_SOLID );
+
+    here.ter_set( wall_pos, ter_id( "t_wall" ) );
+    CHECK( cache.transparency_cache_dirty.count() == 1 );
+    CHECK( cache.transparency_cache_dirty[wall_pos.x / SEEX + ( wall_pos.y / SEEY ) * MAPSIZE] );
+
+    here.build_map_cache( z );
+    CHECK( cache.transparency_cache_dirty.none() );
+    CHECK( cache.transparency_cache[wall_pos.x][wall_pos.y] == LIGHT_TRANSPARENCY_SOLID );
+}
+
+TEST_CASE( "shifted_map_keeps_submaps_at_their_position" )
+{
+    clear_map();
+    map &here = g->m;
+    const tripoint wall_pos( 60, 60, 0 );
+    const tripoint abs_sub = here.get_abs_sub();
+    here.ter_set( wall_pos, ter_id( "t_wall" ) );
+
+    here.shift( point_east );
+    here.shift( point_south );
+    CHECK( here.ter( wall_pos - point( SEEX, SEEY ) ) == ter_id( "t_wall" ) );
+    CHECK( here.ter( wall_pos ) != ter_id( "t_wall" ) );
+
+    // All the way around the ring of submaps and back
+    for( int i = 0; i < MAPSIZE + 2; ++i ) {
+        here.shift( point_west );
+    }
+    for( int i = 0; i < MAPSIZE + 1; ++i ) {
+        here.shift( point_east );
+    }
+    here.shift( point_north );
+    CHECK( here.get_abs_sub() == abs_sub );
+    CHECK( here.ter( wall_pos ) == ter_id( "t_wall" ) );
+}
+
+TEST_CASE( "batched_sees_matches_single_sees" )
+{
+    clear_map();
+    map &here = g->m;
+    const tripoint target( 60, 60, 0 );
+    g->u.setpos( target + tripoint( 0, 20, 0 ) );
+    here.ter_set( target + tripoint( 0, 3, 0 ), ter_id( "t_wall" ) );
+    here.build_map_cache( target.z );
+
+    const std::vector<tripoint> observers = {
+        target + tripoint( 5, 0, 0 ), target + tripoint( 0, 6, 0 ),
+        target + tripoint( -30, 0, 0 ), target + tripoint( 4, 4, 0 )
+    };
+    const int range = 10;
+    const std::vector<bool> batched = here.sees( observers, target, range );
+    REQUIRE( batched.size() == observers.size() );
+    CHECK( batched[0] );
+    // Behind the wall.
+    CHECK_FALSE( batched[1] );
+    // Out of range.
+    CHECK_FALSE( batched[2] );
+    for( size_t i = 0; i < observers.size(); i++ ) {
+        CHECK( batched[i] == here.sees( observers[i], target, range ) );
+    }
+}
+
+// What route() charges for walking `path` from `from` over plain floor.
+static int plain_path_cost( const tripoint &from, const std::vector<tripoint> &path )
+{
+    int cost = 0;
+    tripoint prev = from;
+    for( const tripoint &p : path ) {
+        REQUIRE( square_dist( prev, p ) == 1 );
+        cost += 2 + ( ( prev.x != p.x && prev.y != p.y ) ? 1 : 0 );
+        prev = p;
+    }
+    return cost;
+}
+
+TEST_CASE( "shared_routes_are_as_cheap_as_route" )
+{
+    clear_map();
+    map &here = g->m;
+    const tripoint target( 60, 60, 0 );
+    // A wall between the chasers and the target, with a gap at one end
+    for( int y = 50; y < 68; y++ ) {
+        here.ter_set( tripoint( 55, y, 0 ), ter_id( "t_wall" ) );
+    }
+    const pathfinding_settings settings( 0, 40, 200, 0, false, false, false, false );
+
+    // The first requests are plain A*, the later ones read the shared flow field
+    for( int y = 52; y < 62; y++ ) {
+        const tripoint chaser( 50, y, 0 );
+        const std::vector<tripoint> shared = here.route_shared( chaser, target, settings );
+        const std::vector<tripoint> single = here.route( chaser, target, settings );
+        REQUIRE_FALSE( single.empty() );
+        REQUIRE_FALSE( shared.empty() );
+        CHECK( shared.back() == target );
+        CHECK( plain_path_cost( chaser, shared ) == plain_path_cost( chaser, single ) );
+    }
+}
+
+TEST_CASE( "route_finds_way_around_long_walls" )
+{
+    clear_map();
+    map &here = g->m;
+    // The only way around is far beyond the 16 tiles route pads its search area with
+    for( int y = 20; y < MAPSIZE_Y; y++ ) {
+        here.ter_set( tripoint( 35, y, 0 ), ter_id( "t_wall" ) );
+    }
+    const tripoint from( 30, 60, 0 );
+    const tripoint to( 40, 60, 0 );
+    const pathfinding_settings settings( 0, 100, 500, 0, false, false, false, false );
+
+    const std::vector<tripoint> path = here.route( from, to, settings );
+    REQUIRE_FALSE( path.empty() );
+    CHECK( path.back() == to );
+    plain_path_cost( from, path );
+    bool went_around = false;
+    for( const tripoint &p : path ) {
+        CHECK( here.ter( p ) != ter_id( "t_wall" ) );
+        went_around |= p.y < 20;
+    }
+    CHECK( went_around );
+}
+
+TEST_CASE( "route_follows_terrain_changed_after_caching" )
+{
+    clear_map();
+    map &here = g->m;
+    const tripoint from( 60, 60, 0 );
+    const tripoint to( 66, 60, 0 );
+    const pathfinding_settings settings( 0, 100, 500, 0, false, false, false, false );
+    // Caches the whole level
+    REQUIRE( here.route( from, to, settings ).size() == 6 );
+
+    // Only the submap with the new wall gets recomputed, the route must still see it
+    const tripoint wall( 63, 60, 0 );
+    here.ter_set( wall, ter_id( "t_wall" ) );
+    const std::vector<tripoint> path = here.route( from, to, settings );
+    REQUIRE_FALSE( path.empty() );
+    CHECK( path.back() == to );
+    CHECK( std::find( path.begin(), path.end(), wall ) == path.end() );
+
+    here.ter_set( wall, ter_id( "t_floor" ) );
+    CHECK( here.route( from, to, settings ).size() == 6 );
+}
+
+static int seen_tiles_around( const tripoint &center )
+{
+    const level_cache &cache = g->m.get_cache_ref( center.z );
+    int seen = 0;
+    for( int x = center.x - 3; x <= center.x + 3; ++x ) {
+        for( int y = center.y - 3; y <= center.y + 3; ++y ) {
+            seen += cache.seen_cache[x][y] > LIGHT_TRANSPARENCY_SOLID;
+        }
+    }
+    return seen;
+}
+
+TEST_CASE( "seen_cache_is_rebuilt_when_vision_turns_3d" )
+{
+    clear_map();
+    map &here = g->m;
+    if( !here.has_zlevels() ) {
+        return;
+    }
+    const bool old_fov_3d = fov_3d;
+    const int old_range = fov_3d_z_range;
+    const tripoint origin( 60, 60, 0 );
+    g->u.setpos( origin );
+
+    // Out of range, the level above is only filled as unseen
+    fov_3d = true;
+    fov_3d_z_range = 0;
+    here.build_map_cache( origin.z );
+    REQUIRE( seen_tiles_around( origin + tripoint_above ) == 0 );
+
+    // 2D vision leaves the other levels alone, turning 3D back on has to cast again
+    fov_3d = false;
+    fov_3d_z_range = 1;
+    here.build_map_cache( origin.z );
+    CHECK( seen_tiles_around( origin + tripoint_above ) == 0 );
+    fov_3d = true;
+    here.build_map_cache( origin.z );
+    CHECK( seen_tiles_around( origin + tripoint_above ) > 0 );
+
+    fov_3d = old_fov_3d;
+    fov_3d_z_range = old_range;
+}
+
+TEST_CASE( "seen_cache_is_rebuilt_when_the_3d_vision_range_changes" )
+{
+    clear_map();
+    map &here = g->m;
+    if( !here.has_zlevels() ) {
+        return;
+    }
+    const bool old_fov_3d = fov_3d;
+    const int old_range = fov_3d_z_range;
+    const tripoint origin( 60, 60, 0 );
+    g->u.setpos( origin );
+
+    fov_3d = true;
+    fov_3d_z_range = 0;
+    here.build_map_cache( origin.z );
+    REQUIRE( seen_tiles_around( origin + tripoint_above ) == 0 );
+    // Only the option changed, the player is still in the same place
+    fov_3d_z_range = 1;
+    here.build_map_cache( origin.z );
+    CHECK( seen_tiles_around( origin + tripoint_above ) > 0 );
+
+    fov_3d = old_fov_3d;
+    fov_3d_z_range = old_range;
+}
+
+TEST_CASE( "reading_empty_squares_leaves_items_and_fields_unallocated" )
+{
+    clear_map();
+    map &here = g->m;
+    if( !here.has_zlevels() ) {
+        return;
+    }
+    // High in the air, where no test puts anything
+    const tripoint p( 60, 60, OVERMAP_HEIGHT );
+    const submap *const sm = MAPBUFFER.lookup_submap( ms_to_sm_copy( here.getabs( p ) ) );
+    REQUIRE( sm != nullptr );
+    REQUIRE_FALSE( sm->itm.allocated() );
+    REQUIRE_FALSE( sm->fld.allocated() );
+
+    CHECK_FALSE( here.has_items( p ) );
+    CHECK_FALSE( here.tinder_at( p ) );
+    CHECK_FALSE( here.flammable_items_at( p ) );
+    CHECK( here.get_field( p, fd_fire ) == nullptr );
+    CHECK( here.get_field_intensity( p, fd_fire ) == 0 );
+    CHECK_FALSE( here.dangerous_field_at( p ) );
+    here.remove_field( p, fd_fire );
+    here.i_clear( p );
+    CHECK_FALSE( sm->itm.allocated() );
+    CHECK_FALSE( sm->fld.allocated() );
+
+    // Writing allocates them
+    here.add_field( p, fd_fire, 1 );
+    CHECK( sm->fld.allocated() );
+    here.remove_field( p, fd_fire );
+    here.add_item( p, item( "rock" ) );
+    CHECK( sm->itm.allocated() );
+    here.i_clear( p );
+}
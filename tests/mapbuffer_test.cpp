@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "coordinate_conversions.h"
+#include "json.h"
+#include "mapbuffer.h"
+#include "options.h"
+#include "point.h"
+#include "submap.h"
+#include "trap.h"
+#include "type_id.h"
+
+// Saves a quad of submaps far from the reality bubble, so the save drops them from memory,
+// and reads it back.
+static void check_quad_round_trip( const tripoint &quad_addr, const ter_id &ter )
+{
+    const tripoint sm_addr = omt_to_sm_copy( quad_addr );
+    for( const point &offset : { point_zero, point_south, point_east, point_south_east } ) {
+        std::unique_ptr<submap> sm = std::make_unique<submap>();
+        sm->is_uniform = false;
+        sm->set_ter( offset, ter );
+        REQUIRE( MAPBUFFER.add_submap( sm_addr + offset, sm ) );
+    }
+    MAPBUFFER.save();
+
+    for( const point &offset : { point_zero, point_south, point_east, point_south_east } ) {
+        submap *sm = MAPBUFFER.lookup_submap( sm_addr + offset );
+        REQUIRE( sm != nullptr );
+        CHECK( sm->get_ter( offset ) == ter );
+        // Freshly loaded, saving it again would only rewrite the same data.
+        CHECK_FALSE( sm->modified );
+    }
+}
+
+TEST_CASE( "submaps_survive_saving_in_region_files", "[mapbuffer]" )
+{
+    options_manager::cOpt &region_files = get_options().get_option( "MAP_REGION_FILES" );
+    const std::string old_value = region_files.getValue();
+    region_files.setValue( "true" );
+
+    // Two quads in one segment, the second save appends to the region file.
+    check_quad_round_trip( tripoint( 3000, 3000, 0 ), ter_id( "t_wall" ) );
+    check_quad_round_trip( tripoint( 3001, 3000, 0 ), ter_id( "t_floor" ) );
+    // Saving a quad again replaces its old data.
+    check_quad_round_trip( tripoint( 3000, 3000, 0 ), ter_id( "t_dirt" ) );
+
+    // Saving a quad to its own file again hides the copy in the region file.
+    region_files.setValue( "false" );
+    check_quad_round_trip( tripoint( 3001, 3000, 0 ), ter_id( "t_grass" ) );
+
+    region_files.setValue( old_value );
+}
+
+TEST_CASE( "submap_setters_mark_it_modified", "[mapbuffer]" )
+{
+    submap sm;
+    sm.modified = false;
+    sm.set_ter( point_zero, ter_id( "t_wall" ) );
+    CHECK( sm.modified );
+
+    sm.modified = false;
+    sm.set_furn( point_zero, furn_id( "f_chair" ) );
+    CHECK( sm.modified );
+
+    sm.modified = false;
+    sm.set_graffiti( point_zero, "graffiti" );
+    CHECK( sm.modified );
+}
+
+TEST_CASE( "submap_tiles_survive_the_compact_format", "[mapbuffer]" )
+{
+    options_manager::cOpt &compact = get_options().get_option( "MAP_COMPACT_SUBMAPS" );
+    const std::string old_value = compact.getValue();
+    compact.setValue( "true" );
+
+    submap original;
+    original.is_uniform = false;
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            original.set_ter( point( x, y ), ter_id( x < y ? "t_floor" : "t_dirt" ) );
+        }
+    }
+    original.set_ter( point_zero, ter_id( "t_wall" ) );
+    original.set_furn( point( 3, 4 ), furn_id( "f_chair" ) );
+    original.set_trap( point( 5, 6 ), trap_str_id( "tr_beartrap" ).id() );
+
+    std::ostringstream buffer;
+    JsonOut jsout( buffer );
+    jsout.start_object();
+    original.store( jsout );
+    jsout.end_object();
+    compact.setValue( old_value );
+
+    CHECK( buffer.str().find( "\"tiles\"" ) != std::string::npos );
+    CHECK( buffer.str().find( "\"terrain\":[\"" ) == std::string::npos );
+
+    submap loaded;
+    std::istringstream input( buffer.str() );
+    JsonIn jsin( input );
+    jsin.start_object();
+    while( !jsin.end_object() ) {
+        loaded.load( jsin, jsin.get_member_name(), false );
+    }
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            const point p( x, y );
+            CHECK( loaded.get_ter( p ) == original.get_ter( p ) );
+            CHECK( loaded.get_furn( p ) == original.get_furn( p ) );
+            CHECK( loaded.get_trap( p ) == original.get_trap( p ) );
+        }
+    }
+}
+
+TEST_CASE( "prefetched_submaps_load_like_the_others", "[mapbuffer]" )
+{
+    const tripoint sm_addr = omt_to_sm_copy( tripoint( 3002, 3000, 0 ) );
+    std::unique_ptr<submap> sm = std::make_unique<submap>();
+    sm->is_uniform = false;
+    sm->set_ter( point_zero, ter_id( "t_wall" ) );
+    REQUIRE( MAPBUFFER.add_submap( sm_addr, sm ) );
+    MAPBUFFER.save();
+
+    MAPBUFFER.prefetch( { sm_addr, sm_addr + point_south } );
+    submap *loaded = MAPBUFFER.lookup_submap( sm_addr );
+    REQUIRE( loaded != nullptr );
+    CHECK( loaded->get_ter( point_zero ) == ter_id( "t_wall" ) );
+
+    // Several quads shared between threads.
+    std::vector<tripoint> quads;
+    for( int i = 0; i < 5; i++ ) {
+        quads.push_back( omt_to_sm_copy( tripoint( 3010 + i, 3000, 0 ) ) );
+        std::unique_ptr<submap> quad_sm = std::make_unique<submap>();
+        quad_sm->is_uniform = false;
+        quad_sm->set_ter( point_zero, ter_id( "t_floor" ) );
+        REQUIRE( MAPBUFFER.add_submap( quads.back(), quad_sm ) );
+    }
+    MAPBUFFER.save();
+    MAPBUFFER.prefetch( quads, 3 );
+    for( const tripoint &quad : quads ) {
+        submap *quad_sm = MAPBUFFER.lookup_submap( quad );
+        REQUIRE( quad_sm != nullptr );
+        CHECK( quad_sm->get_ter( point_zero ) == ter_id( "t_floor" ) );
+    }
+}
+
+static bool is_loaded( const tripoint &sm_addr )
+{
+    return std::any_of( MAPBUFFER.begin(), MAPBUFFER.end(),
+    [&sm_addr]( const std::pair<const tripoint, submap *> &elem ) {
+        return elem.first == sm_addr;
+    } );
+}
+
+TEST_CASE( "size_limit_unloads_distant_submaps", "[mapbuffer]" )
+{
+    const tripoint sm_addr = omt_to_sm_copy( tripoint( 3003, 3000, 0 ) );
+    std::unique_ptr<submap> sm = std::make_unique<submap>();
+    sm->is_uniform = false;
+    sm->set_ter( point_zero, ter_id( "t_wall" ) );
+    REQUIRE( MAPBUFFER.add_submap( sm_addr, sm ) );
+
+    MAPBUFFER.limit_size( 1 );
+    CHECK_FALSE( is_loaded( sm_addr ) );
+
+    // It was saved on the way out.
+    submap *loaded = MAPBUFFER.lookup_submap( sm_addr );
+    REQUIRE( loaded != nullptr );
+    CHECK( loaded->get_ter( point_zero ) == ter_id( "t_wall" ) );
+}
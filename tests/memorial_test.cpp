@@ -1,10 +1,15 @@
 #include "catch/catch.hpp"
 
+#include <fstream>
+#include <sstream>
+
 #include "avatar.h"
 #include "enum_conversions.h"
+#include "filesystem.h"
 #include "game.h"
 #include "memorial_logger.h"
 #include "mutation.h"
+#include "path_info.h"
 #include "output.h"
 #include "player_helpers.h"
 
@@ -229,3 +234,46 @@ TEST_CASE( "memorials" )
     check_memorial<event_type::triggers_alarm>(
         m, b, "Set off an alarm.", ch );
 }
+
+TEST_CASE( "memorial_saves_append_to_the_log" )
+{
+    const std::string path = FILENAMES["config_dir"] + "memorial_test.log";
+    remove_file( path );
+    memorial_logger m;
+    m.add( "first", "first" );
+    REQUIRE( m.save( path, nullptr ) );
+    m.add( "second", "second" );
+    m.add( "third", "third" );
+    const std::string all = m.dump();
+    REQUIRE( m.save( path, nullptr ) );
+    CHECK( m.dump() == all );
+    CHECK( string_split( all, '\n' ).size() == 4 );
+
+    std::ifstream fin( path, std::ios::binary );
+    std::stringstream saved;
+    saved << fin.rdbuf();
+    CHECK( saved.str() == all );
+
+    memorial_logger loaded;
+    loaded.load( path );
+    CHECK( loaded.dump() == all );
+    loaded.add( "fourth", "fourth" );
+    CHECK( loaded.dump().find( "fourth" ) > loaded.dump().find( "third" ) );
+    remove_file( path );
+}
+
+TEST_CASE( "memorial_written_at_death_has_the_saved_entries" )
+{
+    const std::string path = FILENAMES["config_dir"] + "memorial_death_test.log";
+    remove_file( path );
+    memorial_logger m;
+    m.add( "before the save", "before the save" );
+    REQUIRE( m.save( path, nullptr ) );
+    m.add( "after the save", "after the save" );
+
+    std::ostringstream memorial;
+    m.write( memorial, "last words" );
+    CHECK( memorial.str().find( "before the save" ) != std::string::npos );
+    CHECK( memorial.str().find( "after the save" ) != std::string::npos );
+    remove_file( path );
+}
@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <string>
+
+#include "avatar.h"
+#include "catch/catch.hpp"
+#include "game.h"
+#include "item.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "memory_census.h"
+#include "point.h"
+
+static memory_census::entry find_entry( const memory_census::census &c,
+                                        const std::string &subsystem, const std::string &type )
+{
+    const auto iter = std::find_if( c.entries().begin(), c.entries().end(),
+    [&]( const memory_census::entry & e ) {
+        return e.subsystem == subsystem && e.type == type;
+    } );
+    return iter == c.entries().end() ? memory_census::entry() : *iter;
+}
+
+TEST_CASE( "memory_census_merges_entries_of_the_same_type", "[memory]" )
+{
+    memory_census::census c;
+    c.add( "submaps", "item", 2, 100 );
+    c.add( "submaps", "item", 3, 50 );
+    c.add( "submaps", "field", 1, 10 );
+    c.add( "types", "item type", 1, 1000 );
+
+    CHECK( c.entries().size() == 3 );
+    CHECK( find_entry( c, "submaps", "item" ).count == 5 );
+    CHECK( find_entry( c, "submaps", "item" ).bytes == 150 );
+    CHECK( c.bytes( "submaps" ) == 160 );
+    CHECK( c.bytes( "types" ) == 1000 );
+}
+
+TEST_CASE( "memory_census_counts_items_on_the_map", "[memory]" )
+{
+    clear_map();
+    const tripoint spot = g->u.pos() + point( 3, 0 );
+    g->m.i_clear( spot );
+    const size_t before = find_entry( memory_census::take(), "submaps", "item" ).count;
+
+    item backpack( "backpack" );
+    backpack.put_in( item( "rock" ) );
+    for( int i = 0; i < 10; ++i ) {
+        g->m.add_item( spot, backpack );
+    }
+    const memory_census::census c = memory_census::take();
+    const memory_census::entry items = find_entry( c, "submaps", "item" );
+    CHECK( items.count == before + 10 );
+    CHECK( memory_census::item_bytes( backpack ) > sizeof( item ) );
+    CHECK( items.bytes >= 10 * memory_census::item_bytes( backpack ) );
+    CHECK( memory_census::report( c, 5 ).find( "Submaps with the most items" ) != std::string::npos );
+    g->m.i_clear( spot );
+}
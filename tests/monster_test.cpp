@@ -1,4 +1,5 @@
 #include <math.h>
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -10,6 +11,7 @@
 
 #include "avatar.h"
 #include "catch/catch.hpp"
+#include "creature_tracker.h"
 #include "game.h"
 #include "map.h"
 #include "map_helpers.h"
@@ -334,3 +336,75 @@ TEST_CASE( "monster_speed_trig", "[speed]" )
     trigdist = true;
     monster_check();
 }
+
+TEST_CASE( "creature_tracker_finds_monsters_near_a_point" )
+{
+    clear_map();
+    const tripoint center( 60, 60, 0 );
+    monster &near = spawn_test_monster( "mon_zombie", center + tripoint( 3, -5, 0 ) );
+    monster &edge = spawn_test_monster( "mon_zombie", center + tripoint( -10, 10, 0 ) );
+    monster &far = spawn_test_monster( "mon_zombie", center + tripoint( 11, 0, 0 ) );
+
+    std::vector<monster *> found = g->critter_tracker->find_near( center, 10, 0 );
+    const auto has = [&found]( const monster & mon ) {
+        return std::find( found.begin(), found.end(), &mon ) != found.end();
+    };
+    CHECK( found.size() == 2 );
+    CHECK( has( near ) );
+    CHECK( has( edge ) );
+    CHECK_FALSE( has( far ) );
+
+    // Moving between submaps keeps the index up to date
+    g->update_zombie_pos( far, center + tripoint( 1, 1, 0 ) );
+    far.spawn( center + tripoint( 1, 1, 0 ) );
+    found = g->critter_tracker->find_near( center, 10, 0 );
+    CHECK( has( far ) );
+    g->remove_zombie( near );
+    found = g->critter_tracker->find_near( center, 10, 0 );
+    CHECK_FALSE( has( near ) );
+}
+
+TEST_CASE( "creatures_near_a_point_include_the_avatar_but_not_the_dead" )
+{
+    clear_map();
+    const tripoint center( 60, 60, 0 );
+    g->u.setpos( center + tripoint( 0, 4, 0 ) );
+    monster &alive = spawn_test_monster( "mon_zombie", center + tripoint( -4, 0, 0 ) );
+    monster &dead = spawn_test_monster( "mon_zombie", center + tripoint( 4, 0, 0 ) );
+    monster &far = spawn_test_monster( "mon_zombie", center + tripoint( 0, -5, 0 ) );
+    dead.set_hp( 0 );
+
+    std::vector<Creature *> found;
+    g->get_creatures_near( center, 4, found );
+    const auto has = [&found]( const Creature & critter ) {
+        return std::find( found.begin(), found.end(), &critter ) != found.end();
+    };
+    CHECK( found.size() == 2 );
+    CHECK( has( alive ) );
+    CHECK( has( g->u ) );
+    CHECK_FALSE( has( dead ) );
+    CHECK_FALSE( has( far ) );
+}
+
+TEST_CASE( "creature_tracker_remove_dead_keeps_order_and_drops_factions" )
+{
+    clear_map();
+    monster &first = spawn_test_monster( "mon_zombie", tripoint( 60, 60, 0 ) );
+    monster &second = spawn_test_monster( "mon_zombie", tripoint( 62, 60, 0 ) );
+    monster &third = spawn_test_monster( "mon_zombie", tripoint( 64, 60, 0 ) );
+    const mfaction_id zombie_faction = first.faction;
+    const size_t faction_size = g->critter_tracker->factions().at( zombie_faction ).size();
+    const monster *const first_ptr = &first;
+    const monster *const third_ptr = &third;
+
+    second.set_hp( 0 );
+    REQUIRE( second.is_dead() );
+    g->critter_tracker->remove_dead();
+
+    const auto &list = g->critter_tracker->get_monsters_list();
+    REQUIRE( list.size() == 2 );
+    CHECK( list[0].get() == first_ptr );
+    CHECK( list[1].get() == third_ptr );
+    CHECK( g->critter_tracker->factions().at( zombie_faction ).size() == faction_size - 1 );
+    CHECK( g->critter_at<monster>( tripoint( 62, 60, 0 ) ) == nullptr );
+}
@@ -124,3 +124,17 @@ TEST_CASE( "Having all pre-threshold mutations gives a sensible threshold breach
         }
     }
 }
+
+TEST_CASE( "Trait flags follow gained and lost mutations", "[mutations]" )
+{
+    npc dummy;
+    const trait_id cannibal( "CANNIBAL" );
+    REQUIRE_FALSE( dummy.has_trait_flag( "CANNIBAL" ) );
+
+    dummy.set_mutation( cannibal );
+    CHECK( dummy.has_trait_flag( "CANNIBAL" ) );
+    CHECK_FALSE( dummy.has_trait_flag( "NOT_A_MUTATION_FLAG" ) );
+
+    dummy.unset_mutation( cannibal );
+    CHECK_FALSE( dummy.has_trait_flag( "CANNIBAL" ) );
+}
@@ -1,13 +1,17 @@
+#include <algorithm>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "catch/catch.hpp"
 #include "map.h"
+#include "monster.h"
 #include "overmap.h"
 #include "overmapbuffer.h"
 #include "calendar.h"
 #include "common_types.h"
+#include "mtype.h"
 #include "omdata.h"
 #include "overmap_types.h"
 #include "type_id.h"
@@ -106,3 +110,52 @@ TEST_CASE( "default_overmap_generation_has_non_mandatory_specials_at_origin" )
     CHECK( found_optional == true );
 }
 
+
+TEST_CASE( "overmap_monsters_survive_saving_before_they_are_read" )
+{
+    const tripoint sm_loc( 3, 4, 0 );
+    // Overmaps are too big for the stack
+    std::unique_ptr<overmap> original = std::make_unique<overmap>( point_zero );
+    original->monsters().emplace( sm_loc, monster( mtype_id( "mon_zombie" ) ) );
+    std::ostringstream saved;
+    original->serialize( saved );
+
+    // Saved again without anyone asking for its monsters.
+    std::unique_ptr<overmap> untouched = std::make_unique<overmap>( point_zero );
+    std::istringstream saved_in( saved.str() );
+    untouched->unserialize( saved_in );
+    std::ostringstream resaved;
+    untouched->serialize( resaved );
+
+    std::unique_ptr<overmap> loaded = std::make_unique<overmap>( point_zero );
+    std::istringstream resaved_in( resaved.str() );
+    loaded->unserialize( resaved_in );
+    REQUIRE( loaded->monsters().count( sm_loc ) == 1 );
+    CHECK( loaded->monsters().find( sm_loc )->second.type->id == mtype_id( "mon_zombie" ) );
+    CHECK( untouched->monsters().size() == 1 );
+}
+
+TEST_CASE( "overmap_terrain_searches_find_every_match" )
+{
+    const tripoint first( 10, 10, 3 );
+    const tripoint second( 20, 12, 3 );
+    const oter_id old_first = overmap_buffer.ter( first );
+    const oter_id old_second = overmap_buffer.ter( second );
+    overmap_buffer.ter( first ) = oter_id( "evac_center_1_north" );
+    overmap_buffer.ter( second ) = oter_id( "evac_center_1_north" );
+
+    omt_find_params params;
+    params.type = "evac_center_1_north";
+    params.match_type = ot_match_type::exact;
+    params.search_range = 20;
+    std::vector<tripoint> found = overmap_buffer.find_all( tripoint( 15, 15, 3 ), params );
+    std::sort( found.begin(), found.end() );
+    CHECK( found == std::vector<tripoint> { first, second } );
+    CHECK( overmap_buffer.find_closest( tripoint( 11, 11, 3 ), params ) == first );
+
+    // Nothing on the other z-levels.
+    CHECK( overmap_buffer.find_all( tripoint( 15, 15, 2 ), params ).empty() );
+
+    overmap_buffer.ter( first ) = old_first;
+    overmap_buffer.ter( second ) = old_second;
+}
@@ -130,3 +130,63 @@ TEST_CASE( "Player body temperatures converge on expected values.", "[.bodytemp]
         test_temperature_spread( &dummy, {{ -115, -87, -54, -6, 36, 64, 80 }} );
     }
 }
+
+static int expected_warmth( const player &p, const body_part bp )
+{
+    int ret = 0;
+    for( const item &it : p.worn ) {
+        if( it.covers( bp ) ) {
+            int warmth = it.get_warmth();
+            if( !it.made_of( material_id( "wool" ) ) ) {
+                warmth *= 1.0 - 0.66 * p.body_wetness[bp] / p.drench_capacity[bp];
+            }
+            ret += warmth;
+        }
+    }
+    return ret;
+}
+
+TEST_CASE( "cached_worn_warmth_follows_gear_and_wetness" )
+{
+    player &dummy = g->u;
+    std::list<item> temp;
+    while( dummy.takeoff( dummy.i_at( -2 ), &temp ) );
+    dummy.body_wetness.fill( 0 );
+    CHECK( dummy.warmth( bp_torso ) == 0 );
+    CHECK( dummy.get_wind_resistance( bp_torso ) == 0 );
+
+    equip_clothing( &dummy, "hat_hunting" );
+    equip_clothing( &dummy, "sweater" );
+    equip_clothing( &dummy, "coat_winter" );
+    equip_clothing( &dummy, "gloves_wool" );
+    equip_clothing( &dummy, "jeans" );
+    const int dressed_warmth = dummy.warmth( bp_torso );
+    const int dressed_wind_resistance = dummy.get_wind_resistance( bp_torso );
+    CHECK( dressed_warmth > 0 );
+    CHECK( dressed_wind_resistance > 0 );
+
+    dummy.body_wetness[bp_torso] = dummy.drench_capacity[bp_torso] / 2;
+    dummy.body_wetness[bp_hand_l] = dummy.drench_capacity[bp_hand_l];
+    for( const body_part bp : all_body_parts ) {
+        if( bp == bp_eyes ) {
+            continue;
+        }
+        CAPTURE( body_part_name( bp ) );
+        CHECK( dummy.warmth( bp ) == expected_warmth( dummy, bp ) );
+    }
+    CHECK( dummy.warmth( bp_torso ) < dressed_warmth );
+
+    REQUIRE( dummy.takeoff( dummy.i_at( -2 ), &temp ) );
+    for( const body_part bp : all_body_parts ) {
+        if( bp == bp_eyes ) {
+            continue;
+        }
+        CAPTURE( body_part_name( bp ) );
+        CHECK( dummy.warmth( bp ) == expected_warmth( dummy, bp ) );
+    }
+
+    while( dummy.takeoff( dummy.i_at( -2 ), &temp ) );
+    dummy.body_wetness.fill( 0 );
+    CHECK( dummy.warmth( bp_torso ) == 0 );
+    CHECK( dummy.get_wind_resistance( bp_torso ) == 0 );
+}
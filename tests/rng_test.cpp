@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <functional>
 #include <vector>
 
@@ -77,3 +78,31 @@ TEST_CASE( "random_entry_preserves_constness" )
     i1 = 5678;
     CHECK( v1[0] == 5678 );
 }
+
+TEST_CASE( "rng_streams_are_reproducible_and_independent" )
+{
+    const auto draw = []( const std::uint64_t key, const std::uint64_t step ) {
+        rng_stream stream( key, step );
+        std::vector<int> rolls;
+        for( int i = 0; i < 16; i++ ) {
+            rolls.push_back( stream.rng( 0, 1000 ) );
+        }
+        return rolls;
+    };
+    const std::vector<int> first = draw( 7, 100 );
+    // Using the global engine in between doesn't change a stream.
+    for( int i = 0; i < 10; i++ ) {
+        rng_bits();
+    }
+    CHECK( draw( 7, 100 ) == first );
+    CHECK( draw( 8, 100 ) != first );
+    CHECK( draw( 7, 101 ) != first );
+
+    rng_stream stream( 3, 5 );
+    statistics<bool> stats( Z99_999_9 );
+    const epsilon_threshold target_range{ 0.25, 0.05 };
+    do {
+        stats.add( stream.one_in( 4 ) );
+    } while( stats.n() < 100 || stats.uncertain_about( target_range ) );
+    CHECK( stats.test_threshold( target_range ) );
+}
@@ -9,6 +9,8 @@
 #include "game.h"
 #include "flat_set.h"
 #include "point.h"
+#include "weather.h"
+#include "game_constants.h"
 
 
 static bool is_nearly( float value, float expected )
@@ -51,3 +53,25 @@ TEST_CASE( "Rate of rotting" )
         CHECK( is_nearly( to_turns<int>( test_item.get_rot() ), to_turns<int>( 20_minutes ) ) );
     }
 }
+
+TEST_CASE( "Rot in a root cellar over a long absence" )
+{
+    // Root cellars hold a constant temperature, so a month away should rot
+    // the item by exactly a month's worth of rot at that temperature.
+    item test_item( "flour" );
+    const time_point start = calendar::turn;
+
+    calendar::turn = to_turn<int>( start + 2_hours );
+    test_item.process_temperature_rot( 1, tripoint_zero, nullptr, TEMP_ROOT_CELLAR );
+    const time_duration rot_before = test_item.get_rot();
+
+    calendar::turn = to_turn<int>( start + 2_hours + 30_days );
+    test_item.process_temperature_rot( 1, tripoint_zero, nullptr, TEMP_ROOT_CELLAR );
+    const time_duration rot_gained = test_item.get_rot() - rot_before;
+
+    const int expected = to_hours<int>( 30_days ) *
+                         get_hourly_rotpoints_at_temp( AVERAGE_ANNUAL_TEMPERATURE );
+    CHECK( is_nearly( to_turns<int>( rot_gained ), expected ) );
+
+    calendar::turn = start;
+}
@@ -50,3 +50,18 @@ TEST_CASE( "safe_reference_not_shared_by_copy", "[safe_reference]" )
     CHECK( !ref0 );
     CHECK( ref1 );
 }
+
+TEST_CASE( "safe_reference_not_carried_over_by_move", "[safe_reference]" )
+{
+    std::unique_ptr<example> e0 = std::make_unique<example>();
+    safe_reference<example> ref0 = e0->get_ref();
+    safe_reference<example> ref0_again = e0->get_ref();
+    std::unique_ptr<example> e1 = std::make_unique<example>( std::move( *e0 ) );
+    CHECK( ref0.get() == e0.get() );
+    CHECK( ref0_again.get() == e0.get() );
+    safe_reference<example> ref1 = e1->get_ref();
+    e0.reset();
+    CHECK( !ref0 );
+    CHECK( !ref0_again );
+    CHECK( ref1.get() == e1.get() );
+}
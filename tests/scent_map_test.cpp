@@ -0,0 +1,50 @@
+#include "catch/catch.hpp"
+#include "avatar.h"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "point.h"
+#include "scent_map.h"
+
+TEST_CASE( "scent_peak_covers_neighbouring_tiles", "[scent]" )
+{
+    scent_map &scent = g->scent;
+    scent.reset();
+    const int z = g->get_levz();
+    CHECK( scent.peak_near( tripoint( 50, 50, z ) ) == 0 );
+
+    scent.set( tripoint( 51, 49, z ), 300 );
+    CHECK( scent.peak_near( tripoint( 50, 50, z ) ) == 300 );
+    CHECK( scent.peak_near( tripoint( 52, 48, z ) ) == 300 );
+    CHECK( scent.peak_near( tripoint( 53, 49, z ) ) == 0 );
+
+    // Changes made after the peak was built are picked up
+    scent.set( tripoint( 53, 50, z ), 500 );
+    CHECK( scent.peak_near( tripoint( 52, 50, z ) ) == 500 );
+    scent.decay();
+    CHECK( scent.peak_near( tripoint( 52, 50, z ) ) == 499 );
+    scent.reset();
+    CHECK( scent.peak_near( tripoint( 52, 50, z ) ) == 0 );
+}
+
+TEST_CASE( "scent_diffuses_evenly_over_open_ground", "[scent]" )
+{
+    clear_map();
+    scent_map &scent = g->scent;
+    scent.reset();
+    const tripoint center = g->u.pos();
+    scent.set( center, 1000 );
+
+    scent.update( center, g->m );
+
+    // With no walls around, 1/10 of the scent moves into each of the eight neighbours
+    CHECK( scent.get( center ) == 200 );
+    for( const tripoint &p : g->m.points_in_radius( center, 1 ) ) {
+        if( p != center ) {
+            CHECK( scent.get( p ) == 100 );
+        }
+    }
+    CHECK( scent.get( center + point( 2, 0 ) ) == 0 );
+    scent.reset();
+}
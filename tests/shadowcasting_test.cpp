@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <cstdio>
 #include <random>
 #include <array>
@@ -643,3 +645,79 @@ TEST_CASE( "bresenham_vs_shadowcasting", "[.]" )
 {
     shadowcasting_runoff( 1, true );
 }
+
+TEST_CASE( "overmap_sight_pays_the_see_cost_of_each_tile", "[shadowcasting]" )
+{
+    struct grids {
+        float costs[MAPSIZE_X][MAPSIZE_Y];
+        float sight_points[MAPSIZE_X][MAPSIZE_Y];
+    };
+    std::unique_ptr<grids> g = std::make_unique<grids>();
+    const point center( MAPSIZE_X / 2, MAPSIZE_Y / 2 );
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            g->costs[x][y] = 1;
+            g->sight_points[x][y] = -1;
+        }
+    }
+    // A wall of the cost of solid rock east of the center
+    for( int y = -1; y <= 1; ++y ) {
+        g->costs[center.x + 3][center.y + y] = 999;
+    }
+    castLightAll<float, float, overmap_sight_calc, overmap_sight_check, update_light,
+                 accumulate_transparency>( g->sight_points, g->costs, center.x, center.y, 0, 10 );
+
+    // What is left on reaching a tile, before paying for the tile itself
+    CHECK( g->sight_points[center.x + 1][center.y] == Approx( 10 ) );
+    CHECK( g->sight_points[center.x + 2][center.y] == Approx( 9 ) );
+    CHECK( g->sight_points[center.x - 5][center.y] == Approx( 6 ) );
+    CHECK( g->sight_points[center.x + 3][center.y] == Approx( 8 ) );
+    CHECK( g->sight_points[center.x + 5][center.y] < 0 );
+}
+
+TEST_CASE( "shadowcasting_3d_skips_levels_without_input", "[shadowcasting]" )
+{
+    struct inputs {
+        float transparency[MAPSIZE_X][MAPSIZE_Y];
+        bool floor[MAPSIZE_X][MAPSIZE_Y];
+    };
+    struct level {
+        float seen[MAPSIZE_X][MAPSIZE_Y];
+    };
+    std::unique_ptr<inputs> in = std::make_unique<inputs>();
+    std::vector<std::unique_ptr<level>> levels;
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            in->transparency[x][y] = LIGHT_TRANSPARENCY_OPEN_AIR;
+            in->floor[x][y] = false;
+        }
+    }
+
+    const tripoint origin( 65, 65, 0 );
+    std::array<const float ( * )[MAPSIZE_X][MAPSIZE_Y], OVERMAP_LAYERS> transparency_caches;
+    std::array<float ( * )[MAPSIZE_X][MAPSIZE_Y], OVERMAP_LAYERS> seen_caches;
+    std::array<const bool ( * )[MAPSIZE_X][MAPSIZE_Y], OVERMAP_LAYERS> floor_caches;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        levels.emplace_back( std::make_unique<level>() );
+        std::fill_n( &levels.back()->seen[0][0], MAPSIZE_X * MAPSIZE_Y, 0.0f );
+        // Only one level up and down is in range
+        transparency_caches[z + OVERMAP_DEPTH] = std::abs( z - origin.z ) <= 1 ?
+                &in->transparency : nullptr;
+        seen_caches[z + OVERMAP_DEPTH] = &levels.back()->seen;
+        floor_caches[z + OVERMAP_DEPTH] = &in->floor;
+    }
+    cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
+        seen_caches, transparency_caches, floor_caches, origin, 0, 1.0 );
+
+    const auto lit_tiles = [&levels]( const int z ) {
+        const level &l = *levels[z + OVERMAP_DEPTH];
+        return std::count_if( &l.seen[0][0], &l.seen[0][0] + MAPSIZE_X * MAPSIZE_Y,
+        []( const float v ) {
+            return v > 0;
+        } );
+    };
+    CHECK( lit_tiles( 1 ) > 0 );
+    CHECK( lit_tiles( -1 ) > 0 );
+    CHECK( lit_tiles( 2 ) == 0 );
+    CHECK( lit_tiles( -2 ) == 0 );
+}
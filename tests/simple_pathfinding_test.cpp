@@ -0,0 +1,42 @@
+#include "catch/catch.hpp"
+#include "simple_pathfinding.h"
+
+#include <cstdlib>
+
+TEST_CASE( "simple_pathfinding_routes_around_walls", "[pathfinding]" )
+{
+    const point source( 0, 0 );
+    const point dest( 9, 0 );
+    // A wall along x == 5 with a single gap at the bottom.
+    const auto is_wall = []( const point & p ) {
+        return p.x == 5 && p.y != 9;
+    };
+    const auto estimator = [&]( const pf::node & cur, const pf::node * ) {
+        if( is_wall( cur.pos ) ) {
+            return pf::rejected;
+        }
+        return std::abs( dest.x - cur.pos.x ) + std::abs( dest.y - cur.pos.y );
+    };
+
+    const pf::path route = pf::find_path( source, dest, 10, 10, estimator );
+
+    REQUIRE_FALSE( route.nodes.empty() );
+    // Nodes run from the destination back to the source.
+    CHECK( route.nodes.front().pos == dest );
+    CHECK( route.nodes.back().pos == source );
+    for( size_t i = 0; i + 1 < route.nodes.size(); ++i ) {
+        const point step = route.nodes[i].pos - route.nodes[i + 1].pos;
+        CHECK( std::abs( step.x ) + std::abs( step.y ) == 1 );
+        CHECK_FALSE( is_wall( route.nodes[i].pos ) );
+    }
+    // The only way through is the gap at y == 9.
+    CHECK( route.nodes.size() >= 28 );
+}
+
+TEST_CASE( "simple_pathfinding_rejects_unreachable_destination", "[pathfinding]" )
+{
+    const auto estimator = []( const pf::node & cur, const pf::node * ) {
+        return cur.pos.x == 5 ? pf::rejected : 0;
+    };
+    CHECK( pf::find_path( point( 0, 0 ), point( 9, 0 ), 10, 10, estimator ).nodes.empty() );
+}
@@ -1,7 +1,10 @@
 #include "catch/catch.hpp"
 
+#include <sstream>
+
 #include "avatar.h"
 #include "game.h"
+#include "json.h"
 #include "stats_tracker.h"
 
 TEST_CASE( "stats_tracker_count_events", "[stats]" )
@@ -58,6 +61,31 @@ TEST_CASE( "stats_tracker_total_events", "[stats]" )
     CHECK( s.total( event_type::character_takes_damage, "damage", damage_to_any ) == 35 );
 }
 
+TEST_CASE( "stats_tracker_serialization", "[stats]" )
+{
+    stats_tracker s;
+    event_bus b;
+    b.subscribe( &s );
+
+    const character_id u_id = g->u.getID();
+    const cata::event kill = cata::event::make<event_type::character_kills_monster>(
+                                 u_id, mtype_id( "mon_zombie" ) );
+    b.send( kill );
+    b.send( kill );
+    b.send<event_type::character_takes_damage>( u_id, 7 );
+
+    std::ostringstream os;
+    JsonOut jsout( os );
+    s.serialize( jsout );
+
+    std::istringstream is( os.str() );
+    JsonIn jsin( is );
+    stats_tracker loaded;
+    loaded.deserialize( jsin );
+    CHECK( loaded.count( kill ) == 2 );
+    CHECK( loaded.total( event_type::character_takes_damage, "damage", {} ) == 7 );
+}
+
 TEST_CASE( "stats_tracker_in_game", "[stats]" )
 {
     g->stats().clear();
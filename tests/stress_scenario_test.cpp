@@ -0,0 +1,100 @@
+#include <vector>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "catch/catch.hpp"
+#include "field.h"
+#include "game.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "monster.h"
+#include "npc.h"
+#include "point.h"
+#include "stress_scenario.h"
+#include "vehicle.h"
+
+static std::vector<tripoint> monster_positions()
+{
+    std::vector<tripoint> result;
+    for( const monster &critter : g->all_monsters() ) {
+        result.push_back( critter.pos() );
+    }
+    return result;
+}
+
+// clear_map() leaves items alone
+static void clear_items()
+{
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            g->m.i_clear( tripoint( x, y, 0 ) );
+        }
+    }
+}
+
+TEST_CASE( "stress_scenarios_are_known_by_name", "[stress]" )
+{
+    CHECK( stress_scenario::names().size() == 4 );
+    CHECK_FALSE( stress_scenario::setup( "no_such_scenario", 1 ) );
+}
+
+TEST_CASE( "horde_night_is_reproducible", "[stress]" )
+{
+    const time_point before = calendar::turn;
+    clear_map();
+    REQUIRE( stress_scenario::setup( "horde_night", 7 ) );
+    const std::vector<tripoint> first = monster_positions();
+    CHECK( first.size() == 300 );
+
+    clear_map();
+    REQUIRE( stress_scenario::setup( "horde_night", 7 ) );
+    CHECK( monster_positions() == first );
+    clear_map();
+    calendar::turn = before;
+}
+
+TEST_CASE( "burning_city_sets_houses_on_fire", "[stress]" )
+{
+    clear_map();
+    REQUIRE( stress_scenario::setup( "burning_city", 1 ) );
+    int fires = 0;
+    int smoke = 0;
+    for( const tripoint &p : g->m.points_in_radius( g->u.pos(), 60 ) ) {
+        fires += g->m.get_field( p, fd_fire ) != nullptr;
+        smoke += g->m.get_field( p, fd_smoke ) != nullptr;
+    }
+    CHECK( fires > 0 );
+    CHECK( smoke > 0 );
+    clear_map();
+}
+
+TEST_CASE( "convoy_places_ten_moving_cars", "[stress]" )
+{
+    clear_map();
+    REQUIRE( stress_scenario::setup( "convoy", 1 ) );
+    const VehicleList vehicles = g->m.get_vehicles();
+    REQUIRE( vehicles.size() == 10 );
+    for( const wrapped_vehicle &veh : vehicles ) {
+        CHECK( veh.v->velocity > 0 );
+    }
+    clear_map();
+}
+
+TEST_CASE( "mega_base_fills_a_storeroom", "[stress]" )
+{
+    clear_map();
+    clear_items();
+    REQUIRE( stress_scenario::setup( "mega_base", 1 ) );
+    size_t items = 0;
+    for( const tripoint &p : g->m.points_in_radius( g->u.pos(), 60 ) ) {
+        items += g->m.i_at( p ).size();
+    }
+    CHECK( items == 50000 );
+    CHECK( g->get_npcs_if( []( const npc & ) {
+        return true;
+    } ).size() == 20 );
+    clear_map();
+    clear_items();
+}
@@ -2,6 +2,7 @@
 #include "submap.h"
 #include "game_constants.h"
 #include "int_id.h"
+#include "item.h"
 #include "point.h"
 #include "type_id.h"
 
@@ -89,3 +90,24 @@ TEST_CASE( "submap rotation", "[submap]" )
         }
     }
 }
+
+TEST_CASE( "submap_items_and_fields_are_allocated_on_first_write", "[submap]" )
+{
+    submap sm;
+    const submap &csm = sm;
+    const point corner{ SEEX - 1, 0 };
+
+    CHECK( csm.itm[corner.x][corner.y].empty() );
+    CHECK( csm.fld[corner.x][corner.y].field_count() == 0 );
+    sm.update_field_tiles();
+    sm.rotate( 1 );
+    CHECK_FALSE( sm.itm.allocated() );
+    CHECK_FALSE( sm.fld.allocated() );
+
+    sm.itm[corner.x][corner.y].insert( item( "rock" ) );
+    CHECK( sm.itm.allocated() );
+    CHECK_FALSE( sm.fld.allocated() );
+    sm.rotate( 1 );
+    CHECK( csm.itm[corner.x][corner.y].empty() );
+    CHECK( csm.itm[SEEX - 1][SEEY - 1].size() == 1 );
+}
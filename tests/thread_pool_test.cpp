@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "point.h"
+#include "thread_pool.h"
+
+TEST_CASE( "parallel_for_visits_every_index_once", "[thread_pool]" )
+{
+    std::vector<int> visits( 1000, 0 );
+    thread_pool::parallel_for( 0, visits.size(), 8, [&visits]( const int i ) {
+        ++visits[i];
+    } );
+    CHECK( std::count( visits.begin(), visits.end(), 1 ) == 1000 );
+
+    // An empty range does nothing, a single thread runs in order on the caller
+    thread_pool::parallel_for( 5, 5, 8, []( int ) {
+        FAIL( "called for an empty range" );
+    } );
+    std::vector<int> order;
+    thread_pool::parallel_for( 0, 10, 1, [&order]( const int i ) {
+        order.push_back( i );
+    } );
+    CHECK( order == std::vector<int>( { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 } ) );
+}
+
+TEST_CASE( "parallel_for_covers_a_rectangle", "[thread_pool]" )
+{
+    const rectangle area( point( -3, 2 ), point( 7, 12 ) );
+    std::vector<int> visits( 100, 0 );
+    thread_pool::parallel_for( area, 4, [&visits]( const point & p ) {
+        ++visits[( p.y - 2 ) * 10 + p.x + 3];
+    } );
+    CHECK( std::count( visits.begin(), visits.end(), 1 ) == 100 );
+}
+
+TEST_CASE( "task_groups_nest_and_report_the_first_error", "[thread_pool]" )
+{
+    std::atomic<int> done( 0 );
+    thread_pool::task_group outer;
+    for( int i = 0; i < 4; ++i ) {
+        outer.run( [&done]() {
+            // Waiting inside a task must not need another free thread
+            thread_pool::task_group inner;
+            for( int j = 0; j < 4; ++j ) {
+                inner.run( [&done]() {
+                    ++done;
+                } );
+            }
+            inner.wait();
+        } );
+    }
+    outer.wait();
+    CHECK( done == 16 );
+
+    thread_pool::task_group failing;
+    for( int i = 0; i < 8; ++i ) {
+        failing.run( [i]() {
+            if( i % 3 == 1 ) {
+                throw std::runtime_error( std::to_string( i ) );
+            }
+        } );
+    }
+    std::string error;
+    try {
+        failing.wait();
+    } catch( const std::runtime_error &err ) {
+        error = err.what();
+    }
+    // Whichever thread ran into its error first, the earliest task's is reported
+    CHECK( error == "1" );
+}
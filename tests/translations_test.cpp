@@ -0,0 +1,29 @@
+#include "catch/catch.hpp"
+
+#include <sstream>
+
+#include "json.h"
+#include "translations.h"
+
+TEST_CASE( "translations_follow_their_text", "[translations]" )
+{
+    std::istringstream is( R"(["first", { "ctxt": "noun", "str": "second" }])" );
+    JsonIn jsin( is );
+    jsin.start_array();
+    translation t;
+    t.deserialize( jsin );
+    CHECK( t.translated() == "first" );
+    // The cached lookup must not outlive the text it was made for.
+    t.deserialize( jsin );
+    CHECK( t.translated() == "second" );
+    translation copy = t;
+    CHECK( copy.translated() == "second" );
+}
+
+TEST_CASE( "repeated_translations_are_not_copied", "[translations]" )
+{
+    const translation t = to_translation( "noun", "second" );
+    const std::string &first = t.translated();
+    CHECK( &t.translated() == &first );
+    CHECK( first == "second" );
+}
@@ -0,0 +1,35 @@
+#include "catch/catch.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "turn_profile.h"
+
+TEST_CASE( "waiting_for_input_is_not_part_of_the_turn", "[turn_profile]" )
+{
+    turn_profile::enable();
+    turn_profile::begin_turn();
+    {
+        turn_profile::input_wait waiting;
+        // Like a menu opened from the game's input loop
+        turn_profile::input_wait nested;
+        std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+    }
+    turn_profile::end_turn();
+    const std::string summary = turn_profile::recent_summary();
+    turn_profile::disable();
+
+    CAPTURE( summary );
+    int turns = 0;
+    double mean = 0;
+    double worst = 0;
+    REQUIRE( std::sscanf( summary.c_str(), "Last %d turns, mean %lf ms, worst %lf ms", &turns,
+                          &mean, &worst ) == 3 );
+    CHECK( turns == 1 );
+    // The turn itself did nothing, only the wait took time
+    CHECK( worst < 50 );
+    // And it was only left out once
+    CHECK( worst >= 0 );
+}
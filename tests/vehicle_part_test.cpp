@@ -1,5 +1,9 @@
+#include <map>
+#include <string>
+
 #include "catch/catch.hpp"
 
+#include "requirements.h"
 #include "veh_type.h"
 
 TEST_CASE( "verify_copy_from_gets_damage_reduction", "[vehicle]" )
@@ -9,3 +13,34 @@ TEST_CASE( "verify_copy_from_gets_damage_reduction", "[vehicle]" )
     const vpart_info &vp = vpart_id( "halfboard_horizontal" ).obj();
     CHECK( vp.damage_reduction[DT_BASH] != 0 );
 }
+
+static std::map<vpart_id, std::string> part_requirements()
+{
+    std::map<vpart_id, std::string> result;
+    for( const auto &e : vpart_info::all() ) {
+        result[e.first] = e.second.install_requirements().list_all() + "|" +
+                          e.second.removal_requirements().list_all() + "|" +
+                          std::to_string( e.second.removal_moves );
+    }
+    return result;
+}
+
+TEST_CASE( "vehicle_parts_are_complete_without_the_consistency_checks", "[vehicle]" )
+{
+    // The checks are skipped for data that already passed them once, so everything the parts
+    // need must come from loading and finalizing alone: running the checks changes nothing.
+    const std::map<vpart_id, std::string> finalized = part_requirements();
+    vpart_info::check();
+    CHECK( part_requirements() == finalized );
+
+    const vpart_info &frame = vpart_id( "frame_vertical" ).obj();
+    CHECK( frame.removal_moves >= 0 );
+    const requirement_data install = frame.install_requirements();
+    bool needs_base_item = false;
+    for( const auto &alternatives : install.get_components() ) {
+        for( const item_comp &comp : alternatives ) {
+            needs_base_item |= comp.type == frame.item;
+        }
+    }
+    CHECK( needs_base_item );
+}
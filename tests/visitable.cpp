@@ -2,6 +2,7 @@
 #include "calendar.h"
 #include "inventory.h"
 #include "item.h"
+#include "type_id.h"
 
 TEST_CASE( "visitable_summation" )
 {
@@ -18,3 +19,23 @@ TEST_CASE( "visitable_summation" )
 
     CHECK( test_inv.charges_of( "water", item::INFINITE_CHARGES ) > 1 );
 }
+
+TEST_CASE( "visitable_quality" )
+{
+    const quality_id hammering( "HAMMER" );
+    inventory test_inv;
+
+    CHECK_FALSE( test_inv.has_quality( hammering ) );
+
+    test_inv.add_item( item( "hammer", calendar::turn ) );
+    test_inv.add_item( item( "hammer", calendar::turn ) );
+
+    CHECK( test_inv.max_quality( hammering ) == 3 );
+    CHECK( test_inv.has_quality( hammering, 3, 2 ) );
+    CHECK_FALSE( test_inv.has_quality( hammering, 3, 3 ) );
+    CHECK_FALSE( test_inv.has_quality( hammering, 4 ) );
+
+    // Adding an item must invalidate the cached quality levels.
+    test_inv.add_item( item( "hammer", calendar::turn ) );
+    CHECK( test_inv.has_quality( hammering, 3, 3 ) );
+}
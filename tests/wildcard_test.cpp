@@ -0,0 +1,25 @@
+#include "catch/catch.hpp"
+#include "output.h"
+
+TEST_CASE( "wildcard_patterns_match_like_wildcard_match", "[wildcard]" )
+{
+    const wildcard_pattern exact( "Wooden Arrow" );
+    CHECK( exact.matches( "wooden arrow" ) );
+    CHECK_FALSE( exact.matches( "wooden arrows" ) );
+
+    const wildcard_pattern parts( "*wood**hard*arrow" );
+    CHECK( parts.matches( "wood hardened arrow" ) );
+    CHECK( parts.matches( "Some WOODEN hard ARROW" ) );
+    CHECK_FALSE( parts.matches( "hard wooden arrow" ) );
+    CHECK_FALSE( parts.matches( "wood hardened arrows" ) );
+
+    const wildcard_pattern anything( "*" );
+    CHECK( anything.matches( "rock" ) );
+    CHECK_FALSE( anything.matches( "" ) );
+
+    CHECK( wildcard_pattern( "wood*" ).matches( "Wood hard arrow" ) );
+    CHECK_FALSE( wildcard_pattern( "*arrow" ).matches( "arrows" ) );
+    // The pieces must not overlap
+    CHECK_FALSE( wildcard_pattern( "w*ood*d" ).matches( "wood" ) );
+    CHECK( wildcard_pattern( "w*o*d" ).matches( "wood" ) );
+}
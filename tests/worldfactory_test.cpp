@@ -0,0 +1,38 @@
+#include "catch/catch.hpp"
+
+#include <ostream>
+#include <string>
+
+#include "cata_utility.h"
+#include "filesystem.h"
+#include "worldfactory.h"
+
+TEST_CASE( "unchanged_worlds_are_kept_and_changed_ones_read_again", "[worldfactory]" )
+{
+    REQUIRE( world_generator->active_world != nullptr );
+    const std::string world_name = world_generator->active_world->world_name;
+    // Other tests may have written to the world since it was last read
+    world_generator->init();
+    WORLDPTR world = world_generator->get_world( world_name );
+    world_generator->set_active_world( world );
+    const save_t save = save_t::from_player_name( "Reread Test" );
+    const std::string save_path = world->folder_path() + "/" + save.base_path() + ".sav";
+    REQUIRE( !world->save_exists( save ) );
+
+    world_generator->init();
+    CHECK( world_generator->get_world( world_name ) == world );
+
+    write_to_file( save_path, []( std::ostream & fout ) {
+        fout << "{}";
+    } );
+    world_generator->init();
+    world = world_generator->get_world( world_name );
+    world_generator->set_active_world( world );
+    CHECK( world->save_exists( save ) );
+
+    remove_file( save_path );
+    world_generator->init();
+    world = world_generator->get_world( world_name );
+    world_generator->set_active_world( world );
+    CHECK( !world->save_exists( save ) );
+}